@@ -39,6 +39,9 @@
 #include <abi/proc/task.h>
 #include <abi/cap.h>
 #include <_bits/errno.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 /* Miscellaneous constants */
 enum {
@@ -57,6 +60,12 @@ enum {
 	 * IPC_M_DATA_READ requests.
 	 */
 	DATA_XFER_LIMIT = 64 * 1024,
+
+	/**
+	 * Maximum number of calls made or received by one batched
+	 * IPC syscall.
+	 */
+	IPC_BATCH_LIMIT = 64,
 };
 
 /* Flags for calls */
@@ -122,6 +131,16 @@ typedef struct {
 	cap_call_handle_t cap_handle;
 } ipc_data_t;
 
+/** One call of a batched asynchronous IPC submission */
+typedef struct {
+	/** Phone capability handle to make the call over */
+	cap_phone_handle_t phone;
+	/** User-defined label associated with the answer */
+	sysarg_t label;
+	/** Interface, method and payload of the call */
+	sysarg_t args[IPC_CALL_LEN];
+} ipc_batch_call_t;
+
 /* Functions for manipulating calling data */
 
 static inline void ipc_set_retval(ipc_data_t *data, errno_t retval)
@@ -193,6 +212,8 @@ static inline sysarg_t ipc_get_arg5(ipc_data_t *data)
 	return data->args[5];
 }
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
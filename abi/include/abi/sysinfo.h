@@ -65,11 +65,15 @@ typedef enum {
  *
  */
 typedef struct {
-	unsigned int id;         /**< CPU ID as stored by kernel */
-	bool active;             /**< CPU is activate */
-	uint16_t frequency_mhz;  /**< Frequency in MHz */
-	uint64_t idle_cycles;    /**< Number of idle cycles */
-	uint64_t busy_cycles;    /**< Number of busy cycles */
+	unsigned int id;           /**< CPU ID as stored by kernel */
+	bool active;               /**< CPU is activate */
+	uint16_t frequency_mhz;    /**< Frequency in MHz */
+	uint64_t idle_cycles;      /**< Number of idle cycles */
+	uint64_t busy_cycles;      /**< Number of busy cycles */
+	uint64_t dispatches;       /**< Number of threads dispatched */
+	uint64_t wait_cycles;      /**< Total cycles from ready to dispatch */
+	uint64_t max_wait_cycles;  /**< Longest ready to dispatch wait */
+	uint64_t migrations;       /**< Threads dispatched from another CPU */
 } stats_cpu_t;
 
 /** Physical memory statistics
@@ -82,6 +86,21 @@ typedef struct {
 	uint64_t free;     /**< Free physical memory (bytes) */
 } stats_physmem_t;
 
+/** Number of block orders in stats_frames_t */
+#define STATS_FRAME_ORDERS  16
+
+/** Physical frame allocator statistics
+ *
+ */
+typedef struct {
+	uint64_t free_blocks[STATS_FRAME_ORDERS];  /**< Free blocks of each order */
+	uint64_t cached;        /**< Free frames held in per-CPU caches */
+	uint64_t cache_allocs;  /**< Allocations served by per-CPU caches */
+	uint64_t cache_cycles;  /**< Cycles spent in these allocations */
+	uint64_t zone_allocs;   /**< Allocations served by the zones */
+	uint64_t zone_cycles;   /**< Cycles spent in these allocations */
+} stats_frames_t;
+
 /** IPC statistics
  *
  * Associated with a task.
@@ -94,6 +113,7 @@ typedef struct {
 	uint64_t answer_received;     /**< IPC answers received */
 	uint64_t irq_notif_received;  /**< IPC IRQ notifications */
 	uint64_t forwarded;           /**< IPC messages forwarded */
+	uint64_t syscalls;            /**< IPC call and wait syscalls */
 } stats_ipc_t;
 
 /** Statistics about a single task
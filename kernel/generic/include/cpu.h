@@ -59,6 +59,11 @@ typedef struct cpu {
 
 	atomic_t nrdy;
 	runq_t rq[RQ_COUNT];
+	/**
+	 * Bit i is set iff rq[i] is not empty. Only modified with
+	 * rq[i].lock held, but may be read without it as a hint.
+	 */
+	atomic_uint rq_bitmap;
 	volatile size_t needs_relink;
 
 	IRQ_SPINLOCK_DECLARE(timeoutlock);
@@ -81,6 +86,14 @@ typedef struct cpu {
 	uint64_t idle_cycles;
 	uint64_t busy_cycles;
 
+	/**
+	 * Scheduler accounting. Protected by lock.
+	 */
+	uint64_t dispatches;
+	uint64_t wait_cycles;
+	uint64_t max_wait_cycles;
+	uint64_t migrations;
+
 	/**
 	 * Processor ID assigned by kernel.
 	 */
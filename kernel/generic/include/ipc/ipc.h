@@ -42,12 +42,20 @@
 #include <abi/proc/task.h>
 #include <typedefs.h>
 #include <mm/slab.h>
+#include <mm/pin.h>
 #include <cap/cap.h>
 
 struct answerbox;
 struct task;
 struct call;
 
+/**
+ * IPC_M_DATA_WRITE and IPC_M_DATA_READ transfers of at least this many
+ * bytes pin the userspace buffer of the calling task and copy directly
+ * between the two address spaces instead of going through call_t::buffer.
+ */
+#define DATA_XFER_PIN_THRESHOLD  (16 * 1024)
+
 typedef enum {
 	/** Phone is free and can be allocated */
 	IPC_PHONE_FREE = 0,
@@ -165,6 +173,9 @@ typedef struct call {
 
 	/** Buffer for IPC_M_DATA_WRITE and IPC_M_DATA_READ. */
 	uint8_t *buffer;
+
+	/** Pinned caller buffer for IPC_M_DATA_WRITE and IPC_M_DATA_READ. */
+	pin_t *pin;
 } call_t;
 
 extern slab_cache_t *phone_cache;
@@ -178,6 +189,7 @@ extern call_t *ipc_call_alloc(void);
 extern errno_t ipc_call_sync(phone_t *, call_t *);
 extern errno_t ipc_call(phone_t *, call_t *);
 extern errno_t ipc_wait_for_call(answerbox_t *, uint32_t, unsigned int, call_t **);
+extern bool ipc_answerbox_pending(answerbox_t *);
 extern errno_t ipc_forward(call_t *, phone_t *, answerbox_t *, unsigned int);
 extern void ipc_answer(answerbox_t *, call_t *);
 extern void _ipc_answer_free_call(call_t *, bool);
@@ -315,6 +315,7 @@ extern void as_hold(as_t *);
 extern void as_release(as_t *);
 extern void as_switch(as_t *, as_t *);
 extern int as_page_fault(uintptr_t, pf_access_t, istate_t *);
+extern errno_t as_page_reference(uintptr_t, pf_access_t, uintptr_t *, bool *);
 
 extern as_area_t *as_area_create(as_t *, unsigned int, size_t, unsigned int,
     mem_backend_t *, mem_backend_data_t *, uintptr_t *, uintptr_t);
@@ -38,15 +38,20 @@
 
 #include <typedefs.h>
 #include <trace.h>
+#include <atomic.h>
 #include <adt/bitmap.h>
 #include <adt/list.h>
 #include <synch/spinlock.h>
 #include <arch/mm/page.h>
 #include <arch/mm/frame.h>
+#include <abi/sysinfo.h>
 
 /** Maximum number of zones in the system. */
 #define ZONES_MAX  32
 
+/** Number of block orders managed by the buddy allocator. */
+#define FRAME_BUDDY_ORDERS  11
+
 typedef uint8_t frame_flags_t;
 
 #define FRAME_NONE        0x00
@@ -90,8 +95,11 @@ typedef uint8_t zone_flags_t;
 	    (((zf) & ~ZONE_EF_MASK) & (f)))
 
 typedef struct {
-	size_t refcount;  /**< Tracking of shared frames */
-	void *parent;     /**< If allocated by slab, this points there */
+	atomic_size_t refcount;  /**< Tracking of shared frames */
+	void *parent;            /**< If allocated by slab, this points there */
+	uint32_t buddy_prev;     /**< Previous free block of the same order */
+	uint32_t buddy_next;     /**< Next free block of the same order */
+	uint8_t buddy_order;     /**< Order of the free block headed here */
 } frame_t;
 
 typedef struct {
@@ -110,9 +118,15 @@ typedef struct {
 	/** Type of the zone */
 	zone_flags_t flags;
 
-	/** Frame bitmap */
+	/** Frame bitmap (set for frames not on the buddy free lists) */
 	bitmap_t bitmap;
 
+	/** Buddy free lists, indices of the first free block of each order */
+	uint32_t buddy_head[FRAME_BUDDY_ORDERS];
+
+	/** Number of free blocks of each order */
+	size_t buddy_count[FRAME_BUDDY_ORDERS];
+
 	/** Array of frame_t structures in this zone */
 	frame_t *frames;
 } zone_t;
@@ -130,6 +144,7 @@ typedef struct {
 extern zones_t zones;
 
 extern void frame_init(void);
+extern void frame_enable_cpucache(void);
 extern bool frame_adjust_zone_bounds(bool, uintptr_t *, size_t *);
 extern uintptr_t frame_alloc_generic(size_t, frame_flags_t, uintptr_t,
     size_t *);
@@ -138,6 +153,7 @@ extern void frame_free_generic(uintptr_t, size_t, frame_flags_t);
 extern void frame_free(uintptr_t, size_t);
 extern void frame_free_noreserve(uintptr_t, size_t);
 extern void frame_reference_add(pfn_t);
+extern bool frame_reference_try_add(pfn_t);
 extern size_t frame_total_free_get(void);
 
 extern size_t find_zone(pfn_t, size_t, size_t);
@@ -151,6 +167,7 @@ extern bool zone_merge(size_t, size_t);
 extern void zone_merge_all(void);
 extern uint64_t zones_total_size(void);
 extern void zones_stats(uint64_t *, uint64_t *, uint64_t *, uint64_t *);
+extern void zones_alloc_stats(stats_frames_t *);
 
 /*
  * Console functions
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_generic_mm
+ * @{
+ */
+/** @file
+ */
+
+#ifndef KERN_PIN_H_
+#define KERN_PIN_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <typedefs.h>
+#include <errno.h>
+
+typedef struct {
+	/** Physical address of the frame. */
+	uintptr_t addr;
+	/** The reference is dropped with the reserving frame_free(). */
+	bool reserved;
+} pin_frame_t;
+
+/** Userspace buffer pinned in physical memory.
+ *
+ * Each frame backing the buffer holds an extra reference, so the data
+ * stays reachable even if the owning address space changes or goes away.
+ */
+typedef struct {
+	/** Offset of the first byte within the first frame. */
+	size_t offset;
+	/** Size of the pinned buffer in bytes. */
+	size_t size;
+	/** Number of frames in @c frames. */
+	size_t count;
+	/** Pinned frames. */
+	pin_frame_t frames[];
+} pin_t;
+
+extern errno_t pin_create(uspace_addr_t, size_t, bool, pin_t **);
+extern void pin_destroy(pin_t *);
+extern errno_t pin_copy_to_uspace(uspace_addr_t, pin_t *, size_t);
+extern errno_t pin_copy_from_uspace(pin_t *, uspace_addr_t, size_t);
+
+#endif
+
+/** @}
+ */
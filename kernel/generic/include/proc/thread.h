@@ -184,6 +184,8 @@ typedef struct thread {
 	uint64_t kcycles;
 	/** Last sampled cycle. */
 	uint64_t last_cycle;
+	/** Cycle at which the thread was last made ready. */
+	uint64_t ready_cycle;
 	/** Thread doesn't affect accumulated accounting. */
 	bool uncounted;
 
@@ -86,6 +86,7 @@ static void _ipc_call_init(call_t *call)
 	call->sender = NULL;
 	call->callerbox = NULL;
 	call->buffer = NULL;
+	call->pin = NULL;
 }
 
 static void call_destroy(void *arg)
@@ -94,6 +95,8 @@ static void call_destroy(void *arg)
 
 	if (call->buffer)
 		free(call->buffer);
+	if (call->pin)
+		pin_destroy(call->pin);
 	if (call->caller_phone)
 		kobject_put(call->caller_phone->kobject);
 	slab_free(call_cache, call);
@@ -613,6 +616,23 @@ errno_t ipc_wait_for_call(answerbox_t *box, uint32_t usec, unsigned int flags,
 	return EOK;
 }
 
+/** Check whether an answerbox has a call, answer or notification queued.
+ *
+ * @param box Answerbox to check.
+ *
+ * @return True if ipc_wait_for_call() would find something to receive.
+ *
+ */
+bool ipc_answerbox_pending(answerbox_t *box)
+{
+	irq_spinlock_lock(&box->lock, true);
+	bool pending = !list_empty(&box->irq_notifs) ||
+	    !list_empty(&box->answers) || !list_empty(&box->calls);
+	irq_spinlock_unlock(&box->lock, true);
+
+	return pending;
+}
+
 /** Answer all calls from list with EHANGUP answer.
  *
  * @param box Answerbox with the list.
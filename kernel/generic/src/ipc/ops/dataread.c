@@ -38,21 +38,33 @@
 #include <stdlib.h>
 #include <abi/errno.h>
 #include <syscall/copy.h>
+#include <mm/pin.h>
 #include <config.h>
 
 static errno_t request_preprocess(call_t *call, phone_t *phone)
 {
+	uspace_addr_t dst = ipc_get_arg1(&call->data);
 	size_t size = ipc_get_arg2(&call->data);
 
 	if (size > DATA_XFER_LIMIT) {
 		int flags = ipc_get_arg3(&call->data);
 
-		if (flags & IPC_XF_RESTRICT)
-			ipc_set_arg2(&call->data, DATA_XFER_LIMIT);
-		else
+		if (flags & IPC_XF_RESTRICT) {
+			size = DATA_XFER_LIMIT;
+			ipc_set_arg2(&call->data, size);
+		} else
 			return ELIMIT;
 	}
 
+	if (size >= DATA_XFER_PIN_THRESHOLD) {
+		/*
+		 * Pin the destination buffer so that the recipient can copy
+		 * the data directly into it. If that fails, the data will be
+		 * transferred via a bounce buffer.
+		 */
+		(void) pin_create(dst, size, true, &call->pin);
+	}
+
 	return EOK;
 }
 
@@ -74,6 +86,17 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 			 */
 			ipc_set_arg1(&answer->data, dst);
 
+			if (answer->pin) {
+				errno_t rc = pin_copy_from_uspace(answer->pin,
+				    src, size);
+				if (rc)
+					ipc_set_retval(&answer->data, rc);
+
+				pin_destroy(answer->pin);
+				answer->pin = NULL;
+				return EOK;
+			}
+
 			answer->buffer = malloc(size);
 			if (!answer->buffer) {
 				ipc_set_retval(&answer->data, ENOMEM);
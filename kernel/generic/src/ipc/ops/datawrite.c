@@ -38,6 +38,7 @@
 #include <stdlib.h>
 #include <abi/errno.h>
 #include <syscall/copy.h>
+#include <mm/pin.h>
 #include <config.h>
 
 static errno_t request_preprocess(call_t *call, phone_t *phone)
@@ -55,6 +56,16 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 			return ELIMIT;
 	}
 
+	if (size >= DATA_XFER_PIN_THRESHOLD) {
+		/*
+		 * Pin the source buffer and let the recipient copy the data
+		 * directly from it. Fall back to the bounce buffer if some of
+		 * the pages cannot be pinned.
+		 */
+		if (pin_create(src, size, false, &call->pin) == EOK)
+			return EOK;
+	}
+
 	call->buffer = (uint8_t *) malloc(size);
 	if (!call->buffer)
 		return ENOMEM;
@@ -72,7 +83,7 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 
 static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 {
-	assert(answer->buffer);
+	assert(answer->buffer || answer->pin);
 
 	if (!ipc_get_retval(&answer->data)) {
 		/* The recipient agreed to receive data. */
@@ -81,8 +92,12 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		size_t max_size = ipc_get_arg2(olddata);
 
 		if (size <= max_size) {
-			errno_t rc = copy_to_uspace(dst,
-			    answer->buffer, size);
+			errno_t rc;
+
+			if (answer->pin)
+				rc = pin_copy_to_uspace(dst, answer->pin, size);
+			else
+				rc = copy_to_uspace(dst, answer->buffer, size);
 			if (rc)
 				ipc_set_retval(&answer->data, rc);
 		} else {
@@ -90,6 +105,12 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		}
 	}
 
+	if (answer->pin) {
+		/* Do not keep the sender's pages pinned until the answer is read. */
+		pin_destroy(answer->pin);
+		answer->pin = NULL;
+	}
+
 	return EOK;
 }
 
@@ -350,6 +350,14 @@ static int check_call_limit(phone_t *phone)
 	return 0;
 }
 
+/** Count an IPC call or wait syscall of the current task. */
+static void count_syscall(void)
+{
+	irq_spinlock_lock(&TASK->lock, true);
+	TASK->ipc_info.syscalls++;
+	irq_spinlock_unlock(&TASK->lock, true);
+}
+
 /** Make a fast asynchronous call over IPC.
  *
  * This function can only handle three arguments of payload, but is faster than
@@ -369,6 +377,8 @@ static int check_call_limit(phone_t *phone)
 sys_errno_t sys_ipc_call_async_fast(cap_phone_handle_t handle, sysarg_t imethod,
     sysarg_t arg1, sysarg_t arg2, sysarg_t arg3, sysarg_t label)
 {
+	count_syscall();
+
 	kobject_t *kobj = kobject_get(TASK, handle, KOBJECT_TYPE_PHONE);
 	if (!kobj)
 		return ENOENT;
@@ -409,17 +419,17 @@ sys_errno_t sys_ipc_call_async_fast(cap_phone_handle_t handle, sysarg_t imethod,
 	return EOK;
 }
 
-/** Make an asynchronous IPC call allowing to transmit the entire payload.
+/** Make an asynchronous IPC call with the payload already in the kernel.
  *
  * @param handle  Phone capability for the call.
- * @param data    Userspace address of call data with the request.
+ * @param args    Interface, method and payload of the call.
  * @param label   User-defined label.
  *
  * @return See sys_ipc_call_async_fast().
  *
  */
-sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_data_t data,
-    sysarg_t label)
+static errno_t ipc_call_async_args(cap_phone_handle_t handle,
+    const sysarg_t *args, sysarg_t label)
 {
 	kobject_t *kobj = kobject_get(TASK, handle, KOBJECT_TYPE_PHONE);
 	if (!kobj)
@@ -436,13 +446,7 @@ sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_da
 		return ENOMEM;
 	}
 
-	errno_t rc = copy_from_uspace(&call->data.args, data + offsetof(ipc_data_t, args),
-	    sizeof(call->data.args));
-	if (rc != EOK) {
-		kobject_put(call->kobject);
-		kobject_put(kobj);
-		return (sys_errno_t) rc;
-	}
+	memcpy(call->data.args, args, sizeof(call->data.args));
 
 	/* Set the user-defined label */
 	call->data.answer_label = label;
@@ -458,6 +462,82 @@ sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_da
 	return EOK;
 }
 
+/** Make an asynchronous IPC call allowing to transmit the entire payload.
+ *
+ * @param handle  Phone capability for the call.
+ * @param data    Userspace address of call data with the request.
+ * @param label   User-defined label.
+ *
+ * @return See sys_ipc_call_async_fast().
+ *
+ */
+sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_data_t data,
+    sysarg_t label)
+{
+	sysarg_t args[IPC_CALL_LEN];
+
+	count_syscall();
+
+	errno_t rc = copy_from_uspace(args, data + offsetof(ipc_data_t, args),
+	    sizeof(args));
+	if (rc != EOK)
+		return (sys_errno_t) rc;
+
+	return (sys_errno_t) ipc_call_async_args(handle, args, label);
+}
+
+/** Make a batch of asynchronous IPC calls.
+ *
+ * The calls are made in the order of the array. Processing stops
+ * at the first call which cannot be made.
+ *
+ * @param calls     Userspace address of the array of calls.
+ * @param count     Number of calls in the array, at most IPC_BATCH_LIMIT.
+ * @param submitted Userspace address where to store the number of calls
+ *                  which were made.
+ *
+ * @return EOK if all calls were made.
+ * @return An error code of the first call which could not be made,
+ *         see sys_ipc_call_async_fast().
+ *
+ */
+sys_errno_t sys_ipc_call_async_batch(uspace_ptr_ipc_batch_call_t calls,
+    size_t count, uspace_ptr_size_t submitted)
+{
+	count_syscall();
+
+	if (count > IPC_BATCH_LIMIT)
+		return EINVAL;
+
+	ipc_batch_call_t chunk[8];
+	size_t done = 0;
+	errno_t rc = EOK;
+
+	while ((done < count) && (rc == EOK)) {
+		size_t cnt = min(count - done, sizeof(chunk) / sizeof(chunk[0]));
+
+		rc = copy_from_uspace(chunk, calls + done * sizeof(ipc_batch_call_t),
+		    cnt * sizeof(ipc_batch_call_t));
+		if (rc != EOK)
+			break;
+
+		for (size_t i = 0; i < cnt; i++) {
+			rc = ipc_call_async_args(chunk[i].phone, chunk[i].args,
+			    chunk[i].label);
+			if (rc != EOK)
+				break;
+
+			done++;
+		}
+	}
+
+	errno_t rc_copy = copy_to_uspace(submitted, &done, sizeof(done));
+	if (rc_copy != EOK)
+		return (sys_errno_t) rc_copy;
+
+	return (sys_errno_t) rc;
+}
+
 /** Forward a received call to another destination
  *
  * Common code for both the fast and the slow version.
@@ -756,7 +836,7 @@ sys_errno_t sys_ipc_hangup(cap_phone_handle_t handle)
 	return rc;
 }
 
-/** Wait for an incoming IPC call or an answer.
+/** Receive one incoming IPC call or answer.
  *
  * @param calldata Pointer to buffer where the call/answer data is stored.
  * @param usec     Timeout. See waitq_sleep_timeout() for explanation.
@@ -764,8 +844,9 @@ sys_errno_t sys_ipc_hangup(cap_phone_handle_t handle)
  *                 for explanation.
  *
  * @return An error code on error.
+ *
  */
-sys_errno_t sys_ipc_wait_for_call(uspace_ptr_ipc_data_t calldata, uint32_t usec,
+static errno_t ipc_wait_one(uspace_ptr_ipc_data_t calldata, uint32_t usec,
     unsigned int flags)
 {
 	call_t *call = NULL;
@@ -865,6 +946,77 @@ error:
 	return rc;
 }
 
+/** Wait for an incoming IPC call or an answer.
+ *
+ * @param calldata Pointer to buffer where the call/answer data is stored.
+ * @param usec     Timeout. See waitq_sleep_timeout() for explanation.
+ * @param flags    Select mode of sleep operation. See waitq_sleep_timeout()
+ *                 for explanation.
+ *
+ * @return An error code on error.
+ */
+sys_errno_t sys_ipc_wait_for_call(uspace_ptr_ipc_data_t calldata, uint32_t usec,
+    unsigned int flags)
+{
+	count_syscall();
+	return (sys_errno_t) ipc_wait_one(calldata, usec, flags);
+}
+
+/** Wait for incoming IPC calls or answers and receive as many as possible.
+ *
+ * Only the wait for the first call blocks, the other calls are received
+ * only if they are already waiting. A pending poke ends the batch, so
+ * that it reaches the next wait.
+ *
+ * @param calldata Pointer to the array where the call/answer data is stored.
+ * @param count    Number of entries of the array, at most IPC_BATCH_LIMIT.
+ * @param usec     Timeout of the first wait. See waitq_sleep_timeout()
+ *                 for explanation.
+ * @param flags    Select mode of sleep operation of the first wait. See
+ *                 waitq_sleep_timeout() for explanation.
+ * @param received Pointer to where the number of received calls is stored.
+ *
+ * @return An error code if no call was received.
+ *
+ */
+sys_errno_t sys_ipc_wait_batch(uspace_ptr_ipc_data_t calldata, size_t count,
+    uint32_t usec, unsigned int flags, uspace_ptr_size_t received)
+{
+	count_syscall();
+
+	if ((count == 0) || (count > IPC_BATCH_LIMIT))
+		return EINVAL;
+
+	errno_t rc = ipc_wait_one(calldata, usec, flags);
+	if (rc != EOK)
+		return (sys_errno_t) rc;
+
+	/*
+	 * A wakeup from sys_ipc_poke() is only consumed by the blocking wait,
+	 * so only continue while there is something queued.
+	 */
+	size_t done = 1;
+	while ((done < count) && ipc_answerbox_pending(&TASK->answerbox)) {
+		rc = ipc_wait_one(calldata + done * sizeof(ipc_data_t),
+		    SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING);
+		if (rc == ENOENT) {
+			/*
+			 * The queued call is gone (taken by another thread or
+			 * a discarded answer), so the wakeup we consumed was
+			 * most likely a poke. Leave it for the next wait.
+			 */
+			waitq_wakeup(&TASK->answerbox.wq, WAKEUP_FIRST);
+		}
+
+		if (rc != EOK)
+			break;
+
+		done++;
+	}
+
+	return (sys_errno_t) copy_to_uspace(received, &done, sizeof(done));
+}
+
 /** Interrupt one thread from sys_ipc_wait_for_call().
  *
  */
@@ -1607,6 +1607,92 @@ page_fault:
 	return AS_PF_DEFER;
 }
 
+/** Check whether a present mapping allows a read or write access. */
+static bool pte_allows(pte_t *pte, pf_access_t access)
+{
+	if (!PTE_PRESENT(pte))
+		return false;
+
+	return (access == PF_ACCESS_WRITE) ? PTE_WRITABLE(pte) :
+	    PTE_READABLE(pte);
+}
+
+/** Reference the frame backing a page of the current address space.
+ *
+ * The page is resolved the same way a userspace access would resolve it,
+ * but its contents are left untouched.
+ *
+ * @param address  Userspace address within the page.
+ * @param access   Access mode the page must allow (read or write).
+ * @param frame    Place to store the physical address of the frame.
+ * @param reserved Place to store whether the reference is to be dropped
+ *                 with frame_free() rather than frame_free_noreserve(),
+ *                 i.e. whether the area's backend would use the former.
+ *
+ * @return EOK on success.
+ * @return ENOMEM if a late memory reservation failed.
+ * @return ENOENT if the page cannot be mapped with the requested access
+ *         or is not backed by memory managed by the frame allocator.
+ *
+ */
+errno_t as_page_reference(uintptr_t address, pf_access_t access,
+    uintptr_t *frame, bool *reserved)
+{
+	uintptr_t page = ALIGN_DOWN(address, PAGE_SIZE);
+	errno_t rc = ENOENT;
+
+	mutex_lock(&AS->lock);
+	as_area_t *area = find_area_and_lock(AS, page);
+	if (!area) {
+		mutex_unlock(&AS->lock);
+		return ENOENT;
+	}
+
+	if ((area->attributes & AS_AREA_ATTR_PARTIAL) ||
+	    (!area->backend) || (!area->backend->page_fault)) {
+		mutex_unlock(&area->lock);
+		mutex_unlock(&AS->lock);
+		return ENOENT;
+	}
+
+	page_table_lock(AS, false);
+
+	pte_t pte;
+	if ((!page_mapping_find(AS, page, false, &pte)) ||
+	    (!pte_allows(&pte, access))) {
+		int pf = area->backend->page_fault(area, page, access);
+		if (pf != AS_PF_OK) {
+			rc = (pf == AS_PF_SILENT) ? ENOMEM : ENOENT;
+			goto out;
+		}
+
+		if ((!page_mapping_find(AS, page, false, &pte)) ||
+		    (!pte_allows(&pte, access)))
+			goto out;
+	}
+
+	if (!frame_reference_try_add(ADDR2PFN(PTE_GET_FRAME(&pte))))
+		goto out;
+
+	*frame = PTE_GET_FRAME(&pte);
+
+	/*
+	 * Frames of late-reserving anonymous areas and of user-paged areas
+	 * carry their own reservation. Other backends give it back when
+	 * the area is destroyed or resized.
+	 */
+	*reserved = (area->backend == &user_backend) ||
+	    ((area->backend == &anon_backend) &&
+	    (area->flags & AS_AREA_LATE_RESERVE));
+	rc = EOK;
+
+out:
+	page_table_unlock(AS, false);
+	mutex_unlock(&area->lock);
+	mutex_unlock(&AS->lock);
+	return rc;
+}
+
 /** Switch address spaces.
  *
  * Note that this function cannot sleep as it is essentially a part of
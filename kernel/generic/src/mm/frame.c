@@ -37,7 +37,9 @@
  * @brief Physical frame allocator.
  *
  * This file contains the physical frame allocator and memory zone management.
- * The frame allocator is built on top of the two-level bitmap structure.
+ * Free frames of each zone are kept on buddy free lists, with the two-level
+ * bitmap structure tracking which frames are off the lists. Single frames
+ * are allocated and freed through small per-CPU caches.
  *
  */
 
@@ -60,6 +62,10 @@
 #include <macros.h>
 #include <config.h>
 #include <str.h>
+#include <mem.h>
+#include <stdlib.h>
+#include <cpu.h>
+#include <arch/cycle.h>
 #include <proc/thread.h> /* THREAD */
 
 zones_t zones;
@@ -73,6 +79,55 @@ static condvar_t mem_avail_cv;
 static size_t mem_avail_req = 0;  /**< Number of frames requested. */
 static size_t mem_avail_gen = 0;  /**< Generation counter. */
 
+/** Number of frames of each kind a per-CPU cache can hold. */
+#define FRAME_CACHE_SIZE  64
+
+/** Number of frames moved between a per-CPU cache and the zones at once. */
+#define FRAME_CACHE_BATCH  16
+
+typedef enum {
+	FRAME_CACHE_LOWMEM,
+	FRAME_CACHE_HIGHMEM,
+	FRAME_CACHE_KINDS
+} frame_cache_kind_t;
+
+/** Per-CPU cache of single free frames.
+ *
+ * Single-frame allocations without a constraint are served from the cache
+ * of the current CPU and single frames are freed into it, so that the
+ * common case does not need the zones lock. From the point of view of the
+ * zones, the cached frames are allocated. They have the reference count
+ * of one and do not appear on the buddy free lists.
+ */
+typedef struct {
+	IRQ_SPINLOCK_DECLARE(lock);
+
+	/** Number of cached frames of each kind */
+	size_t count[FRAME_CACHE_KINDS];
+
+	/** Stacks of cached frames, the most recently freed on top */
+	pfn_t pfn[FRAME_CACHE_KINDS][FRAME_CACHE_SIZE];
+
+	/** Number of allocations served by the cache */
+	uint64_t allocs;
+
+	/** Cycles spent in allocations served by the cache */
+	uint64_t cycles;
+} frame_cache_t;
+
+/** Per-CPU frame caches, NULL until frame_enable_cpucache() */
+static frame_cache_t *frame_caches = NULL;
+
+/** True if there is high memory to be cached separately. */
+static bool frame_cache_highmem = false;
+
+/*
+ * Number of allocations served by the zones and cycles spent in them.
+ * Protected by the zones lock.
+ */
+static uint64_t zone_allocs = 0;
+static uint64_t zone_cycles = 0;
+
 /** Initialize frame structure.
  *
  * @param frame Frame structure to be initialized.
@@ -209,18 +264,380 @@ _NO_TRACE size_t find_zone(pfn_t frame, size_t count, size_t hint)
 	return (size_t) -1;
 }
 
+/** Check if frame range  priority memory
+ *
+ * @param pfn   Starting frame.
+ * @param count Number of frames.
+ *
+ * @return True if the range contains only priority memory.
+ *
+ */
+_NO_TRACE static bool is_high_priority(pfn_t base, size_t count)
+{
+	return (base + count <= FRAME_LOWPRIO);
+}
+
+/*****************************/
+/* Buddy allocator functions */
+/*****************************/
+
+/*
+ * Free frames of a zone are kept in naturally aligned blocks of 2^order
+ * frames on per-order free lists. The lists are linked through the frame_t
+ * structures of the first frame of each block, by indices relative to the
+ * zone base, so that the zone structure can be moved and copied freely.
+ *
+ * The zone bitmap is kept in sync: a bit is clear if and only if the frame
+ * belongs to a block on one of the free lists. Allocations the buddy
+ * allocator cannot serve directly (larger than the largest block or with
+ * an unusual constraint) search the bitmap and carve the frames out of the
+ * free blocks afterwards.
+ */
+
+/** The frame does not head a free block. */
+#define BUDDY_ORDER_NONE  UINT8_MAX
+
+/** End of a buddy free list. */
+#define BUDDY_NIL  UINT32_MAX
+
+/** Number of frames in a block of given order. */
+#define BUDDY_SIZE(order)  (((size_t) 1) << (order))
+
+/** Put a free block on the free list of its order.
+ *
+ * High-priority memory is put at the end of the list so that it is used
+ * only when no other block of that order is available.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ * @param order Order of the block.
+ *
+ */
+_NO_TRACE static void buddy_insert(zone_t *zone, size_t index,
+    unsigned int order)
+{
+	frame_t *frame = &zone->frames[index];
+	uint32_t head = zone->buddy_head[order];
+
+	frame->buddy_order = order;
+
+	if (head == BUDDY_NIL) {
+		frame->buddy_prev = index;
+		frame->buddy_next = index;
+		zone->buddy_head[order] = index;
+	} else {
+		frame_t *first = &zone->frames[head];
+
+		frame->buddy_next = head;
+		frame->buddy_prev = first->buddy_prev;
+		zone->frames[first->buddy_prev].buddy_next = index;
+		first->buddy_prev = index;
+
+		if (!is_high_priority(zone->base + index, BUDDY_SIZE(order)))
+			zone->buddy_head[order] = index;
+	}
+
+	zone->buddy_count[order]++;
+}
+
+/** Take a free block off its free list.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ *
+ */
+_NO_TRACE static void buddy_remove(zone_t *zone, size_t index)
+{
+	frame_t *frame = &zone->frames[index];
+	unsigned int order = frame->buddy_order;
+
+	assert(order < FRAME_BUDDY_ORDERS);
+
+	if (frame->buddy_next == index) {
+		zone->buddy_head[order] = BUDDY_NIL;
+	} else {
+		zone->frames[frame->buddy_prev].buddy_next = frame->buddy_next;
+		zone->frames[frame->buddy_next].buddy_prev = frame->buddy_prev;
+
+		if (zone->buddy_head[order] == index)
+			zone->buddy_head[order] = frame->buddy_next;
+	}
+
+	frame->buddy_order = BUDDY_ORDER_NONE;
+	zone->buddy_count[order]--;
+}
+
+/** Free a block and merge it with its free buddies.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ * @param order Order of the block.
+ *
+ */
+_NO_TRACE static void buddy_free_block(zone_t *zone, size_t index,
+    unsigned int order)
+{
+	while (order + 1 < FRAME_BUDDY_ORDERS) {
+		pfn_t buddy = (zone->base + index) ^ BUDDY_SIZE(order);
+		if (buddy < zone->base)
+			break;
+
+		size_t buddy_index = buddy - zone->base;
+		if (buddy_index + BUDDY_SIZE(order) > zone->count)
+			break;
+
+		if (zone->frames[buddy_index].buddy_order != order)
+			break;
+
+		buddy_remove(zone, buddy_index);
+		index = min(index, buddy_index);
+		order++;
+	}
+
+	buddy_insert(zone, index, order);
+}
+
+/** Free a range of frames as the largest possible aligned blocks.
+ *
+ * @param zone  Zone containing the range.
+ * @param index Index of the first frame of the range.
+ * @param count Number of frames in the range.
+ *
+ */
+_NO_TRACE static void buddy_free_range(zone_t *zone, size_t index,
+    size_t count)
+{
+	while (count > 0) {
+		unsigned int order = 0;
+
+		while ((order + 1 < FRAME_BUDDY_ORDERS) &&
+		    (BUDDY_SIZE(order + 1) <= count) &&
+		    (((zone->base + index) & (BUDDY_SIZE(order + 1) - 1)) == 0))
+			order++;
+
+		buddy_free_block(zone, index, order);
+
+		index += BUDDY_SIZE(order);
+		count -= BUDDY_SIZE(order);
+	}
+}
+
+/** Find the free block containing a frame.
+ *
+ * @param zone  Zone containing the frame.
+ * @param index Index of the frame.
+ *
+ * @return Index of the first frame of the block.
+ * @return -1 if the frame is not free.
+ *
+ */
+_NO_TRACE static size_t buddy_block_find(zone_t *zone, size_t index)
+{
+	for (unsigned int order = 0; order < FRAME_BUDDY_ORDERS; order++) {
+		pfn_t head = ALIGN_DOWN(zone->base + index, BUDDY_SIZE(order));
+		if (head < zone->base)
+			break;
+
+		if (zone->frames[head - zone->base].buddy_order == order)
+			return head - zone->base;
+	}
+
+	return (size_t) -1;
+}
+
+/** Free the parts of a block which lie outside of a range.
+ *
+ * @param zone  Zone containing the block.
+ * @param index Index of the first frame of the block.
+ * @param order Order of the block.
+ * @param start Index of the first frame of the range.
+ * @param end   Index of the first frame after the range.
+ *
+ */
+_NO_TRACE static void buddy_split_outside(zone_t *zone, size_t index,
+    unsigned int order, size_t start, size_t end)
+{
+	size_t block_end = index + BUDDY_SIZE(order);
+
+	if ((block_end <= start) || (index >= end)) {
+		buddy_insert(zone, index, order);
+		return;
+	}
+
+	if ((index >= start) && (block_end <= end))
+		return;
+
+	buddy_split_outside(zone, index, order - 1, start, end);
+	buddy_split_outside(zone, index + BUDDY_SIZE(order - 1), order - 1,
+	    start, end);
+}
+
+/** Take a range of frames off the buddy free lists.
+ *
+ * The frames which are not free are skipped. The zone bitmap is not
+ * modified.
+ *
+ * @param zone  Zone containing the range.
+ * @param start Index of the first frame of the range.
+ * @param count Number of frames in the range.
+ *
+ */
+_NO_TRACE static void buddy_carve(zone_t *zone, size_t start, size_t count)
+{
+	size_t end = start + count;
+
+	for (size_t index = start; index < end; index++) {
+		size_t head = buddy_block_find(zone, index);
+		if (head == (size_t) -1)
+			continue;
+
+		unsigned int order = zone->frames[head].buddy_order;
+
+		buddy_remove(zone, head);
+		buddy_split_outside(zone, head, order, start, end);
+
+		index = min(head + BUDDY_SIZE(order), end) - 1;
+	}
+}
+
+/** Build the buddy free lists of a zone from its bitmap.
+ *
+ * @param zone Zone to process.
+ *
+ */
+_NO_TRACE static void buddy_build(zone_t *zone)
+{
+	for (unsigned int order = 0; order < FRAME_BUDDY_ORDERS; order++) {
+		zone->buddy_head[order] = BUDDY_NIL;
+		zone->buddy_count[order] = 0;
+	}
+
+	for (size_t index = 0; index < zone->count; index++)
+		zone->frames[index].buddy_order = BUDDY_ORDER_NONE;
+
+	size_t index = 0;
+	while (index < zone->count) {
+		if (bitmap_get(&zone->bitmap, index)) {
+			index++;
+			continue;
+		}
+
+		size_t count = 1;
+		while ((index + count < zone->count) &&
+		    (!bitmap_get(&zone->bitmap, index + count)))
+			count++;
+
+		buddy_free_range(zone, index, count);
+		index += count;
+	}
+}
+
+/** Get the block order suitable for an allocation.
+ *
+ * Buddy blocks are naturally aligned, so a constraint which only
+ * requires alignment is satisfied by a block of a large enough order.
+ *
+ * @param count      Number of frames to allocate.
+ * @param constraint Indication of bits that cannot be set in the
+ *                   physical frame number of the first allocated frame.
+ *
+ * @return Block order.
+ * @return FRAME_BUDDY_ORDERS if the buddy allocator cannot serve
+ *         the allocation.
+ *
+ */
+_NO_TRACE static unsigned int buddy_order_get(size_t count, pfn_t constraint)
+{
+	if ((constraint & (constraint + 1)) != 0)
+		return FRAME_BUDDY_ORDERS;
+
+	unsigned int order = 0;
+	while ((order < FRAME_BUDDY_ORDERS) &&
+	    ((BUDDY_SIZE(order) < count) || (BUDDY_SIZE(order) - 1 < constraint)))
+		order++;
+
+	return order;
+}
+
+/** Allocate a range of frames from the free lists of a zone.
+ *
+ * @param zone       Zone to allocate from.
+ * @param count      Number of frames to allocate.
+ * @param constraint Indication of bits that cannot be set in the
+ *                   physical frame number of the first allocated frame.
+ * @param index      Place to store the index of the first allocated frame.
+ *                   If NULL, only check whether the allocation is possible.
+ *
+ * @return True if the allocation is possible or was done.
+ *
+ */
+_NO_TRACE static bool buddy_alloc(zone_t *zone, size_t count,
+    pfn_t constraint, size_t *index)
+{
+	unsigned int order = buddy_order_get(count, constraint);
+
+	if (order >= FRAME_BUDDY_ORDERS) {
+		/* Fall back to searching the bitmap. */
+		if (!bitmap_allocate_range(&zone->bitmap, count, zone->base,
+		    FRAME_LOWPRIO, constraint, index))
+			return false;
+
+		if (index != NULL)
+			buddy_carve(zone, *index, count);
+
+		return true;
+	}
+
+	/*
+	 * Prefer blocks of low-priority memory. Such blocks are at the
+	 * beginning of the free lists, so it suffices to check the first
+	 * block of each order.
+	 */
+	for (unsigned int pass = 0; pass < 2; pass++) {
+		for (unsigned int i = order; i < FRAME_BUDDY_ORDERS; i++) {
+			uint32_t head = zone->buddy_head[i];
+			if (head == BUDDY_NIL)
+				continue;
+
+			if ((pass == 0) &&
+			    (is_high_priority(zone->base + head, BUDDY_SIZE(i))))
+				continue;
+
+			if (index == NULL)
+				return true;
+
+			buddy_remove(zone, head);
+
+			/* Split the block down to the requested order. */
+			while (i > order) {
+				i--;
+				buddy_insert(zone, head + BUDDY_SIZE(i), i);
+			}
+
+			/* Return the unused tail of the block. */
+			buddy_free_range(zone, head + count,
+			    BUDDY_SIZE(order) - count);
+
+			bitmap_set_range(&zone->bitmap, head, count);
+			*index = head;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /** @return True if zone can allocate specified number of frames */
 _NO_TRACE static bool zone_can_alloc(zone_t *zone, size_t count,
     pfn_t constraint)
 {
 	/*
-	 * The function bitmap_allocate_range() does not modify
-	 * the bitmap if the last argument is NULL.
+	 * The function buddy_alloc() does not modify the zone if the last
+	 * argument is NULL.
 	 */
 
 	return ((zone->flags & ZONE_AVAILABLE) &&
-	    bitmap_allocate_range(&zone->bitmap, count, zone->base,
-	    FRAME_LOWPRIO, constraint, NULL));
+	    buddy_alloc(zone, count, constraint, NULL));
 }
 
 /** Find a zone that can allocate specified number of frames
@@ -256,19 +673,6 @@ _NO_TRACE static size_t find_free_zone_all(size_t count, zone_flags_t flags,
 	return (size_t) -1;
 }
 
-/** Check if frame range  priority memory
- *
- * @param pfn   Starting frame.
- * @param count Number of frames.
- *
- * @return True if the range contains only priority memory.
- *
- */
-_NO_TRACE static bool is_high_priority(pfn_t base, size_t count)
-{
-	return (base + count <= FRAME_LOWPRIO);
-}
-
 /** Find a zone that can allocate specified number of frames
  *
  * This function ignores zones that contain only high-priority
@@ -372,8 +776,7 @@ _NO_TRACE static size_t zone_frame_alloc(zone_t *zone, size_t count,
 
 	/* Allocate frames from zone */
 	size_t index = (size_t) -1;
-	int avail = bitmap_allocate_range(&zone->bitmap, count, zone->base,
-	    FRAME_LOWPRIO, constraint, &index);
+	bool avail = buddy_alloc(zone, count, constraint, &index);
 
 	(void) avail;
 	assert(avail);
@@ -414,6 +817,7 @@ _NO_TRACE static size_t zone_frame_free(zone_t *zone, size_t index)
 
 	if (!--frame->refcount) {
 		bitmap_set(&zone->bitmap, index, 0);
+		buddy_free_block(zone, index, 0);
 
 		/* Update zone information. */
 		zone->free_count++;
@@ -436,6 +840,7 @@ _NO_TRACE static void zone_mark_unavailable(zone_t *zone, size_t index)
 
 	frame->refcount = 1;
 	bitmap_set_range(&zone->bitmap, index, 1);
+	buddy_carve(zone, index, 1);
 
 	zone->free_count--;
 	reserve_force_alloc(1);
@@ -491,6 +896,8 @@ _NO_TRACE static void zone_merge_internal(size_t z1, size_t z2, zone_t *old_z1,
 		zones.info[z1].frames[base_diff + i] =
 		    zones.info[z2].frames[i];
 	}
+
+	buddy_build(&zones.info[z1]);
 }
 
 /** Return old configuration frames into the zone.
@@ -649,9 +1056,17 @@ _NO_TRACE static void zone_construct(zone_t *zone, pfn_t start, size_t count,
 
 		for (size_t i = 0; i < count; i++)
 			frame_initialize(&zone->frames[i]);
+
+		assert(count < BUDDY_NIL);
+		buddy_build(zone);
 	} else {
 		bitmap_initialize(&zone->bitmap, 0, NULL);
 		zone->frames = NULL;
+
+		for (unsigned int order = 0; order < FRAME_BUDDY_ORDERS; order++) {
+			zone->buddy_head[order] = BUDDY_NIL;
+			zone->buddy_count[order] = 0;
+		}
 	}
 }
 
@@ -780,6 +1195,274 @@ size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
 	return znum;
 }
 
+/*******************************/
+/* Per-CPU frame cache functions */
+/*******************************/
+
+/** Get the kind of frames cached for an allocation. */
+_NO_TRACE static frame_cache_kind_t frame_cache_kind(bool lowmem)
+{
+	if ((!lowmem) && (frame_cache_highmem))
+		return FRAME_CACHE_HIGHMEM;
+
+	return FRAME_CACHE_LOWMEM;
+}
+
+/** Get the kind of frames cached from a zone. */
+_NO_TRACE static frame_cache_kind_t frame_cache_zone_kind(zone_t *zone)
+{
+	if (zone->flags & ZONE_HIGHMEM)
+		return FRAME_CACHE_HIGHMEM;
+
+	return FRAME_CACHE_LOWMEM;
+}
+
+/** Return cached frames to their zones.
+ *
+ * @param pfn   Array of frames to return.
+ * @param count Number of frames in the array.
+ *
+ */
+_NO_TRACE static void frame_cache_return(pfn_t *pfn, size_t count)
+{
+	irq_spinlock_lock(&zones.lock, true);
+
+	for (size_t i = 0; i < count; i++) {
+		size_t znum = find_zone(pfn[i], 1, 0);
+
+		assert(znum != (size_t) -1);
+
+		(void) zone_frame_free(&zones.info[znum],
+		    pfn[i] - zones.info[znum].base);
+	}
+
+	irq_spinlock_unlock(&zones.lock, true);
+}
+
+/** Allocate a frame from the cache of the current CPU.
+ *
+ * @param kind  Kind of the frame.
+ * @param start Cycle count at the start of the allocation.
+ * @param pfn   Place to store the allocated frame.
+ *
+ * @return True if the allocation succeeded.
+ *
+ */
+_NO_TRACE static bool frame_cache_alloc(frame_cache_kind_t kind,
+    uint64_t start, pfn_t *pfn)
+{
+	if ((frame_caches == NULL) || (CPU == NULL))
+		return false;
+
+	frame_cache_t *cache = &frame_caches[CPU->id];
+	bool found = false;
+
+	irq_spinlock_lock(&cache->lock, true);
+
+	if (cache->count[kind] > 0) {
+		*pfn = cache->pfn[kind][--cache->count[kind]];
+		cache->allocs++;
+		cache->cycles += get_cycle() - start;
+		found = true;
+	}
+
+	irq_spinlock_unlock(&cache->lock, true);
+
+	return found;
+}
+
+/** Put frames allocated from the zones into the cache of the current CPU.
+ *
+ * Frames which do not fit into the cache are returned to the zones.
+ *
+ * @param kind  Kind of the frames.
+ * @param pfn   Array of frames.
+ * @param count Number of frames in the array.
+ *
+ */
+_NO_TRACE static void frame_cache_fill(frame_cache_kind_t kind, pfn_t *pfn,
+    size_t count)
+{
+	size_t i = 0;
+
+	if ((frame_caches != NULL) && (CPU != NULL)) {
+		frame_cache_t *cache = &frame_caches[CPU->id];
+
+		irq_spinlock_lock(&cache->lock, true);
+
+		while ((i < count) && (cache->count[kind] < FRAME_CACHE_SIZE))
+			cache->pfn[kind][cache->count[kind]++] = pfn[i++];
+
+		irq_spinlock_unlock(&cache->lock, true);
+	}
+
+	if (i < count)
+		frame_cache_return(pfn + i, count - i);
+}
+
+/** Free a frame into the cache of the current CPU.
+ *
+ * If the cache is full, its least recently freed frames are returned
+ * to the zones.
+ *
+ * @param pfn   Frame to free.
+ * @param freed Place to store the number of freed frames.
+ *
+ * @return True if the frame was handled, false if it has to be freed
+ *         to its zone.
+ *
+ */
+_NO_TRACE static bool frame_cache_free(pfn_t pfn, size_t *freed)
+{
+	if ((frame_caches == NULL) || (CPU == NULL))
+		return false;
+
+	/* Keep high-priority memory out of the caches. */
+	if (is_high_priority(pfn, 1))
+		return false;
+
+	/*
+	 * The zones do not change once the caches are enabled, so they can
+	 * be searched without the zones lock.
+	 */
+	size_t znum = find_zone(pfn, 1, 0);
+
+	assert(znum != (size_t) -1);
+
+	zone_t *zone = &zones.info[znum];
+	frame_t *frame = zone_get_frame(zone, pfn - zone->base);
+
+	assert(zone->flags & ZONE_AVAILABLE);
+	assert(frame->refcount > 0);
+
+	if (--frame->refcount > 0) {
+		*freed = 0;
+		return true;
+	}
+
+	/* The frame now belongs to the cache. */
+	frame->refcount = 1;
+	*freed = 1;
+
+	frame_cache_kind_t kind = frame_cache_zone_kind(zone);
+	frame_cache_t *cache = &frame_caches[CPU->id];
+	pfn_t batch[FRAME_CACHE_BATCH];
+	size_t count = 0;
+
+	irq_spinlock_lock(&cache->lock, true);
+
+	if (cache->count[kind] == FRAME_CACHE_SIZE) {
+		count = FRAME_CACHE_BATCH;
+		memcpy(batch, cache->pfn[kind], sizeof(batch));
+		memmove(cache->pfn[kind], cache->pfn[kind] + count,
+		    (FRAME_CACHE_SIZE - count) * sizeof(pfn_t));
+		cache->count[kind] -= count;
+	}
+
+	cache->pfn[kind][cache->count[kind]++] = pfn;
+
+	irq_spinlock_unlock(&cache->lock, true);
+
+	if (count > 0)
+		frame_cache_return(batch, count);
+
+	return true;
+}
+
+/** Return the frames of all per-CPU caches to the zones.
+ *
+ * @return Number of returned frames.
+ *
+ */
+_NO_TRACE static size_t frame_cache_drain(void)
+{
+	if (frame_caches == NULL)
+		return 0;
+
+	size_t drained = 0;
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		frame_cache_t *cache = &frame_caches[i];
+
+		for (unsigned int kind = 0; kind < FRAME_CACHE_KINDS; kind++) {
+			while (true) {
+				pfn_t batch[FRAME_CACHE_BATCH];
+
+				irq_spinlock_lock(&cache->lock, true);
+
+				size_t count = min(cache->count[kind],
+				    (size_t) FRAME_CACHE_BATCH);
+				cache->count[kind] -= count;
+				memcpy(batch, cache->pfn[kind] + cache->count[kind],
+				    count * sizeof(pfn_t));
+
+				irq_spinlock_unlock(&cache->lock, true);
+
+				if (count == 0)
+					break;
+
+				frame_cache_return(batch, count);
+				drained += count;
+			}
+		}
+	}
+
+	return drained;
+}
+
+/** Get the number of frames held by all per-CPU caches. */
+_NO_TRACE static size_t frame_cache_count(void)
+{
+	if (frame_caches == NULL)
+		return 0;
+
+	size_t count = 0;
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		frame_cache_t *cache = &frame_caches[i];
+
+		irq_spinlock_lock(&cache->lock, true);
+
+		for (unsigned int kind = 0; kind < FRAME_CACHE_KINDS; kind++)
+			count += cache->count[kind];
+
+		irq_spinlock_unlock(&cache->lock, true);
+	}
+
+	return count;
+}
+
+/** Enable per-CPU frame caches.
+ *
+ * Must be called once the number of processors is known and after
+ * all zones have been created and merged.
+ *
+ */
+void frame_enable_cpucache(void)
+{
+	frame_cache_t *caches = (frame_cache_t *)
+	    malloc(sizeof(frame_cache_t) * config.cpu_count);
+	if (caches == NULL)
+		return;
+
+	memsetb(caches, sizeof(frame_cache_t) * config.cpu_count, 0);
+
+	for (size_t i = 0; i < config.cpu_count; i++)
+		irq_spinlock_initialize(&caches[i].lock, "frame.cache.lock");
+
+	irq_spinlock_lock(&zones.lock, true);
+
+	for (size_t i = 0; i < zones.count; i++) {
+		if ((zones.info[i].flags & ZONE_AVAILABLE) &&
+		    (zones.info[i].flags & ZONE_HIGHMEM))
+			frame_cache_highmem = true;
+	}
+
+	frame_caches = caches;
+
+	irq_spinlock_unlock(&zones.lock, true);
+}
+
 /*******************/
 /* Frame functions */
 /*******************/
@@ -845,28 +1528,54 @@ uintptr_t frame_alloc_generic(size_t count, frame_flags_t flags,
 {
 	assert(count > 0);
 
+	uint64_t start = get_cycle();
+	bool waited = false;
+
 	size_t hint = pzone ? (*pzone) : 0;
 	pfn_t frame_constraint = ADDR2PFN(constraint);
 
+	// TODO: Print diagnostic if neither is explicitly specified.
+	bool lowmem = (flags & FRAME_LOWMEM) || !(flags & FRAME_HIGHMEM);
+
+	/* Single frames without a constraint go through the per-CPU caches. */
+	bool cacheable = (count == 1) && (frame_constraint == 0);
+
 	/*
 	 * If not told otherwise, we must first reserve the memory.
 	 */
 	if (!(flags & FRAME_NO_RESERVE))
 		reserve_force_alloc(count);
 
+	if (cacheable) {
+		pfn_t pfn;
+
+		if (frame_cache_alloc(frame_cache_kind(lowmem), start, &pfn))
+			return PFN2ADDR(pfn);
+	}
+
 loop:
 	irq_spinlock_lock(&zones.lock, true);
 
-	// TODO: Print diagnostic if neither is explicitly specified.
-	bool lowmem = (flags & FRAME_LOWMEM) || !(flags & FRAME_HIGHMEM);
-
 	/*
 	 * First, find suitable frame zone.
 	 */
 	size_t znum = try_find_zone(count, lowmem, frame_constraint, hint);
 
 	/*
-	 * If no memory, reclaim some slab memory,
+	 * If no memory, return the frames held by the per-CPU caches.
+	 */
+	if ((znum == (size_t) -1) && (frame_caches != NULL)) {
+		irq_spinlock_unlock(&zones.lock, true);
+		size_t drained = frame_cache_drain();
+		irq_spinlock_lock(&zones.lock, true);
+
+		if (drained > 0)
+			znum = try_find_zone(count, lowmem,
+			    frame_constraint, hint);
+	}
+
+	/*
+	 * If still no memory, reclaim some slab memory,
 	 * if it does not help, reclaim all.
 	 */
 	if ((znum == (size_t) -1) && (!(flags & FRAME_NO_RECLAIM))) {
@@ -942,14 +1651,45 @@ loop:
 		    THREAD->tid);
 #endif
 
+		waited = true;
 		goto loop;
 	}
 
-	pfn_t pfn = zone_frame_alloc(&zones.info[znum], count,
-	    frame_constraint) + zones.info[znum].base;
+	zone_t *zone = &zones.info[znum];
+	pfn_t pfn = zone_frame_alloc(zone, count, frame_constraint) +
+	    zone->base;
+
+	/*
+	 * Refill the cache of the current CPU while we hold the lock.
+	 * Leave high-priority memory in the zone.
+	 */
+	pfn_t batch[FRAME_CACHE_BATCH - 1];
+	size_t batch_count = 0;
+
+	if ((cacheable) && (frame_caches != NULL)) {
+		while ((batch_count < FRAME_CACHE_BATCH - 1) &&
+		    (zone_can_alloc(zone, 1, 0))) {
+			size_t index = zone_frame_alloc(zone, 1, 0);
+
+			if (is_high_priority(zone->base + index, 1)) {
+				(void) zone_frame_free(zone, index);
+				break;
+			}
+
+			batch[batch_count++] = zone->base + index;
+		}
+	}
+
+	if (!waited) {
+		zone_allocs++;
+		zone_cycles += get_cycle() - start;
+	}
 
 	irq_spinlock_unlock(&zones.lock, true);
 
+	if (batch_count > 0)
+		frame_cache_fill(frame_cache_zone_kind(zone), batch, batch_count);
+
 	if (pzone)
 		*pzone = znum;
 
@@ -976,22 +1716,35 @@ void frame_free_generic(uintptr_t start, size_t count, frame_flags_t flags)
 {
 	size_t freed = 0;
 
-	irq_spinlock_lock(&zones.lock, true);
-
-	for (size_t i = 0; i < count; i++) {
+	if ((count == 1) && (frame_cache_free(ADDR2PFN(start), &freed))) {
 		/*
-		 * First, find host frame zone for addr.
+		 * The frame went to a per-CPU cache. Unless somebody
+		 * is waiting for memory, we are done.
 		 */
-		pfn_t pfn = ADDR2PFN(start) + i;
-		size_t znum = find_zone(pfn, 1, 0);
+		if (mem_avail_req == 0) {
+			if (!(flags & FRAME_NO_RESERVE))
+				reserve_free(freed);
 
-		assert(znum != (size_t) -1);
+			return;
+		}
+	} else {
+		irq_spinlock_lock(&zones.lock, true);
 
-		freed += zone_frame_free(&zones.info[znum],
-		    pfn - zones.info[znum].base);
-	}
+		for (size_t i = 0; i < count; i++) {
+			/*
+			 * First, find host frame zone for addr.
+			 */
+			pfn_t pfn = ADDR2PFN(start) + i;
+			size_t znum = find_zone(pfn, 1, 0);
 
-	irq_spinlock_unlock(&zones.lock, true);
+			assert(znum != (size_t) -1);
+
+			freed += zone_frame_free(&zones.info[znum],
+			    pfn - zones.info[znum].base);
+		}
+
+		irq_spinlock_unlock(&zones.lock, true);
+	}
 
 	/*
 	 * Signal that some memory has been freed.
@@ -1052,6 +1805,33 @@ _NO_TRACE void frame_reference_add(pfn_t pfn)
 	irq_spinlock_unlock(&zones.lock, true);
 }
 
+/** Add reference to frame if it is managed by the frame allocator.
+ *
+ * Unlike frame_reference_add(), this function tolerates PFNs which do
+ * not belong to any available zone (e.g. device memory mapped by the
+ * physical memory backend).
+ *
+ * @param pfn Frame number of the frame to be referenced.
+ *
+ * @return True if the reference was added.
+ *
+ */
+_NO_TRACE bool frame_reference_try_add(pfn_t pfn)
+{
+	irq_spinlock_lock(&zones.lock, true);
+
+	size_t znum = find_zone(pfn, 1, 0);
+	bool managed = (znum != (size_t) -1) &&
+	    (zones.info[znum].flags & ZONE_AVAILABLE);
+
+	if (managed)
+		zones.info[znum].frames[pfn - zones.info[znum].base].refcount++;
+
+	irq_spinlock_unlock(&zones.lock, true);
+
+	return managed;
+}
+
 /** Mark given range unavailable in frame zones.
  *
  */
@@ -1173,6 +1953,9 @@ void zones_stats(uint64_t *total, uint64_t *unavail, uint64_t *busy,
 	assert(busy != NULL);
 	assert(free != NULL);
 
+	/* Frames held by the per-CPU caches are reported as free. */
+	size_t cached = frame_cache_count();
+
 	irq_spinlock_lock(&zones.lock, true);
 
 	*total = 0;
@@ -1191,6 +1974,54 @@ void zones_stats(uint64_t *total, uint64_t *unavail, uint64_t *busy,
 	}
 
 	irq_spinlock_unlock(&zones.lock, true);
+
+	cached = min((uint64_t) cached, SIZE2FRAMES(*busy));
+	*busy -= (uint64_t) FRAMES2SIZE(cached);
+	*free += (uint64_t) FRAMES2SIZE(cached);
+}
+
+/** Get frame allocator statistics.
+ *
+ * @param stats Place to store the statistics.
+ *
+ */
+void zones_alloc_stats(stats_frames_t *stats)
+{
+	assert(stats != NULL);
+
+	memsetb(stats, sizeof(stats_frames_t), 0);
+
+	if (frame_caches != NULL) {
+		for (size_t i = 0; i < config.cpu_count; i++) {
+			frame_cache_t *cache = &frame_caches[i];
+
+			irq_spinlock_lock(&cache->lock, true);
+
+			for (unsigned int kind = 0; kind < FRAME_CACHE_KINDS; kind++)
+				stats->cached += cache->count[kind];
+
+			stats->cache_allocs += cache->allocs;
+			stats->cache_cycles += cache->cycles;
+
+			irq_spinlock_unlock(&cache->lock, true);
+		}
+	}
+
+	irq_spinlock_lock(&zones.lock, true);
+
+	for (size_t i = 0; i < zones.count; i++) {
+		if (!(zones.info[i].flags & ZONE_AVAILABLE))
+			continue;
+
+		for (unsigned int order = 0; (order < FRAME_BUDDY_ORDERS) &&
+		    (order < STATS_FRAME_ORDERS); order++)
+			stats->free_blocks[order] += zones.info[i].buddy_count[order];
+	}
+
+	stats->zone_allocs = zone_allocs;
+	stats->zone_cycles = zone_cycles;
+
+	irq_spinlock_unlock(&zones.lock, true);
 }
 
 /** Prints list of zones.
@@ -1347,6 +2178,9 @@ void zone_print_one(size_t num)
 	size_t count = zones.info[znum].count;
 	size_t free_count = zones.info[znum].free_count;
 	size_t busy_count = zones.info[znum].busy_count;
+	size_t buddy_count[FRAME_BUDDY_ORDERS];
+
+	memcpy(buddy_count, zones.info[znum].buddy_count, sizeof(buddy_count));
 
 	bool available = ((flags & ZONE_AVAILABLE) != 0);
 	bool lowmem = ((flags & ZONE_LOWMEM) != 0);
@@ -1422,6 +2256,11 @@ void zone_print_one(size_t num)
 		    false);
 		printf("Available high priority: %zu frames (%" PRIu64 " %s)\n",
 		    free_highprio, size, size_suffix);
+
+		printf("Free blocks per order:  ");
+		for (unsigned int order = 0; order < FRAME_BUDDY_ORDERS; order++)
+			printf(" %zu", buddy_count[order]);
+		printf("\n");
 	}
 }
 
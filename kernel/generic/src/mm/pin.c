@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_generic_mm
+ * @{
+ */
+
+/**
+ * @file
+ * @brief Pinning of userspace buffers.
+ *
+ * A pinned buffer is described by the list of physical frames that back
+ * it at the time of pinning. Each of these frames gets an extra reference
+ * so that it cannot be freed until the buffer is unpinned. This lets the
+ * kernel copy data directly between two address spaces without staging it
+ * in a kernel heap buffer.
+ */
+
+#include <mm/pin.h>
+#include <mm/page.h>
+#include <mm/frame.h>
+#include <mm/km.h>
+#include <mm/as.h>
+#include <arch/mm/page.h>
+#include <syscall/copy.h>
+#include <proc/task.h>
+#include <align.h>
+#include <macros.h>
+#include <config.h>
+#include <stdlib.h>
+
+/** Pin a userspace buffer of the current address space.
+ *
+ * @param addr  Userspace address of the buffer.
+ * @param size  Size of the buffer in bytes.
+ * @param write True if the buffer is going to be written to.
+ * @param pin   Place to store the pinned buffer.
+ *
+ * @return EOK on success.
+ * @return ENOMEM if there is not enough memory to describe the buffer.
+ * @return ENOENT if part of the buffer cannot be pinned.
+ * @return Error code of as_page_reference() if part of the buffer cannot
+ *         be accessed.
+ *
+ */
+errno_t pin_create(uspace_addr_t addr, size_t size, bool write, pin_t **pin)
+{
+	uintptr_t base = ALIGN_DOWN(addr, PAGE_SIZE);
+	size_t offset = addr - base;
+	size_t count = SIZE2FRAMES(offset + size);
+
+	pin_t *p = malloc(sizeof(pin_t) + count * sizeof(pin_frame_t));
+	if (!p)
+		return ENOMEM;
+
+	p->offset = offset;
+	p->size = size;
+	p->count = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		uintptr_t page = base + P2SZ(i);
+
+		errno_t rc = as_page_reference(page,
+		    write ? PF_ACCESS_WRITE : PF_ACCESS_READ,
+		    &p->frames[i].addr, &p->frames[i].reserved);
+		if (rc != EOK) {
+			pin_destroy(p);
+			return rc;
+		}
+
+		p->count++;
+	}
+
+	*pin = p;
+	return EOK;
+}
+
+/** Unpin a userspace buffer.
+ *
+ * Drop the references taken by pin_create(). Frames no longer mapped by
+ * any address space are freed here, giving back their reservation only
+ * if the area's backend would have done so.
+ *
+ * @param pin Pinned buffer.
+ *
+ */
+void pin_destroy(pin_t *pin)
+{
+	for (size_t i = 0; i < pin->count; i++) {
+		if (pin->frames[i].reserved)
+			frame_free(pin->frames[i].addr, 1);
+		else
+			frame_free_noreserve(pin->frames[i].addr, 1);
+	}
+
+	free(pin);
+}
+
+/** Map a pinned frame into the kernel address space.
+ *
+ * @param frame Physical address of the frame.
+ *
+ * @return Kernel address of the frame.
+ *
+ */
+static uintptr_t pin_map(uintptr_t frame)
+{
+	if (frame >= config.identity_size)
+		return km_map(frame, PAGE_SIZE, PAGE_SIZE,
+		    PAGE_READ | PAGE_WRITE | PAGE_CACHEABLE);
+
+	return PA2KA(frame);
+}
+
+/** Unmap a pinned frame mapped by pin_map().
+ *
+ * @param frame Physical address of the frame.
+ * @param page  Kernel address returned by pin_map().
+ *
+ */
+static void pin_unmap(uintptr_t frame, uintptr_t page)
+{
+	if (frame >= config.identity_size)
+		km_unmap(page, PAGE_SIZE);
+}
+
+/** Copy data between a pinned buffer and the current address space.
+ *
+ * @param uspace Userspace address in the current address space.
+ * @param pin    Pinned buffer.
+ * @param size   Number of bytes to copy.
+ * @param to     True to copy from the pinned buffer to @a uspace.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+static errno_t pin_copy(uspace_addr_t uspace, pin_t *pin, size_t size,
+    bool to)
+{
+	if (size > pin->size)
+		return ELIMIT;
+
+	size_t offset = pin->offset;
+	size_t done = 0;
+	errno_t rc = EOK;
+
+	for (size_t i = 0; (done < size) && (rc == EOK); i++) {
+		size_t chunk = min(PAGE_SIZE - offset, size - done);
+		uintptr_t page = pin_map(pin->frames[i].addr);
+		void *kaddr = (void *) (page + offset);
+		if (to)
+			rc = copy_to_uspace(uspace + done, kaddr, chunk);
+		else
+			rc = copy_from_uspace(kaddr, uspace + done, chunk);
+
+		pin_unmap(pin->frames[i].addr, page);
+
+		done += chunk;
+		offset = 0;
+	}
+
+	return rc;
+}
+
+/** Copy data from a pinned buffer to the current address space.
+ *
+ * @param dst  Destination userspace address.
+ * @param pin  Pinned source buffer.
+ * @param size Number of bytes to copy.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+errno_t pin_copy_to_uspace(uspace_addr_t dst, pin_t *pin, size_t size)
+{
+	return pin_copy(dst, pin, size, true);
+}
+
+/** Copy data from the current address space to a pinned buffer.
+ *
+ * @param pin  Pinned destination buffer.
+ * @param src  Source userspace address.
+ * @param size Number of bytes to copy.
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+errno_t pin_copy_from_uspace(pin_t *pin, uspace_addr_t src, size_t size)
+{
+	return pin_copy(src, pin, size, false);
+}
+
+/** @}
+ */
@@ -40,6 +40,7 @@
 
 #include <assert.h>
 #include <atomic.h>
+#include <bitops.h>
 #include <proc/scheduler.h>
 #include <proc/thread.h>
 #include <proc/task.h>
@@ -172,6 +173,79 @@ void scheduler_init(void)
 {
 }
 
+/** Index of the highest-priority non-empty run queue
+ *
+ * @param bitmap Run queue bitmap, must not be zero.
+ *
+ * @return Index of the lowest set bit.
+ *
+ */
+static inline unsigned int rq_first(unsigned int bitmap)
+{
+	return fnzb32(bitmap & -bitmap);
+}
+
+/** Index of the lowest-priority non-empty run queue
+ *
+ * @param bitmap Run queue bitmap, must not be zero.
+ *
+ * @return Index of the highest set bit.
+ *
+ */
+static inline unsigned int rq_last(unsigned int bitmap)
+{
+	return fnzb32(bitmap);
+}
+
+/** Remove thread from a run queue
+ *
+ * @param cpu    CPU owning the run queue.
+ * @param i      Run queue index. The queue's lock must be held.
+ * @param thread Thread to remove.
+ *
+ */
+static void rq_remove(cpu_t *cpu, unsigned int i, thread_t *thread)
+{
+	assert(irq_spinlock_locked(&cpu->rq[i].lock));
+
+	list_remove(&thread->rq_link);
+	if (--cpu->rq[i].n == 0) {
+		atomic_fetch_and_explicit(&cpu->rq_bitmap, ~(1U << i),
+		    memory_order_relaxed);
+	}
+
+	atomic_dec(&cpu->nrdy);
+	atomic_dec(&nrdy);
+}
+
+/** Account a thread dispatch
+ *
+ * @param ready_cycle Cycle at which the thread was made ready.
+ * @param migrated    Whether the thread last ran on another CPU.
+ *
+ */
+static void account_dispatch(uint64_t ready_cycle, bool migrated)
+{
+	uint64_t now = get_cycle();
+
+	/*
+	 * The thread may have been readied on another CPU whose cycle
+	 * counter is not synchronized with ours.
+	 */
+	uint64_t wait = (now > ready_cycle) ? now - ready_cycle : 0;
+
+	irq_spinlock_lock(&CPU->lock, false);
+
+	CPU->dispatches++;
+	CPU->wait_cycles += wait;
+	if (wait > CPU->max_wait_cycles)
+		CPU->max_wait_cycles = wait;
+	if (migrated)
+		CPU->migrations++;
+
+	irq_spinlock_unlock(&CPU->lock, false);
+}
+
 /** Get thread to be scheduled
  *
  * Get the optimal thread to be scheduled
@@ -210,45 +284,53 @@ loop:
 
 	assert(!CPU->idle);
 
-	unsigned int i;
-	for (i = 0; i < RQ_COUNT; i++) {
-		irq_spinlock_lock(&(CPU->rq[i].lock), false);
-		if (CPU->rq[i].n == 0) {
-			/*
-			 * If this queue is empty, try a lower-priority queue.
-			 */
-			irq_spinlock_unlock(&(CPU->rq[i].lock), false);
-			continue;
-		}
+	unsigned int bitmap = atomic_load_explicit(&CPU->rq_bitmap,
+	    memory_order_relaxed);
+	if (bitmap == 0) {
+		/*
+		 * The thread counted in nrdy has not been queued yet or
+		 * has just been stolen.
+		 */
+		goto loop;
+	}
 
-		atomic_dec(&CPU->nrdy);
-		atomic_dec(&nrdy);
-		CPU->rq[i].n--;
+	unsigned int i = rq_first(bitmap);
 
+	irq_spinlock_lock(&(CPU->rq[i].lock), false);
+	if (CPU->rq[i].n == 0) {
 		/*
-		 * Take the first thread from the queue.
+		 * The queue was emptied since we looked at the bitmap.
 		 */
-		thread_t *thread = list_get_instance(
-		    list_first(&CPU->rq[i].rq), thread_t, rq_link);
-		list_remove(&thread->rq_link);
+		irq_spinlock_unlock(&(CPU->rq[i].lock), false);
+		goto loop;
+	}
+
+	/*
+	 * Take the first thread from the queue.
+	 */
+	thread_t *thread = list_get_instance(
+	    list_first(&CPU->rq[i].rq), thread_t, rq_link);
+	rq_remove(CPU, i, thread);
 
-		irq_spinlock_pass(&(CPU->rq[i].lock), &thread->lock);
+	irq_spinlock_pass(&(CPU->rq[i].lock), &thread->lock);
 
-		thread->cpu = CPU;
-		thread->ticks = us2ticks((i + 1) * 10000);
-		thread->priority = i;  /* Correct rq index */
+	uint64_t ready_cycle = thread->ready_cycle;
+	bool migrated = (thread->cpu != NULL) && (thread->cpu != CPU);
 
-		/*
-		 * Clear the stolen flag so that it can be migrated
-		 * when load balancing needs emerge.
-		 */
-		thread->stolen = false;
-		irq_spinlock_unlock(&thread->lock, false);
+	thread->cpu = CPU;
+	thread->ticks = us2ticks((i + 1) * 10000);
+	thread->priority = i;  /* Correct rq index */
 
-		return thread;
-	}
+	/*
+	 * Clear the stolen flag so that it can be migrated
+	 * when load balancing needs emerge.
+	 */
+	thread->stolen = false;
+	irq_spinlock_unlock(&thread->lock, false);
 
-	goto loop;
+	account_dispatch(ready_cycle, migrated);
+
+	return thread;
 }
 
 /** Prevent rq starvation
@@ -278,6 +360,8 @@ static void relink_rq(int start)
 			list_concat(&list, &CPU->rq[i + 1].rq);
 			size_t n = CPU->rq[i + 1].n;
 			CPU->rq[i + 1].n = 0;
+			atomic_fetch_and_explicit(&CPU->rq_bitmap, ~(1U << (i + 1)),
+			    memory_order_relaxed);
 			irq_spinlock_unlock(&CPU->rq[i + 1].lock, false);
 
 			/* Append rq[i + 1] to rq[i] */
@@ -285,6 +369,10 @@ static void relink_rq(int start)
 			irq_spinlock_lock(&CPU->rq[i].lock, false);
 			list_concat(&CPU->rq[i].rq, &list);
 			CPU->rq[i].n += n;
+			if (CPU->rq[i].n > 0) {
+				atomic_fetch_or_explicit(&CPU->rq_bitmap, 1U << i,
+				    memory_order_relaxed);
+			}
 			irq_spinlock_unlock(&CPU->rq[i].lock, false);
 		}
 
@@ -537,6 +625,98 @@ void scheduler_separated_stack(void)
 }
 
 #ifdef CONFIG_SMP
+/** Number of threads examined per run queue when choosing one to steal */
+#define KCPULB_SCAN_MAX  8
+
+/** Choose a thread to steal from a run queue
+ *
+ * Threads which last ran on the stealing CPU, or did not run at all, are
+ * taken first as their cache footprint does not favour the victim. Otherwise
+ * the thread waiting the longest is chosen, as it is the one most likely to
+ * have its cache footprint evicted already.
+ *
+ * @param cpu Victim CPU.
+ * @param i   Run queue index. The queue's lock must be held.
+ *
+ * @return Thread to steal or NULL if there is none which can migrate.
+ *
+ */
+static thread_t *steal_candidate(cpu_t *cpu, unsigned int i)
+{
+	thread_t *best = NULL;
+	unsigned int scanned = 0;
+
+	assert(irq_spinlock_locked(&cpu->rq[i].lock));
+
+	list_foreach(cpu->rq[i].rq, rq_link, thread_t, thread) {
+		if (scanned++ == KCPULB_SCAN_MAX)
+			break;
+
+		/*
+		 * Do not steal CPU-wired threads, threads
+		 * already stolen, threads for which migration
+		 * was temporarily disabled or threads whose
+		 * FPU context is still in the CPU.
+		 */
+		irq_spinlock_lock(&thread->lock, false);
+		bool movable = (!thread->wired) && (!thread->stolen) &&
+		    (!thread->nomigrate) && (!thread->fpu_context_engaged);
+		cpu_t *last = thread->cpu;
+		irq_spinlock_unlock(&thread->lock, false);
+
+		if (!movable)
+			continue;
+
+		if ((last == CPU) || (last == NULL))
+			return thread;
+
+		/* The queue is in FIFO order, so the first is the oldest. */
+		if (best == NULL)
+			best = thread;
+	}
+
+	return best;
+}
+
+/** Steal a thread from another CPU
+ *
+ * Lower priority run queues are searched first.
+ *
+ * @param cpu Victim CPU.
+ *
+ * @return Stolen thread in the Entering state or NULL.
+ *
+ */
+static thread_t *steal_thread(cpu_t *cpu)
+{
+	unsigned int bitmap = atomic_load_explicit(&cpu->rq_bitmap,
+	    memory_order_relaxed);
+
+	while (bitmap != 0) {
+		unsigned int i = rq_last(bitmap);
+		bitmap &= ~(1U << i);
+
+		irq_spinlock_lock(&(cpu->rq[i].lock), true);
+
+		thread_t *thread = steal_candidate(cpu, i);
+		if (thread == NULL) {
+			irq_spinlock_unlock(&(cpu->rq[i].lock), true);
+			continue;
+		}
+
+		rq_remove(cpu, i, thread);
+		irq_spinlock_pass(&(cpu->rq[i].lock), &thread->lock);
+
+		thread->stolen = true;
+		thread->state = Entering;
+
+		irq_spinlock_unlock(&thread->lock, true);
+		return thread;
+	}
+
+	return NULL;
+}
+
 /** Load balancing thread
  *
  * SMP load balancing thread, supervising thread supplies
@@ -577,16 +757,20 @@ not_satisfied:
 	size_t count = average - rdy;
 
 	/*
-	 * Searching least priority queues on all CPU's first and most priority
-	 * queues on all CPU's last.
+	 * Visit the CPUs above average from the longest run queue to the
+	 * shortest, ties broken by index. The last visited CPU bounds the
+	 * next search so that each CPU is visited at most once.
 	 */
-	size_t acpu;
-	size_t acpu_bias = 0;
-	int rq;
+	size_t bound_rdy = SIZE_MAX;
+	size_t bound_acpu = 0;
+
+	while (true) {
+		cpu_t *victim = NULL;
+		size_t victim_rdy = average;
+		size_t victim_acpu = 0;
 
-	for (rq = RQ_COUNT - 1; rq >= 0; rq--) {
-		for (acpu = 0; acpu < config.cpu_active; acpu++) {
-			cpu_t *cpu = &cpus[(acpu + acpu_bias) % config.cpu_active];
+		for (size_t acpu = 0; acpu < config.cpu_active; acpu++) {
+			cpu_t *cpu = &cpus[acpu];
 
 			/*
 			 * Not interested in ourselves.
@@ -597,92 +781,46 @@ not_satisfied:
 			if (CPU == cpu)
 				continue;
 
-			if (atomic_load(&cpu->nrdy) <= average)
+			size_t cpu_rdy = atomic_load(&cpu->nrdy);
+			if (cpu_rdy <= victim_rdy)
 				continue;
 
-			irq_spinlock_lock(&(cpu->rq[rq].lock), true);
-			if (cpu->rq[rq].n == 0) {
-				irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
+			if ((cpu_rdy > bound_rdy) ||
+			    ((cpu_rdy == bound_rdy) && (acpu <= bound_acpu)))
 				continue;
-			}
-
-			thread_t *thread = NULL;
-
-			/* Search rq from the back */
-			link_t *link = cpu->rq[rq].rq.head.prev;
-
-			while (link != &(cpu->rq[rq].rq.head)) {
-				thread = (thread_t *) list_get_instance(link,
-				    thread_t, rq_link);
-
-				/*
-				 * Do not steal CPU-wired threads, threads
-				 * already stolen, threads for which migration
-				 * was temporarily disabled or threads whose
-				 * FPU context is still in the CPU.
-				 */
-				irq_spinlock_lock(&thread->lock, false);
-
-				if ((!thread->wired) && (!thread->stolen) &&
-				    (!thread->nomigrate) &&
-				    (!thread->fpu_context_engaged)) {
-					/*
-					 * Remove thread from ready queue.
-					 */
-					irq_spinlock_unlock(&thread->lock,
-					    false);
-
-					atomic_dec(&cpu->nrdy);
-					atomic_dec(&nrdy);
-
-					cpu->rq[rq].n--;
-					list_remove(&thread->rq_link);
 
-					break;
-				}
-
-				irq_spinlock_unlock(&thread->lock, false);
+			victim = cpu;
+			victim_rdy = cpu_rdy;
+			victim_acpu = acpu;
+		}
 
-				link = link->prev;
-				thread = NULL;
-			}
+		if (victim == NULL)
+			break;
 
-			if (thread) {
-				/*
-				 * Ready thread on local CPU
-				 */
+		bound_rdy = victim_rdy;
+		bound_acpu = victim_acpu;
 
-				irq_spinlock_pass(&(cpu->rq[rq].lock),
-				    &thread->lock);
+		/* Do not push the victim below the average. */
+		while (atomic_load(&victim->nrdy) > average) {
+			thread_t *thread = steal_thread(victim);
+			if (thread == NULL)
+				break;
 
 #ifdef KCPULB_VERBOSE
-				log(LF_OTHER, LVL_DEBUG,
-				    "kcpulb%u: TID %" PRIu64 " -> cpu%u, "
-				    "nrdy=%ld, avg=%ld", CPU->id, thread->tid,
-				    CPU->id, atomic_load(&CPU->nrdy),
-				    atomic_load(&nrdy) / config.cpu_active);
+			log(LF_OTHER, LVL_DEBUG,
+			    "kcpulb%u: TID %" PRIu64 " cpu%u -> cpu%u, "
+			    "nrdy=%ld, avg=%ld", CPU->id, thread->tid,
+			    victim->id, CPU->id, atomic_load(&CPU->nrdy),
+			    atomic_load(&nrdy) / config.cpu_active);
 #endif
 
-				thread->stolen = true;
-				thread->state = Entering;
-
-				irq_spinlock_unlock(&thread->lock, true);
-				thread_ready(thread);
-
-				if (--count == 0)
-					goto satisfied;
-
-				/*
-				 * We are not satisfied yet, focus on another
-				 * CPU next time.
-				 *
-				 */
-				acpu_bias++;
-
-				continue;
-			} else
-				irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
+			/*
+			 * Ready thread on local CPU
+			 */
+			thread_ready(thread);
 
+			if (--count == 0)
+				goto satisfied;
 		}
 	}
 
@@ -219,6 +219,7 @@ task_t *task_create(as_t *as, const char *name)
 	task->ipc_info.answer_received = 0;
 	task->ipc_info.irq_notif_received = 0;
 	task->ipc_info.forwarded = 0;
+	task->ipc_info.syscalls = 0;
 
 	event_task_init(task);
 
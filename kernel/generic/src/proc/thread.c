@@ -305,6 +305,7 @@ void thread_ready(thread_t *thread)
 	}
 
 	thread->state = Ready;
+	thread->ready_cycle = get_cycle();
 
 	irq_spinlock_pass(&thread->lock, &(cpu->rq[i].lock));
 
@@ -314,7 +315,10 @@ void thread_ready(thread_t *thread)
 	 */
 
 	list_append(&thread->rq_link, &cpu->rq[i].rq);
-	cpu->rq[i].n++;
+	if (cpu->rq[i].n++ == 0) {
+		atomic_fetch_or_explicit(&cpu->rq_bitmap, 1U << i,
+		    memory_order_relaxed);
+	}
 	irq_spinlock_unlock(&(cpu->rq[i].lock), true);
 
 	atomic_inc(&nrdy);
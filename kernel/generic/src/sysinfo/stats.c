@@ -117,6 +117,10 @@ static void *get_stats_cpus(struct sysinfo_item *item, size_t *size,
 		stats_cpus[i].frequency_mhz = cpus[i].frequency_mhz;
 		stats_cpus[i].busy_cycles = cpus[i].busy_cycles;
 		stats_cpus[i].idle_cycles = cpus[i].idle_cycles;
+		stats_cpus[i].dispatches = cpus[i].dispatches;
+		stats_cpus[i].wait_cycles = cpus[i].wait_cycles;
+		stats_cpus[i].max_wait_cycles = cpus[i].max_wait_cycles;
+		stats_cpus[i].migrations = cpus[i].migrations;
 
 		irq_spinlock_unlock(&cpus[i].lock, true);
 	}
@@ -667,6 +671,36 @@ static void *get_stats_physmem(struct sysinfo_item *item, size_t *size,
 	return ((void *) stats_physmem);
 }
 
+/** Get frame allocator statistics
+ *
+ * @param item    Sysinfo item (unused).
+ * @param size    Size of the returned data.
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Data containing stats_frames_t.
+ *         If the return value is not NULL, it should be freed
+ *         in the context of the sysinfo request.
+ */
+static void *get_stats_frames(struct sysinfo_item *item, size_t *size,
+    bool dry_run, void *data)
+{
+	*size = sizeof(stats_frames_t);
+	if (dry_run)
+		return NULL;
+
+	stats_frames_t *stats_frames =
+	    (stats_frames_t *) malloc(*size);
+	if (stats_frames == NULL) {
+		*size = 0;
+		return NULL;
+	}
+
+	zones_alloc_stats(stats_frames);
+
+	return ((void *) stats_frames);
+}
+
 /** Get system load
  *
  * @param item    Sysinfo item (unused).
@@ -750,6 +784,7 @@ void stats_init(void)
 
 	sysinfo_set_item_gen_data("system.cpus", NULL, get_stats_cpus, NULL);
 	sysinfo_set_item_gen_data("system.physmem", NULL, get_stats_physmem, NULL);
+	sysinfo_set_item_gen_data("system.frames", NULL, get_stats_frames, NULL);
 	sysinfo_set_item_gen_data("system.load", NULL, get_stats_load, NULL);
 	sysinfo_set_item_gen_data("system.tasks", NULL, get_stats_tasks, NULL);
 	sysinfo_set_item_gen_data("system.threads", NULL, get_stats_threads, NULL);
@@ -54,6 +54,7 @@ test_t tests[] = {
 #include <print/print3.def>
 #include <print/print4.def>
 #include <print/print5.def>
+#include <thread/sched1.def>
 #include <thread/thread1.def>
 	{
 		.name = NULL,
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <atomic.h>
+#include <cpu.h>
+#include <errno.h>
+#include <proc/thread.h>
+#include <synch/semaphore.h>
+#include <arch/cycle.h>
+
+/*
+ * Measure the time from readying a thread to the thread running. A waker
+ * and a wakee thread wired to the same CPU hand a token back and forth,
+ * first on an otherwise idle CPU and then with busy threads competing for
+ * the same CPU.
+ */
+
+#define LOAD_THREADS  4
+#define ROUNDS        100
+
+/** How long the wakee may take to run in microseconds */
+#define ROUND_TIMEOUT  1000000
+
+static atomic_t finish;
+static atomic_t load_finished;
+
+static semaphore_t wake;
+static semaphore_t done;
+
+static uint64_t wake_cycle;
+static uint64_t sum_cycles;
+static uint64_t max_cycles;
+static bool timed_out;
+
+static void load(void *arg)
+{
+	thread_detach(THREAD);
+
+	while (atomic_load(&finish))
+		;
+
+	atomic_inc(&load_finished);
+}
+
+static void wakee(void *arg)
+{
+	for (unsigned int i = 0; i < ROUNDS; i++) {
+		semaphore_down(&wake);
+
+		uint64_t cycles = get_cycle() - wake_cycle;
+		sum_cycles += cycles;
+		if (cycles > max_cycles)
+			max_cycles = cycles;
+
+		semaphore_up(&done);
+	}
+}
+
+static void waker(void *arg)
+{
+	for (unsigned int i = 0; i < ROUNDS; i++) {
+		/* Let the load threads use up some of their time slices. */
+		thread_usleep(1000);
+
+		wake_cycle = get_cycle();
+		semaphore_up(&wake);
+
+		if (semaphore_down_timeout(&done, ROUND_TIMEOUT) != EOK) {
+			/* Record the failure, but keep the wakee in step. */
+			timed_out = true;
+			semaphore_down(&done);
+		}
+	}
+}
+
+static const char *measure(const char *label)
+{
+	semaphore_initialize(&wake, 0);
+	semaphore_initialize(&done, 0);
+	sum_cycles = 0;
+	max_cycles = 0;
+	timed_out = false;
+
+	thread_t *wakee_thread = thread_create(wakee, NULL, TASK,
+	    THREAD_FLAG_NONE, "sched1-wakee");
+	if (wakee_thread == NULL)
+		return "Could not create wakee thread";
+
+	thread_t *waker_thread = thread_create(waker, NULL, TASK,
+	    THREAD_FLAG_NONE, "sched1-waker");
+	if (waker_thread == NULL) {
+		/* Let the wakee run through its rounds on its own. */
+		thread_ready(wakee_thread);
+		for (unsigned int i = 0; i < ROUNDS; i++)
+			semaphore_up(&wake);
+		thread_join(wakee_thread);
+		thread_detach(wakee_thread);
+		return "Could not create waker thread";
+	}
+
+	thread_wire(wakee_thread, &cpus[0]);
+	thread_wire(waker_thread, &cpus[0]);
+	thread_ready(wakee_thread);
+	thread_ready(waker_thread);
+
+	thread_join(waker_thread);
+	thread_detach(waker_thread);
+	thread_join(wakee_thread);
+	thread_detach(wakee_thread);
+
+	if (timed_out)
+		return "Wakee did not run in time";
+
+	uint64_t avg_cycles = sum_cycles / ROUNDS;
+	uint16_t mhz = cpus[0].frequency_mhz;
+
+	if (mhz != 0) {
+		TPRINTF("%s: average %" PRIu64 " cycles (%" PRIu64 " us), "
+		    "max %" PRIu64 " cycles (%" PRIu64 " us)\n", label,
+		    avg_cycles, avg_cycles / mhz, max_cycles, max_cycles / mhz);
+	} else {
+		TPRINTF("%s: average %" PRIu64 " cycles, max %" PRIu64
+		    " cycles\n", label, avg_cycles, max_cycles);
+	}
+
+	return NULL;
+}
+
+const char *test_sched1(void)
+{
+	const char *err = measure("Idle");
+	if (err != NULL)
+		return err;
+
+	atomic_store(&finish, 1);
+	atomic_store(&load_finished, 0);
+
+	size_t total = 0;
+	for (unsigned int i = 0; i < LOAD_THREADS; i++) {
+		thread_t *t = thread_create(load, NULL, TASK,
+		    THREAD_FLAG_NONE, "sched1-load");
+		if (t == NULL) {
+			TPRINTF("Could not create load thread %u\n", i);
+			break;
+		}
+
+		thread_wire(t, &cpus[0]);
+		thread_ready(t);
+		total++;
+	}
+
+	err = measure("Loaded");
+
+	atomic_store(&finish, 0);
+	while (atomic_load(&load_finished) < total)
+		thread_usleep(10000);
+
+	return err;
+}
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compares stackful fibrils with stackless coroutines on an IPC ping-pong
+ * workload against the IPC test server (/srv/test/ipc-test). Both variants
+ * keep the same number of requests in flight and report throughput together
+ * with the memory each in-flight request needs. The coroutine variant is
+ * only available when the compiler supports coroutines.
+ */
+
+#include <chrono>
+#include <coroutine>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <async.h>
+#include <fibril_synch.h>
+#include <ipc/ipc_test.h>
+#include <ipc_test.h>
+#include <stack.h>
+
+namespace
+{
+    /**
+     * Note: The kernel limits the number of unanswered
+     *       calls per phone, so all in-flight requests
+     *       share one exchange and stay below that limit.
+     */
+    constexpr std::size_t default_concurrency = 32;
+    constexpr std::size_t default_rounds = 1000;
+
+    struct workload
+    {
+        ::helenos::async_exch_t* exch;
+        std::size_t rounds;
+        ::helenos::fibril_semaphore_t done;
+        ::helenos::errno_t rc;
+    };
+
+#ifdef __cpp_lib_coroutine
+    using std::experimental::async_call;
+    using std::experimental::fibril_executor;
+
+    std::size_t frame_bytes{};
+    std::size_t frame_count{};
+
+    /**
+     * Detached coroutine that accounts for the size
+     * of its frame so we can report it.
+     */
+    struct request
+    {
+        struct promise_type
+        {
+            static void* operator new(std::size_t size)
+            {
+                frame_bytes += size;
+                ++frame_count;
+
+                return ::operator new(size);
+            }
+
+            static void operator delete(void* ptr)
+            {
+                ::operator delete(ptr);
+            }
+
+            request get_return_object() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            { /* DUMMY BODY */ }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    request coroutine_client(fibril_executor& ex, workload& wl)
+    {
+        co_await ex.schedule();
+
+        for (std::size_t i = 0; i < wl.rounds; ++i)
+        {
+            auto rc = co_await async_call(ex, wl.exch, ::helenos::IPC_TEST_PING, nullptr);
+            if (rc != EOK)
+                wl.rc = rc;
+        }
+
+        ::helenos::fibril_semaphore_up(&wl.done);
+    }
+#endif
+
+    ::helenos::errno_t fibril_client(void* arg)
+    {
+        auto& wl = *static_cast<workload*>(arg);
+
+        for (std::size_t i = 0; i < wl.rounds; ++i)
+        {
+            auto aid = ::helenos::async_send_0(wl.exch, ::helenos::IPC_TEST_PING, nullptr);
+
+            ::helenos::errno_t rc;
+            ::helenos::async_wait_for(aid, &rc);
+            if (rc != EOK)
+                wl.rc = rc;
+        }
+
+        ::helenos::fibril_semaphore_up(&wl.done);
+
+        return EOK;
+    }
+
+    void report(const char* name, std::size_t calls,
+                std::chrono::steady_clock::duration elapsed,
+                std::size_t bytes_per_request)
+    {
+        auto usec = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        if (usec == 0)
+            usec = 1;
+
+        std::printf("%-10s %8zu calls in %10lld us: %10llu calls/s, %8zu B per request\n",
+                    name, calls, static_cast<long long>(usec),
+                    static_cast<unsigned long long>(calls) * 1000000ULL / usec,
+                    bytes_per_request);
+    }
+
+    bool run_fibrils(workload& wl, std::size_t concurrency)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < concurrency; ++i)
+        {
+            auto fid = ::helenos::fibril_create(fibril_client, &wl);
+            if (!fid)
+            {
+                std::printf("Failed creating fibril.\n");
+                return false;
+            }
+            ::helenos::fibril_add_ready(fid);
+        }
+
+        for (std::size_t i = 0; i < concurrency; ++i)
+            ::helenos::fibril_semaphore_down(&wl.done);
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        /**
+         * Note: The fibril structure itself is allocated on the heap
+         *       as well, but it is dwarfed by the stack.
+         */
+        report("fibrils", concurrency * wl.rounds, elapsed,
+               ::helenos::stack_size_get());
+
+        return true;
+    }
+
+    bool run_coroutines(workload& wl, std::size_t concurrency)
+    {
+#ifdef __cpp_lib_coroutine
+        fibril_executor ex{};
+        if (!ex.start())
+        {
+            std::printf("Failed starting executor.\n");
+            return false;
+        }
+
+        frame_bytes = 0;
+        frame_count = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < concurrency; ++i)
+            coroutine_client(ex, wl);
+
+        for (std::size_t i = 0; i < concurrency; ++i)
+            ::helenos::fibril_semaphore_down(&wl.done);
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        ex.stop();
+
+        report("coroutines", concurrency * wl.rounds, elapsed,
+               frame_count ? frame_bytes / frame_count : 0);
+#else
+        std::printf("coroutines not supported by the compiler\n");
+#endif
+
+        return true;
+    }
+
+    void usage()
+    {
+        std::printf("Usage: corobench [-c <concurrency>] [-r <rounds>]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t concurrency = default_concurrency;
+    std::size_t rounds = default_rounds;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            concurrency = ::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            rounds = ::strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (concurrency == 0 || concurrency >= ::helenos::IPC_MAX_ASYNC_CALLS || rounds == 0)
+    {
+        std::printf("Concurrency must be between 1 and %d, rounds must be positive.\n",
+                    ::helenos::IPC_MAX_ASYNC_CALLS - 1);
+        return 1;
+    }
+
+    ::helenos::ipc_test_t* test{};
+    auto rc = ::helenos::ipc_test_create(&test);
+    if (rc != EOK)
+    {
+        std::printf("Failed contacting IPC test server "
+                    "(have you run /srv/test/ipc-test?).\n");
+        return 1;
+    }
+
+    workload wl{};
+    wl.rounds = rounds;
+    wl.rc = EOK;
+    ::helenos::fibril_semaphore_initialize(&wl.done, 0);
+    wl.exch = ::helenos::async_exchange_begin(test->sess);
+
+    bool ok = run_fibrils(wl, concurrency) && run_coroutines(wl, concurrency);
+
+    ::helenos::async_exchange_end(wl.exch);
+    ::helenos::ipc_test_destroy(test);
+
+    if (ok && wl.rc != EOK)
+    {
+        std::printf("Ping failed (%d).\n", wl.rc);
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
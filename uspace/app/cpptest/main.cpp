@@ -26,6 +26,7 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <__bits/test/benchmarks.hpp>
 #include <__bits/test/tests.hpp>
 
 /* using namespace std::chrono_literals; */
@@ -100,8 +101,75 @@
 
 #include <__bits/trycatch.hpp>
 
-int main()
+namespace
 {
+    void usage()
+    {
+        std::printf("Usage: cpptest [--bench [-o <file.csv>] [-n <samples>]]\n");
+    }
+
+    int run_benchmarks(const char* csv_path, std::size_t samples)
+    {
+        std::FILE* csv{};
+        if (csv_path)
+        {
+            csv = std::fopen(csv_path, "w");
+            if (!csv)
+            {
+                std::printf("Failed to open %s.\n", csv_path);
+                return 1;
+            }
+
+            std::fprintf(csv, "benchmark,run,size,duration_nanos\n");
+        }
+
+        std::test::benchmark_set bs{};
+        bs.add<std::test::vector_benchmark>();
+        bs.add<std::test::string_benchmark>();
+        bs.add<std::test::deque_benchmark>();
+        bs.add<std::test::map_benchmark>();
+        bs.add<std::test::btree_benchmark>();
+        bs.add<std::test::memory_benchmark>();
+        bs.add<std::test::sort_benchmark>();
+        bs.add<std::test::stream_benchmark>();
+        bs.add<std::test::rtti_benchmark>();
+        bs.add<std::test::thread_local_benchmark>();
+        bs.add<std::test::future_benchmark>();
+        bs.add<std::test::random_benchmark>();
+
+        bs.run(csv, samples);
+
+        if (csv)
+            std::fclose(csv);
+
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool bench{false};
+    const char* csv_path{};
+    std::size_t samples{21};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)
+            bench = true;
+        else if (bench && std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            csv_path = argv[++i];
+        else if (bench && std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            samples = ::strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (bench)
+        return run_benchmarks(csv_path, samples);
+
     std::test::test_set ts{};
     ts.add<std::test::vector_test>();
     ts.add<std::test::string_test>();
@@ -111,6 +179,7 @@ int main()
     ts.add<std::test::tuple_test>();
     ts.add<std::test::map_test>();
     ts.add<std::test::set_test>();
+    ts.add<std::test::btree_test>();
     ts.add<std::test::unordered_map_test>();
     ts.add<std::test::unordered_set_test>();
     ts.add<std::test::numeric_test>();
@@ -121,6 +190,10 @@ int main()
     ts.add<std::test::functional_test>();
     ts.add<std::test::algorithm_test>();
     ts.add<std::test::future_test>();
+    ts.add<std::test::coroutine_test>();
+    ts.add<std::test::rtti_test>();
+    ts.add<std::test::abi_test>();
+    ts.add<std::test::random_test>();
 
     return ts.run(true) ? 0 : 1;
 }
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <adt/cht.h>
+#include <adt/hash_table.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Scaling benchmarks for the concurrent hash table. The number of worker
+ * fibrils, one per runner thread, is given by the "runners" parameter
+ * (1 to 8). With the parameter "table" set to "locked" instead of "cht",
+ * the benchmarks use a hash_table_t guarded by a fibril mutex instead,
+ * which is how the users of hash_table_t share it.
+ *
+ * cht_lookup looks up random keys of a table of LOOKUP_KEYS items.
+ *
+ * cht_insert inserts an item with a new key in every iteration and
+ * removes the one inserted INSERT_WINDOW iterations before, so the size
+ * of the table stays the same.
+ */
+
+#define DEFAULT_RUNNERS 4
+#define MAX_RUNNERS 8
+
+#define LOOKUP_KEYS 4096
+#define INSERT_WINDOW 256
+
+typedef struct {
+	ht_link_t ht_link;
+	cht_link_t cht_link;
+	size_t key;
+} entry_t;
+
+typedef struct {
+	bool locked;
+	cht_t cht;
+	hash_table_t ht;
+	fibril_mutex_t ht_lock;
+
+	fibril_semaphore_t done;
+	uint64_t iterations;
+	atomic_bool failed;
+	atomic_bool missing;
+} shared_t;
+
+typedef struct {
+	shared_t *shared;
+	size_t id;
+} worker_t;
+
+static size_t ht_entry_hash(const ht_link_t *item)
+{
+	return hash_table_get_inst(item, entry_t, ht_link)->key;
+}
+
+static size_t cht_entry_hash(const cht_link_t *item)
+{
+	return cht_get_inst(item, entry_t, cht_link)->key;
+}
+
+static size_t entry_key_hash(const void *key)
+{
+	return *(const size_t *) key;
+}
+
+static bool ht_entry_key_equal(const void *key, const ht_link_t *item)
+{
+	return *(const size_t *) key == ht_entry_hash(item);
+}
+
+static bool cht_entry_key_equal(const void *key, const cht_link_t *item)
+{
+	return *(const size_t *) key == cht_entry_hash(item);
+}
+
+static void ht_entry_remove(ht_link_t *item)
+{
+	free(hash_table_get_inst(item, entry_t, ht_link));
+}
+
+static void cht_entry_remove(cht_link_t *item)
+{
+	free(cht_get_inst(item, entry_t, cht_link));
+}
+
+static hash_table_ops_t ht_ops = {
+	.hash = ht_entry_hash,
+	.key_hash = entry_key_hash,
+	.key_equal = ht_entry_key_equal,
+	.equal = NULL,
+	.remove_callback = ht_entry_remove
+};
+
+static cht_ops_t cht_ops = {
+	.hash = cht_entry_hash,
+	.key_hash = entry_key_hash,
+	.key_equal = cht_entry_key_equal,
+	.equal = NULL,
+	.remove_callback = cht_entry_remove
+};
+
+static bool table_init(bench_env_t *env, bench_run_t *run, shared_t *shared,
+    size_t *runners)
+{
+	const char *runners_str = bench_env_param_get(env, "runners", NULL);
+	*runners = DEFAULT_RUNNERS;
+	if (runners_str != NULL) {
+		if (str_size_t(runners_str, NULL, 10, true, runners) != EOK ||
+		    *runners == 0 || *runners > MAX_RUNNERS) {
+			return bench_run_fail(run,
+			    "invalid runner count '%s' (expected 1-%d)",
+			    runners_str, MAX_RUNNERS);
+		}
+	}
+
+	const char *table = bench_env_param_get(env, "table", "cht");
+	if (str_cmp(table, "cht") == 0) {
+		shared->locked = false;
+	} else if (str_cmp(table, "locked") == 0) {
+		shared->locked = true;
+	} else {
+		return bench_run_fail(run,
+		    "invalid table '%s' (expected cht or locked)", table);
+	}
+
+	if (bench_runners_ensure(*runners) < *runners)
+		return bench_run_fail(run, "failed to spawn %zu runners", *runners);
+
+	bool ok;
+	if (shared->locked) {
+		fibril_mutex_initialize(&shared->ht_lock);
+		ok = hash_table_create(&shared->ht, 0, 0, &ht_ops);
+	} else {
+		ok = cht_create(&shared->cht, 0, 0, &cht_ops);
+	}
+
+	if (!ok)
+		return bench_run_fail(run, "failed to create the table");
+
+	fibril_semaphore_initialize(&shared->done, 0);
+	atomic_store(&shared->failed, false);
+	atomic_store(&shared->missing, false);
+	return true;
+}
+
+static void table_fini(shared_t *shared)
+{
+	if (shared->locked)
+		hash_table_destroy(&shared->ht);
+	else
+		cht_destroy(&shared->cht);
+}
+
+static bool table_insert(shared_t *shared, size_t key)
+{
+	entry_t *entry = malloc(sizeof(entry_t));
+	if (entry == NULL)
+		return false;
+
+	entry->key = key;
+
+	if (shared->locked) {
+		fibril_mutex_lock(&shared->ht_lock);
+		hash_table_insert(&shared->ht, &entry->ht_link);
+		fibril_mutex_unlock(&shared->ht_lock);
+	} else {
+		cht_insert(&shared->cht, &entry->cht_link);
+	}
+
+	return true;
+}
+
+static void table_remove(shared_t *shared, size_t key)
+{
+	if (shared->locked) {
+		fibril_mutex_lock(&shared->ht_lock);
+		hash_table_remove(&shared->ht, &key);
+		fibril_mutex_unlock(&shared->ht_lock);
+	} else {
+		cht_remove(&shared->cht, &key);
+	}
+}
+
+static bool table_contains(shared_t *shared, size_t key)
+{
+	bool found;
+
+	if (shared->locked) {
+		fibril_mutex_lock(&shared->ht_lock);
+		found = hash_table_find(&shared->ht, &key) != NULL;
+		fibril_mutex_unlock(&shared->ht_lock);
+	} else {
+		cht_read_t rd;
+		cht_read_lock(&shared->cht, &rd);
+		found = cht_find(&shared->cht, &key) != NULL;
+		cht_read_unlock(&shared->cht, &rd);
+	}
+
+	return found;
+}
+
+static bool run_workers(bench_run_t *run, shared_t *shared, size_t runners,
+    errno_t (*fn)(void *))
+{
+	worker_t workers[MAX_RUNNERS];
+
+	bench_run_start(run);
+
+	size_t started = 0;
+	for (size_t i = 0; i < runners; i++) {
+		workers[i].shared = shared;
+		workers[i].id = i;
+
+		fid_t fid = fibril_create(fn, &workers[i]);
+		if (fid == 0) {
+			atomic_store(&shared->failed, true);
+			break;
+		}
+
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&shared->done);
+
+	bench_run_stop(run);
+
+	if (atomic_load(&shared->failed))
+		return bench_run_fail(run, "failed to create a fibril or an item");
+
+	return true;
+}
+
+static errno_t lookup_worker(void *arg)
+{
+	worker_t *worker = arg;
+	shared_t *shared = worker->shared;
+	fibril_detach(fibril_get_id());
+
+	size_t seed = worker->id + 1;
+	for (uint64_t i = 0; i < shared->iterations; i++) {
+		seed = seed * 1103515245 + 12345;
+		if (!table_contains(shared, (seed >> 8) % LOOKUP_KEYS))
+			atomic_store(&shared->missing, true);
+	}
+
+	fibril_semaphore_up(&shared->done);
+	return EOK;
+}
+
+static bool lookup_runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	shared_t shared;
+	size_t runners;
+	if (!table_init(env, run, &shared, &runners))
+		return false;
+
+	for (size_t key = 0; key < LOOKUP_KEYS; key++) {
+		if (!table_insert(&shared, key)) {
+			table_fini(&shared);
+			return bench_run_fail(run, "failed to create an item");
+		}
+	}
+
+	shared.iterations = niter / runners + 1;
+	bool ok = run_workers(run, &shared, runners, lookup_worker);
+
+	table_fini(&shared);
+
+	if (ok && atomic_load(&shared.missing))
+		return bench_run_fail(run, "an item was not found");
+
+	return ok;
+}
+
+static errno_t insert_worker(void *arg)
+{
+	worker_t *worker = arg;
+	shared_t *shared = worker->shared;
+	fibril_detach(fibril_get_id());
+
+	/* Every worker has keys of its own. */
+	for (uint64_t i = 0; i < shared->iterations; i++) {
+		if (!table_insert(shared, i * MAX_RUNNERS + worker->id)) {
+			atomic_store(&shared->failed, true);
+			break;
+		}
+
+		if (i >= INSERT_WINDOW) {
+			table_remove(shared,
+			    (i - INSERT_WINDOW) * MAX_RUNNERS + worker->id);
+		}
+	}
+
+	fibril_semaphore_up(&shared->done);
+	return EOK;
+}
+
+static bool insert_runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	shared_t shared;
+	size_t runners;
+	if (!table_init(env, run, &shared, &runners))
+		return false;
+
+	shared.iterations = niter / runners + 1;
+	bool ok = run_workers(run, &shared, runners, insert_worker);
+
+	table_fini(&shared);
+	return ok;
+}
+
+benchmark_t benchmark_cht_insert = {
+	.name = "cht_insert",
+	.desc = "Concurrent hash table insertion and removal scaling",
+	.entry = &insert_runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_cht_lookup = {
+	.name = "cht_lookup",
+	.desc = "Concurrent hash table lookup scaling",
+	.entry = &lookup_runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
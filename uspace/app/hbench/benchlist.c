@@ -38,13 +38,26 @@
 #include "hbench.h"
 
 benchmark_t *benchmarks[] = {
+	&benchmark_cht_insert,
+	&benchmark_cht_lookup,
 	&benchmark_dir_read,
 	&benchmark_fibril_mutex,
+	&benchmark_fibril_rwlock,
+	&benchmark_fibril_timeout,
+	&benchmark_fibril_wakeup,
+	&benchmark_fibril_yield,
 	&benchmark_file_read,
+	&benchmark_ipc_data_read,
+	&benchmark_ipc_data_write,
+	&benchmark_ipc_notification,
+	&benchmark_ipc_throughput,
 	&benchmark_malloc1,
 	&benchmark_malloc2,
+	&benchmark_malloc3,
+	&benchmark_malloc4,
 	&benchmark_ns_ping,
-	&benchmark_ping_pong
+	&benchmark_ping_pong,
+	&benchmark_ping_pong_batch
 };
 
 size_t benchmark_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
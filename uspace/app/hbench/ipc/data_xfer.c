@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <errno.h>
+#include <ipc_test.h>
+#include <mem.h>
+#include <stdlib.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * Bulk data transfer to and from the IPC test server. Each iteration moves
+ * one buffer of the given size, split into IPC_M_DATA_WRITE or
+ * IPC_M_DATA_READ calls of at most DATA_XFER_LIMIT bytes.
+ *
+ * The buffer size is set with the size parameter and accepts a K or M
+ * suffix, so the whole range is swept by running e.g.
+ *
+ *   hbench -p size=4K ipc_data_write
+ *   hbench -p size=16K ipc_data_write
+ *   ...
+ *   hbench -p size=4M ipc_data_write
+ *
+ * Calls of 16K and more (DATA_XFER_PIN_THRESHOLD in the kernel) copy
+ * directly between the two address spaces, smaller ones go through a kernel
+ * bounce buffer.
+ */
+
+#define MIN_SIZE (4 * 1024)
+#define MAX_SIZE (4 * 1024 * 1024)
+#define DEFAULT_SIZE (64 * 1024)
+
+static ipc_test_t *test = NULL;
+static void *buffer = NULL;
+static size_t buffer_size;
+
+static bool parse_size(const char *str, size_t *rsize)
+{
+	const char *end;
+	size_t size;
+
+	if (str_size_t(str, &end, 10, false, &size) != EOK)
+		return false;
+
+	if (str_cmp(end, "K") == 0 || str_cmp(end, "k") == 0)
+		size *= 1024;
+	else if (str_cmp(end, "M") == 0 || str_cmp(end, "m") == 0)
+		size *= 1024 * 1024;
+	else if (*end != '\0')
+		return false;
+
+	*rsize = size;
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *size_str = bench_env_param_get(env, "size", NULL);
+	buffer_size = DEFAULT_SIZE;
+	if (size_str != NULL) {
+		if (!parse_size(size_str, &buffer_size) ||
+		    buffer_size < MIN_SIZE || buffer_size > MAX_SIZE) {
+			return bench_run_fail(run,
+			    "invalid size '%s' (expected 4K-4M)", size_str);
+		}
+	}
+
+	buffer = malloc(buffer_size);
+	if (buffer == NULL)
+		return bench_run_fail(run, "failed allocating %zu bytes",
+		    buffer_size);
+
+	/* Fault the buffer in so that the first run is not penalized. */
+	memset(buffer, 0x5a, buffer_size);
+
+	errno_t rc = ipc_test_create(&test);
+	if (rc != EOK) {
+		free(buffer);
+		buffer = NULL;
+		return bench_run_fail(run,
+		    "failed contacting IPC test server (have you run /srv/test/ipc-test?): %s (%d)",
+		    str_error(rc), rc);
+	}
+
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	ipc_test_destroy(test);
+	free(buffer);
+	buffer = NULL;
+	return true;
+}
+
+static bool runner_write(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		errno_t rc = ipc_test_write(test, buffer, buffer_size);
+		if (rc != EOK) {
+			return bench_run_fail(run,
+			    "failed writing data: %s (%d)",
+			    str_error(rc), rc);
+		}
+	}
+
+	bench_run_stop(run);
+
+	return true;
+}
+
+static bool runner_read(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		errno_t rc = ipc_test_read(test, buffer, buffer_size);
+		if (rc != EOK) {
+			return bench_run_fail(run,
+			    "failed reading data: %s (%d)",
+			    str_error(rc), rc);
+		}
+	}
+
+	bench_run_stop(run);
+
+	return true;
+}
+
+benchmark_t benchmark_ipc_data_read = {
+	.name = "ipc_data_read",
+	.desc = "IPC data read of a buffer of the given size (4K-4M)",
+	.entry = &runner_read,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+benchmark_t benchmark_ipc_data_write = {
+	.name = "ipc_data_write",
+	.desc = "IPC data write of a buffer of the given size (4K-4M)",
+	.entry = &runner_write,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
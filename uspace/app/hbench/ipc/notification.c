@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <async.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * Notification delivery with synthetic notifications. Several producer
+ * fibrils, one per runner thread, post notifications of one method as
+ * fast as they can, like an interrupt-heavy driver. The "work" parameter
+ * makes the handler spin for the given number of iterations, so that it
+ * falls behind and the notifications are coalesced.
+ *
+ * Besides the rate, the benchmark prints how many of the notifications
+ * were coalesced.
+ */
+
+#define DEFAULT_PRODUCERS 2
+#define MAX_PRODUCERS 8
+
+typedef struct {
+	uint64_t iterations;
+	uint64_t posted;
+	uint64_t coalesced;
+	errno_t rc;
+	fibril_semaphore_t *done;
+} producer_t;
+
+static producer_t producers[MAX_PRODUCERS];
+static size_t producer_count;
+static size_t handler_work;
+
+static bool notification_created = false;
+static sysarg_t notification_method;
+static atomic_uint_fast64_t handled;
+
+static uint64_t total_posted;
+static uint64_t total_coalesced;
+
+static void handler(ipc_call_t *call, void *arg)
+{
+	for (volatile size_t i = 0; i < handler_work; i++)
+		;
+
+	atomic_fetch_add_explicit(&handled, 1, memory_order_relaxed);
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *producers_str = bench_env_param_get(env, "producers", NULL);
+	producer_count = DEFAULT_PRODUCERS;
+	if (producers_str != NULL) {
+		if (str_size_t(producers_str, NULL, 10, true, &producer_count) != EOK ||
+		    producer_count == 0 || producer_count > MAX_PRODUCERS) {
+			return bench_run_fail(run,
+			    "invalid producer count '%s' (expected 1-%d)",
+			    producers_str, MAX_PRODUCERS);
+		}
+	}
+
+	const char *work_str = bench_env_param_get(env, "work", "0");
+	if (str_size_t(work_str, NULL, 10, true, &handler_work) != EOK)
+		return bench_run_fail(run, "invalid handler work '%s'", work_str);
+
+	if (!notification_created) {
+		errno_t rc = async_notification_create(handler, NULL,
+		    &notification_method);
+		if (rc != EOK) {
+			return bench_run_fail(run,
+			    "failed creating notification: %s (%d)",
+			    str_error(rc), rc);
+		}
+
+		notification_created = true;
+	}
+
+	bench_runners_ensure(producer_count);
+
+	total_posted = 0;
+	total_coalesced = 0;
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	if (total_posted > 0) {
+		printf("Coalesced %" PRIu64 " of %" PRIu64 " notifications "
+		    "(%.1f%%).\n", total_coalesced, total_posted,
+		    100.0 * total_coalesced / total_posted);
+	}
+
+	return true;
+}
+
+static errno_t producer(void *arg)
+{
+	producer_t *p = arg;
+	fibril_detach(fibril_get_id());
+
+	ipc_call_t call = { 0 };
+	ipc_set_imethod(&call, notification_method);
+
+	p->rc = EOK;
+	p->posted = 0;
+	p->coalesced = 0;
+	for (uint64_t i = 0; i < p->iterations; i++) {
+		ipc_set_arg1(&call, i);
+
+		errno_t rc = async_notification_post(&call);
+		if (rc == EBUSY) {
+			p->coalesced++;
+		} else if (rc != EOK) {
+			p->rc = rc;
+			break;
+		}
+
+		p->posted++;
+	}
+
+	fibril_semaphore_up(p->done);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	fibril_semaphore_t done;
+	fibril_semaphore_initialize(&done, 0);
+
+	uint64_t handled_before = atomic_load(&handled);
+
+	bench_run_start(run);
+
+	size_t started = 0;
+	for (size_t i = 0; i < producer_count; i++) {
+		producers[i].iterations = niter / producer_count + 1;
+		producers[i].done = &done;
+
+		fid_t fid = fibril_create(producer, &producers[i]);
+		if (fid == 0)
+			break;
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&done);
+
+	uint64_t posted = 0;
+	uint64_t coalesced = 0;
+	for (size_t i = 0; i < started; i++) {
+		posted += producers[i].posted;
+		coalesced += producers[i].coalesced;
+	}
+
+	/* Wait for the handler to catch up. */
+	while (atomic_load(&handled) - handled_before < posted - coalesced)
+		fibril_yield();
+
+	bench_run_stop(run);
+
+	if (started < producer_count)
+		return bench_run_fail(run, "failed to create a producer fibril");
+
+	for (size_t i = 0; i < producer_count; i++) {
+		if (producers[i].rc != EOK) {
+			return bench_run_fail(run,
+			    "failed posting notification: %s (%d)",
+			    str_error(producers[i].rc), producers[i].rc);
+		}
+	}
+
+	total_posted += posted;
+	total_coalesced += coalesced;
+	return true;
+}
+
+benchmark_t benchmark_ipc_notification = {
+	.name = "ipc_notification",
+	.desc = "Delivery of synthetic notifications from several producers",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <inttypes.h>
+#include <ipc_test.h>
+#include <stats.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include <str_error.h>
+#include <task.h>
+#include "../hbench.h"
+
+/*
+ * IPC ping-pong with several pings in flight. The client sends a batch
+ * of pings before waiting for the answers, so the pings are submitted
+ * and the answers received by batched IPC syscalls.
+ *
+ * Besides the ping rate, the benchmark prints how many IPC syscalls the
+ * client made per ping.
+ */
+
+#define DEFAULT_BATCH 16
+
+static ipc_test_t *test = NULL;
+static size_t batch;
+static uint64_t total_syscalls;
+static uint64_t total_calls;
+
+static bool get_ipc_stats(stats_ipc_t *ipc)
+{
+	stats_task_t *stats = stats_get_task(task_get_id());
+	if (stats == NULL)
+		return false;
+
+	*ipc = stats->ipc_info;
+	free(stats);
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *batch_str = bench_env_param_get(env, "batch", NULL);
+	batch = DEFAULT_BATCH;
+	if (batch_str != NULL) {
+		if (str_size_t(batch_str, NULL, 10, true, &batch) != EOK ||
+		    batch == 0 || batch > IPC_TEST_PING_BATCH_MAX) {
+			return bench_run_fail(run,
+			    "invalid batch size '%s' (expected 1-%d)",
+			    batch_str, IPC_TEST_PING_BATCH_MAX);
+		}
+	}
+
+	errno_t rc = ipc_test_create(&test);
+	if (rc != EOK) {
+		return bench_run_fail(run,
+		    "failed contacting IPC test server (have you run /srv/test/ipc-test?): %s (%d)",
+		    str_error(rc), rc);
+	}
+
+	total_syscalls = 0;
+	total_calls = 0;
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	ipc_test_destroy(test);
+
+	if (total_calls > 0) {
+		printf("IPC syscalls per ping: %.2f (%" PRIu64 " syscalls, "
+		    "%" PRIu64 " pings).\n",
+		    (double) total_syscalls / total_calls,
+		    total_syscalls, total_calls);
+	}
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	stats_ipc_t before;
+	stats_ipc_t after;
+	bool have_stats = get_ipc_stats(&before);
+
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count += batch) {
+		size_t n = niter - count < batch ? niter - count : batch;
+		errno_t rc = ipc_test_ping_batch(test, n);
+
+		if (rc != EOK) {
+			return bench_run_fail(run, "failed sending ping messages: %s (%d)",
+			    str_error(rc), rc);
+		}
+	}
+
+	bench_run_stop(run);
+
+	if (have_stats && get_ipc_stats(&after)) {
+		total_syscalls += after.syscalls - before.syscalls;
+		total_calls += after.call_sent - before.call_sent;
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_ping_pong_batch = {
+	.name = "ping_pong_batch",
+	.desc = "IPC ping-pong benchmark with batched pings",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
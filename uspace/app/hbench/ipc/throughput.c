@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <ipc_test.h>
+#include <stdatomic.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * IPC throughput with several clients. Each client fibril has its own
+ * session to the IPC test server and keeps sending pings, and the clients
+ * run on one runner thread per client.
+ *
+ * Comparing the results for the server started as plain
+ * /srv/test/ipc-test and as /srv/test/ipc-test --pool shows how much the
+ * server gains from its runner pool.
+ */
+
+#define DEFAULT_CLIENTS 4
+#define MAX_CLIENTS 16
+
+typedef struct {
+	ipc_test_t *test;
+	uint64_t iterations;
+	errno_t rc;
+	fibril_semaphore_t *done;
+} client_t;
+
+static client_t clients[MAX_CLIENTS];
+static size_t client_count;
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *clients_str = bench_env_param_get(env, "clients", NULL);
+	client_count = DEFAULT_CLIENTS;
+	if (clients_str != NULL) {
+		if (str_size_t(clients_str, NULL, 10, true, &client_count) != EOK ||
+		    client_count == 0 || client_count > MAX_CLIENTS) {
+			return bench_run_fail(run,
+			    "invalid client count '%s' (expected 1-%d)",
+			    clients_str, MAX_CLIENTS);
+		}
+	}
+
+	bench_runners_ensure(client_count);
+
+	for (size_t i = 0; i < client_count; i++) {
+		errno_t rc = ipc_test_create(&clients[i].test);
+		if (rc != EOK) {
+			while (i-- > 0)
+				ipc_test_destroy(clients[i].test);
+
+			return bench_run_fail(run,
+			    "failed contacting IPC test server (have you run /srv/test/ipc-test?): %s (%d)",
+			    str_error(rc), rc);
+		}
+	}
+
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	for (size_t i = 0; i < client_count; i++)
+		ipc_test_destroy(clients[i].test);
+
+	return true;
+}
+
+static errno_t client(void *arg)
+{
+	client_t *c = arg;
+	fibril_detach(fibril_get_id());
+
+	c->rc = EOK;
+	for (uint64_t i = 0; i < c->iterations; i++) {
+		c->rc = ipc_test_ping(c->test);
+		if (c->rc != EOK)
+			break;
+	}
+
+	fibril_semaphore_up(c->done);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	fibril_semaphore_t done;
+	fibril_semaphore_initialize(&done, 0);
+
+	bench_run_start(run);
+
+	size_t started = 0;
+	for (size_t i = 0; i < client_count; i++) {
+		clients[i].iterations = niter / client_count + 1;
+		clients[i].done = &done;
+
+		fid_t fid = fibril_create(client, &clients[i]);
+		if (fid == 0)
+			break;
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&done);
+
+	bench_run_stop(run);
+
+	if (started < client_count)
+		return bench_run_fail(run, "failed to create a client fibril");
+
+	for (size_t i = 0; i < client_count; i++) {
+		if (clients[i].rc != EOK) {
+			return bench_run_fail(run,
+			    "failed sending ping message: %s (%d)",
+			    str_error(clients[i].rc), clients[i].rc);
+		}
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_ipc_throughput = {
+	.name = "ipc_throughput",
+	.desc = "IPC ping throughput with several concurrent clients",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Allocator benchmark with a mix of block sizes. A working set of blocks
+ * is kept alive and every iteration replaces a random one of them with
+ * a block of a random size. Most blocks are small, with a tail of larger
+ * ones, roughly like in a typical server.
+ */
+
+#define DEFAULT_SLOTS 256
+#define MAX_SLOTS 65536
+
+/** Simple xorshift generator, we do not want to measure rand(). */
+static inline uint32_t next_random(uint32_t *state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static size_t random_size(uint32_t *state)
+{
+	uint32_t r = next_random(state);
+	uint32_t kind = r % 100;
+	r >>= 7;
+
+	if (kind < 60)
+		return 8 + r % 121;
+	if (kind < 90)
+		return 129 + r % 896;
+	if (kind < 99)
+		return 1025 + r % 7168;
+	return 8193 + r % 57344;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	const char *slots_str = bench_env_param_get(env, "slots", NULL);
+	size_t slots = DEFAULT_SLOTS;
+	if (slots_str != NULL) {
+		if (str_size_t(slots_str, NULL, 10, true, &slots) != EOK ||
+		    slots == 0 || slots > MAX_SLOTS) {
+			return bench_run_fail(run,
+			    "invalid slot count '%s' (expected 1-%d)",
+			    slots_str, MAX_SLOTS);
+		}
+	}
+
+	void **blocks = calloc(slots, sizeof(void *));
+	if (blocks == NULL)
+		return bench_run_fail(run, "failed to allocate slot array");
+
+	uint32_t state = 0x12345678;
+	bool ok = true;
+
+	bench_run_start(run);
+
+	for (uint64_t i = 0; i < niter; i++) {
+		size_t slot = next_random(&state) % slots;
+		size_t size = random_size(&state);
+
+		free(blocks[slot]);
+		blocks[slot] = malloc(size);
+		if (blocks[slot] == NULL) {
+			ok = bench_run_fail(run, "failed to allocate %zuB", size);
+			break;
+		}
+
+		/* Touch the block so that the memory is really used. */
+		*((volatile char *) blocks[slot]) = 0;
+	}
+
+	for (size_t i = 0; i < slots; i++)
+		free(blocks[i]);
+
+	bench_run_stop(run);
+
+	free(blocks);
+	return ok;
+}
+
+benchmark_t benchmark_malloc3 = {
+	.name = "malloc3",
+	.desc = "User-space memory allocator benchmark, random block sizes",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
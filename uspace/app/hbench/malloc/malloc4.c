@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Multi-threaded allocator benchmark. Several worker fibrils run on
+ * separate runner threads, each replacing blocks in a private working
+ * set. Every few iterations a worker swaps a block with its neighbour,
+ * so that some blocks are freed by a different thread than the one
+ * that allocated them.
+ */
+
+#define DEFAULT_THREADS 4
+#define MAX_THREADS 32
+
+#define SLOTS 64
+
+/** One in HANDOFF_RATE blocks is passed to the neighbouring worker. */
+#define HANDOFF_RATE 16
+
+typedef struct {
+	atomic_size_t running;
+	size_t workers;
+	uint64_t iterations;
+	_Atomic(void *) handoff[MAX_THREADS];
+	atomic_bool failed;
+} shared_t;
+
+typedef struct {
+	shared_t *shared;
+	size_t idx;
+} worker_arg_t;
+
+static inline uint32_t next_random(uint32_t *state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static errno_t worker(void *arg)
+{
+	worker_arg_t *wa = arg;
+	shared_t *shared = wa->shared;
+	fibril_detach(fibril_get_id());
+
+	void *blocks[SLOTS] = { NULL };
+	uint32_t state = 0x9E3779B9u * (wa->idx + 1);
+	_Atomic(void *) *next =
+	    &shared->handoff[(wa->idx + 1) % shared->workers];
+
+	for (uint64_t i = 0; i < shared->iterations; i++) {
+		uint32_t r = next_random(&state);
+		size_t slot = r % SLOTS;
+		size_t size = 16 + (r >> 8) % 497;
+
+		free(blocks[slot]);
+		blocks[slot] = malloc(size);
+		if (blocks[slot] == NULL) {
+			atomic_store(&shared->failed, true);
+			break;
+		}
+
+		if (i % HANDOFF_RATE == 0) {
+			blocks[slot] = atomic_exchange(next, blocks[slot]);
+		}
+	}
+
+	for (size_t i = 0; i < SLOTS; i++)
+		free(blocks[i]);
+
+	atomic_fetch_sub(&shared->running, 1);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	const char *threads_str = bench_env_param_get(env, "threads", NULL);
+	size_t threads = DEFAULT_THREADS;
+	if (threads_str != NULL) {
+		if (str_size_t(threads_str, NULL, 10, true, &threads) != EOK ||
+		    threads == 0 || threads > MAX_THREADS) {
+			return bench_run_fail(run,
+			    "invalid thread count '%s' (expected 1-%d)",
+			    threads_str, MAX_THREADS);
+		}
+	}
+
+	bench_runners_ensure(threads);
+
+	shared_t *shared = calloc(1, sizeof(shared_t));
+	if (shared == NULL)
+		return bench_run_fail(run, "failed to allocate shared state");
+
+	worker_arg_t args[MAX_THREADS];
+
+	shared->workers = threads;
+	shared->iterations = niter / threads + 1;
+	atomic_store(&shared->running, 0);
+	atomic_store(&shared->failed, false);
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < threads; i++) {
+		args[i].shared = shared;
+		args[i].idx = i;
+
+		fid_t fid = fibril_create(worker, &args[i]);
+		if (fid == 0)
+			break;
+		atomic_fetch_add(&shared->running, 1);
+		fibril_add_ready(fid);
+	}
+
+	while (atomic_load(&shared->running) > 0)
+		fibril_yield();
+
+	bench_run_stop(run);
+
+	for (size_t i = 0; i < threads; i++)
+		free(atomic_load(&shared->handoff[i]));
+
+	bool failed = atomic_load(&shared->failed);
+	free(shared);
+
+	if (failed)
+		return bench_run_fail(run, "a worker failed to allocate memory");
+
+	return true;
+}
+
+benchmark_t benchmark_malloc4 = {
+	.name = "malloc4",
+	.desc = "User-space memory allocator benchmark, several threads",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
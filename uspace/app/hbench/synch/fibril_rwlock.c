@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Reader-heavy benchmark for fibril rwlocks. Several reader fibrils hold
+ * the lock in overlapping critical sections while a single writer keeps
+ * trying to get in with a short deadline. The measured fibril is a reader,
+ * and the run fails if any of the readers never got the lock.
+ */
+
+#define DEFAULT_READERS 4
+#define MAX_READERS 64
+
+/** How long the writer waits before giving up on an attempt. */
+#define WRITER_TIMEOUT_USEC 1000
+
+typedef struct {
+	fibril_rwlock_t rwlock;
+	atomic_bool stop;
+	atomic_size_t running;
+	uint64_t reads[MAX_READERS];
+	uint64_t writes;
+	uint64_t write_timeouts;
+} shared_t;
+
+typedef struct {
+	shared_t *shared;
+	size_t idx;
+} reader_arg_t;
+
+static errno_t reader(void *arg)
+{
+	reader_arg_t *ra = arg;
+	shared_t *shared = ra->shared;
+	fibril_detach(fibril_get_id());
+
+	while (!atomic_load(&shared->stop)) {
+		fibril_rwlock_read_lock(&shared->rwlock);
+		shared->reads[ra->idx]++;
+		fibril_yield();
+		fibril_rwlock_read_unlock(&shared->rwlock);
+		fibril_yield();
+	}
+
+	atomic_fetch_sub(&shared->running, 1);
+	return EOK;
+}
+
+static errno_t writer(void *arg)
+{
+	shared_t *shared = arg;
+	fibril_detach(fibril_get_id());
+
+	while (!atomic_load(&shared->stop)) {
+		struct timespec expires;
+		getuptime(&expires);
+		ts_add_diff(&expires, USEC2NSEC(WRITER_TIMEOUT_USEC));
+
+		if (fibril_rwlock_write_lock_until(&shared->rwlock,
+		    &expires) == EOK) {
+			shared->writes++;
+			fibril_rwlock_write_unlock(&shared->rwlock);
+		} else {
+			shared->write_timeouts++;
+		}
+		fibril_yield();
+	}
+
+	atomic_fetch_sub(&shared->running, 1);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *readers_str = bench_env_param_get(env, "readers", NULL);
+	size_t readers = DEFAULT_READERS;
+	if (readers_str != NULL) {
+		if (str_size_t(readers_str, NULL, 10, true, &readers) != EOK ||
+		    readers == 0 || readers > MAX_READERS) {
+			return bench_run_fail(run,
+			    "invalid reader count '%s' (expected 1-%d)",
+			    readers_str, MAX_READERS);
+		}
+	}
+
+	shared_t *shared = calloc(1, sizeof(shared_t));
+	if (shared == NULL)
+		return bench_run_fail(run, "failed to allocate shared state");
+
+	reader_arg_t args[MAX_READERS];
+
+	fibril_rwlock_initialize(&shared->rwlock);
+	atomic_store(&shared->stop, false);
+	atomic_store(&shared->running, 0);
+
+	for (size_t i = 0; i < readers; i++) {
+		args[i].shared = shared;
+		args[i].idx = i;
+
+		fid_t fid = fibril_create(reader, &args[i]);
+		if (fid == 0)
+			break;
+		atomic_fetch_add(&shared->running, 1);
+		fibril_add_ready(fid);
+	}
+
+	fid_t fid = fibril_create(writer, shared);
+	if (fid != 0) {
+		atomic_fetch_add(&shared->running, 1);
+		fibril_add_ready(fid);
+	}
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		fibril_rwlock_read_lock(&shared->rwlock);
+		fibril_yield();
+		fibril_rwlock_read_unlock(&shared->rwlock);
+	}
+	bench_run_stop(run);
+
+	atomic_store(&shared->stop, true);
+	while (atomic_load(&shared->running) > 0)
+		fibril_yield();
+
+	bool ret = true;
+	for (size_t i = 0; i < readers; i++) {
+		if (shared->reads[i] == 0) {
+			ret = bench_run_fail(run,
+			    "reader %zu starved (writer got %" PRIu64
+			    " locks, gave up %" PRIu64 " times)",
+			    i, shared->writes, shared->write_timeouts);
+			break;
+		}
+	}
+
+	free(shared);
+	return ret;
+}
+
+benchmark_t benchmark_fibril_rwlock = {
+	.name = "fibril_rwlock",
+	.desc = "Reader-heavy rwlock contention with a timed writer (use 'readers' param to alter the default).",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
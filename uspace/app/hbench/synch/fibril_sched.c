@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Scaling benchmarks for the fibril scheduler. The number of runner
+ * threads is given by the "runners" parameter (1 to 8).
+ *
+ * fibril_yield keeps two fibrils per runner busy calling fibril_yield(),
+ * so every runner always has a ready fibril in its queue.
+ *
+ * fibril_wakeup runs one pair of fibrils per runner. The two fibrils
+ * of a pair hand a token back and forth over two semaphores, so every
+ * iteration is one blocking wait and one wakeup.
+ */
+
+#define DEFAULT_RUNNERS 4
+#define MAX_RUNNERS 8
+
+#define YIELDERS_PER_RUNNER 2
+
+typedef struct {
+	fibril_semaphore_t done;
+	uint64_t iterations;
+	atomic_bool failed;
+} shared_t;
+
+typedef struct {
+	shared_t *shared;
+	fibril_semaphore_t ping;
+	fibril_semaphore_t pong;
+} pair_t;
+
+static bool get_runners(bench_env_t *env, bench_run_t *run, size_t *runners)
+{
+	const char *runners_str = bench_env_param_get(env, "runners", NULL);
+	*runners = DEFAULT_RUNNERS;
+	if (runners_str != NULL) {
+		if (str_size_t(runners_str, NULL, 10, true, runners) != EOK ||
+		    *runners == 0 || *runners > MAX_RUNNERS) {
+			return bench_run_fail(run,
+			    "invalid runner count '%s' (expected 1-%d)",
+			    runners_str, MAX_RUNNERS);
+		}
+	}
+
+	if (bench_runners_ensure(*runners) < *runners)
+		return bench_run_fail(run, "failed to spawn %zu runners", *runners);
+
+	return true;
+}
+
+static bool start(shared_t *shared, errno_t (*fn)(void *), void *arg)
+{
+	fid_t fid = fibril_create(fn, arg);
+	if (fid == 0) {
+		atomic_store(&shared->failed, true);
+		return false;
+	}
+
+	fibril_add_ready(fid);
+	return true;
+}
+
+static errno_t yielder(void *arg)
+{
+	shared_t *shared = arg;
+	fibril_detach(fibril_get_id());
+
+	for (uint64_t i = 0; i < shared->iterations; i++)
+		fibril_yield();
+
+	fibril_semaphore_up(&shared->done);
+	return EOK;
+}
+
+static bool yield_runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	size_t runners;
+	if (!get_runners(env, run, &runners))
+		return false;
+
+	size_t workers = runners * YIELDERS_PER_RUNNER;
+
+	shared_t shared;
+	fibril_semaphore_initialize(&shared.done, 0);
+	shared.iterations = niter / workers + 1;
+	atomic_store(&shared.failed, false);
+
+	bench_run_start(run);
+
+	size_t started = 0;
+	while (started < workers && start(&shared, yielder, &shared))
+		started++;
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&shared.done);
+
+	bench_run_stop(run);
+
+	if (atomic_load(&shared.failed))
+		return bench_run_fail(run, "failed to create a fibril");
+
+	return true;
+}
+
+static errno_t pinger(void *arg)
+{
+	pair_t *pair = arg;
+	fibril_detach(fibril_get_id());
+
+	for (uint64_t i = 0; i < pair->shared->iterations; i++) {
+		fibril_semaphore_up(&pair->pong);
+		fibril_semaphore_down(&pair->ping);
+	}
+
+	fibril_semaphore_up(&pair->shared->done);
+	return EOK;
+}
+
+static errno_t ponger(void *arg)
+{
+	pair_t *pair = arg;
+	fibril_detach(fibril_get_id());
+
+	for (uint64_t i = 0; i < pair->shared->iterations; i++) {
+		fibril_semaphore_down(&pair->pong);
+		fibril_semaphore_up(&pair->ping);
+	}
+
+	fibril_semaphore_up(&pair->shared->done);
+	return EOK;
+}
+
+static bool wakeup_runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	size_t runners;
+	if (!get_runners(env, run, &runners))
+		return false;
+
+	shared_t shared;
+	fibril_semaphore_initialize(&shared.done, 0);
+	shared.iterations = niter / runners + 1;
+	atomic_store(&shared.failed, false);
+
+	pair_t pairs[MAX_RUNNERS];
+
+	bench_run_start(run);
+
+	size_t started = 0;
+	for (size_t i = 0; i < runners; i++) {
+		pairs[i].shared = &shared;
+		fibril_semaphore_initialize(&pairs[i].ping, 0);
+		fibril_semaphore_initialize(&pairs[i].pong, 0);
+
+		/* A pair is only useful as a whole. */
+		if (!start(&shared, ponger, &pairs[i]))
+			break;
+		started++;
+		if (!start(&shared, pinger, &pairs[i])) {
+			/* Let the lone ponger finish. */
+			for (uint64_t j = 0; j < shared.iterations; j++)
+				fibril_semaphore_up(&pairs[i].pong);
+			break;
+		}
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&shared.done);
+
+	bench_run_stop(run);
+
+	if (atomic_load(&shared.failed))
+		return bench_run_fail(run, "failed to create a fibril");
+
+	return true;
+}
+
+benchmark_t benchmark_fibril_yield = {
+	.name = "fibril_yield",
+	.desc = "Speed of fibril_yield() with one or more runner threads",
+	.entry = &yield_runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_fibril_wakeup = {
+	.name = "fibril_wakeup",
+	.desc = "Speed of fibril block/wakeup with one or more runner threads",
+	.entry = &wakeup_runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <as.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Cost of timed waits with many timeouts outstanding. The number of
+ * outstanding timeouts is given by the "timeouts" parameter. That many
+ * fibrils are parked in a timed wait which does not expire during the
+ * run, then two fibrils hand a token back and forth with timed waits
+ * that expire after all the parked ones. Every iteration thus registers
+ * and cancels one timeout behind all those outstanding.
+ */
+
+#define DEFAULT_TIMEOUTS 100000
+#define MAX_TIMEOUTS 1000000
+
+/** Parked fibrils only ever wait, so they make do with a small stack. */
+#define PARKED_STACK_SIZE (4 * PAGE_SIZE)
+
+/** Timeouts of the parked fibrils (1 hour). */
+#define PARKED_TIMEOUT (3600LL * 1000000)
+
+/** Timeouts of the measured waits, later than all the parked ones. */
+#define WAIT_TIMEOUT (2 * PARKED_TIMEOUT)
+
+typedef struct {
+	fibril_semaphore_t park;
+	fibril_semaphore_t released;
+	atomic_size_t parked;
+
+	fibril_semaphore_t ping;
+	fibril_semaphore_t pong;
+	uint64_t iterations;
+	atomic_bool timed_out;
+} shared_t;
+
+static errno_t parked(void *arg)
+{
+	shared_t *shared = arg;
+	fibril_detach(fibril_get_id());
+
+	atomic_fetch_add(&shared->parked, 1);
+	if (fibril_semaphore_down_timeout(&shared->park, PARKED_TIMEOUT) != EOK)
+		atomic_store(&shared->timed_out, true);
+
+	fibril_semaphore_up(&shared->released);
+	return EOK;
+}
+
+static errno_t ponger(void *arg)
+{
+	shared_t *shared = arg;
+	fibril_detach(fibril_get_id());
+
+	for (uint64_t i = 0; i < shared->iterations; i++) {
+		if (fibril_semaphore_down_timeout(&shared->pong,
+		    WAIT_TIMEOUT) != EOK)
+			atomic_store(&shared->timed_out, true);
+		fibril_semaphore_up(&shared->ping);
+	}
+
+	fibril_semaphore_up(&shared->released);
+	return EOK;
+}
+
+static void release(shared_t *shared, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		fibril_semaphore_up(&shared->park);
+
+	for (size_t i = 0; i < count; i++)
+		fibril_semaphore_down(&shared->released);
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	const char *timeouts_str = bench_env_param_get(env, "timeouts", NULL);
+	size_t timeouts = DEFAULT_TIMEOUTS;
+	if (timeouts_str != NULL) {
+		if (str_size_t(timeouts_str, NULL, 10, true, &timeouts) != EOK ||
+		    timeouts > MAX_TIMEOUTS) {
+			return bench_run_fail(run,
+			    "invalid timeout count '%s' (expected 0-%d)",
+			    timeouts_str, MAX_TIMEOUTS);
+		}
+	}
+
+	shared_t shared;
+	fibril_semaphore_initialize(&shared.park, 0);
+	fibril_semaphore_initialize(&shared.released, 0);
+	atomic_store(&shared.parked, 0);
+	fibril_semaphore_initialize(&shared.ping, 0);
+	fibril_semaphore_initialize(&shared.pong, 0);
+	shared.iterations = niter;
+	atomic_store(&shared.timed_out, false);
+
+	size_t started = 0;
+	while (started < timeouts) {
+		fid_t fid = fibril_create_generic(parked, &shared,
+		    PARKED_STACK_SIZE);
+		if (fid == 0)
+			break;
+
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	if (started < timeouts) {
+		release(&shared, started);
+		return bench_run_fail(run, "failed to create fibril %zu",
+		    started);
+	}
+
+	/* Let all parked fibrils reach their timed wait. */
+	while (atomic_load(&shared.parked) < started)
+		fibril_yield();
+	fibril_yield();
+
+	fid_t fid = fibril_create(ponger, &shared);
+	if (fid == 0) {
+		release(&shared, started);
+		return bench_run_fail(run, "failed to create a fibril");
+	}
+
+	fibril_add_ready(fid);
+
+	bench_run_start(run);
+
+	for (uint64_t i = 0; i < niter; i++) {
+		fibril_semaphore_up(&shared.pong);
+		if (fibril_semaphore_down_timeout(&shared.ping,
+		    WAIT_TIMEOUT) != EOK)
+			atomic_store(&shared.timed_out, true);
+	}
+
+	bench_run_stop(run);
+
+	/* The ponger signals released as well. */
+	release(&shared, started);
+	fibril_semaphore_down(&shared.released);
+
+	if (atomic_load(&shared.timed_out))
+		return bench_run_fail(run, "a wait timed out");
+
+	return true;
+}
+
+benchmark_t benchmark_fibril_timeout = {
+	.name = "fibril_timeout",
+	.desc = "Speed of timed fibril waits with many timeouts outstanding",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -33,10 +33,14 @@
  * @file
  */
 
+#include <fibril.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include "hbench.h"
 
+/** Number of runner threads of this task, including the main one. */
+static size_t runners = 1;
+
 /** Initialize bench run structure.
  *
  * @param run Structure to intialize.
@@ -75,5 +79,21 @@ bool bench_run_fail(bench_run_t *run, const char *fmt, ...)
 	return false;
 }
 
+/** Make sure the task has at least the given number of runner threads.
+ *
+ * Runners cannot be stopped, so only the missing ones are spawned and
+ * benchmarks that ask for fewer runners afterwards get more of them.
+ *
+ * @param count Requested number of runners, including the main thread.
+ * @return Number of runners the task has now.
+ */
+size_t bench_runners_ensure(size_t count)
+{
+	if (count > runners)
+		runners += fibril_test_spawn_runners(count - runners);
+
+	return runners;
+}
+
 /** @}
  */
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Measures how the parallel algorithms from <execution> scale with the
+ * number of workers. Every algorithm runs over a vector of 10^7 elements
+ * once sequentially and then with 1 to N workers (N defaults to the number
+ * of CPUs), the speedup is reported relative to the sequential run.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t default_size = 10'000'000;
+
+    using clock = std::chrono::steady_clock;
+    using data_t = std::vector<std::uint64_t>;
+
+    struct benchmark
+    {
+        const char* name;
+        void (*run_seq)(data_t&, data_t&);
+        void (*run_par)(data_t&, data_t&);
+    };
+
+    /**
+     * Keeps the compiler from optimizing
+     * out the results of reductions.
+     */
+    volatile std::uint64_t sink{};
+
+    const benchmark benchmarks[] = {
+        {
+            "fill",
+            [](data_t& in, data_t&) {
+                std::fill(std::execution::seq, in.begin(), in.end(), 42);
+            },
+            [](data_t& in, data_t&) {
+                std::fill(std::execution::par, in.begin(), in.end(), 42);
+            }
+        },
+        {
+            "copy",
+            [](data_t& in, data_t& out) {
+                std::copy(std::execution::seq, in.begin(), in.end(), out.begin());
+            },
+            [](data_t& in, data_t& out) {
+                std::copy(std::execution::par, in.begin(), in.end(), out.begin());
+            }
+        },
+        {
+            "for_each",
+            [](data_t& in, data_t&) {
+                std::for_each(std::execution::seq, in.begin(), in.end(),
+                              [](auto& x) { x = x * 2654435761u + 1; });
+            },
+            [](data_t& in, data_t&) {
+                std::for_each(std::execution::par, in.begin(), in.end(),
+                              [](auto& x) { x = x * 2654435761u + 1; });
+            }
+        },
+        {
+            "transform",
+            [](data_t& in, data_t& out) {
+                std::transform(std::execution::seq, in.begin(), in.end(), out.begin(),
+                               [](auto x) { return x ^ (x >> 7); });
+            },
+            [](data_t& in, data_t& out) {
+                std::transform(std::execution::par, in.begin(), in.end(), out.begin(),
+                               [](auto x) { return x ^ (x >> 7); });
+            }
+        },
+        {
+            "reduce",
+            [](data_t& in, data_t&) {
+                sink = std::reduce(std::execution::seq, in.begin(), in.end());
+            },
+            [](data_t& in, data_t&) {
+                sink = std::reduce(std::execution::par, in.begin(), in.end());
+            }
+        },
+        {
+            "transform_reduce",
+            [](data_t& in, data_t& out) {
+                sink = std::transform_reduce(std::execution::seq, in.begin(),
+                                             in.end(), out.begin(), std::uint64_t{});
+            },
+            [](data_t& in, data_t& out) {
+                sink = std::transform_reduce(std::execution::par, in.begin(),
+                                             in.end(), out.begin(), std::uint64_t{});
+            }
+        },
+        {
+            "inclusive_scan",
+            [](data_t& in, data_t& out) {
+                std::inclusive_scan(std::execution::seq, in.begin(), in.end(), out.begin());
+            },
+            [](data_t& in, data_t& out) {
+                std::inclusive_scan(std::execution::par, in.begin(), in.end(), out.begin());
+            }
+        },
+        {
+            "sort",
+            [](data_t& in, data_t& out) {
+                std::copy(in.begin(), in.end(), out.begin());
+                std::sort(std::execution::seq, out.begin(), out.end());
+            },
+            [](data_t& in, data_t& out) {
+                std::copy(in.begin(), in.end(), out.begin());
+                std::sort(std::execution::par, out.begin(), out.end());
+            }
+        }
+    };
+
+    void reset(data_t& data)
+    {
+        std::uint64_t state{88172645463325252ull};
+        for (auto& x: data)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            x = state;
+        }
+    }
+
+    std::int64_t measure(void (*fn)(data_t&, data_t&), data_t& in, data_t& out)
+    {
+        reset(in);
+
+        auto start = clock::now();
+        fn(in, out);
+        auto end = clock::now();
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    }
+
+    void usage()
+    {
+        std::printf("Usage: parbench [-n <elements>] [-w <max workers>]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t size = default_size;
+    std::size_t max_workers = std::thread::hardware_concurrency();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            size = ::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+            max_workers = ::strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (size == 0 || max_workers == 0)
+    {
+        std::printf("Number of elements and workers must be positive.\n");
+        return 1;
+    }
+
+    data_t in(size);
+    data_t out(size);
+
+    std::printf("%zu elements, up to %zu workers\n", size, max_workers);
+    std::printf("%-18s %8s %12s %8s\n", "algorithm", "workers", "time [us]", "speedup");
+
+    for (const auto& bench: benchmarks)
+    {
+        auto seq = measure(bench.run_seq, in, out);
+        std::printf("%-18s %8s %12lld %8s\n", bench.name, "seq",
+                    static_cast<long long>(seq), "1.00");
+
+        for (std::size_t workers = 1; workers <= max_workers; ++workers)
+        {
+            std::experimental::set_parallel_concurrency(workers);
+
+            auto par = measure(bench.run_par, in, out);
+            auto speedup = par > 0 ? (seq * 100) / par : 0;
+
+            std::printf("%-18s %8zu %12lld %5lld.%02lld\n", bench.name, workers,
+                        static_cast<long long>(par),
+                        static_cast<long long>(speedup / 100),
+                        static_cast<long long>(speedup % 100));
+        }
+    }
+
+    std::experimental::set_parallel_concurrency(0);
+
+    return 0;
+}
@@ -186,6 +186,80 @@ static void print_load(void)
 	free(load);
 }
 
+static void print_memory(void)
+{
+	stats_physmem_t *physmem = stats_get_physmem();
+	if (physmem == NULL) {
+		fprintf(stderr, "%s: Unable to get memory statistics\n", NAME);
+		return;
+	}
+
+	uint64_t total, used, avail;
+	const char *total_suffix, *used_suffix, *avail_suffix;
+
+	bin_order_suffix(physmem->total, &total, &total_suffix, false);
+	bin_order_suffix(physmem->used, &used, &used_suffix, false);
+	bin_order_suffix(physmem->free, &avail, &avail_suffix, false);
+
+	printf("%s: Memory: %" PRIu64 "%s total, %" PRIu64 "%s used, "
+	    "%" PRIu64 "%s free\n", NAME, total, total_suffix, used,
+	    used_suffix, avail, avail_suffix);
+
+	free(physmem);
+
+	stats_frames_t *frames = stats_get_frames();
+	if (frames == NULL) {
+		fprintf(stderr, "%s: Unable to get frame statistics\n", NAME);
+		return;
+	}
+
+	printf("[order] [free blocks] [free frames]\n");
+
+	uint64_t free_frames = 0;
+	unsigned int largest = 0;
+
+	for (unsigned int order = 0; order < STATS_FRAME_ORDERS; order++) {
+		if (frames->free_blocks[order] == 0)
+			continue;
+
+		uint64_t count = frames->free_blocks[order] << order;
+
+		printf("%-7u %13" PRIu64 " %13" PRIu64 "\n", order,
+		    frames->free_blocks[order], count);
+
+		free_frames += count;
+		largest = order;
+	}
+
+	/*
+	 * Fragmentation is the share of free frames which are not
+	 * part of a block of the largest available order.
+	 */
+	if (free_frames > 0) {
+		uint64_t frag = free_frames -
+		    (frames->free_blocks[largest] << largest);
+
+		printf("%s: Fragmentation: %" PRIu64 "%% of free frames below "
+		    "order %u\n", NAME, frag * 100 / free_frames, largest);
+	}
+
+	printf("%s: Cached frames: %" PRIu64 "\n", NAME, frames->cached);
+
+	if (frames->cache_allocs > 0) {
+		printf("%s: CPU cache allocations: %" PRIu64 ", %" PRIu64
+		    " cycles on average\n", NAME, frames->cache_allocs,
+		    frames->cache_cycles / frames->cache_allocs);
+	}
+
+	if (frames->zone_allocs > 0) {
+		printf("%s: Zone allocations: %" PRIu64 ", %" PRIu64
+		    " cycles on average\n", NAME, frames->zone_allocs,
+		    frames->zone_cycles / frames->zone_allocs);
+	}
+
+	free(frames);
+}
+
 static void print_uptime(void)
 {
 	struct timespec uptime;
@@ -199,7 +273,7 @@ static void print_uptime(void)
 static void usage(const char *name)
 {
 	printf(
-	    "Usage: %s [-t task_id] [-a] [-c] [-l] [-u]\n"
+	    "Usage: %s [-t task_id] [-a] [-c] [-l] [-m] [-u]\n"
 	    "\n"
 	    "Options:\n"
 	    "\t-t task_id\n"
@@ -218,6 +292,10 @@ static void usage(const char *name)
 	    "\t--load\n"
 	    "\t\tPrint system load\n"
 	    "\n"
+	    "\t-m\n"
+	    "\t--memory\n"
+	    "\t\tPrint physical memory and frame allocator statistics\n"
+	    "\n"
 	    "\t-u\n"
 	    "\t--uptime\n"
 	    "\t\tPrint system uptime\n"
@@ -237,6 +315,7 @@ int main(int argc, char *argv[])
 	bool toggle_all = false;
 	bool toggle_cpus = false;
 	bool toggle_load = false;
+	bool toggle_memory = false;
 	bool toggle_uptime = false;
 
 	task_id_t task_id = 0;
@@ -290,6 +369,13 @@ int main(int argc, char *argv[])
 			continue;
 		}
 
+		/* Memory */
+		if ((off = arg_parse_short_long(argv[i], "-m", "--memory")) != -1) {
+			toggle_tasks = false;
+			toggle_memory = true;
+			continue;
+		}
+
 		/* Uptime */
 		if ((off = arg_parse_short_long(argv[i], "-u", "--uptime")) != -1) {
 			toggle_tasks = false;
@@ -310,6 +396,9 @@ int main(int argc, char *argv[])
 	if (toggle_load)
 		print_load();
 
+	if (toggle_memory)
+		print_memory();
+
 	if (toggle_uptime)
 		print_uptime();
 
@@ -239,6 +239,22 @@ static inline void print_thread_summary(data_t *data)
 	screen_newline();
 }
 
+static inline void print_sched_info(stats_cpu_t *cpu, perc_cpu_t *perc)
+{
+	printf("      dispatches: %" PRIu64 ", migrations: %" PRIu64,
+	    perc->dispatches, perc->migrations);
+
+	/* Waits are shown in microseconds when the frequency is known. */
+	if (cpu->frequency_mhz != 0) {
+		printf(", avg wait: %" PRIu64 " us, max wait: %" PRIu64 " us",
+		    perc->wait_cycles / cpu->frequency_mhz,
+		    cpu->max_wait_cycles / cpu->frequency_mhz);
+	} else {
+		printf(", avg wait: %" PRIu64 " cycles, max wait: %" PRIu64
+		    " cycles", perc->wait_cycles, cpu->max_wait_cycles);
+	}
+}
+
 static inline void print_cpu_info(data_t *data)
 {
 	size_t i;
@@ -260,6 +276,9 @@ static inline void print_cpu_info(data_t *data)
 			print_percent(data->cpus_perc[i].idle, 2);
 			fputs(", busy: ", stdout);
 			print_percent(data->cpus_perc[i].busy, 2);
+			screen_newline();
+
+			print_sched_info(&data->cpus[i], &data->cpus_perc[i]);
 		} else
 			printf("cpu%u inactive", data->cpus[i].id);
 
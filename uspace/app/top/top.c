@@ -261,6 +261,18 @@ static void compute_percentages(data_t *old_data, data_t *new_data)
 
 		FRACTION_TO_FLOAT(new_data->cpus_perc[i].idle, idle * 100, sum);
 		FRACTION_TO_FLOAT(new_data->cpus_perc[i].busy, busy * 100, sum);
+
+		/* Scheduler activity during the interval */
+		uint64_t dispatches =
+		    new_data->cpus[i].dispatches - old_data->cpus[i].dispatches;
+		uint64_t wait =
+		    new_data->cpus[i].wait_cycles - old_data->cpus[i].wait_cycles;
+
+		new_data->cpus_perc[i].dispatches = dispatches;
+		new_data->cpus_perc[i].migrations =
+		    new_data->cpus[i].migrations - old_data->cpus[i].migrations;
+		new_data->cpus_perc[i].wait_cycles =
+		    (dispatches > 0) ? wait / dispatches : 0;
 	}
 
 	/* For all tasks compute sum and differencies of all cycles */
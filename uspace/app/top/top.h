@@ -65,6 +65,9 @@ typedef struct {
 typedef struct {
 	fixed_float idle;
 	fixed_float busy;
+	uint64_t dispatches;
+	uint64_t migrations;
+	uint64_t wait_cycles;
 } perc_cpu_t;
 
 typedef struct {
@@ -0,0 +1,735 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ */
+
+/*
+ * This is an implementation of a concurrent resizable chained hash table.
+ *
+ * Lookups do not lock. They run in read sections, which only announce
+ * themselves in one of the reader counters of the current grace period.
+ * Removed items are passed to remove_callback() in batches once the
+ * grace period of their removal has ended, i.e. once no read section
+ * which could still see them is running.
+ *
+ * Insertions and removals lock the stripe of the bucket. The number of
+ * buckets is a power of two and at least CHT_STRIPES, so all items of
+ * a bucket share the stripe both before and after the table is resized.
+ *
+ * Resizing does not rehash the whole table at once. A new bucket array
+ * replaces the current one and the insertions and removals which follow
+ * move the items of the old array over a few buckets at a time. Until
+ * then lookups search both arrays. Moving items may make a concurrent
+ * lookup miss the rest of a bucket, so unsuccessful lookups are retried
+ * if move_seq changed in the meantime.
+ */
+
+#include <adt/cht.h>
+#include <adt/hash.h>
+#include <assert.h>
+#include <fibril.h>
+#include <stdlib.h>
+
+/* Initial and minimal bucket count. Must be a power of two and at least CHT_STRIPES. */
+#define CHT_MIN_BUCKETS  64
+/* The table is resized when the average load per bucket exceeds this number. */
+#define CHT_MAX_LOAD  2
+/* Number of buckets moved to the new bucket array by an insertion or removal. */
+#define CHT_MOVE_STEP  4
+/* Number of removed items after which the end of a grace period is awaited. */
+#define CHT_RETIRE_BATCH  32
+
+static void resize_step(cht_t *, size_t);
+static void retire(cht_t *, cht_link_t *);
+
+/* Dummy do nothing callback to invoke in place of remove_callback == NULL. */
+static void nop_remove_callback(cht_link_t *item)
+{
+	/* no-op */
+}
+
+/** Allocates an empty bucket array. */
+static cht_buckets_t *alloc_buckets(size_t bucket_cnt)
+{
+	assert(CHT_MIN_BUCKETS <= bucket_cnt);
+	assert((bucket_cnt & (bucket_cnt - 1)) == 0);
+
+	cht_buckets_t *b = malloc(sizeof(cht_buckets_t) +
+	    bucket_cnt * sizeof(b->bucket[0]));
+	if (!b)
+		return NULL;
+
+	b->bucket_cnt = bucket_cnt;
+	for (size_t i = 0; i < bucket_cnt; i++)
+		atomic_init(&b->bucket[i], NULL);
+
+	return b;
+}
+
+static size_t item_hash(cht_t *h, const cht_link_t *item)
+{
+	return hash_mix(h->op->hash(item));
+}
+
+static size_t key_hash(cht_t *h, const void *key)
+{
+	return hash_mix(h->op->key_hash(key));
+}
+
+static _Atomic(cht_link_t *) *bucket_head(cht_buckets_t *b, size_t hash)
+{
+	return &b->bucket[hash & (b->bucket_cnt - 1)];
+}
+
+/** Lock the stripe of the buckets of a hash. */
+static void stripe_lock(cht_t *h, size_t hash)
+{
+	atomic_bool *lock = &h->stripe[hash & (CHT_STRIPES - 1)];
+
+	while (atomic_exchange_explicit(lock, true, memory_order_acquire)) {
+		/* The holder runs on another thread. */
+		while (atomic_load_explicit(lock, memory_order_relaxed))
+			fibril_yield();
+	}
+}
+
+static void stripe_unlock(cht_t *h, size_t hash)
+{
+	atomic_store_explicit(&h->stripe[hash & (CHT_STRIPES - 1)], false,
+	    memory_order_release);
+}
+
+/** Start moving items between the bucket arrays. */
+static void move_begin(cht_t *h)
+{
+	size_t seq = atomic_load_explicit(&h->move_seq, memory_order_relaxed);
+	atomic_store_explicit(&h->move_seq, seq + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+}
+
+static void move_end(cht_t *h)
+{
+	size_t seq = atomic_load_explicit(&h->move_seq, memory_order_relaxed);
+	atomic_store_explicit(&h->move_seq, seq + 1, memory_order_release);
+}
+
+/** Create concurrent hash table.
+ *
+ * @param h         Hash table structure. Will be initialized by this call.
+ * @param init_size Initial desired number of hash table buckets. Pass zero
+ *                  if you want the default initial size.
+ * @param max_load  The table is resized when the average load per bucket
+ *                  exceeds this number. Pass zero if you want the default.
+ * @param op        Hash table operations structure. remove_callback()
+ *                  is optional and can be NULL if no action is to be taken
+ *                  upon removal. equal() is optional if and only if
+ *                  cht_insert_unique() will never be invoked.
+ *                  All other operations are mandatory.
+ *
+ * @return True on success
+ *
+ */
+bool cht_create(cht_t *h, size_t init_size, size_t max_load, cht_ops_t *op)
+{
+	assert(h);
+	assert(op && op->hash && op->key_hash && op->key_equal);
+
+	/* Check for compulsory ops. */
+	if (!op || !op->hash || !op->key_hash || !op->key_equal)
+		return false;
+
+	size_t bucket_cnt = CHT_MIN_BUCKETS;
+	while (bucket_cnt < init_size)
+		bucket_cnt *= 2;
+
+	cht_buckets_t *b = alloc_buckets(bucket_cnt);
+	if (!b)
+		return false;
+
+	h->op = op;
+	atomic_init(&h->cur, b);
+	atomic_init(&h->old, NULL);
+	h->moved_cnt = 0;
+	atomic_init(&h->move_seq, 0);
+	atomic_init(&h->resizing, false);
+	atomic_init(&h->item_cnt, 0);
+	h->max_load = (max_load == 0) ? CHT_MAX_LOAD : max_load;
+
+	for (size_t i = 0; i < CHT_STRIPES; i++)
+		atomic_init(&h->stripe[i], false);
+
+	atomic_init(&h->epoch, 0);
+	for (size_t i = 0; i < CHT_READER_SLOTS; i++) {
+		atomic_init(&h->readers[0][i].cnt, 0);
+		atomic_init(&h->readers[1][i].cnt, 0);
+	}
+
+	fibril_mutex_initialize(&h->retire_lock);
+	h->retired = NULL;
+	h->retired_cnt = 0;
+
+	if (h->op->remove_callback == NULL)
+		h->op->remove_callback = nop_remove_callback;
+
+	return true;
+}
+
+/** Destroy a concurrent hash table instance.
+ *
+ * remove_callback() is called for all items still in the table. The
+ * table must not be used concurrently any longer.
+ *
+ * @param h Hash table to be destroyed.
+ *
+ */
+void cht_destroy(cht_t *h)
+{
+	assert(h);
+
+	cht_synchronize(h);
+
+	cht_buckets_t *arrays[] = {
+		atomic_load(&h->cur),
+		atomic_load(&h->old)
+	};
+
+	for (size_t a = 0; a < sizeof(arrays) / sizeof(arrays[0]); a++) {
+		cht_buckets_t *b = arrays[a];
+		if (!b)
+			continue;
+
+		for (size_t i = 0; i < b->bucket_cnt; i++) {
+			cht_link_t *item = atomic_load(&b->bucket[i]);
+			while (item) {
+				cht_link_t *next = atomic_load(&item->next);
+				h->op->remove_callback(item);
+				item = next;
+			}
+		}
+
+		free(b);
+	}
+
+	atomic_store(&h->cur, NULL);
+	atomic_store(&h->old, NULL);
+}
+
+/** Returns the number of items in the table. */
+size_t cht_size(cht_t *h)
+{
+	return atomic_load_explicit(&h->item_cnt, memory_order_relaxed);
+}
+
+/** Enter a read section.
+ *
+ * Items found by cht_find() may be used until the end of the read
+ * section. Read sections must be short and must not block. They must not
+ * contain calls to the functions modifying the table, which wait for
+ * the read sections running.
+ *
+ * @param h  Hash table.
+ * @param rd Read section structure, passed to cht_read_unlock().
+ *
+ */
+void cht_read_lock(cht_t *h, cht_read_t *rd)
+{
+	size_t slot = hash_mix((size_t) fibril_get_id()) % CHT_READER_SLOTS;
+
+	while (true) {
+		size_t epoch = atomic_load(&h->epoch);
+		atomic_size_t *cnt = &h->readers[epoch & 1][slot].cnt;
+
+		atomic_fetch_add(cnt, 1);
+
+		/* A new grace period may have started in the meantime. */
+		if (atomic_load(&h->epoch) == epoch) {
+			rd->cnt = cnt;
+			return;
+		}
+
+		atomic_fetch_sub(cnt, 1);
+	}
+}
+
+/** Leave a read section.
+ *
+ * @param h  Hash table.
+ * @param rd Read section structure filled in by cht_read_lock().
+ *
+ */
+void cht_read_unlock(cht_t *h, cht_read_t *rd)
+{
+	atomic_fetch_sub_explicit(rd->cnt, 1, memory_order_release);
+}
+
+/** Wait for the end of the read sections running.
+ *
+ * Must be called with retire_lock held.
+ *
+ */
+static void wait_readers(cht_t *h)
+{
+	size_t epoch = atomic_load(&h->epoch);
+	atomic_store(&h->epoch, epoch + 1);
+
+	/*
+	 * The read sections entered from now on count themselves in the other
+	 * counters. Those counting themselves in the counters of the previous
+	 * grace period have been waited for by the previous call.
+	 */
+	for (size_t i = 0; i < CHT_READER_SLOTS; i++) {
+		while (atomic_load(&h->readers[epoch & 1][i].cnt) != 0)
+			fibril_yield();
+	}
+}
+
+/** Pass a list of retired items to remove_callback(). */
+static void release_retired(cht_t *h, cht_link_t *item)
+{
+	while (item) {
+		cht_link_t *next = item->retired;
+		h->op->remove_callback(item);
+		item = next;
+	}
+}
+
+/** Remove retired items once no read section can reference them.
+ *
+ * Waits for the read sections running and passes all items removed
+ * before to remove_callback(). Must not be called in a read section.
+ *
+ * @param h Hash table.
+ *
+ */
+void cht_synchronize(cht_t *h)
+{
+	fibril_mutex_lock(&h->retire_lock);
+
+	cht_link_t *retired = h->retired;
+	h->retired = NULL;
+	h->retired_cnt = 0;
+
+	wait_readers(h);
+
+	fibril_mutex_unlock(&h->retire_lock);
+
+	release_retired(h, retired);
+}
+
+/** Hand a removed item over to remove_callback() when safe. */
+static void retire(cht_t *h, cht_link_t *item)
+{
+	fibril_mutex_lock(&h->retire_lock);
+
+	item->retired = h->retired;
+	h->retired = item;
+
+	if (++h->retired_cnt < CHT_RETIRE_BATCH) {
+		fibril_mutex_unlock(&h->retire_lock);
+		return;
+	}
+
+	cht_link_t *retired = h->retired;
+	h->retired = NULL;
+	h->retired_cnt = 0;
+
+	wait_readers(h);
+
+	fibril_mutex_unlock(&h->retire_lock);
+
+	release_retired(h, retired);
+}
+
+/** Search a bucket of a bucket array for an item matching the key. */
+static cht_link_t *bucket_find(cht_t *h, cht_buckets_t *b, size_t hash,
+    const void *key)
+{
+	cht_link_t *item = atomic_load_explicit(bucket_head(b, hash),
+	    memory_order_acquire);
+
+	while (item) {
+		if (h->op->key_equal(key, item))
+			return item;
+
+		item = atomic_load_explicit(&item->next, memory_order_acquire);
+	}
+
+	return NULL;
+}
+
+/** Search hash table for an item matching the key.
+ *
+ * Must be called in a read section.
+ *
+ * @param h   Hash table.
+ * @param key Key to look for.
+ *
+ * @return Matching item on success, NULL if there is no such item.
+ *
+ */
+cht_link_t *cht_find(cht_t *h, const void *key)
+{
+	assert(h);
+
+	size_t hash = key_hash(h, key);
+
+	while (true) {
+		size_t seq = atomic_load_explicit(&h->move_seq,
+		    memory_order_acquire);
+		if (seq & 1)
+			continue;
+
+		cht_buckets_t *cur = atomic_load_explicit(&h->cur,
+		    memory_order_acquire);
+		cht_link_t *item = bucket_find(h, cur, hash, key);
+		if (item)
+			return item;
+
+		cht_buckets_t *old = atomic_load_explicit(&h->old,
+		    memory_order_acquire);
+		if (old) {
+			item = bucket_find(h, old, hash, key);
+			if (item)
+				return item;
+		}
+
+		/* The item may have been moved past us. */
+		atomic_thread_fence(memory_order_acquire);
+		if (atomic_load_explicit(&h->move_seq,
+		    memory_order_relaxed) == seq)
+			return NULL;
+	}
+}
+
+/** Link an item to its bucket of the current array.
+ *
+ * Must be called with the stripe of the item locked.
+ *
+ */
+static void bucket_push(cht_t *h, size_t hash, cht_link_t *item)
+{
+	cht_buckets_t *cur = atomic_load_explicit(&h->cur,
+	    memory_order_acquire);
+	_Atomic(cht_link_t *) *head = bucket_head(cur, hash);
+
+	atomic_store_explicit(&item->next,
+	    atomic_load_explicit(head, memory_order_relaxed),
+	    memory_order_relaxed);
+	atomic_store_explicit(head, item, memory_order_release);
+}
+
+/** Insert item into a concurrent hash table.
+ *
+ * @param h    Hash table.
+ * @param item Item to be inserted into the hash table.
+ */
+void cht_insert(cht_t *h, cht_link_t *item)
+{
+	assert(item);
+	assert(h);
+
+	size_t hash = item_hash(h, item);
+
+	stripe_lock(h, hash);
+	bucket_push(h, hash, item);
+	stripe_unlock(h, hash);
+
+	resize_step(h, atomic_fetch_add_explicit(&h->item_cnt, 1,
+	    memory_order_relaxed) + 1);
+}
+
+/** Check a bucket for an item equal to item. */
+static bool bucket_contains(cht_t *h, cht_buckets_t *b, size_t hash,
+    cht_link_t *item)
+{
+	cht_link_t *cur = atomic_load_explicit(bucket_head(b, hash),
+	    memory_order_relaxed);
+
+	while (cur) {
+		if (h->op->equal(cur, item))
+			return true;
+
+		cur = atomic_load_explicit(&cur->next, memory_order_relaxed);
+	}
+
+	return false;
+}
+
+/** Insert item into a concurrent hash table if not already present.
+ *
+ * @param h    Hash table.
+ * @param item Item to be inserted into the hash table.
+ *
+ * @return False if such an item had already been inserted.
+ * @return True if the inserted item was the only item with such a lookup key.
+ */
+bool cht_insert_unique(cht_t *h, cht_link_t *item)
+{
+	assert(item);
+	assert(h && h->op->equal);
+
+	size_t hash = item_hash(h, item);
+	cht_read_t rd;
+
+	/* The read section keeps the old array from being freed. */
+	cht_read_lock(h, &rd);
+	stripe_lock(h, hash);
+
+	/* The stripe lock keeps the items from moving. */
+	cht_buckets_t *cur = atomic_load_explicit(&h->cur,
+	    memory_order_acquire);
+	cht_buckets_t *old = atomic_load_explicit(&h->old,
+	    memory_order_acquire);
+
+	if (bucket_contains(h, cur, hash, item) ||
+	    (old && bucket_contains(h, old, hash, item))) {
+		stripe_unlock(h, hash);
+		cht_read_unlock(h, &rd);
+		return false;
+	}
+
+	bucket_push(h, hash, item);
+	stripe_unlock(h, hash);
+	cht_read_unlock(h, &rd);
+
+	resize_step(h, atomic_fetch_add_explicit(&h->item_cnt, 1,
+	    memory_order_relaxed) + 1);
+	return true;
+}
+
+/** Unlink matching items from a bucket.
+ *
+ * Must be called with the stripe of the bucket locked. The unlinked
+ * items are chained through their retired links.
+ *
+ * @param key  Key of the items to unlink or NULL.
+ * @param item Item to unlink if key is NULL.
+ *
+ * @return Number of unlinked items.
+ *
+ */
+static size_t bucket_unlink(cht_t *h, cht_buckets_t *b, size_t hash,
+    const void *key, cht_link_t *item, cht_link_t **unlinked)
+{
+	_Atomic(cht_link_t *) *prev = bucket_head(b, hash);
+	cht_link_t *cur = atomic_load_explicit(prev, memory_order_relaxed);
+	size_t removed = 0;
+
+	while (cur) {
+		cht_link_t *next = atomic_load_explicit(&cur->next,
+		    memory_order_relaxed);
+
+		if (key ? h->op->key_equal(key, cur) : cur == item) {
+			/* Readers at cur still continue to next. */
+			atomic_store_explicit(prev, next, memory_order_release);
+			cur->retired = *unlinked;
+			*unlinked = cur;
+			removed++;
+		} else {
+			prev = &cur->next;
+		}
+
+		cur = next;
+	}
+
+	return removed;
+}
+
+/** Unlink matching items from both bucket arrays and retire them. */
+static size_t remove_matching(cht_t *h, size_t hash, const void *key,
+    cht_link_t *item)
+{
+	cht_link_t *unlinked = NULL;
+	cht_read_t rd;
+
+	/* The read section keeps the old array from being freed. */
+	cht_read_lock(h, &rd);
+	stripe_lock(h, hash);
+
+	cht_buckets_t *cur = atomic_load_explicit(&h->cur,
+	    memory_order_acquire);
+	cht_buckets_t *old = atomic_load_explicit(&h->old,
+	    memory_order_acquire);
+
+	size_t removed = bucket_unlink(h, cur, hash, key, item, &unlinked);
+	if (old)
+		removed += bucket_unlink(h, old, hash, key, item, &unlinked);
+
+	stripe_unlock(h, hash);
+	cht_read_unlock(h, &rd);
+
+	if (removed == 0)
+		return 0;
+
+	size_t cnt = atomic_fetch_sub_explicit(&h->item_cnt, removed,
+	    memory_order_relaxed) - removed;
+
+	while (unlinked) {
+		cht_link_t *next = unlinked->retired;
+		retire(h, unlinked);
+		unlinked = next;
+	}
+
+	resize_step(h, cnt);
+	return removed;
+}
+
+/** Remove all matching items from hash table.
+ *
+ * For each removed item, remove_callback() is called once no read
+ * section can reference it any longer. Must not be called in a read
+ * section.
+ *
+ * @param h    Hash table.
+ * @param key  Key that will be compared against items of the hash table.
+ *
+ * @return Returns the number of removed items.
+ */
+size_t cht_remove(cht_t *h, const void *key)
+{
+	assert(h);
+
+	return remove_matching(h, key_hash(h, key), key, NULL);
+}
+
+/** Removes an item already present in the table. The item must be in the table.*/
+void cht_remove_item(cht_t *h, cht_link_t *item)
+{
+	assert(item);
+	assert(h);
+
+	size_t removed = remove_matching(h, item_hash(h, item), NULL, item);
+	assert(removed == 1);
+	(void) removed;
+}
+
+/** Move the items of a bucket of the old array to the current one. */
+static void move_bucket(cht_t *h, cht_buckets_t *old, cht_buckets_t *cur,
+    size_t idx)
+{
+	_Atomic(cht_link_t *) *head = &old->bucket[idx];
+
+	stripe_lock(h, idx);
+	move_begin(h);
+
+	cht_link_t *item = atomic_load_explicit(head, memory_order_relaxed);
+	while (item) {
+		cht_link_t *next = atomic_load_explicit(&item->next,
+		    memory_order_relaxed);
+		_Atomic(cht_link_t *) *new_head =
+		    bucket_head(cur, item_hash(h, item));
+
+		atomic_store_explicit(&item->next,
+		    atomic_load_explicit(new_head, memory_order_relaxed),
+		    memory_order_relaxed);
+		atomic_store_explicit(new_head, item, memory_order_release);
+		atomic_store_explicit(head, next, memory_order_release);
+
+		item = next;
+	}
+
+	move_end(h);
+	stripe_unlock(h, idx);
+}
+
+/** Start resizing the table if needed and move a few buckets.
+ *
+ * @param h        Hash table.
+ * @param item_cnt Number of items after the modification.
+ *
+ */
+static void resize_step(cht_t *h, size_t item_cnt)
+{
+	/* Somebody else is already at it. */
+	if (atomic_exchange_explicit(&h->resizing, true, memory_order_acquire))
+		return;
+
+	cht_buckets_t *cur = atomic_load_explicit(&h->cur,
+	    memory_order_relaxed);
+	cht_buckets_t *old = atomic_load_explicit(&h->old,
+	    memory_order_relaxed);
+
+	if (!old) {
+		size_t new_cnt = 0;
+
+		if (h->max_load * cur->bucket_cnt < item_cnt)
+			new_cnt = 2 * cur->bucket_cnt;
+		else if (item_cnt <= h->max_load * cur->bucket_cnt / 4 &&
+		    CHT_MIN_BUCKETS < cur->bucket_cnt)
+			new_cnt = cur->bucket_cnt / 2;
+
+		cht_buckets_t *b = NULL;
+		if (new_cnt != 0)
+			b = alloc_buckets(new_cnt);
+
+		/* Leave the table as is if we cannot resize. */
+		if (!b) {
+			atomic_store_explicit(&h->resizing, false,
+			    memory_order_release);
+			return;
+		}
+
+		move_begin(h);
+		atomic_store_explicit(&h->old, cur, memory_order_release);
+		atomic_store_explicit(&h->cur, b, memory_order_release);
+		move_end(h);
+
+		h->moved_cnt = 0;
+		old = cur;
+		cur = b;
+	}
+
+	for (size_t i = 0; i < CHT_MOVE_STEP && h->moved_cnt < old->bucket_cnt;
+	    i++)
+		move_bucket(h, old, cur, h->moved_cnt++);
+
+	if (h->moved_cnt < old->bucket_cnt) {
+		atomic_store_explicit(&h->resizing, false, memory_order_release);
+		return;
+	}
+
+	move_begin(h);
+	atomic_store_explicit(&h->old, NULL, memory_order_release);
+	move_end(h);
+
+	atomic_store_explicit(&h->resizing, false, memory_order_release);
+
+	/* Read sections may still be searching the old array. */
+	fibril_mutex_lock(&h->retire_lock);
+	wait_readers(h);
+	fibril_mutex_unlock(&h->retire_lock);
+
+	free(old);
+}
+
+/** @}
+ */
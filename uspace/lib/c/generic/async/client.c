@@ -123,6 +123,17 @@
 
 static fibril_rmutex_t message_mutex;
 
+/** Maximum number of outgoing calls submitted by one syscall. */
+#define ASYNC_SEND_BATCH  8
+
+/** Calls sent by a fibril which were not submitted to the kernel yet. */
+typedef struct {
+	size_t count;
+	ipc_batch_call_t calls[ASYNC_SEND_BATCH];
+} async_send_queue_t;
+
+static fibril_local async_send_queue_t send_queue;
+
 /** Naming service session */
 async_sess_t session_ns;
 
@@ -136,6 +147,10 @@ typedef struct {
 	/** If the message / reply should be discarded on arrival. */
 	bool forget;
 
+	/** Completion callback registered by async_wait_callback(). */
+	async_reply_cb_t callback;
+	void *callback_arg;
+
 	/** Pointer to where the answer data is stored. */
 	ipc_call_t *dataptr;
 
@@ -195,6 +210,37 @@ void __async_client_fini(void)
 	fibril_rmutex_destroy(&message_mutex);
 }
 
+/** Complete a message.
+ *
+ * @param msg    Message to complete.
+ * @param retval Return value of the message.
+ * @param data   Call data of the answer or NULL if there is none.
+ *
+ */
+static void amsg_complete(amsg_t *msg, errno_t retval, ipc_call_t *data)
+{
+	fibril_rmutex_lock(&message_mutex);
+
+	msg->retval = retval;
+
+	/* Copy data inside lock, just in case the call was detached */
+	if ((msg->dataptr) && (data))
+		*msg->dataptr = *data;
+
+	msg->done = true;
+
+	if (msg->callback) {
+		msg->callback(msg->callback_arg, msg->retval);
+		amsg_destroy(msg);
+	} else if (msg->forget) {
+		amsg_destroy(msg);
+	} else {
+		fibril_notify(&msg->received);
+	}
+
+	fibril_rmutex_unlock(&message_mutex);
+}
+
 /** Reply received callback.
  *
  * This function is called whenever a reply for an asynchronous message sent out
@@ -213,23 +259,82 @@ void async_reply_received(ipc_call_t *data)
 	if (!msg)
 		return;
 
-	fibril_rmutex_lock(&message_mutex);
+	amsg_complete(msg, ipc_get_retval(data), data);
+}
 
-	msg->retval = ipc_get_retval(data);
+/** Queue a call sent by the current fibril.
+ *
+ * The queued calls are submitted to the kernel together, once the queue
+ * is full or once the fibril blocks, yields or otherwise makes IPC.
+ *
+ * @param phone   Phone to make the call over.
+ * @param imethod Service-defined interface and method.
+ * @param arg1    Service-defined payload argument.
+ * @param arg2    Service-defined payload argument.
+ * @param arg3    Service-defined payload argument.
+ * @param arg4    Service-defined payload argument.
+ * @param arg5    Service-defined payload argument.
+ * @param msg     Message record of the call.
+ *
+ */
+static void async_send_queue(cap_phone_handle_t phone, sysarg_t imethod,
+    sysarg_t arg1, sysarg_t arg2, sysarg_t arg3, sysarg_t arg4, sysarg_t arg5,
+    amsg_t *msg)
+{
+	if (send_queue.count == ASYNC_SEND_BATCH)
+		async_flush();
 
-	/* Copy data inside lock, just in case the call was detached */
-	if ((msg->dataptr) && (data))
-		*msg->dataptr = *data;
+	ipc_batch_call_t *call = &send_queue.calls[send_queue.count++];
 
-	msg->done = true;
+	call->phone = phone;
+	call->label = (sysarg_t) msg;
+	call->args[0] = imethod;
+	call->args[1] = arg1;
+	call->args[2] = arg2;
+	call->args[3] = arg3;
+	call->args[4] = arg4;
+	call->args[5] = arg5;
+}
 
-	if (msg->forget) {
-		amsg_destroy(msg);
-	} else {
-		fibril_notify(&msg->received);
-	}
+/** Submit the calls queued by the current fibril to the kernel.
+ *
+ * This happens implicitly whenever the fibril waits, yields, exits,
+ * ends an exchange or answers or forwards a call, so that the order
+ * of its IPC is preserved.
+ *
+ */
+void async_flush(void)
+{
+	size_t count = send_queue.count;
+	size_t done = 0;
+
+	/* Completions below must not see the calls again. */
+	send_queue.count = 0;
+
+	while (done < count) {
+		ipc_batch_call_t *call = &send_queue.calls[done];
+		size_t submitted;
+		errno_t rc;
+
+		if (count - done == 1) {
+			rc = ipc_call_async_slow(call->phone, call->args[0],
+			    call->args[1], call->args[2], call->args[3],
+			    call->args[4], call->args[5], (void *) call->label);
+			submitted = (rc == EOK) ? 1 : 0;
+		} else {
+			rc = ipc_call_async_batch(call, count - done,
+			    &submitted);
+		}
 
-	fibril_rmutex_unlock(&message_mutex);
+		done += submitted;
+
+		if (rc != EOK) {
+			/* The call which failed is answered right away. */
+			amsg_complete((amsg_t *) send_queue.calls[done].label,
+			    rc, NULL);
+			done++;
+		}
+	}
 }
 
 /** Send message and return id of the sent message.
@@ -260,12 +365,7 @@ static aid_t async_send_fast(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1
 
 	msg->dataptr = dataptr;
 
-	errno_t rc = ipc_call_async_4(exch->phone, imethod, arg1, arg2, arg3,
-	    arg4, msg);
-	if (rc != EOK) {
-		msg->retval = rc;
-		msg->done = true;
-	}
+	async_send_queue(exch->phone, imethod, arg1, arg2, arg3, arg4, 0, msg);
 
 	return (aid_t) msg;
 }
@@ -301,12 +401,8 @@ static aid_t async_send_slow(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1
 
 	msg->dataptr = dataptr;
 
-	errno_t rc = ipc_call_async_5(exch->phone, imethod, arg1, arg2, arg3,
-	    arg4, arg5, msg);
-	if (rc != EOK) {
-		msg->retval = rc;
-		msg->done = true;
-	}
+	async_send_queue(exch->phone, imethod, arg1, arg2, arg3, arg4, arg5,
+	    msg);
 
 	return (aid_t) msg;
 }
@@ -448,6 +544,47 @@ void async_forget(aid_t amsgid)
 	fibril_rmutex_unlock(&message_mutex);
 }
 
+/** Get notified about the reply instead of waiting for it.
+ *
+ * Instead of blocking a fibril in async_wait_for(), the caller registers
+ * a callback which is invoked with the return value of the answer once it
+ * arrives (or immediately if it already has). The message is destroyed
+ * after the callback returns, so it is not allowed to call
+ * async_wait_for(), async_wait_timeout() or async_forget() on it
+ * afterwards.
+ *
+ * The callback runs with a restricted mutex held and therefore must not
+ * block. It is meant to hand the result over, e.g. via mpsc_send().
+ *
+ * @param amsgid Hash of the message.
+ * @param cb     Callback to invoke on completion.
+ * @param arg    Argument passed to the callback.
+ */
+void async_wait_callback(aid_t amsgid, async_reply_cb_t cb, void *arg)
+{
+	if (amsgid == 0) {
+		cb(arg, ENOMEM);
+		return;
+	}
+
+	amsg_t *msg = (amsg_t *) amsgid;
+
+	assert(!msg->forget);
+	assert(!msg->callback);
+
+	fibril_rmutex_lock(&message_mutex);
+
+	if (msg->done) {
+		cb(arg, msg->retval);
+		amsg_destroy(msg);
+	} else {
+		msg->callback = cb;
+		msg->callback_arg = arg;
+	}
+
+	fibril_rmutex_unlock(&message_mutex);
+}
+
 /** Pseudo-synchronous message sending - fast version.
  *
  * Send message asynchronously and return only after the reply arrives.
@@ -736,44 +873,56 @@ errno_t async_req_5_5(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1, sysar
 
 void async_msg_0(async_exch_t *exch, sysarg_t imethod)
 {
-	if (exch != NULL)
+	if (exch != NULL) {
+		async_flush();
 		ipc_call_async_0(exch->phone, imethod, NULL);
+	}
 }
 
 void async_msg_1(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1)
 {
-	if (exch != NULL)
+	if (exch != NULL) {
+		async_flush();
 		ipc_call_async_1(exch->phone, imethod, arg1, NULL);
+	}
 }
 
 void async_msg_2(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1,
     sysarg_t arg2)
 {
-	if (exch != NULL)
+	if (exch != NULL) {
+		async_flush();
 		ipc_call_async_2(exch->phone, imethod, arg1, arg2, NULL);
+	}
 }
 
 void async_msg_3(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1,
     sysarg_t arg2, sysarg_t arg3)
 {
-	if (exch != NULL)
+	if (exch != NULL) {
+		async_flush();
 		ipc_call_async_3(exch->phone, imethod, arg1, arg2, arg3, NULL);
+	}
 }
 
 void async_msg_4(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1,
     sysarg_t arg2, sysarg_t arg3, sysarg_t arg4)
 {
-	if (exch != NULL)
+	if (exch != NULL) {
+		async_flush();
 		ipc_call_async_4(exch->phone, imethod, arg1, arg2, arg3, arg4,
 		    NULL);
+	}
 }
 
 void async_msg_5(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1,
     sysarg_t arg2, sysarg_t arg3, sysarg_t arg4, sysarg_t arg5)
 {
-	if (exch != NULL)
+	if (exch != NULL) {
+		async_flush();
 		ipc_call_async_5(exch->phone, imethod, arg1, arg2, arg3, arg4,
 		    arg5, NULL);
+	}
 }
 
 static errno_t async_connect_me_to_internal(cap_phone_handle_t phone,
@@ -792,6 +941,8 @@ static errno_t async_connect_me_to_internal(cap_phone_handle_t phone,
 
 	msg->dataptr = &result;
 
+	async_flush();
+
 	errno_t rc = ipc_call_async_4(phone, IPC_M_CONNECT_ME_TO,
 	    (sysarg_t) iface, arg2, arg3, flags, msg);
 	if (rc != EOK) {
@@ -957,6 +1108,7 @@ async_sess_t *async_connect_kbox(task_id_t id)
 
 static errno_t async_hangup_internal(cap_phone_handle_t phone)
 {
+	async_flush();
 	return ipc_hangup(phone);
 }
 
@@ -1109,6 +1261,9 @@ void async_exchange_end(async_exch_t *exch)
 	if (exch == NULL)
 		return;
 
+	/* The calls of the exchange must not mix with those of the next one. */
+	async_flush();
+
 	async_sess_t *sess = exch->sess;
 	assert(sess != NULL);
 
@@ -109,6 +109,7 @@
 #include <adt/list.h>
 #include <assert.h>
 #include <errno.h>
+#include <stdatomic.h>
 #include <time.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -159,19 +160,42 @@ typedef struct {
 	void *data;
 } connection_t;
 
-/* Member of notification_t::msg_list. */
+/** Number of pending notifications of one method.
+ *
+ * Further notifications of the method are coalesced with the pending ones
+ * until the handler catches up.
+ */
+#define NOTIFICATION_RING  32
+
+/** Notification methods per chunk of the method table. */
+#define NOTIFICATION_CHUNK  64
+
+/** Maximum number of chunks of the method table. */
+#define NOTIFICATION_CHUNKS  64
+
+/* Member of notification_t::msgs. */
 typedef struct {
-	link_t link;
+	/** Position in the ring for which the slot is free or ready. */
+	atomic_size_t seq;
 	ipc_call_t calldata;
 } notification_msg_t;
 
+/* Link of notification_queue. */
+typedef struct notification_link {
+	_Atomic(struct notification_link *) next;
+} notification_link_t;
+
 /* Notification data */
 typedef struct {
-	/** notification_hash_table link */
-	ht_link_t htlink;
-
 	/** notification_queue link */
-	link_t qlink;
+	notification_link_t qlink;
+
+	/**
+	 * Set while the notification is in notification_queue or while
+	 * a handler fibril takes care of it. The handlers of one method
+	 * thus never run concurrently.
+	 */
+	atomic_bool queued;
 
 	/** Notification method */
 	sysarg_t imethod;
@@ -182,10 +206,21 @@ typedef struct {
 	/** Notification handler argument */
 	void *arg;
 
-	/** List of arrived notifications. */
-	list_t msg_list;
+	/** Position of the next free slot of msgs. */
+	atomic_size_t head;
+
+	/** Position of the oldest pending slot, used by the handler fibril. */
+	size_t tail;
+
+	/** Ring of arrived notifications. */
+	notification_msg_t msgs[NOTIFICATION_RING];
 } notification_t;
 
+/* Chunk of the notification method table. */
+typedef struct {
+	_Atomic(notification_t *) notifications[NOTIFICATION_CHUNK];
+} notification_chunk_t;
+
 /** Identifier of the incoming connection handled by the current fibril. */
 static fibril_local connection_t *fibril_connection;
 
@@ -218,16 +253,20 @@ void async_set_client_data_destructor(async_client_data_dtor_t dtor)
 static fibril_rmutex_t client_mutex;
 static hash_table_t client_hash_table;
 
-// TODO: lockfree notification_queue?
+/*
+ * Notifications are queued without locking since they are received by
+ * any of the runner threads. notification_queue is an intrusive
+ * multi-producer single-consumer queue, notification_consumer_mutex
+ * serializes the handler fibrils removing from it.
+ */
 static fibril_rmutex_t notification_mutex;
-static hash_table_t notification_hash_table;
-static LIST_INITIALIZE(notification_queue);
+static fibril_rmutex_t notification_consumer_mutex;
+static _Atomic(notification_chunk_t *) notification_chunks[NOTIFICATION_CHUNKS];
+static notification_link_t notification_stub;
+static _Atomic(notification_link_t *) notification_queue_head = &notification_stub;
+static notification_link_t *notification_queue_tail = &notification_stub;
 static FIBRIL_SEMAPHORE_INITIALIZE(notification_semaphore, 0);
 
-static LIST_INITIALIZE(notification_freelist);
-static long notification_freelist_total = 0;
-static long notification_freelist_used = 0;
-
 static sysarg_t notification_avail = 0;
 
 static size_t client_key_hash(const void *key)
@@ -489,35 +528,95 @@ errno_t async_create_callback_port(async_exch_t *exch, iface_t iface, sysarg_t a
 	return EOK;
 }
 
-static size_t notification_key_hash(const void *key)
+/** Find the notification structure of a method.
+ *
+ * @param imethod Notification method.
+ *
+ * @return The notification structure or NULL if there is none.
+ *
+ */
+static notification_t *notification_find(sysarg_t imethod)
+{
+	if (imethod >= NOTIFICATION_CHUNK * NOTIFICATION_CHUNKS)
+		return NULL;
+
+	notification_chunk_t *chunk = atomic_load_explicit(
+	    &notification_chunks[imethod / NOTIFICATION_CHUNK],
+	    memory_order_acquire);
+	if (!chunk)
+		return NULL;
+
+	return atomic_load_explicit(
+	    &chunk->notifications[imethod % NOTIFICATION_CHUNK],
+	    memory_order_acquire);
+}
+
+/** Append a notification to notification_queue.
+ *
+ * Can be called concurrently from any number of fibrils.
+ *
+ */
+static void notification_queue_push(notification_link_t *link)
 {
-	const sysarg_t *id = key;
-	return *id;
+	atomic_store_explicit(&link->next, NULL, memory_order_relaxed);
+	notification_link_t *prev = atomic_exchange_explicit(
+	    &notification_queue_head, link, memory_order_acq_rel);
+	atomic_store_explicit(&prev->next, link, memory_order_release);
 }
 
-static size_t notification_hash(const ht_link_t *item)
+/** Remove the first notification from notification_queue.
+ *
+ * Must be called with notification_consumer_mutex held.
+ *
+ * @return The first notification or NULL if the queue is empty or if
+ *         a concurrent append has not linked its item yet.
+ *
+ */
+static notification_t *notification_queue_pop(void)
 {
-	notification_t *notification =
-	    hash_table_get_inst(item, notification_t, htlink);
-	return notification_key_hash(&notification->imethod);
+	notification_link_t *tail = notification_queue_tail;
+	notification_link_t *next =
+	    atomic_load_explicit(&tail->next, memory_order_acquire);
+
+	if (tail == &notification_stub) {
+		if (!next)
+			return NULL;
+
+		notification_queue_tail = next;
+		tail = next;
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+	}
+
+	if (!next) {
+		if (tail != atomic_load_explicit(&notification_queue_head,
+		    memory_order_acquire))
+			return NULL;
+
+		/* Keep the queue non-empty when taking the last item. */
+		notification_queue_push(&notification_stub);
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+		if (!next)
+			return NULL;
+	}
+
+	notification_queue_tail = next;
+	return member_to_inst(tail, notification_t, qlink);
 }
 
-static bool notification_key_equal(const void *key, const ht_link_t *item)
+/** Queue a notification to be taken care of by a handler fibril. */
+static void notification_enqueue(notification_t *notification)
 {
-	const sysarg_t *id = key;
-	notification_t *notification =
-	    hash_table_get_inst(item, notification_t, htlink);
-	return *id == notification->imethod;
+	notification_queue_push(&notification->qlink);
+	fibril_semaphore_up(&notification_semaphore);
 }
 
-/** Operations for the notification hash table. */
-static hash_table_ops_t notification_hash_table_ops = {
-	.hash = notification_hash,
-	.key_hash = notification_key_hash,
-	.key_equal = notification_key_equal,
-	.equal = NULL,
-	.remove_callback = NULL
-};
+/** Check whether the oldest pending notification of a method arrived. */
+static bool notification_pending(notification_t *notification)
+{
+	size_t pos = notification->tail;
+	return atomic_load(&notification->msgs[pos % NOTIFICATION_RING].seq) ==
+	    pos + 1;
+}
 
 /** Try to route a call to an appropriate connection fibril.
  *
@@ -565,46 +664,56 @@ static errno_t notification_fibril_func(void *arg)
 	while (true) {
 		fibril_semaphore_down(&notification_semaphore);
 
-		fibril_rmutex_lock(&notification_mutex);
-
 		/*
-		 * The semaphore ensures that if we get this far,
-		 * the queue must be non-empty.
+		 * The semaphore ensures that if we get this far, the queue
+		 * is non-empty. It may only take a moment for a concurrent
+		 * append to become visible.
 		 */
-		assert(!list_empty(&notification_queue));
-
-		notification_t *notification = list_get_instance(
-		    list_first(&notification_queue), notification_t, qlink);
-
-		async_notification_handler_t handler = notification->handler;
-		void *arg = notification->arg;
+		notification_t *notification;
+		while (true) {
+			fibril_rmutex_lock(&notification_consumer_mutex);
+			notification = notification_queue_pop();
+			fibril_rmutex_unlock(&notification_consumer_mutex);
 
-		notification_msg_t *m = list_pop(&notification->msg_list,
-		    notification_msg_t, link);
-		assert(m);
-		ipc_call_t calldata = m->calldata;
+			if (notification)
+				break;
 
-		notification_freelist_used--;
-
-		if (notification_freelist_total > 64 &&
-		    notification_freelist_total > 2 * notification_freelist_used) {
-			/* Going to free the structure if we have too much. */
-			notification_freelist_total--;
-		} else {
-			/* Otherwise add to freelist. */
-			list_append(&m->link, &notification_freelist);
-			m = NULL;
+			fibril_yield();
 		}
 
-		if (list_empty(&notification->msg_list))
-			list_remove(&notification->qlink);
+		/*
+		 * The slot may still be being filled in, in which case its
+		 * producer queues the notification again once it is done.
+		 */
+		if (notification_pending(notification)) {
+			size_t pos = notification->tail;
+			notification_msg_t *m =
+			    &notification->msgs[pos % NOTIFICATION_RING];
+			ipc_call_t calldata = m->calldata;
+
+			atomic_store_explicit(&m->seq, pos + NOTIFICATION_RING,
+			    memory_order_release);
+			notification->tail = pos + 1;
+
+			if (notification->handler)
+				notification->handler(&calldata, notification->arg);
+		}
 
-		fibril_rmutex_unlock(&notification_mutex);
+		/*
+		 * Queue the notification again if more have arrived in the
+		 * meantime. Their producers saw the queued flag set and left
+		 * that to us.
+		 */
+		if (notification_pending(notification)) {
+			notification_enqueue(notification);
+			continue;
+		}
 
-		if (handler)
-			handler(&calldata, arg);
+		atomic_store(&notification->queued, false);
 
-		free(m);
+		if (notification_pending(notification) &&
+		    !atomic_exchange(&notification->queued, true))
+			notification_enqueue(notification);
 	}
 
 	/* Not reached. */
@@ -630,55 +739,81 @@ errno_t async_spawn_notification_handler(void)
 }
 
 /** Queue notification.
+ *
+ * The notification is stored into a free slot of its method without
+ * locking. If all slots of the method are taken because the handler
+ * cannot keep up, the notification is coalesced with the pending ones,
+ * i.e. the handler is called only for those.
  *
  * @param call   Data of the incoming call.
  *
+ * @return EOK if the notification was queued.
+ * @return EBUSY if the notification was coalesced.
+ * @return ENOENT if there is no notification with the method.
+ *
  */
-static void queue_notification(ipc_call_t *call)
+static errno_t queue_notification(ipc_call_t *call)
 {
 	assert(call);
 
-	fibril_rmutex_lock(&notification_mutex);
+	notification_t *notification = notification_find(ipc_get_imethod(call));
+	if (!notification) {
+		/* Invalid notification. */
+		// TODO: Make sure this can't happen and turn it into assert.
+		return ENOENT;
+	}
 
-	notification_msg_t *m = list_pop(&notification_freelist,
-	    notification_msg_t, link);
+	errno_t rc = EBUSY;
+	size_t pos = atomic_load_explicit(&notification->head,
+	    memory_order_relaxed);
 
-	if (!m) {
-		fibril_rmutex_unlock(&notification_mutex);
-		m = malloc(sizeof(notification_msg_t));
-		if (!m) {
-			DPRINTF("Out of memory.\n");
-			abort();
+	while (true) {
+		notification_msg_t *m =
+		    &notification->msgs[pos % NOTIFICATION_RING];
+		size_t seq = atomic_load_explicit(&m->seq, memory_order_acquire);
+
+		if (seq == pos) {
+			if (!atomic_compare_exchange_weak_explicit(
+			    &notification->head, &pos, pos + 1,
+			    memory_order_relaxed, memory_order_relaxed))
+				continue;
+
+			m->calldata = *call;
+			atomic_store_explicit(&m->seq, pos + 1,
+			    memory_order_release);
+			rc = EOK;
+			break;
 		}
 
-		fibril_rmutex_lock(&notification_mutex);
-		notification_freelist_total++;
-	}
+		/* All slots are pending. */
+		if ((ssize_t) (seq - pos) < 0)
+			break;
 
-	sysarg_t imethod = ipc_get_imethod(call);
-	ht_link_t *link = hash_table_find(&notification_hash_table, &imethod);
-	if (!link) {
-		/* Invalid notification. */
-		// TODO: Make sure this can't happen and turn it into assert.
-		notification_freelist_total--;
-		fibril_rmutex_unlock(&notification_mutex);
-		free(m);
-		return;
+		pos = atomic_load_explicit(&notification->head,
+		    memory_order_relaxed);
 	}
 
-	notification_t *notification =
-	    hash_table_get_inst(link, notification_t, htlink);
+	if (!atomic_exchange(&notification->queued, true))
+		notification_enqueue(notification);
 
-	notification_freelist_used++;
-	m->calldata = *call;
-	list_append(&m->link, &notification->msg_list);
-
-	if (!link_in_use(&notification->qlink))
-		list_append(&notification->qlink, &notification_queue);
-
-	fibril_rmutex_unlock(&notification_mutex);
+	return rc;
+}
 
-	fibril_semaphore_up(&notification_semaphore);
+/** Queue a notification generated in userspace.
+ *
+ * The notification is handled like one sent by the kernel. This can be
+ * used to emulate a notification source, e.g. for benchmarking.
+ *
+ * @param call  Notification data, the method selects the handler.
+ *
+ * @return EOK if the notification was queued.
+ * @return EBUSY if the notification was coalesced with pending ones.
+ * @return ENOENT if there is no notification with the method.
+ *
+ */
+errno_t async_notification_post(ipc_call_t *call)
+{
+	return queue_notification(call);
 }
 
 /**
@@ -697,27 +832,53 @@ static notification_t *notification_create(async_notification_handler_t handler,
 	notification->handler = handler;
 	notification->arg = arg;
 
-	list_initialize(&notification->msg_list);
+	for (size_t i = 0; i < NOTIFICATION_RING; i++)
+		atomic_init(&notification->msgs[i].seq, i);
 
 	fid_t fib = 0;
 
 	fibril_rmutex_lock(&notification_mutex);
 
-	if (notification_avail == 0) {
+	sysarg_t imethod = notification_avail;
+	if (imethod >= NOTIFICATION_CHUNK * NOTIFICATION_CHUNKS) {
+		fibril_rmutex_unlock(&notification_mutex);
+		free(notification);
+		return NULL;
+	}
+
+	notification_chunk_t *new_chunk = NULL;
+	notification_chunk_t *chunk = atomic_load_explicit(
+	    &notification_chunks[imethod / NOTIFICATION_CHUNK],
+	    memory_order_relaxed);
+	if (!chunk) {
+		new_chunk = calloc(1, sizeof(notification_chunk_t));
+		if (!new_chunk) {
+			fibril_rmutex_unlock(&notification_mutex);
+			free(notification);
+			return NULL;
+		}
+
+		chunk = new_chunk;
+	}
+
+	if (imethod == 0) {
 		/* Attempt to create the first handler fibril. */
 		fib = fibril_create(notification_fibril_func, NULL);
 		if (fib == 0) {
 			fibril_rmutex_unlock(&notification_mutex);
+			free(new_chunk);
 			free(notification);
 			return NULL;
 		}
 	}
 
-	sysarg_t imethod = notification_avail;
 	notification_avail++;
-
 	notification->imethod = imethod;
-	hash_table_insert(&notification_hash_table, &notification->htlink);
+
+	atomic_store_explicit(&chunk->notifications[imethod % NOTIFICATION_CHUNK],
+	    notification, memory_order_release);
+	atomic_store_explicit(&notification_chunks[imethod / NOTIFICATION_CHUNK],
+	    chunk, memory_order_release);
 
 	fibril_rmutex_unlock(&notification_mutex);
 
@@ -810,6 +971,28 @@ errno_t async_event_task_subscribe(event_task_type_t evno,
 	return ipc_event_task_subscribe(evno, notification->imethod);
 }
 
+/** Register a notification handler without a kernel notification source.
+ *
+ * The notifications are generated by async_notification_post().
+ *
+ * @param handler      Notification handler.
+ * @param data         Notification handler client data.
+ * @param[out] imethod Method of the notifications.
+ *
+ * @return Zero on success or an error code.
+ *
+ */
+errno_t async_notification_create(async_notification_handler_t handler,
+    void *data, sysarg_t *imethod)
+{
+	notification_t *notification = notification_create(handler, data);
+	if (!notification)
+		return ENOMEM;
+
+	*imethod = notification->imethod;
+	return EOK;
+}
+
 /** Unmask event notifications.
  *
  * @param evno Event type to unmask.
@@ -937,7 +1120,7 @@ static void handle_call(ipc_call_t *call)
 	if (call->cap_handle == CAP_NIL) {
 		if (call->flags & IPC_CALL_NOTIF) {
 			/* Kernel notification */
-			queue_notification(call);
+			(void) queue_notification(call);
 		}
 		return;
 	}
@@ -1023,12 +1206,10 @@ void __async_server_init(void)
 		abort();
 	if (fibril_rmutex_initialize(&notification_mutex) != EOK)
 		abort();
-
-	if (!hash_table_create(&client_hash_table, 0, 0, &client_hash_table_ops))
+	if (fibril_rmutex_initialize(&notification_consumer_mutex) != EOK)
 		abort();
 
-	if (!hash_table_create(&notification_hash_table, 0, 0,
-	    &notification_hash_table_ops))
+	if (!hash_table_create(&client_hash_table, 0, 0, &client_hash_table_ops))
 		abort();
 
 	async_create_manager();
@@ -1038,6 +1219,7 @@ void __async_server_fini(void)
 {
 	fibril_rmutex_destroy(&client_mutex);
 	fibril_rmutex_destroy(&notification_mutex);
+	fibril_rmutex_destroy(&notification_consumer_mutex);
 }
 
 errno_t async_accept_0(ipc_call_t *call)
@@ -1045,6 +1227,7 @@ errno_t async_accept_0(ipc_call_t *call)
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_5(chandle, EOK, 0, 0, 0, 0, async_get_label());
 }
 
@@ -1053,6 +1236,7 @@ errno_t async_answer_0(ipc_call_t *call, errno_t retval)
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_0(chandle, retval);
 }
 
@@ -1061,6 +1245,7 @@ errno_t async_answer_1(ipc_call_t *call, errno_t retval, sysarg_t arg1)
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_1(chandle, retval, arg1);
 }
 
@@ -1070,6 +1255,7 @@ errno_t async_answer_2(ipc_call_t *call, errno_t retval, sysarg_t arg1,
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_2(chandle, retval, arg1, arg2);
 }
 
@@ -1079,6 +1265,7 @@ errno_t async_answer_3(ipc_call_t *call, errno_t retval, sysarg_t arg1,
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_3(chandle, retval, arg1, arg2, arg3);
 }
 
@@ -1088,6 +1275,7 @@ errno_t async_answer_4(ipc_call_t *call, errno_t retval, sysarg_t arg1,
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_4(chandle, retval, arg1, arg2, arg3, arg4);
 }
 
@@ -1097,6 +1285,7 @@ errno_t async_answer_5(ipc_call_t *call, errno_t retval, sysarg_t arg1,
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
+	async_flush();
 	return ipc_answer_5(chandle, retval, arg1, arg2, arg3, arg4, arg5);
 }
 
@@ -1112,6 +1301,7 @@ static errno_t async_forward_fast(ipc_call_t *call, async_exch_t *exch,
 	if (exch == NULL)
 		return ENOENT;
 
+	async_flush();
 	return ipc_forward_fast(chandle, exch->phone, imethod, arg1, arg2,
 	    mode);
 }
@@ -1129,6 +1319,7 @@ static errno_t async_forward_slow(ipc_call_t *call, async_exch_t *exch,
 	if (exch == NULL)
 		return ENOENT;
 
+	async_flush();
 	return ipc_forward_slow(chandle, exch->phone, imethod, arg1, arg2, arg3,
 	    arg4, arg5, mode);
 }
@@ -1248,6 +1439,7 @@ errno_t async_share_in_finalize(ipc_call_t *call, void *src, unsigned int flags)
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
 
+	async_flush();
 	return ipc_answer_2(chandle, EOK, (sysarg_t) src, (sysarg_t) flags);
 }
 
@@ -1304,6 +1496,7 @@ errno_t async_share_out_finalize(ipc_call_t *call, void **dst)
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
 
+	async_flush();
 	return ipc_answer_2(chandle, EOK, (sysarg_t) __progsymbols.end,
 	    (sysarg_t) dst);
 }
@@ -1359,6 +1552,7 @@ errno_t async_data_read_finalize(ipc_call_t *call, const void *src, size_t size)
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
 
+	async_flush();
 	return ipc_answer_2(chandle, EOK, (sysarg_t) src, (sysarg_t) size);
 }
 
@@ -1385,6 +1579,7 @@ static errno_t async_data_read_forward_fast(async_exch_t *exch, sysarg_t imethod
 		return EINVAL;
 	}
 
+	async_flush();
 	errno_t retval = ipc_forward_fast(call.cap_handle, exch->phone, 0, 0, 0,
 	    IPC_FF_ROUTE_FROM_ME);
 	if (retval != EOK) {
@@ -1630,6 +1825,7 @@ static errno_t async_data_write_forward_fast(async_exch_t *exch,
 		return EINVAL;
 	}
 
+	async_flush();
 	errno_t retval = ipc_forward_fast(call.cap_handle, exch->phone, 0, 0, 0,
 	    IPC_FF_ROUTE_FROM_ME);
 	if (retval != EOK) {
@@ -109,6 +109,26 @@ errno_t ipc_call_async_slow(cap_phone_handle_t phandle, sysarg_t imethod,
 	    (sysarg_t) label);
 }
 
+/** Make a batch of asynchronous calls.
+ *
+ * The calls are made in the order of the array. If a call cannot be made,
+ * the calls after it are not made either.
+ *
+ * @param calls     Array of calls to make.
+ * @param count     Number of calls in the array, at most IPC_BATCH_LIMIT.
+ * @param submitted Place to store the number of calls which were made.
+ *
+ * @return EOK if all calls were made.
+ * @return Error code of the first call which could not be made.
+ *
+ */
+errno_t ipc_call_async_batch(ipc_batch_call_t *calls, size_t count,
+    size_t *submitted)
+{
+	return (errno_t) __SYSCALL3(SYS_IPC_CALL_ASYNC_BATCH, (sysarg_t) calls,
+	    count, (sysarg_t) submitted);
+}
+
 /** Answer received call (fast version).
  *
  * The fast answer makes use of passing retval and first four arguments in
@@ -176,6 +196,27 @@ errno_t ipc_wait(ipc_call_t *call, sysarg_t usec, unsigned int flags)
 	return __SYSCALL3(SYS_IPC_WAIT, (sysarg_t) call, usec, flags);
 }
 
+/** Wait for calls and receive as many as are available.
+ *
+ * Only the wait for the first call blocks.
+ *
+ * @param calls    Array to store the received calls to.
+ * @param count    Number of entries of the array, at most IPC_BATCH_LIMIT.
+ * @param usec     Timeout of the wait for the first call.
+ * @param flags    Flags of the wait for the first call.
+ * @param received Place to store the number of received calls.
+ *
+ * @return EOK if at least one call was received.
+ * @return Error code of the wait for the first call otherwise.
+ *
+ */
+errno_t ipc_wait_batch(ipc_call_t *calls, size_t count, sysarg_t usec,
+    unsigned int flags, size_t *received)
+{
+	return (errno_t) __SYSCALL5(SYS_IPC_WAIT_BATCH, (sysarg_t) calls,
+	    count, usec, flags, (sysarg_t) received);
+}
+
 /** Hang up a phone.
  *
  * @param phandle  Handle of the phone to be hung up.
@@ -38,6 +38,8 @@
 #include <ipc/services.h>
 #include <ipc/ipc_test.h>
 #include <loc.h>
+#include <macros.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <ipc_test.h>
 
@@ -111,6 +113,45 @@ errno_t ipc_test_ping(ipc_test_t *test)
 	return EOK;
 }
 
+/** Several pings in flight at once.
+ *
+ * All pings are sent before waiting for the first answer so that they
+ * can be submitted and received in batches.
+ *
+ * @param test IPC test service
+ * @param count Number of pings, at most IPC_TEST_PING_BATCH_MAX
+ * @return EOK on success or an error code
+ */
+errno_t ipc_test_ping_batch(ipc_test_t *test, size_t count)
+{
+	aid_t req[IPC_TEST_PING_BATCH_MAX];
+	async_exch_t *exch;
+	errno_t retval = EOK;
+
+	if (count > IPC_TEST_PING_BATCH_MAX)
+		return EINVAL;
+
+	exch = async_exchange_begin(test->sess);
+	for (size_t i = 0; i < count; i++)
+		req[i] = async_send_0(exch, IPC_TEST_PING, NULL);
+	async_exchange_end(exch);
+
+	for (size_t i = 0; i < count; i++) {
+		errno_t rc;
+
+		if (req[i] == 0) {
+			retval = ENOMEM;
+			continue;
+		}
+
+		async_wait_for(req[i], &rc);
+		if (rc != EOK)
+			retval = rc;
+	}
+
+	return retval;
+}
+
 /** Get size of shared read-only memory area.
  *
  * @param test IPC test service
@@ -220,5 +261,91 @@ errno_t ipc_test_share_in_rw(ipc_test_t *test, size_t size, void **rptr)
 	return EOK;
 }
 
+/** Test data write.
+ *
+ * Transfers larger than DATA_XFER_LIMIT are split into several calls.
+ *
+ * @param test IPC test service
+ * @param data Data to write
+ * @param size Number of bytes to write
+ * @return EOK on success or an error code
+ */
+errno_t ipc_test_write(ipc_test_t *test, const void *data, size_t size)
+{
+	const uint8_t *bp = data;
+	async_exch_t *exch;
+	ipc_call_t answer;
+	aid_t req;
+	size_t now;
+	errno_t retval;
+	errno_t rc;
+
+	while (size > 0) {
+		now = min(size, DATA_XFER_LIMIT);
+
+		exch = async_exchange_begin(test->sess);
+		req = async_send_0(exch, IPC_TEST_WRITE, &answer);
+		rc = async_data_write_start(exch, bp, now);
+		async_exchange_end(exch);
+
+		if (rc != EOK) {
+			async_forget(req);
+			return rc;
+		}
+
+		async_wait_for(req, &retval);
+		if (retval != EOK)
+			return retval;
+
+		bp += now;
+		size -= now;
+	}
+
+	return EOK;
+}
+
+/** Test data read.
+ *
+ * Transfers larger than DATA_XFER_LIMIT are split into several calls.
+ *
+ * @param test IPC test service
+ * @param buf Buffer for the data
+ * @param size Number of bytes to read
+ * @return EOK on success or an error code
+ */
+errno_t ipc_test_read(ipc_test_t *test, void *buf, size_t size)
+{
+	uint8_t *bp = buf;
+	async_exch_t *exch;
+	ipc_call_t answer;
+	aid_t req;
+	size_t now;
+	errno_t retval;
+	errno_t rc;
+
+	while (size > 0) {
+		now = min(size, DATA_XFER_LIMIT);
+
+		exch = async_exchange_begin(test->sess);
+		req = async_send_0(exch, IPC_TEST_READ, &answer);
+		rc = async_data_read_start(exch, bp, now);
+		async_exchange_end(exch);
+
+		if (rc != EOK) {
+			async_forget(req);
+			return rc;
+		}
+
+		async_wait_for(req, &retval);
+		if (retval != EOK)
+			return retval;
+
+		bp += now;
+		size -= now;
+	}
+
+	return EOK;
+}
+
 /** @}
  */
@@ -182,6 +182,9 @@ void __libc_exit(int status)
 		task_retval(status);
 	}
 
+	/* Submit the calls the exiting fibril has queued but not sent yet. */
+	async_flush();
+
 	__SYSCALL1(SYS_TASK_EXIT, false);
 	__builtin_unreachable();
 }
@@ -1,6 +1,7 @@
 /*
  * Copyright (c) 2009 Martin Decky
  * Copyright (c) 2009 Petr Tuma
+ * Copyright (c) 2026 HelenOS developers
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -31,11 +32,30 @@
  * @{
  */
 /** @file
+ *
+ * Size-class memory allocator.
+ *
+ * Blocks up to SMALL_MAX bytes are rounded up to one of the size classes
+ * and carved from spans, SPAN_SIZE aligned address space areas holding
+ * blocks of a single class. Spans of the larger classes are bigger, so
+ * that each holds several blocks. Every runner thread keeps a cache of
+ * free blocks for each class, so most malloc() and free() calls take no
+ * lock at all. The caches exchange blocks with the spans in batches under
+ * a per-class lock. Only larger blocks get an address space area of their
+ * own.
+ *
+ * Each span and large block area starts with a descriptor on a SPAN_SIZE
+ * boundary below every block it holds, which is how free() and realloc()
+ * find it without any per-block header.
+ *
+ * With CONFIG_MALLOC_DEBUG, all requests are served by the checking
+ * next-fit heap (see heap.c) instead.
  */
 
 #include <malloc.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <as.h>
 #include <align.h>
 #include <macros.h>
@@ -44,723 +64,616 @@
 #include <bitops.h>
 #include <mem.h>
 #include <stdlib.h>
-#include <adt/gcdlcm.h>
+#include <fibril.h>
+#include <adt/list.h>
 
 #include "private/malloc.h"
 #include "private/fibril.h"
+#include "private/thread.h"
 
-/** Magic used in heap headers. */
-#define HEAP_BLOCK_HEAD_MAGIC  UINT32_C(0xBEEF0101)
+/** Allocation alignment. */
+#define BASE_ALIGN  16
 
-/** Magic used in heap footers. */
-#define HEAP_BLOCK_FOOT_MAGIC  UINT32_C(0xBEEF0202)
+#define malloc_assert(expr) safe_assert(expr)
 
-/** Magic used in heap descriptor. */
-#define HEAP_AREA_MAGIC  UINT32_C(0xBEEFCAFE)
+#ifndef CONFIG_MALLOC_DEBUG
 
-/** Allocation alignment.
- *
- * This also covers the alignment of fields
- * in the heap header and footer.
- *
- */
-#define BASE_ALIGN  16
+/** Magic used in span descriptors. */
+#define SPAN_MAGIC  UINT32_C(0xBEEF0303)
 
-/** Heap shrink granularity
- *
- * Try not to pump and stress the heap too much
- * by shrinking and enlarging it too often.
- * A heap area won't shrink if the released
- * free block is smaller than this constant.
- *
- */
-#define SHRINK_GRANULARITY  (64 * PAGE_SIZE)
+/** Alignment of spans and the largest span size. */
+#define SPAN_SIZE  (256 * 1024)
 
-/** Overhead of each heap block. */
-#define STRUCT_OVERHEAD \
-	(sizeof(heap_block_head_t) + sizeof(heap_block_foot_t))
+/** Smallest span size. */
+#define SPAN_MIN_SIZE  (64 * 1024)
 
-/** Overhead of each area. */
-#define AREA_OVERHEAD(size) \
-	(ALIGN_UP(size + sizeof(heap_area_t), BASE_ALIGN))
+/** Number of blocks a span should hold at least. */
+#define SPAN_MIN_BLOCKS  4
 
-/** Calculate real size of a heap block.
- *
- * Add header and footer size.
- *
- */
-#define GROSS_SIZE(size)  ((size) + STRUCT_OVERHEAD)
+/** Largest block carved from spans. */
+#define SMALL_MAX  (64 * 1024)
 
-/** Calculate net size of a heap block.
- *
- * Subtract header and footer size.
- *
- */
-#define NET_SIZE(size)  ((size) - STRUCT_OVERHEAD)
-
-/** Get first block in heap area.
- *
- */
-#define AREA_FIRST_BLOCK_HEAD(area) \
-	(ALIGN_UP(((uintptr_t) (area)) + sizeof(heap_area_t), BASE_ALIGN))
+/** Number of size classes. */
+#define CLASS_COUNT  44
 
-/** Get last block in heap area.
- *
- */
-#define AREA_LAST_BLOCK_FOOT(area) \
-	(((uintptr_t) (area)->end) - sizeof(heap_block_foot_t))
+/** Amount of memory moved between a thread cache and spans at once. */
+#define BATCH_BYTES  (8 * 1024)
 
-#define AREA_LAST_BLOCK_HEAD(area) \
-	((uintptr_t) BLOCK_HEAD(((heap_block_foot_t *) AREA_LAST_BLOCK_FOOT(area))))
+/** Upper bound on the number of blocks moved at once. */
+#define BATCH_MAX  32
 
-/** Get header in heap block.
- *
- */
-#define BLOCK_HEAD(foot) \
-	((heap_block_head_t *) \
-	    (((uintptr_t) (foot)) + sizeof(heap_block_foot_t) - (foot)->size))
+/** Number of completely free spans kept around for each class. */
+#define SPARE_SPANS  1
 
-/** Get footer in heap block.
- *
- */
-#define BLOCK_FOOT(head) \
-	((heap_block_foot_t *) \
-	    (((uintptr_t) (head)) + (head)->size - sizeof(heap_block_foot_t)))
+typedef enum {
+	SPAN_SMALL,
+	SPAN_LARGE
+} span_kind_t;
 
-/** Heap area.
+/** Span or large block descriptor
  *
- * The memory managed by the heap allocator is divided into
- * multiple discontinuous heaps. Each heap is represented
- * by a separate address space area which has this structure
- * at its very beginning.
+ * Placed at the (SPAN_SIZE aligned) start of every address
+ * space area managed by the allocator.
  *
  */
-typedef struct heap_area {
-	/** Start of the heap area (including this structure)
-	 *
-	 * Aligned on page boundary.
-	 *
-	 */
-	void *start;
+typedef struct {
+	/** A magic value */
+	uint32_t magic;
 
-	/** End of the heap area (aligned on page boundary) */
-	void *end;
+	/** Kind of the area */
+	span_kind_t kind;
 
-	/** Previous heap area */
-	struct heap_area *prev;
+	/** Size of the whole address space area */
+	size_t area_size;
 
-	/** Next heap area */
-	struct heap_area *next;
+	/** Link in the list of all areas */
+	link_t all_link;
 
-	/** A magic value */
-	uint32_t magic;
-} heap_area_t;
+	/** Offset of the block from the area start (large blocks only) */
+	size_t offset;
 
-/** Header of a heap block
- *
- */
-typedef struct {
-	/* Size of the block (including header and footer) */
-	size_t size;
+	/** Size class of the blocks (small spans only) */
+	unsigned int cls;
 
-	/* Indication of a free block */
-	bool free;
+	/** Link in the list of partially used spans of the class */
+	link_t partial_link;
 
-	/** Heap area this block belongs to */
-	heap_area_t *area;
+	/** Number of blocks handed out, including those in thread caches */
+	size_t used;
 
-	/* A magic value to detect overwrite of heap header */
-	uint32_t magic;
-} heap_block_head_t;
+	/** Number of blocks the span can hold */
+	size_t capacity;
 
-/** Footer of a heap block
- *
- */
-typedef struct {
-	/* Size of the block (including header and footer) */
-	size_t size;
+	/** Freed blocks */
+	void *free;
 
-	/* A magic value to detect overwrite of heap footer */
-	uint32_t magic;
-} heap_block_foot_t;
+	/** Next block never handed out before */
+	uintptr_t bump;
+} span_t;
 
-/** First heap area */
-static heap_area_t *first_heap_area = NULL;
+/** Central state of a size class */
+typedef struct {
+	/** Protects the spans of the class */
+	fibril_rmutex_t lock;
 
-/** Last heap area */
-static heap_area_t *last_heap_area = NULL;
+	/** Spans with at least one free block */
+	list_t partial;
 
-/** Next heap block to examine (next fit algorithm) */
-static heap_block_head_t *next_fit = NULL;
+	/** Number of completely free spans on the partial list */
+	size_t spare;
+} size_class_t;
 
-/** Futex for thread-safe heap manipulation */
-static fibril_rmutex_t malloc_mutex;
+/** Free blocks of one size class cached by a thread */
+typedef struct {
+	void *head;
+	size_t count;
+} cache_bin_t;
 
-#define malloc_assert(expr) safe_assert(expr)
+/** Per-thread block cache */
+struct malloc_tcache {
+	cache_bin_t bins[CLASS_COUNT];
+};
+
+typedef struct malloc_tcache malloc_tcache_t;
 
-/** Serializes access to the heap from multiple threads. */
-static inline void heap_lock(void)
+/** Block sizes of the size classes
+ *
+ * Steps of 16 bytes up to 128 bytes, then four classes per power of two,
+ * which bounds the internal fragmentation by 25 %. Every power of two up
+ * to SMALL_MAX is a class of its own, memalign() relies on that.
+ *
+ */
+static const size_t class_size[CLASS_COUNT] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024,
+	1280, 1536, 1792, 2048,
+	2560, 3072, 3584, 4096,
+	5120, 6144, 7168, 8192,
+	10240, 12288, 14336, 16384,
+	20480, 24576, 28672, 32768,
+	40960, 49152, 57344, 65536
+};
+
+static size_class_t classes[CLASS_COUNT];
+
+/** Cache of the main thread (and of all fibrils while single-threaded) */
+static malloc_tcache_t main_tcache;
+
+/** Thread which uses main_tcache */
+static thread_id_t main_thread;
+
+/** Protects the list of all areas */
+static fibril_rmutex_t areas_lock;
+
+/** All spans and large block areas (used by heap_check()) */
+static LIST_INITIALIZE(areas);
+
+/** Get the size class for a block of the given size (at most SMALL_MAX) */
+static inline unsigned int size_to_class(size_t size)
 {
-	fibril_rmutex_lock(&malloc_mutex);
+	if (size <= 128)
+		return (size <= 16) ? 0 : (size - 1) / 16;
+
+	unsigned int order = fnzb(size - 1);
+	return 8 + (order - 7) * 4 + (((size - 1) >> (order - 2)) - 4);
 }
 
-/** Serializes access to the heap from multiple threads. */
-static inline void heap_unlock(void)
+/** Number of blocks moved between a thread cache and spans at once */
+static inline size_t class_batch(unsigned int cls)
 {
-	fibril_rmutex_unlock(&malloc_mutex);
+	return max(1, min(BATCH_MAX, BATCH_BYTES / class_size[cls]));
 }
 
-/** Initialize a heap block
- *
- * Fill in the structures related to a heap block.
- * Should be called only inside the critical section.
+/** Size of the spans of a class
  *
- * @param addr Address of the block.
- * @param size Size of the block including the header and the footer.
- * @param free Indication of a free block.
- * @param area Heap area the block belongs to.
+ * The smallest power of two, at least SPAN_MIN_SIZE and at most SPAN_SIZE,
+ * with room for SPAN_MIN_BLOCKS blocks next to the descriptor.
  *
  */
-static void block_init(void *addr, size_t size, bool free, heap_area_t *area)
+static inline size_t class_span_size(unsigned int cls)
 {
-	/* Calculate the position of the header and the footer */
-	heap_block_head_t *head = (heap_block_head_t *) addr;
+	size_t size = SPAN_MIN_SIZE;
+	while ((size < SPAN_SIZE) &&
+	    (size < (SPAN_MIN_BLOCKS + 1) * class_size[cls]))
+		size *= 2;
 
-	head->size = size;
-	head->free = free;
-	head->area = area;
-	head->magic = HEAP_BLOCK_HEAD_MAGIC;
-
-	heap_block_foot_t *foot = BLOCK_FOOT(head);
+	return size;
+}
 
-	foot->size = size;
-	foot->magic = HEAP_BLOCK_FOOT_MAGIC;
+/** Get the descriptor of the area holding a block */
+static inline span_t *span_of(void *addr)
+{
+	return (span_t *) (((uintptr_t) addr - 1) &
+	    ~((uintptr_t) SPAN_SIZE - 1));
 }
 
-/** Check a heap block
+/** Create an address space area for a span or a large block
+ *
+ * Address space areas are only page aligned, so a larger area is mapped
+ * first to find a suitably aligned range, and then just that range is
+ * mapped in its place.
  *
- * Verifies that the structures related to a heap block still contain
- * the magic constants. This helps detect heap corruption early on.
- * Should be called only inside the critical section.
+ * @param size  Size of the area.
+ * @param align Required alignment of base + skew, a power of two
+ *              and a multiple of SPAN_SIZE.
+ * @param skew  Multiple of SPAN_SIZE smaller than align.
  *
- * @param addr Address of the block.
+ * @return Base of the area, aligned on SPAN_SIZE, or NULL.
  *
  */
-static void block_check(void *addr)
+static span_t *area_map(size_t size, size_t align, size_t skew)
 {
-	heap_block_head_t *head = (heap_block_head_t *) addr;
+	const unsigned int flags =
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE;
 
-	malloc_assert(head->magic == HEAP_BLOCK_HEAD_MAGIC);
+	size_t gross_size = size + align - PAGE_SIZE;
+	if (gross_size < size)
+		return NULL;
+
+	while (true) {
+		void *start = as_area_create(AS_AREA_ANY, gross_size, flags,
+		    AS_AREA_UNPAGED);
+		if (start == AS_MAP_FAILED)
+			return NULL;
 
-	heap_block_foot_t *foot = BLOCK_FOOT(head);
+		uintptr_t base =
+		    ALIGN_UP((uintptr_t) start + skew, align) - skew;
 
-	malloc_assert(foot->magic == HEAP_BLOCK_FOOT_MAGIC);
-	malloc_assert(head->size == foot->size);
+		if (base == (uintptr_t) start) {
+			if (as_area_resize(start, size, 0) != EOK) {
+				as_area_destroy(start);
+				return NULL;
+			}
+
+			return (span_t *) start;
+		}
+
+		as_area_destroy(start);
+
+		void *area = as_area_create((void *) base, size, flags,
+		    AS_AREA_UNPAGED);
+		if (area != AS_MAP_FAILED)
+			return (span_t *) area;
+
+		/* Another thread has mapped the range meanwhile, try again. */
+	}
 }
 
-/** Check a heap area structure
- *
- * Should be called only inside the critical section.
- *
- * @param addr Address of the heap area.
- *
- */
-static void area_check(void *addr)
+static void area_register(span_t *span)
 {
-	heap_area_t *area = (heap_area_t *) addr;
+	fibril_rmutex_lock(&areas_lock);
+	list_append(&span->all_link, &areas);
+	fibril_rmutex_unlock(&areas_lock);
+}
 
-	malloc_assert(area->magic == HEAP_AREA_MAGIC);
-	malloc_assert(addr == area->start);
-	malloc_assert(area->start < area->end);
-	malloc_assert(((uintptr_t) area->start % PAGE_SIZE) == 0);
-	malloc_assert(((uintptr_t) area->end % PAGE_SIZE) == 0);
+static void area_unmap(span_t *span)
+{
+	fibril_rmutex_lock(&areas_lock);
+	list_remove(&span->all_link);
+	fibril_rmutex_unlock(&areas_lock);
+
+	span->magic = 0;
+	as_area_destroy(span);
 }
 
-/** Create new heap area
+/** Create a new span
+ *
+ * Should be called only with the class lock held.
  *
- * Should be called only inside the critical section.
+ * @param cls Size class of the span.
  *
- * @param size Size of the area.
+ * @return New span or NULL on not enough memory.
  *
  */
-static bool area_create(size_t size)
+static span_t *span_create(unsigned int cls)
 {
-	/* Align the heap area size on page boundary */
-	size_t asize = ALIGN_UP(size, PAGE_SIZE);
-	void *astart = as_area_create(AS_AREA_ANY, asize,
-	    AS_AREA_WRITE | AS_AREA_READ | AS_AREA_CACHEABLE, AS_AREA_UNPAGED);
-	if (astart == AS_MAP_FAILED)
-		return false;
-
-	heap_area_t *area = (heap_area_t *) astart;
-
-	area->start = astart;
-	area->end = (void *) ((uintptr_t) astart + asize);
-	area->prev = NULL;
-	area->next = NULL;
-	area->magic = HEAP_AREA_MAGIC;
-
-	void *block = (void *) AREA_FIRST_BLOCK_HEAD(area);
-	size_t bsize = (size_t) (area->end - block);
-
-	block_init(block, bsize, true, area);
-
-	if (last_heap_area == NULL) {
-		first_heap_area = area;
-		last_heap_area = area;
-	} else {
-		area->prev = last_heap_area;
-		last_heap_area->next = area;
-		last_heap_area = area;
-	}
+	size_t span_size = class_span_size(cls);
+	span_t *span = area_map(span_size, SPAN_SIZE, 0);
+	if (span == NULL)
+		return NULL;
 
-	return true;
+	/*
+	 * Align the first block on the largest power of two dividing
+	 * the block size, so that blocks of power of two classes are
+	 * naturally aligned.
+	 */
+	size_t size = class_size[cls];
+	size_t offset = ALIGN_UP(sizeof(span_t), size & -size);
+
+	span->magic = SPAN_MAGIC;
+	span->kind = SPAN_SMALL;
+	span->area_size = span_size;
+	span->offset = offset;
+	span->cls = cls;
+	link_initialize(&span->partial_link);
+	span->used = 0;
+	span->capacity = (span_size - offset) / size;
+	span->free = NULL;
+	span->bump = (uintptr_t) span + offset;
+
+	area_register(span);
+	return span;
 }
 
-/** Try to enlarge a heap area
+/** Move blocks of a class from spans to a cache bin
  *
- * Should be called only inside the critical section.
+ * @param cls   Size class.
+ * @param bin   Cache bin to fill.
+ * @param count Number of blocks to move.
  *
- * @param area Heap area to grow.
- * @param size Gross size to grow (bytes).
- *
- * @return True if successful.
+ * @return Number of blocks actually moved.
  *
  */
-static bool area_grow(heap_area_t *area, size_t size)
+static size_t class_refill(unsigned int cls, cache_bin_t *bin, size_t count)
 {
-	if (size == 0)
-		return true;
+	size_class_t *sc = &classes[cls];
+	size_t size = class_size[cls];
+	size_t moved = 0;
 
-	area_check(area);
+	fibril_rmutex_lock(&sc->lock);
 
-	/* New heap area size */
-	size_t gross_size = (size_t) (area->end - area->start) + size;
-	size_t asize = ALIGN_UP(gross_size, PAGE_SIZE);
-	void *end = (void *) ((uintptr_t) area->start + asize);
+	while (moved < count) {
+		span_t *span;
 
-	/* Check for overflow */
-	if (end < area->start)
-		return false;
+		if (list_empty(&sc->partial)) {
+			span = span_create(cls);
+			if (span == NULL)
+				break;
 
-	/* Resize the address space area */
-	errno_t ret = as_area_resize(area->start, asize, 0);
-	if (ret != EOK)
-		return false;
+			list_append(&span->partial_link, &sc->partial);
+		} else {
+			span = list_get_instance(list_first(&sc->partial),
+			    span_t, partial_link);
 
-	heap_block_head_t *last_head =
-	    (heap_block_head_t *) AREA_LAST_BLOCK_HEAD(area);
+			if (span->used == 0)
+				sc->spare--;
+		}
 
-	if (last_head->free) {
-		/* Add the new space to the last block. */
-		size_t net_size = (size_t) (end - area->end) + last_head->size;
-		malloc_assert(net_size > 0);
-		block_init(last_head, net_size, true, area);
-	} else {
-		/* Add new free block */
-		size_t net_size = (size_t) (end - area->end);
-		if (net_size > 0)
-			block_init(area->end, net_size, true, area);
+		while ((moved < count) && (span->used < span->capacity)) {
+			void *block;
+
+			if (span->free != NULL) {
+				block = span->free;
+				span->free = *(void **) block;
+			} else {
+				block = (void *) span->bump;
+				span->bump += size;
+			}
+
+			span->used++;
+
+			*(void **) block = bin->head;
+			bin->head = block;
+			moved++;
+		}
+
+		if (span->used == span->capacity)
+			list_remove(&span->partial_link);
 	}
 
-	/* Update heap area parameters */
-	area->end = end;
+	fibril_rmutex_unlock(&sc->lock);
 
-	return true;
+	bin->count += moved;
+	return moved;
 }
 
-/** Try to shrink heap
- *
- * Should be called only inside the critical section.
- * In all cases the next pointer is reset.
+/** Return blocks from a cache bin to their spans
  *
- * @param area Last modified heap area.
+ * @param cls   Size class.
+ * @param bin   Cache bin to drain.
+ * @param count Number of blocks to move.
  *
  */
-static void heap_shrink(heap_area_t *area)
+static void class_flush(unsigned int cls, cache_bin_t *bin, size_t count)
 {
-	area_check(area);
+	size_class_t *sc = &classes[cls];
 
-	heap_block_foot_t *last_foot =
-	    (heap_block_foot_t *) AREA_LAST_BLOCK_FOOT(area);
-	heap_block_head_t *last_head = BLOCK_HEAD(last_foot);
+	fibril_rmutex_lock(&sc->lock);
 
-	block_check((void *) last_head);
-	malloc_assert(last_head->area == area);
+	while ((count > 0) && (bin->head != NULL)) {
+		void *block = bin->head;
+		bin->head = *(void **) block;
+		bin->count--;
+		count--;
 
-	if (last_head->free) {
-		/*
-		 * The last block of the heap area is
-		 * unused. The area might be potentially
-		 * shrunk.
-		 */
+		span_t *span = span_of(block);
+		malloc_assert(span->magic == SPAN_MAGIC);
+		malloc_assert(span->used > 0);
+
+		if (span->used == span->capacity)
+			list_prepend(&span->partial_link, &sc->partial);
 
-		heap_block_head_t *first_head =
-		    (heap_block_head_t *) AREA_FIRST_BLOCK_HEAD(area);
-
-		block_check((void *) first_head);
-		malloc_assert(first_head->area == area);
-
-		size_t shrink_size = ALIGN_DOWN(last_head->size, PAGE_SIZE);
-
-		if (first_head == last_head) {
-			/*
-			 * The entire heap area consists of a single
-			 * free heap block. This means we can get rid
-			 * of it entirely.
-			 */
-
-			heap_area_t *prev = area->prev;
-			heap_area_t *next = area->next;
-
-			if (prev != NULL) {
-				area_check(prev);
-				prev->next = next;
-			} else
-				first_heap_area = next;
-
-			if (next != NULL) {
-				area_check(next);
-				next->prev = prev;
-			} else
-				last_heap_area = prev;
-
-			as_area_destroy(area->start);
-		} else if (shrink_size >= SHRINK_GRANULARITY) {
-			/*
-			 * Make sure that we always shrink the area
-			 * by a multiple of page size and update
-			 * the block layout accordingly.
-			 */
-
-			size_t asize = (size_t) (area->end - area->start) - shrink_size;
-			void *end = (void *) ((uintptr_t) area->start + asize);
-
-			/* Resize the address space area */
-			errno_t ret = as_area_resize(area->start, asize, 0);
-			if (ret != EOK)
-				abort();
-
-			/* Update heap area parameters */
-			area->end = end;
-			size_t excess = ((size_t) area->end) - ((size_t) last_head);
-
-			if (excess > 0) {
-				if (excess >= STRUCT_OVERHEAD) {
-					/*
-					 * The previous block cannot be free and there
-					 * is enough free space left in the area to
-					 * create a new free block.
-					 */
-					block_init((void *) last_head, excess, true, area);
-				} else {
-					/*
-					 * The excess is small. Therefore just enlarge
-					 * the previous block.
-					 */
-					heap_block_foot_t *prev_foot = (heap_block_foot_t *)
-					    (((uintptr_t) last_head) - sizeof(heap_block_foot_t));
-					heap_block_head_t *prev_head = BLOCK_HEAD(prev_foot);
-
-					block_check((void *) prev_head);
-
-					block_init(prev_head, prev_head->size + excess,
-					    prev_head->free, area);
-				}
+		*(void **) block = span->free;
+		span->free = block;
+		span->used--;
+
+		if (span->used == 0) {
+			if (sc->spare < SPARE_SPANS) {
+				sc->spare++;
+			} else {
+				list_remove(&span->partial_link);
+				area_unmap(span);
 			}
 		}
 	}
 
-	next_fit = NULL;
+	fibril_rmutex_unlock(&sc->lock);
 }
 
-/** Initialize the heap allocator
- *
- * Create initial heap memory area. This routine is
- * only called from libc initialization, thus we do not
- * take any locks.
- *
- */
-void __malloc_init(void)
+/** Return all blocks cached by a thread to their spans */
+static void tcache_drain(malloc_tcache_t *tcache)
 {
-	if (fibril_rmutex_initialize(&malloc_mutex) != EOK)
-		abort();
+	for (unsigned int cls = 0; cls < CLASS_COUNT; cls++) {
+		cache_bin_t *bin = &tcache->bins[cls];
 
-	if (!area_create(PAGE_SIZE))
-		abort();
-}
-
-void __malloc_fini(void)
-{
-	fibril_rmutex_destroy(&malloc_mutex);
+		if (bin->count > 0)
+			class_flush(cls, bin, bin->count);
+	}
 }
 
-/** Split heap block and mark it as used.
- *
- * Should be called only inside the critical section.
+/** Get the block cache of the current thread
  *
- * @param cur  Heap block to split.
- * @param size Number of bytes to split and mark from the beginning
- *             of the block.
+ * @return Block cache or NULL if it could not be allocated.
  *
  */
-static void split_mark(heap_block_head_t *cur, const size_t size)
+static malloc_tcache_t *tcache_get(void)
 {
-	malloc_assert(cur->size >= size);
+	if (!fibril_is_multithreaded())
+		return &main_tcache;
+
+	/*
+	 * The helper fibril of a thread is handed over to whichever fibril
+	 * runs on it, so it identifies the thread. Only the main thread
+	 * runs fibrils without one, until a fibril on it first blocks.
+	 */
+	fibril_t *ctx = fibril_self()->thread_ctx;
+	if (ctx == NULL)
+		return &main_tcache;
 
-	/* See if we should split the block. */
-	size_t split_limit = GROSS_SIZE(size);
+	if (ctx->malloc_tcache == NULL) {
+		cache_bin_t bin = { NULL, 0 };
+		unsigned int cls = size_to_class(sizeof(malloc_tcache_t));
 
-	if (cur->size > split_limit) {
-		/* Block big enough -> split. */
-		void *next = ((void *) cur) + size;
-		block_init(next, cur->size - size, true, cur->area);
-		block_init(cur, size, false, cur->area);
-	} else {
-		/* Block too small -> use as is. */
-		cur->free = false;
+		if (class_refill(cls, &bin, 1) == 0)
+			return NULL;
+
+		memset(bin.head, 0, sizeof(malloc_tcache_t));
+		ctx->malloc_tcache = bin.head;
+
+		/*
+		 * Once the main thread has a cache of its own, nothing
+		 * uses main_tcache anymore, so the blocks cached there
+		 * would be stranded.
+		 */
+		if (thread_get_id() == main_thread)
+			tcache_drain(&main_tcache);
 	}
+
+	return ctx->malloc_tcache;
 }
 
-/** Allocate memory from heap area starting from given block
- *
- * Should be called only inside the critical section.
- * As a side effect this function also sets the current
- * pointer on successful allocation.
- *
- * @param area        Heap area where to allocate from.
- * @param first_block Starting heap block.
- * @param final_block Heap block where to finish the search
- *                    (may be NULL).
- * @param real_size   Gross number of bytes to allocate.
- * @param falign      Physical alignment of the block.
- *
- * @return Address of the allocated block or NULL on not enough memory.
- *
- */
-static void *malloc_area(heap_area_t *area, heap_block_head_t *first_block,
-    heap_block_head_t *final_block, size_t real_size, size_t falign)
+static void *small_alloc(unsigned int cls)
 {
-	area_check((void *) area);
-	malloc_assert((void *) first_block >= (void *) AREA_FIRST_BLOCK_HEAD(area));
-	malloc_assert((void *) first_block < area->end);
+	malloc_tcache_t *tcache = tcache_get();
+	cache_bin_t local = { NULL, 0 };
+	cache_bin_t *bin;
+	size_t batch;
+
+	if (tcache != NULL) {
+		bin = &tcache->bins[cls];
+		batch = class_batch(cls);
+	} else {
+		bin = &local;
+		batch = 1;
+	}
 
-	for (heap_block_head_t *cur = first_block; (void *) cur < area->end;
-	    cur = (heap_block_head_t *) (((void *) cur) + cur->size)) {
-		block_check(cur);
+	if ((bin->head == NULL) && (class_refill(cls, bin, batch) == 0))
+		return NULL;
 
-		/* Finish searching on the final block */
-		if ((final_block != NULL) && (cur == final_block))
-			break;
+	void *block = bin->head;
+	bin->head = *(void **) block;
+	bin->count--;
 
-		/* Try to find a block that is free and large enough. */
-		if ((cur->free) && (cur->size >= real_size)) {
-			/*
-			 * We have found a suitable block.
-			 * Check for alignment properties.
-			 */
-			void *addr = (void *)
-			    ((uintptr_t) cur + sizeof(heap_block_head_t));
-			void *aligned = (void *)
-			    ALIGN_UP((uintptr_t) addr, falign);
-
-			if (addr == aligned) {
-				/* Exact block start including alignment. */
-				split_mark(cur, real_size);
-
-				next_fit = cur;
-				return addr;
-			} else {
-				/* Block start has to be aligned */
-				size_t excess = (size_t) (aligned - addr);
-
-				if (cur->size >= real_size + excess) {
-					/*
-					 * The current block is large enough to fit
-					 * data in (including alignment).
-					 */
-					if ((void *) cur > (void *) AREA_FIRST_BLOCK_HEAD(area)) {
-						/*
-						 * There is a block before the current block.
-						 * This previous block can be enlarged to
-						 * compensate for the alignment excess.
-						 */
-						heap_block_foot_t *prev_foot = (heap_block_foot_t *)
-						    ((void *) cur - sizeof(heap_block_foot_t));
-
-						heap_block_head_t *prev_head = (heap_block_head_t *)
-						    ((void *) cur - prev_foot->size);
-
-						block_check(prev_head);
-
-						size_t reduced_size = cur->size - excess;
-						heap_block_head_t *next_head = ((void *) cur) + excess;
-
-						if ((!prev_head->free) &&
-						    (excess >= STRUCT_OVERHEAD)) {
-							/*
-							 * The previous block is not free and there
-							 * is enough free space left to fill in
-							 * a new free block between the previous
-							 * and current block.
-							 */
-							block_init(cur, excess, true, area);
-						} else {
-							/*
-							 * The previous block is free (thus there
-							 * is no need to induce additional
-							 * fragmentation to the heap) or the
-							 * excess is small. Therefore just enlarge
-							 * the previous block.
-							 */
-							block_init(prev_head, prev_head->size + excess,
-							    prev_head->free, area);
-						}
-
-						block_init(next_head, reduced_size, true, area);
-						split_mark(next_head, real_size);
-
-						next_fit = next_head;
-						return aligned;
-					} else {
-						/*
-						 * The current block is the first block
-						 * in the heap area. We have to make sure
-						 * that the alignment excess is large enough
-						 * to fit a new free block just before the
-						 * current block.
-						 */
-						while (excess < STRUCT_OVERHEAD) {
-							aligned += falign;
-							excess += falign;
-						}
-
-						/* Check for current block size again */
-						if (cur->size >= real_size + excess) {
-							size_t reduced_size = cur->size - excess;
-							cur = (heap_block_head_t *)
-							    (AREA_FIRST_BLOCK_HEAD(area) + excess);
-
-							block_init((void *) AREA_FIRST_BLOCK_HEAD(area),
-							    excess, true, area);
-							block_init(cur, reduced_size, true, area);
-							split_mark(cur, real_size);
-
-							next_fit = cur;
-							return aligned;
-						}
-					}
-				}
-			}
-		}
-	}
+	return block;
+}
 
-	return NULL;
+static void small_free(span_t *span, void *addr)
+{
+	unsigned int cls = span->cls;
+	malloc_tcache_t *tcache = tcache_get();
+	cache_bin_t local = { NULL, 0 };
+	cache_bin_t *bin = (tcache != NULL) ? &tcache->bins[cls] : &local;
+
+	*(void **) addr = bin->head;
+	bin->head = addr;
+	bin->count++;
+
+	if (tcache == NULL)
+		class_flush(cls, bin, 1);
+	else if (bin->count > 2 * class_batch(cls))
+		class_flush(cls, bin, class_batch(cls));
 }
 
-/** Try to enlarge any of the heap areas.
- *
- * If successful, allocate block of the given size in the area.
- * Should be called only inside the critical section.
+/** Allocate a block in an address space area of its own
  *
- * @param size  Gross size of item to allocate (bytes).
- * @param align Memory address alignment.
+ * @param size  Size of the block.
+ * @param align Alignment of the block, a power of two.
  *
- * @return Allocated block.
- * @return NULL on failure.
+ * @return Address of the block or NULL on not enough memory.
  *
  */
-static void *heap_grow_and_alloc(size_t size, size_t align)
+static void *large_alloc(size_t size, size_t align)
 {
-	if (size == 0)
-		return NULL;
+	size_t offset;
+	size_t area_align;
+	size_t skew;
+
+	if (align <= SPAN_SIZE) {
+		offset = ALIGN_UP(sizeof(span_t), max(align, BASE_ALIGN));
+		area_align = SPAN_SIZE;
+		skew = 0;
+	} else {
+		/* Keep the descriptor in the span just below the block. */
+		offset = SPAN_SIZE;
+		area_align = align;
+		skew = SPAN_SIZE;
+	}
 
-	/* First try to enlarge some existing area */
-	for (heap_area_t *area = first_heap_area; area != NULL;
-	    area = area->next) {
+	size_t area_size = ALIGN_UP(offset + size, PAGE_SIZE);
+	if (area_size < size)
+		return NULL;
 
-		if (area_grow(area, size + align)) {
-			heap_block_head_t *first =
-			    (heap_block_head_t *) AREA_LAST_BLOCK_HEAD(area);
+	span_t *span = area_map(area_size, area_align, skew);
+	if (span == NULL)
+		return NULL;
 
-			void *addr =
-			    malloc_area(area, first, NULL, size, align);
-			malloc_assert(addr != NULL);
-			return addr;
-		}
-	}
+	span->magic = SPAN_MAGIC;
+	span->kind = SPAN_LARGE;
+	span->area_size = area_size;
+	span->offset = offset;
 
-	/* Eventually try to create a new area */
-	if (area_create(AREA_OVERHEAD(size + align))) {
-		heap_block_head_t *first =
-		    (heap_block_head_t *) AREA_FIRST_BLOCK_HEAD(last_heap_area);
+	area_register(span);
+	return ((void *) span) + offset;
+}
 
-		void *addr =
-		    malloc_area(last_heap_area, first, NULL, size, align);
-		malloc_assert(addr != NULL);
-		return addr;
-	}
+/** Get the number of bytes usable in a block */
+static size_t block_size(span_t *span)
+{
+	if (span->kind == SPAN_SMALL)
+		return class_size[span->cls];
 
-	return NULL;
+	return span->area_size - span->offset;
 }
 
-/** Allocate a memory block
- *
- * Should be called only inside the critical section.
+/** Try to resize a block without moving it
  *
- * @param size  The size of the block to allocate.
- * @param align Memory address alignment.
- *
- * @return Address of the allocated block or NULL on not enough memory.
+ * @return True if the block now holds at least size bytes.
  *
  */
-static void *malloc_internal(const size_t size, const size_t align)
+static bool block_resize(span_t *span, size_t size)
 {
-	malloc_assert(first_heap_area != NULL);
+	if (span->kind == SPAN_SMALL)
+		return (size <= SMALL_MAX) && (size_to_class(size) == span->cls);
 
-	if (align == 0)
-		return NULL;
+	/* Do not keep a whole area for a block that fits in a span. */
+	if (size <= SMALL_MAX)
+		return false;
 
-	size_t falign = lcm(align, BASE_ALIGN);
+	size_t area_size = ALIGN_UP(span->offset + size, PAGE_SIZE);
+	if (area_size < size)
+		return false;
 
-	/* Check for integer overflow. */
-	if (falign < align)
-		return NULL;
+	if (area_size == span->area_size)
+		return true;
 
-	/*
-	 * The size of the allocated block needs to be naturally
-	 * aligned, because the footer structure also needs to reside
-	 * on a naturally aligned address in order to avoid unaligned
-	 * memory accesses.
-	 */
-	size_t gross_size = GROSS_SIZE(ALIGN_UP(size, BASE_ALIGN));
+	/* Address space areas can grow and shrink at their end. */
+	if (as_area_resize(span, area_size, 0) != EOK)
+		return false;
 
-	/* Try the next fit approach */
-	heap_block_head_t *split = next_fit;
+	span->area_size = area_size;
+	return true;
+}
 
-	if (split != NULL) {
-		void *addr = malloc_area(split->area, split, NULL, gross_size,
-		    falign);
+#endif
 
-		if (addr != NULL)
-			return addr;
-	}
+/** Initialize the allocator
+ *
+ * This routine is only called from libc
+ * initialization, thus we do not take any locks.
+ *
+ */
+void __malloc_init(void)
+{
+#ifdef CONFIG_MALLOC_DEBUG
+	__heap_init();
+#else
+	if (fibril_rmutex_initialize(&areas_lock) != EOK)
+		abort();
 
-	/* Search the entire heap */
-	for (heap_area_t *area = first_heap_area; area != NULL;
-	    area = area->next) {
-		heap_block_head_t *first = (heap_block_head_t *)
-		    AREA_FIRST_BLOCK_HEAD(area);
+	main_thread = thread_get_id();
 
-		void *addr = malloc_area(area, first, split, gross_size,
-		    falign);
+	for (unsigned int i = 0; i < CLASS_COUNT; i++) {
+		if (fibril_rmutex_initialize(&classes[i].lock) != EOK)
+			abort();
 
-		if (addr != NULL)
-			return addr;
+		list_initialize(&classes[i].partial);
+		classes[i].spare = 0;
 	}
+#endif
+}
 
-	/* Finally, try to grow heap space and allocate in the new area. */
-	return heap_grow_and_alloc(gross_size, falign);
+void __malloc_fini(void)
+{
+#ifdef CONFIG_MALLOC_DEBUG
+	__heap_fini();
+#else
+	for (unsigned int i = 0; i < CLASS_COUNT; i++)
+		fibril_rmutex_destroy(&classes[i].lock);
+
+	fibril_rmutex_destroy(&areas_lock);
+#endif
 }
 
 /** Allocate memory by number of elements
@@ -773,12 +686,19 @@ static void *malloc_internal(const size_t size, const size_t align)
  */
 void *calloc(const size_t nmemb, const size_t size)
 {
-	// FIXME: Check for overflow
+	if ((size != 0) && (nmemb > SIZE_MAX / size))
+		return NULL;
 
 	void *block = malloc(nmemb * size);
 	if (block == NULL)
 		return NULL;
 
+#ifndef CONFIG_MALLOC_DEBUG
+	/* Large blocks live in fresh anonymous memory, which is zeroed. */
+	if (nmemb * size > SMALL_MAX)
+		return block;
+#endif
+
 	memset(block, 0, nmemb * size);
 	return block;
 }
@@ -792,11 +712,14 @@ void *calloc(const size_t nmemb, const size_t size)
  */
 void *malloc(const size_t size)
 {
-	heap_lock();
-	void *block = malloc_internal(size, BASE_ALIGN);
-	heap_unlock();
-
-	return block;
+#ifdef CONFIG_MALLOC_DEBUG
+	return __heap_alloc(size, BASE_ALIGN);
+#else
+	if (size <= SMALL_MAX)
+		return small_alloc(size_to_class(size));
+
+	return large_alloc(size, BASE_ALIGN);
+#endif
 }
 
 /** Allocate memory with specified alignment
@@ -815,11 +738,23 @@ void *memalign(const size_t align, const size_t size)
 	size_t palign =
 	    1 << (fnzb(max(sizeof(void *), align) - 1) + 1);
 
-	heap_lock();
-	void *block = malloc_internal(size, palign);
-	heap_unlock();
+#ifdef CONFIG_MALLOC_DEBUG
+	return __heap_alloc(size, palign);
+#else
+	if (palign <= BASE_ALIGN)
+		return malloc(size);
+
+	/* Blocks of power of two classes are naturally aligned. */
+	if ((size <= SMALL_MAX) && (palign <= SMALL_MAX)) {
+		size_t bsize = max(size, palign);
+		bsize = (size_t) 1 << (fnzb(bsize - 1) + 1);
 
-	return block;
+		if (bsize <= SMALL_MAX)
+			return small_alloc(size_to_class(bsize));
+	}
+
+	return large_alloc(size, palign);
+#endif
 }
 
 /** Reallocate memory block
@@ -832,6 +767,9 @@ void *memalign(const size_t align, const size_t size)
  */
 void *realloc(void *const addr, const size_t size)
 {
+#ifdef CONFIG_MALLOC_DEBUG
+	return __heap_realloc(addr, size);
+#else
 	if (size == 0) {
 		free(addr);
 		return NULL;
@@ -840,103 +778,20 @@ void *realloc(void *const addr, const size_t size)
 	if (addr == NULL)
 		return malloc(size);
 
-	heap_lock();
-
-	/* Calculate the position of the header. */
-	heap_block_head_t *head =
-	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
-
-	block_check(head);
-	malloc_assert(!head->free);
-
-	heap_area_t *area = head->area;
-
-	area_check(area);
-	malloc_assert((void *) head >= (void *) AREA_FIRST_BLOCK_HEAD(area));
-	malloc_assert((void *) head < area->end);
-
-	void *ptr = NULL;
-	bool reloc = false;
-	size_t real_size = GROSS_SIZE(ALIGN_UP(size, BASE_ALIGN));
-	size_t orig_size = head->size;
-
-	if (orig_size > real_size) {
-		/* Shrink */
-		if (orig_size - real_size >= STRUCT_OVERHEAD) {
-			/*
-			 * Split the original block to a full block
-			 * and a trailing free block.
-			 */
-			block_init((void *) head, real_size, false, area);
-			block_init((void *) head + real_size,
-			    orig_size - real_size, true, area);
-			heap_shrink(area);
-		}
+	span_t *span = span_of(addr);
+	malloc_assert(span->magic == SPAN_MAGIC);
 
-		ptr = ((void *) head) + sizeof(heap_block_head_t);
-	} else {
-		heap_block_head_t *next_head =
-		    (heap_block_head_t *) (((void *) head) + head->size);
-		bool have_next = ((void *) next_head < area->end);
-
-		if (((void *) head) + real_size > area->end) {
-			/*
-			 * The current area is too small to hold the resized
-			 * block. Make sure there are no used blocks standing
-			 * in our way and try to grow the area using real_size
-			 * as a safe upper bound.
-			 */
-
-			bool have_next_next;
-
-			if (have_next) {
-				have_next_next = (((void *) next_head) +
-				    next_head->size < area->end);
-			}
-			if (!have_next || (next_head->free && !have_next_next)) {
-				/*
-				 * There is no next block in this area or
-				 * it is a free block and there is no used
-				 * block following it. There can't be any
-				 * free block following it either as
-				 * two free blocks would be merged.
-				 */
-				(void) area_grow(area, real_size);
-			}
-		}
-
-		/*
-		 * Look at the next block. If it is free and the size is
-		 * sufficient then merge the two. Otherwise just allocate a new
-		 * block, copy the original data into it and free the original
-		 * block.
-		 */
-
-		if (have_next && (head->size + next_head->size >= real_size) &&
-		    next_head->free) {
-			block_check(next_head);
-			block_init(head, head->size + next_head->size, false,
-			    area);
-			split_mark(head, real_size);
-
-			ptr = ((void *) head) + sizeof(heap_block_head_t);
-			next_fit = NULL;
-		} else {
-			reloc = true;
-		}
-	}
-
-	heap_unlock();
+	if (block_resize(span, size))
+		return addr;
 
-	if (reloc) {
-		ptr = malloc(size);
-		if (ptr != NULL) {
-			memcpy(ptr, addr, NET_SIZE(orig_size));
-			free(addr);
-		}
+	void *ptr = malloc(size);
+	if (ptr != NULL) {
+		memcpy(ptr, addr, min(size, block_size(span)));
+		free(addr);
 	}
 
 	return ptr;
+#endif
 }
 
 /** Free a memory block
@@ -946,104 +801,61 @@ void *realloc(void *const addr, const size_t size)
  */
 void free(void *const addr)
 {
+#ifdef CONFIG_MALLOC_DEBUG
+	__heap_free(addr);
+#else
 	if (addr == NULL)
 		return;
 
-	heap_lock();
-
-	/* Calculate the position of the header. */
-	heap_block_head_t *head =
-	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
-
-	block_check(head);
-	malloc_assert(!head->free);
-
-	heap_area_t *area = head->area;
-
-	area_check(area);
-	malloc_assert((void *) head >= (void *) AREA_FIRST_BLOCK_HEAD(area));
-	malloc_assert((void *) head < area->end);
-
-	/* Mark the block itself as free. */
-	head->free = true;
-
-	/* Look at the next block. If it is free, merge the two. */
-	heap_block_head_t *next_head =
-	    (heap_block_head_t *) (((void *) head) + head->size);
-
-	if ((void *) next_head < area->end) {
-		block_check(next_head);
-		if (next_head->free)
-			block_init(head, head->size + next_head->size, true, area);
-	}
-
-	/* Look at the previous block. If it is free, merge the two. */
-	if ((void *) head > (void *) AREA_FIRST_BLOCK_HEAD(area)) {
-		heap_block_foot_t *prev_foot =
-		    (heap_block_foot_t *) (((void *) head) - sizeof(heap_block_foot_t));
-
-		heap_block_head_t *prev_head =
-		    (heap_block_head_t *) (((void *) head) - prev_foot->size);
-
-		block_check(prev_head);
-
-		if (prev_head->free)
-			block_init(prev_head, prev_head->size + head->size, true,
-			    area);
-	}
-
-	heap_shrink(area);
+	span_t *span = span_of(addr);
+	malloc_assert(span->magic == SPAN_MAGIC);
 
-	heap_unlock();
+	if (span->kind == SPAN_SMALL)
+		small_free(span, addr);
+	else
+		area_unmap(span);
+#endif
 }
 
+/** Check the consistency of the allocator structures
+ *
+ * @return NULL if no damage was found, address of the first damaged
+ *         structure otherwise.
+ *
+ */
 void *heap_check(void)
 {
-	heap_lock();
-
-	if (first_heap_area == NULL) {
-		heap_unlock();
-		return (void *) -1;
-	}
+#ifdef CONFIG_MALLOC_DEBUG
+	return __heap_check();
+#else
+	void *damaged = NULL;
 
-	/* Walk all heap areas */
-	for (heap_area_t *area = first_heap_area; area != NULL;
-	    area = area->next) {
-
-		/* Check heap area consistency */
-		if ((area->magic != HEAP_AREA_MAGIC) ||
-		    ((void *) area != area->start) ||
-		    (area->start >= area->end) ||
-		    (((uintptr_t) area->start % PAGE_SIZE) != 0) ||
-		    (((uintptr_t) area->end % PAGE_SIZE) != 0)) {
-			heap_unlock();
-			return (void *) area;
-		}
-
-		/* Walk all heap blocks */
-		for (heap_block_head_t *head = (heap_block_head_t *)
-		    AREA_FIRST_BLOCK_HEAD(area); (void *) head < area->end;
-		    head = (heap_block_head_t *) (((void *) head) + head->size)) {
+	fibril_rmutex_lock(&areas_lock);
 
-			/* Check heap block consistency */
-			if (head->magic != HEAP_BLOCK_HEAD_MAGIC) {
-				heap_unlock();
-				return (void *) head;
-			}
+	list_foreach(areas, all_link, span_t, span) {
+		bool ok = (span->magic == SPAN_MAGIC) &&
+		    (((uintptr_t) span % SPAN_SIZE) == 0) &&
+		    ((span->area_size % PAGE_SIZE) == 0);
 
-			heap_block_foot_t *foot = BLOCK_FOOT(head);
+		if (span->kind == SPAN_SMALL) {
+			ok = ok && (span->cls < CLASS_COUNT) &&
+			    (span->area_size == class_span_size(span->cls));
+		} else {
+			ok = ok && (span->kind == SPAN_LARGE) &&
+			    (span->offset > 0) && (span->offset <= SPAN_SIZE) &&
+			    (span->offset < span->area_size);
+		}
 
-			if ((foot->magic != HEAP_BLOCK_FOOT_MAGIC) ||
-			    (head->size != foot->size)) {
-				heap_unlock();
-				return (void *) foot;
-			}
+		if (!ok) {
+			damaged = span;
+			break;
 		}
 	}
 
-	heap_unlock();
+	fibril_rmutex_unlock(&areas_lock);
 
-	return NULL;
+	return damaged;
+#endif
 }
 
 /** @}
@@ -39,9 +39,15 @@
 #include "./futex.h"
 
 typedef struct {
-	fibril_t *fibril;
+	_Atomic(fibril_t *) fibril;
 } fibril_event_t;
 
+typedef struct fibril_exit_hook {
+	struct fibril_exit_hook *next;
+	void (*func)(void *);
+	void *arg;
+} fibril_exit_hook_t;
+
 #define FIBRIL_EVENT_INIT ((fibril_event_t) {0})
 
 struct fibril {
@@ -57,11 +63,23 @@ struct fibril {
 	errno_t (*func)(void *);
 	tcb_t *tcb;
 
+	/* Set by the fibril switching to us, handled once the switch is done. */
 	fibril_t *clean_after_me;
+	fibril_t *ready_after_me;
+	fibril_t *sleep_after_me;
 	errno_t retval;
 
 	fibril_t *thread_ctx;
 
+	/* Runner of the thread, only set in the helper fibril of a thread. */
+	struct fibril_runner *runner;
+
+	/* Functions to call when the fibril exits, most recent first. */
+	fibril_exit_hook_t *exit_hooks;
+
+	/* Block cache of malloc(), only set in the helper fibril of a thread. */
+	struct malloc_tcache *malloc_tcache;
+
 	bool is_running : 1;
 	bool is_writer : 1;
 	/* In some places, we use fibril structs that can't be freed. */
@@ -77,6 +95,7 @@ extern fibril_t *fibril_alloc(void);
 extern void fibril_setup(fibril_t *);
 extern void fibril_teardown(fibril_t *f);
 extern fibril_t *fibril_self(void);
+extern void fibril_run_exit_hooks(void);
 
 extern void __fibrils_init(void);
 extern void __fibrils_fini(void);
@@ -88,6 +107,9 @@ extern void fibril_notify(fibril_event_t *);
 extern errno_t fibril_ipc_wait(ipc_call_t *, const struct timespec *);
 extern void fibril_ipc_poke(void);
 
+/* Defined by the async framework, which fibril.c cannot include. */
+extern void async_flush(void);
+
 /**
  * "Restricted" fibril mutex.
  *
@@ -35,9 +35,19 @@
 #ifndef _LIBC_PRIVATE_MALLOC_H_
 #define _LIBC_PRIVATE_MALLOC_H_
 
+#include <stddef.h>
+
 extern void __malloc_init(void);
 extern void __malloc_fini(void);
 
+/* Next-fit heap, the backend of malloc() with CONFIG_MALLOC_DEBUG. */
+extern void __heap_init(void);
+extern void __heap_fini(void);
+extern void *__heap_alloc(size_t, size_t);
+extern void *__heap_realloc(void *, size_t);
+extern void __heap_free(void *);
+extern void *__heap_check(void);
+
 #endif
 
 /** @}
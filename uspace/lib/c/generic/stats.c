@@ -104,6 +104,28 @@ stats_physmem_t *stats_get_physmem(void)
 	return stats_physmem;
 }
 
+/** Get frame allocator statistics
+ *
+ * @return Pointer to the stats_frames_t structure.
+ *         If non-NULL then it should be eventually freed
+ *         by free().
+ *
+ */
+stats_frames_t *stats_get_frames(void)
+{
+	size_t size = 0;
+	stats_frames_t *stats_frames =
+	    (stats_frames_t *) sysinfo_get_data("system.frames", &size);
+
+	if (size != sizeof(stats_frames_t)) {
+		if (stats_frames != NULL)
+			free(stats_frames);
+		return NULL;
+	}
+
+	return stats_frames;
+}
+
 /** Get task statistics
  *
  * @param count Number of records returned.
@@ -37,6 +37,7 @@
 #include <fibril_synch.h>
 #include <stdlib.h>
 #include <errno.h>
+#include "private/fibril.h"
 #include "private/libc.h"
 #include "private/scanf.h"
 #include "private/stdlib.h"
@@ -118,6 +119,9 @@ void exit(int status)
 	link_t *link;
 	__exit_handler_t *eh;
 
+	/* Destroy fibril-local objects of the exiting fibril first */
+	fibril_run_exit_hooks();
+
 	/* Call exit handlers */
 	fibril_mutex_lock(&exit_handlers_lock);
 	while (!list_empty(&exit_handlers)) {
@@ -35,6 +35,7 @@
  */
 
 #include <adt/list.h>
+#include <adt/odict.h>
 #include <fibril.h>
 #include <stack.h>
 #include <tls.h>
@@ -46,6 +47,7 @@
 #include <mem.h>
 #include <str.h>
 #include <ipc/ipc.h>
+#include <sysinfo.h>
 #include <libarch/faddr.h>
 
 #include "../private/thread.h"
@@ -56,9 +58,18 @@
 #define DPRINTF(...) ((void)0)
 #undef READY_DEBUG
 
-/** Member of timeout_list. */
+/** Maximum number of IPC calls received by one wait. */
+#define IPC_WAIT_BATCH 16
+
+/** Smallest default size of the runner pool. */
+#define RUNNER_POOL_DEFAULT 4
+
+/** A pooled runner that is idle for this long leaves the pool. */
+#define RUNNER_IDLE_TIMEOUT 1000000
+
+/** Member of timeout_tree. */
 typedef struct {
-	link_t link;
+	odlink_t link;
 	struct timespec expires;
 	fibril_event_t *event;
 } _timeout_t;
@@ -76,6 +87,29 @@ typedef struct {
 	ipc_call_t call;
 } _ipc_buffer_t;
 
+/**
+ * Scheduling state of one runner thread.
+ *
+ * Every runner has its own queue of ready fibrils. A fibril that becomes
+ * ready is queued on the runner that made it ready, so that wakeups stay
+ * on the CPU that has the waker's data in cache. An idle runner takes
+ * work from its own queue first and steals from the others after that.
+ */
+typedef struct fibril_runner {
+	/** Protects ready. */
+	futex_t lock;
+	/** Ready fibrils in FIFO order. */
+	list_t ready;
+	/** Length of ready, so that empty queues can be skipped unlocked. */
+	atomic_size_t ready_count;
+	/** Fibrils waiting for IPC on this runner, under ipc_lists_futex. */
+	list_t ipc_waiters;
+	/** Next registered runner, NULL for the last one. */
+	struct fibril_runner *_Atomic next;
+	/** Member of the runner pool, may be parked when idle. */
+	bool pooled;
+} _runner_t;
+
 typedef enum {
 	SWITCH_FROM_DEAD,
 	SWITCH_FROM_HELPER,
@@ -85,17 +119,28 @@ typedef enum {
 
 static bool multithreaded = false;
 
-/* This futex serializes access to global data. */
+/*
+ * This futex serializes access to global data, i.e. the fibril and timeout
+ * lists and the list of runners.
+ */
 static futex_t fibril_futex;
 static futex_t ready_semaphore;
 static long ready_st_count;
 
-static LIST_INITIALIZE(ready_list);
 static LIST_INITIALIZE(fibril_list);
-static LIST_INITIALIZE(timeout_list);
+
+/*
+ * Pending timeouts ordered by expiration. The tree keeps insertion and
+ * cancellation logarithmic and the earliest timeout at hand even with
+ * many thousands of timed waits outstanding.
+ */
+static odict_t timeout_tree;
+
+/* The main thread's runner is the head of the runner list. */
+static _runner_t main_runner;
+static _runner_t *last_runner = &main_runner;
 
 static futex_t ipc_lists_futex;
-static LIST_INITIALIZE(ipc_waiter_list);
 static LIST_INITIALIZE(ipc_buffer_list);
 static LIST_INITIALIZE(ipc_buffer_free_list);
 
@@ -110,7 +155,7 @@ static inline void _ready_debug_check(void)
 {
 #ifdef READY_DEBUG
 	assert(!multithreaded);
-	long count = (long) list_count(&ready_list) +
+	long count = (long) list_count(&main_runner.ready) +
 	    (long) list_count(&ipc_buffer_free_list);
 	assert(ready_st_count == count);
 #endif
@@ -136,8 +181,145 @@ static inline errno_t _ready_down(const struct timespec *expires)
 	return EOK;
 }
 
+/** Take a token without blocking, if one is available. */
+static inline bool _ready_trydown(void)
+{
+	if (multithreaded)
+		return futex_trydown(&ready_semaphore);
+
+	_ready_debug_check();
+	if (ready_st_count == 0)
+		return false;
+
+	ready_st_count--;
+	return true;
+}
+
 static atomic_int threads_in_ipc_wait;
 
+/*
+ * The runner pool (see fibril_enable_runner_pool()). Pooled runners that
+ * stay idle park on park_futex, as long as more than pool_keep of them
+ * are active. They are unparked again when work is queued and no runner
+ * is idle to pick it up.
+ */
+static futex_t pool_futex;
+static futex_t park_futex;
+static int pool_size;
+static atomic_int pool_keep;
+static atomic_int pool_active;
+static atomic_int runners_parked;
+
+/* Runners waiting for work in their helper fibril. */
+static atomic_int runners_idle;
+
+static errno_t _runner_init(_runner_t *r)
+{
+	if (futex_initialize(&r->lock, 1) != EOK)
+		return ENOMEM;
+
+	list_initialize(&r->ready);
+	atomic_init(&r->ready_count, 0);
+	list_initialize(&r->ipc_waiters);
+	atomic_init(&r->next, NULL);
+	r->pooled = false;
+	return EOK;
+}
+
+/** Wake up a parked runner if there is ready work and nobody to do it. */
+static void _runner_unpark(void)
+{
+	int parked = atomic_load(&runners_parked);
+
+	while (parked > 0) {
+		if (atomic_load(&runners_idle) > 0)
+			return;
+
+		if (atomic_compare_exchange_weak(&runners_parked, &parked,
+		    parked - 1)) {
+			futex_up(&park_futex);
+			return;
+		}
+	}
+}
+
+/** Park the current pooled runner, unless the pool is at its minimum. */
+static void _runner_park(void)
+{
+	int active = atomic_load(&pool_active);
+
+	do {
+		if (active <= atomic_load(&pool_keep))
+			return;
+	} while (!atomic_compare_exchange_weak(&pool_active, &active,
+	    active - 1));
+
+	atomic_fetch_add(&runners_parked, 1);
+	futex_down(&park_futex);
+	atomic_fetch_add(&pool_active, 1);
+}
+
+/** @return the runner the current fibril is running on. */
+static inline _runner_t *_runner_self(void)
+{
+	fibril_t *ctx = fibril_self()->thread_ctx;
+
+	/* The main thread may run without a helper fibril for a while. */
+	return (ctx != NULL) ? ctx->runner : &main_runner;
+}
+
+/** @return the runner after r in the runner list, wrapping around. */
+static inline _runner_t *_runner_next(_runner_t *r)
+{
+	_runner_t *next = atomic_load_explicit(&r->next, memory_order_acquire);
+	return (next != NULL) ? next : &main_runner;
+}
+
+static void _runner_push(_runner_t *r, fibril_t *f)
+{
+	futex_lock(&r->lock);
+	list_append(&f->link, &r->ready);
+	atomic_fetch_add(&r->ready_count, 1);
+	futex_unlock(&r->lock);
+}
+
+static fibril_t *_runner_pop(_runner_t *r)
+{
+	if (atomic_load(&r->ready_count) == 0)
+		return NULL;
+
+	futex_lock(&r->lock);
+	fibril_t *f = list_pop(&r->ready, fibril_t, link);
+	if (f)
+		atomic_fetch_sub(&r->ready_count, 1);
+	futex_unlock(&r->lock);
+	return f;
+}
+
+/**
+ * Take a ready fibril from the current runner's queue or, if that is empty,
+ * steal one from another runner, starting with the next one in the list so
+ * that idle runners do not all go after the same queue.
+ */
+static fibril_t *_ready_queue_pop(void)
+{
+	_runner_t *self = _runner_self();
+
+	fibril_t *f = _runner_pop(self);
+	if (f)
+		return f;
+
+	for (_runner_t *r = _runner_next(self); r != self; r = _runner_next(r)) {
+		f = _runner_pop(r);
+		if (f)
+			return f;
+	}
+
+	return NULL;
+}
+
+static void _fibril_after_switch(void);
+
 /** Function that spans the whole life-cycle of a fibril.
  *
  * Each fibril begins execution in this function. Then the function implementing
@@ -147,8 +329,7 @@ static atomic_int threads_in_ipc_wait;
  */
 static void _fibril_main(void)
 {
-	/* fibril_futex is locked when a fibril is started. */
-	futex_unlock(&fibril_futex);
+	_fibril_after_switch();
 
 	fibril_t *fibril = fibril_self();
 
@@ -212,47 +393,63 @@ static fibril_t *_fibril_trigger_internal(fibril_event_t *event, fibril_t *reaso
 	assert(reason != _EVENT_INITIAL);
 	assert(reason == _EVENT_TIMED_OUT || reason == _EVENT_TRIGGERED);
 
-	futex_assert_is_locked(&fibril_futex);
+	fibril_t *f = atomic_load(&event->fibril);
 
-	if (event->fibril == _EVENT_INITIAL) {
-		event->fibril = reason;
-		return NULL;
-	}
+	do {
+		if (f == _EVENT_TRIGGERED) {
+			/* Already triggered. Nothing to do. */
+			return NULL;
+		}
 
-	if (event->fibril == _EVENT_TIMED_OUT) {
-		assert(reason == _EVENT_TRIGGERED);
-		event->fibril = reason;
-		return NULL;
-	}
+		if (f == _EVENT_TIMED_OUT)
+			assert(reason == _EVENT_TRIGGERED);
+	} while (!atomic_compare_exchange_weak(&event->fibril, &f, reason));
 
-	if (event->fibril == _EVENT_TRIGGERED) {
-		/* Already triggered. Nothing to do. */
+	if (f == _EVENT_INITIAL || f == _EVENT_TIMED_OUT)
 		return NULL;
-	}
-
-	fibril_t *f = event->fibril;
-	event->fibril = reason;
 
 	assert(f->sleep_event == event);
 	return f;
 }
 
-static errno_t _ipc_wait(ipc_call_t *call, const struct timespec *expires)
+static void _ready_list_push(fibril_t *f)
+{
+	if (!f)
+		return;
+
+	/* Enqueue on the waker's runner. */
+	_runner_push(_runner_self(), f);
+	_ready_up();
+
+	if (atomic_load(&threads_in_ipc_wait)) {
+		DPRINTF("Poking.\n");
+		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
+		ipc_poke();
+	}
+
+	_runner_unpark();
+}
+
+static errno_t _ipc_wait(ipc_call_t *calls, size_t count, size_t *received,
+    const struct timespec *expires)
 {
 	if (!expires)
-		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NONE);
+		return ipc_wait_batch(calls, count, SYNCH_NO_TIMEOUT,
+		    SYNCH_FLAGS_NONE, received);
 
 	if (expires->tv_sec == 0)
-		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING);
+		return ipc_wait_batch(calls, count, SYNCH_NO_TIMEOUT,
+		    SYNCH_FLAGS_NON_BLOCKING, received);
 
 	struct timespec now;
 	getuptime(&now);
 
 	if (ts_gteq(&now, expires))
-		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING);
+		return ipc_wait_batch(calls, count, SYNCH_NO_TIMEOUT,
+		    SYNCH_FLAGS_NON_BLOCKING, received);
 
-	return ipc_wait(call, NSEC2USEC(ts_sub_diff(expires, &now)),
-	    SYNCH_FLAGS_NONE);
+	return ipc_wait_batch(calls, count, NSEC2USEC(ts_sub_diff(expires, &now)),
+	    SYNCH_FLAGS_NONE, received);
 }
 
 /*
@@ -260,16 +457,9 @@ static errno_t _ipc_wait(ipc_call_t *call, const struct timespec *expires)
  * Returns NULL on timeout and may also return NULL if returning from IPC
  * wait after new ready fibrils are added.
  */
-static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
+static fibril_t *_ready_list_pop(const struct timespec *expires)
 {
-	if (locked) {
-		futex_assert_is_locked(&fibril_futex);
-		assert(expires);
-		/* Must be nonblocking. */
-		assert(expires->tv_sec == 0);
-	} else {
-		futex_assert_is_not_locked(&fibril_futex);
-	}
+	futex_assert_is_not_locked(&fibril_futex);
 
 	errno_t rc = _ready_down(expires);
 	if (rc != EOK)
@@ -282,31 +472,53 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	 * for each entry of the call buffer.
 	 */
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-	fibril_t *f = list_pop(&ready_list, fibril_t, link);
-	if (!f)
-		atomic_fetch_add_explicit(&threads_in_ipc_wait, 1,
-		    memory_order_relaxed);
-	if (!locked)
-		futex_unlock(&fibril_futex);
-
+	fibril_t *f = _ready_queue_pop();
 	if (f)
 		return f;
 
+	/*
+	 * Announce the IPC wait before looking at the queues once more.
+	 * A concurrent _ready_list_push() either queues its fibril before
+	 * we look, or sees the announcement and pokes us out of the wait.
+	 */
+	atomic_fetch_add(&threads_in_ipc_wait, 1);
+
+	/*
+	 * Every received call needs a token of its own, which either stays
+	 * with the buffer entry the call is put into or is returned when
+	 * the call is handed to a waiting fibril. Take as many tokens as are
+	 * available without blocking, to receive that many calls at once.
+	 */
+	size_t tokens = 1;
+	while ((tokens < IPC_WAIT_BATCH) && (_ready_trydown()))
+		tokens++;
+
+	f = _ready_queue_pop();
+	if (f) {
+		atomic_fetch_sub(&threads_in_ipc_wait, 1);
+
+		/* Return the extra tokens. */
+		for (size_t i = 1; i < tokens; i++)
+			_ready_up();
+
+		return f;
+	}
+
 	if (!multithreaded)
 		assert(list_empty(&ipc_buffer_list));
 
 	/* No fibril is ready, IPC wait it is. */
-	ipc_call_t call = { 0 };
-	rc = _ipc_wait(&call, expires);
+	ipc_call_t calls[IPC_WAIT_BATCH];
+	size_t received = 0;
+	rc = _ipc_wait(calls, tokens, &received, expires);
 
-	atomic_fetch_sub_explicit(&threads_in_ipc_wait, 1,
-	    memory_order_relaxed);
+	atomic_fetch_sub(&threads_in_ipc_wait, 1);
 
 	if (rc != EOK && rc != ENOENT) {
-		/* Return token. */
-		_ready_up();
+		/* Return tokens. */
+		for (size_t i = 0; i < tokens; i++)
+			_ready_up();
+
 		return NULL;
 	}
 
@@ -315,66 +527,83 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	 * In that case, we propagate the null call out of fibril_ipc_wait(),
 	 * because poke must result in that call returning.
 	 */
+	if (rc == ENOENT) {
+		calls[0] = (ipc_call_t) { 0 };
+		received = 1;
+	}
+
+	assert(received > 0 && received <= tokens);
 
 	/*
 	 * If a fibril is already waiting for IPC, we wake up the fibril,
 	 * and return the token to ready_semaphore.
 	 * If there is no fibril waiting, we pop a buffer bucket and
 	 * put our call there. The token then returns when the bucket is
-	 * returned.
+	 * returned. Waiters on our own runner are preferred, the call is
+	 * then handled on the CPU that received it.
 	 */
 
-	if (!locked)
-		futex_lock(&fibril_futex);
+	fibril_t *woken[IPC_WAIT_BATCH];
+	size_t woken_count = 0;
 
 	futex_lock(&ipc_lists_futex);
 
-	_ipc_waiter_t *w = list_pop(&ipc_waiter_list, _ipc_waiter_t, link);
-	if (w) {
-		*w->call = call;
-		w->rc = rc;
-		/* We switch to the woken up fibril immediately if possible. */
-		f = _fibril_trigger_internal(&w->event, _EVENT_TRIGGERED);
+	_runner_t *self = _runner_self();
 
-		/* Return token. */
-		_ready_up();
-	} else {
-		_ipc_buffer_t *buf = list_pop(&ipc_buffer_free_list, _ipc_buffer_t, link);
-		assert(buf);
-		*buf = (_ipc_buffer_t) { .call = call, .rc = rc };
-		list_append(&buf->link, &ipc_buffer_list);
+	for (size_t i = 0; i < received; i++) {
+		_runner_t *r = self;
+		_ipc_waiter_t *w;
+		while (!(w = list_pop(&r->ipc_waiters, _ipc_waiter_t, link))) {
+			r = _runner_next(r);
+			if (r == self)
+				break;
+		}
+
+		if (w) {
+			*w->call = calls[i];
+			w->rc = rc;
+
+			/*
+			 * We switch to the first woken up fibril immediately
+			 * if possible, the others are made ready.
+			 */
+			fibril_t *wf = _fibril_trigger_internal(&w->event,
+			    _EVENT_TRIGGERED);
+			if (f == NULL)
+				f = wf;
+			else if (wf != NULL)
+				woken[woken_count++] = wf;
+
+			/* Return token. */
+			_ready_up();
+		} else {
+			_ipc_buffer_t *buf = list_pop(&ipc_buffer_free_list,
+			    _ipc_buffer_t, link);
+			assert(buf);
+			*buf = (_ipc_buffer_t) { .call = calls[i], .rc = rc };
+			list_append(&buf->link, &ipc_buffer_list);
+
+			/* Nobody was waiting for the call, the task is falling behind. */
+			_runner_unpark();
+		}
 	}
 
 	futex_unlock(&ipc_lists_futex);
 
-	if (!locked)
-		futex_unlock(&fibril_futex);
+	/* Return the tokens of the calls we did not receive. */
+	for (size_t i = received; i < tokens; i++)
+		_ready_up();
+
+	for (size_t i = 0; i < woken_count; i++)
+		_ready_list_push(woken[i]);
 
 	return f;
 }
 
-static fibril_t *_ready_list_pop_nonblocking(bool locked)
+static fibril_t *_ready_list_pop_nonblocking(void)
 {
 	struct timespec tv = { .tv_sec = 0, .tv_nsec = 0 };
-	return _ready_list_pop(&tv, locked);
-}
-
-static void _ready_list_push(fibril_t *f)
-{
-	if (!f)
-		return;
-
-	futex_assert_is_locked(&fibril_futex);
-
-	/* Enqueue in ready_list. */
-	list_append(&f->link, &ready_list);
-	_ready_up();
-
-	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed)) {
-		DPRINTF("Poking.\n");
-		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
-		ipc_poke();
-	}
+	return _ready_list_pop(&tv);
 }
 
 /* Blocks the current fibril until an IPC call arrives. */
@@ -398,7 +627,7 @@ static errno_t _wait_ipc(ipc_call_t *call, const struct timespec *expires)
 	}
 
 	_ipc_waiter_t w = { .call = call };
-	list_append(&w.link, &ipc_waiter_list);
+	list_append(&w.link, &_runner_self()->ipc_waiters);
 	futex_unlock(&ipc_lists_futex);
 
 	errno_t rc = fibril_wait_timeout(&w.event, expires);
@@ -422,9 +651,9 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 
 	futex_lock(&fibril_futex);
 
-	while (!list_empty(&timeout_list)) {
-		link_t *cur = list_first(&timeout_list);
-		_timeout_t *to = list_get_instance(cur, _timeout_t, link);
+	odlink_t *cur;
+	while ((cur = odict_first(&timeout_tree)) != NULL) {
+		_timeout_t *to = odict_get_instance(cur, _timeout_t, link);
 
 		if (ts_gt(&to->expires, &ts)) {
 			*next_timeout = to->expires;
@@ -432,7 +661,7 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 			return next_timeout;
 		}
 
-		list_remove(&to->link);
+		odict_remove(&to->link);
 
 		_ready_list_push(_fibril_trigger_internal(
 		    to->event, _EVENT_TIMED_OUT));
@@ -443,65 +672,79 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 }
 
 /**
- * Clean up after a dead fibril from which we restored context, if any.
- * Called after a switch is made and fibril_futex is unlocked.
+ * Finish the switch away from the fibril whose context we just restored from.
+ *
+ * The context of the source fibril is only complete once context_swap()
+ * returns in the destination, so it must not be made ready or published
+ * to its event before that, or another runner could resume a half-saved
+ * context. The destination fibril does it here instead.
  */
-static void _fibril_cleanup_dead(void)
+static void _fibril_after_switch(void)
 {
-	fibril_t *srcf = fibril_self();
-	if (!srcf->clean_after_me)
-		return;
+	fibril_t *self = fibril_self();
 
-	void *stack = srcf->clean_after_me->stack;
-	assert(stack);
-	as_area_destroy(stack);
-	fibril_teardown(srcf->clean_after_me);
-	srcf->clean_after_me = NULL;
+	fibril_t *f = self->ready_after_me;
+	if (f) {
+		self->ready_after_me = NULL;
+		_ready_list_push(f);
+	}
+
+	f = self->sleep_after_me;
+	if (f) {
+		self->sleep_after_me = NULL;
+
+		/* If the event fired in the meantime, the fibril is ready again. */
+		fibril_t *expected = _EVENT_INITIAL;
+		if (!atomic_compare_exchange_strong(&f->sleep_event->fibril,
+		    &expected, f))
+			_ready_list_push(f);
+	}
+
+	f = self->clean_after_me;
+	if (f) {
+		self->clean_after_me = NULL;
+
+		void *stack = f->stack;
+		assert(stack);
+		as_area_destroy(stack);
+		fibril_teardown(f);
+	}
 }
 
 /** Switch to a fibril. */
-static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
+static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf)
 {
 	assert(fibril_self()->rmutex_locks == 0);
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-	else
-		futex_assert_is_locked(&fibril_futex);
-
 	fibril_t *srcf = fibril_self();
 	assert(srcf);
 	assert(dstf);
 
 	switch (type) {
 	case SWITCH_FROM_YIELD:
-		_ready_list_push(srcf);
+		dstf->ready_after_me = srcf;
+		break;
+	case SWITCH_FROM_BLOCKED:
+		dstf->sleep_after_me = srcf;
 		break;
 	case SWITCH_FROM_DEAD:
 		dstf->clean_after_me = srcf;
 		break;
 	case SWITCH_FROM_HELPER:
-	case SWITCH_FROM_BLOCKED:
 		break;
 	}
 
 	dstf->thread_ctx = srcf->thread_ctx;
 	srcf->thread_ctx = NULL;
 
-	/* Just some bookkeeping to allow better debugging of futex locks. */
-	futex_give_to(&fibril_futex, dstf);
-
 	/* Swap to the next fibril. */
 	context_swap(&srcf->ctx, &dstf->ctx);
 
 	assert(srcf == fibril_self());
 	assert(srcf->thread_ctx);
 
-	if (!locked) {
-		/* Must be after context_swap()! */
-		futex_unlock(&fibril_futex);
-		_fibril_cleanup_dead();
-	}
+	/* Must be after context_swap()! */
+	_fibril_after_switch();
 }
 
 /**
@@ -515,17 +758,40 @@ static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
  */
 static errno_t _helper_fibril_fn(void *arg)
 {
+	fibril_t *self = fibril_self();
+
 	/* Set itself as the thread's own context. */
-	fibril_self()->thread_ctx = fibril_self();
+	self->thread_ctx = self;
 
-	(void) arg;
+	/* Spawned runners pass their runner, the main one is set up front. */
+	if (arg)
+		self->runner = arg;
+	assert(self->runner);
 
 	struct timespec next_timeout;
+	struct timespec idle;
 	while (true) {
 		struct timespec *to = _handle_expired_timeouts(&next_timeout);
-		fibril_t *f = _ready_list_pop(to, false);
+
+		/* Pooled runners wake up at least once per idle period. */
+		if (self->runner->pooled) {
+			getuptime(&idle);
+			ts_add_diff(&idle, USEC2NSEC(RUNNER_IDLE_TIMEOUT));
+			if (!to || ts_gt(to, &idle))
+				to = &idle;
+		}
+
+		atomic_fetch_add(&runners_idle, 1);
+		fibril_t *f = _ready_list_pop(to);
+		atomic_fetch_sub(&runners_idle, 1);
+
 		if (f) {
-			_fibril_switch_to(SWITCH_FROM_HELPER, f, false);
+			_fibril_switch_to(SWITCH_FROM_HELPER, f);
+		} else if (to == &idle) {
+			struct timespec now;
+			getuptime(&now);
+			if (ts_gteq(&now, &idle))
+				_runner_park();
 		}
 	}
 
@@ -595,22 +861,29 @@ void fibril_destroy(fid_t fid)
 	fibril_teardown(fibril);
 }
 
+static void *_timeout_key(odlink_t *link)
+{
+	return &odict_get_instance(link, _timeout_t, link)->expires;
+}
+
+static int _timeout_cmp(void *a, void *b)
+{
+	struct timespec *ta = a;
+	struct timespec *tb = b;
+
+	if (ts_gt(ta, tb))
+		return 1;
+	if (ts_gt(tb, ta))
+		return -1;
+	return 0;
+}
+
 static void _insert_timeout(_timeout_t *timeout)
 {
 	futex_assert_is_locked(&fibril_futex);
 	assert(timeout);
 
-	link_t *tmp = timeout_list.head.next;
-	while (tmp != &timeout_list.head) {
-		_timeout_t *cur = list_get_instance(tmp, _timeout_t, link);
-
-		if (ts_gteq(&cur->expires, &timeout->expires))
-			break;
-
-		tmp = tmp->next;
-	}
-
-	list_insert_before(&timeout->link, tmp);
+	odict_insert(&timeout->link, &timeout_tree, NULL);
 }
 
 /**
@@ -630,80 +903,89 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 
 	DPRINTF("### Fibril %p sleeping on event %p.\n", fibril_self(), event);
 
+	/* Submit the calls queued by this fibril before it stops running. */
+	async_flush();
+
 	if (!fibril_self()->thread_ctx) {
-		fibril_self()->thread_ctx =
-		    fibril_create_generic(_helper_fibril_fn, NULL, PAGE_SIZE);
-		if (!fibril_self()->thread_ctx)
+		fibril_t *helper = (fibril_t *) fibril_create_generic(
+		    _helper_fibril_fn, NULL, PAGE_SIZE);
+		if (!helper)
 			return ENOMEM;
-	}
 
-	futex_lock(&fibril_futex);
+		helper->runner = &main_runner;
+		fibril_self()->thread_ctx = helper;
+	}
 
-	if (event->fibril == _EVENT_TRIGGERED) {
+	fibril_t *state = _EVENT_TRIGGERED;
+	if (atomic_compare_exchange_strong(&event->fibril, &state,
+	    _EVENT_INITIAL)) {
 		DPRINTF("### Already triggered. Returning. \n");
-		event->fibril = _EVENT_INITIAL;
-		futex_unlock(&fibril_futex);
 		return EOK;
 	}
 
-	assert(event->fibril == _EVENT_INITIAL);
+	assert(state == _EVENT_INITIAL);
 
 	fibril_t *srcf = fibril_self();
 	fibril_t *dstf = NULL;
 
 	/*
 	 * We cannot block here waiting for another fibril becoming
-	 * ready, since that would require unlocking the fibril_futex,
-	 * and that in turn would allow another thread to restore
+	 * ready, since another thread could then wake and restore
 	 * the source fibril before this thread finished switching.
 	 *
 	 * Instead, we switch to an internal "helper" fibril whose only
 	 * job is to wait for an event, freeing the source fibril for
 	 * wakeups. There is always one for each running thread.
+	 * The source fibril is published to the event by whichever
+	 * fibril we switch to, once our context is saved.
 	 */
 
-	dstf = _ready_list_pop_nonblocking(true);
+	dstf = _ready_list_pop_nonblocking();
 	if (!dstf) {
 		// XXX: It is possible for the _ready_list_pop_nonblocking() to
 		//      check for IPC, find a pending message, and trigger the
 		//      event on which we are currently trying to sleep.
-		if (event->fibril == _EVENT_TRIGGERED) {
-			event->fibril = _EVENT_INITIAL;
-			futex_unlock(&fibril_futex);
+		state = _EVENT_TRIGGERED;
+		if (atomic_compare_exchange_strong(&event->fibril, &state,
+		    _EVENT_INITIAL))
 			return EOK;
-		}
 
 		dstf = srcf->thread_ctx;
 		assert(dstf);
 	}
 
 	_timeout_t timeout = { 0 };
+	odlink_initialize(&timeout.link);
 	if (expires) {
 		timeout.expires = *expires;
 		timeout.event = event;
+
+		futex_lock(&fibril_futex);
 		_insert_timeout(&timeout);
+		futex_unlock(&fibril_futex);
 	}
 
 	assert(srcf);
 
-	event->fibril = srcf;
 	srcf->sleep_event = event;
 
-	assert(event->fibril != _EVENT_INITIAL);
+	_fibril_switch_to(SWITCH_FROM_BLOCKED, dstf);
 
-	_fibril_switch_to(SWITCH_FROM_BLOCKED, dstf, true);
+	if (expires) {
+		futex_lock(&fibril_futex);
+		/* An expired timeout has already been removed. */
+		if (odlink_used(&timeout.link))
+			odict_remove(&timeout.link);
+		futex_unlock(&fibril_futex);
+	}
 
-	assert(event->fibril != srcf);
-	assert(event->fibril != _EVENT_INITIAL);
-	assert(event->fibril == _EVENT_TIMED_OUT || event->fibril == _EVENT_TRIGGERED);
+	state = atomic_exchange(&event->fibril, _EVENT_INITIAL);
 
-	list_remove(&timeout.link);
-	errno_t rc = (event->fibril == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
-	event->fibril = _EVENT_INITIAL;
+	assert(state != srcf);
+	assert(state != _EVENT_INITIAL);
+	assert(state == _EVENT_TIMED_OUT || state == _EVENT_TRIGGERED);
 
-	futex_unlock(&fibril_futex);
-	_fibril_cleanup_dead();
-	return rc;
+	return (state == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
 }
 
 void fibril_wait_for(fibril_event_t *event)
@@ -721,9 +1003,7 @@ void fibril_wait_for(fibril_event_t *event)
  */
 void fibril_notify(fibril_event_t *event)
 {
-	futex_lock(&fibril_futex);
 	_ready_list_push(_fibril_trigger_internal(event, _EVENT_TRIGGERED));
-	futex_unlock(&fibril_futex);
 }
 
 /** Start a fibril that has not been running yet. */
@@ -736,9 +1016,9 @@ void fibril_start(fibril_t *fibril)
 	if (!link_in_use(&fibril->all_link))
 		list_append(&fibril->all_link, &fibril_list);
 
-	_ready_list_push(fibril);
-
 	futex_unlock(&fibril_futex);
+
+	_ready_list_push(fibril);
 }
 
 /** Start a fibril that has not been running yet. (obsolete) */
@@ -775,9 +1055,11 @@ void fibril_yield(void)
 	if (fibril_self()->rmutex_locks > 0)
 		return;
 
-	fibril_t *f = _ready_list_pop_nonblocking(false);
+	async_flush();
+
+	fibril_t *f = _ready_list_pop_nonblocking();
 	if (f)
-		_fibril_switch_to(SWITCH_FROM_YIELD, f, false);
+		_fibril_switch_to(SWITCH_FROM_YIELD, f);
 }
 
 static void _runner_fn(void *arg)
@@ -785,15 +1067,8 @@ static void _runner_fn(void *arg)
 	_helper_fibril_fn(arg);
 }
 
-/**
- * Spawn a given number of runners (i.e. OS threads) immediately, and
- * unconditionally. This is meant to be used for tests and debugging.
- * Regular programs should just use `fibril_enable_multithreaded()`.
- *
- * @param n  Number of runners to spawn.
- * @return   Number of runners successfully spawned.
- */
-int fibril_test_spawn_runners(int n)
+/** Spawn one more runner thread. */
+static errno_t _runner_spawn(bool pooled)
 {
 	assert(fibril_self()->rmutex_locks == 0);
 
@@ -804,35 +1079,136 @@ int fibril_test_spawn_runners(int n)
 		multithreaded = true;
 	}
 
-	errno_t rc;
+	_runner_t *r = malloc(sizeof(_runner_t));
+	if (!r)
+		return ENOMEM;
+
+	errno_t rc = _runner_init(r);
+	if (rc != EOK) {
+		free(r);
+		return rc;
+	}
+
+	r->pooled = pooled;
+	if (pooled)
+		atomic_fetch_add(&pool_active, 1);
+
+	/*
+	 * The runner is registered before its thread starts, so that
+	 * its queue is visible to thieves from the first push on.
+	 * Runners are never unregistered. If the thread cannot be
+	 * created, the runner just never gets any work.
+	 */
+	futex_lock(&fibril_futex);
+	atomic_store_explicit(&last_runner->next, r, memory_order_release);
+	last_runner = r;
+	futex_unlock(&fibril_futex);
+
+	thread_id_t tid;
+	rc = thread_create(_runner_fn, r, "fibril runner", &tid);
+	if (rc != EOK) {
+		if (pooled)
+			atomic_fetch_sub(&pool_active, 1);
+		return rc;
+	}
 
+	thread_detach(tid);
+	return EOK;
+}
+
+/**
+ * Spawn a given number of runners (i.e. OS threads) immediately, and
+ * unconditionally. This is meant to be used for tests and debugging.
+ * Regular programs should just use `fibril_enable_multithreaded()`.
+ *
+ * @param n  Number of runners to spawn.
+ * @return   Number of runners successfully spawned.
+ */
+int fibril_test_spawn_runners(int n)
+{
 	for (int i = 0; i < n; i++) {
-		thread_id_t tid;
-		rc = thread_create(_runner_fn, NULL, "fibril runner", &tid);
-		if (rc != EOK)
+		if (_runner_spawn(false) != EOK)
 			return i;
-		thread_detach(tid);
 	}
 
 	return n;
 }
 
+/** @return number of CPUs in the system. */
+static int _cpu_count(void)
+{
+	size_t size = 0;
+	void *cpus = sysinfo_get_data("system.cpus", &size);
+	free(cpus);
+
+	size_t count = size / sizeof(stats_cpu_t);
+	return (count > 0) ? (int) count : 1;
+}
+
+/**
+ * Run the task's fibrils on a pool of runner threads.
+ *
+ * The pool grows up to @a max runners while there is more work, i.e. ready
+ * fibrils or incoming IPC calls, than the active runners pick up. Runners
+ * that stay idle for a while are parked, down to @a min active runners.
+ *
+ * The pool never shrinks below the runners spawned earlier, so calling
+ * this again can only raise the limits.
+ *
+ * @param min  Runners that are always active, including the main thread.
+ * @param max  Maximum number of runners including the main thread, or zero
+ *             for one per CPU (but at least RUNNER_POOL_DEFAULT).
+ */
+void fibril_enable_runner_pool(int min, int max)
+{
+	if (max <= 0) {
+		max = _cpu_count();
+		if (max < RUNNER_POOL_DEFAULT)
+			max = RUNNER_POOL_DEFAULT;
+	}
+
+	if (min < 1)
+		min = 1;
+	if (min > max)
+		min = max;
+
+	futex_lock(&pool_futex);
+
+	/* The main thread is not part of the pool. */
+	if (min - 1 > atomic_load(&pool_keep))
+		atomic_store(&pool_keep, min - 1);
+
+	while (pool_size < max - 1) {
+		if (_runner_spawn(true) != EOK)
+			break;
+		pool_size++;
+	}
+
+	futex_unlock(&pool_futex);
+}
+
 /**
  * Opt-in to have more than one runner thread.
  *
  * Currently, a task only ever runs in one thread because multithreading
- * might break some existing code.
- *
- * Eventually, the number of runner threads for a given task should become
- * configurable in the environment and this function becomes no-op.
+ * might break some existing code. This enables the default runner pool,
+ * with one runner per CPU.
  */
 void fibril_enable_multithreaded(void)
 {
-	// TODO: Implement better.
-	//       For now, 4 total runners is a sensible default.
-	if (!multithreaded) {
-		fibril_test_spawn_runners(3);
-	}
+	fibril_enable_runner_pool(1, 0);
+}
+
+/**
+ * Check whether the task may run fibrils in more than one thread.
+ *
+ * Once this returns true it never goes back to false. The flag is set
+ * before any additional runner is spawned, so code that only touches
+ * data from fibrils can skip atomic operations while this is false.
+ */
+bool fibril_is_multithreaded(void)
+{
+	return multithreaded;
 }
 
 /**
@@ -845,6 +1221,53 @@ void fibril_detach(fid_t f)
 	//       limited lifetime should call this function.
 }
 
+/**
+ * Register a function to be called when the current fibril exits.
+ *
+ * The functions are called in the reverse order of their registration,
+ * in the context of the exiting fibril, so they can still access its
+ * fibril-local variables. This is used to destroy C++ thread_local
+ * objects. For the main fibril and fibrils that started a thread,
+ * the functions are called when the program or the thread exits.
+ *
+ * @param func  Function to call.
+ * @param arg   Argument to pass to the function.
+ * @return      EOK on success, ENOMEM if out of memory.
+ */
+errno_t fibril_add_exit_hook(void (*func)(void *), void *arg)
+{
+	fibril_exit_hook_t *hook = malloc(sizeof(fibril_exit_hook_t));
+	if (!hook)
+		return ENOMEM;
+
+	fibril_t *f = fibril_self();
+
+	hook->func = func;
+	hook->arg = arg;
+	hook->next = f->exit_hooks;
+	f->exit_hooks = hook;
+
+	return EOK;
+}
+
+/**
+ * Call the exit hooks of the current fibril.
+ *
+ * Hooks registered by the hooks themselves are called as well.
+ */
+void fibril_run_exit_hooks(void)
+{
+	fibril_t *f = fibril_self();
+
+	while (f->exit_hooks) {
+		fibril_exit_hook_t *hook = f->exit_hooks;
+		f->exit_hooks = hook->next;
+
+		hook->func(hook->arg);
+		free(hook);
+	}
+}
+
 /**
  * Exit a fibril. Never returns.
  *
@@ -855,20 +1278,31 @@ _Noreturn void fibril_exit(long retval)
 	// TODO: implement fibril_join() and remember retval
 	(void) retval;
 
-	fibril_t *f = _ready_list_pop_nonblocking(false);
+	fibril_run_exit_hooks();
+	async_flush();
+
+	fibril_t *f = _ready_list_pop_nonblocking();
 	if (!f)
 		f = fibril_self()->thread_ctx;
 
-	_fibril_switch_to(SWITCH_FROM_DEAD, f, false);
+	_fibril_switch_to(SWITCH_FROM_DEAD, f);
 	__builtin_unreachable();
 }
 
 void __fibrils_init(void)
 {
+	odict_initialize(&timeout_tree, _timeout_key, _timeout_cmp);
+
 	if (futex_initialize(&fibril_futex, 1) != EOK)
 		abort();
 	if (futex_initialize(&ipc_lists_futex, 1) != EOK)
 		abort();
+	if (_runner_init(&main_runner) != EOK)
+		abort();
+	if (futex_initialize(&pool_futex, 1) != EOK)
+		abort();
+	if (futex_initialize(&park_futex, 0) != EOK)
+		abort();
 
 	/*
 	 * We allow a fixed, small amount of parallelism for IPC reads, but
@@ -889,6 +1323,9 @@ void __fibrils_fini(void)
 {
 	futex_destroy(&fibril_futex);
 	futex_destroy(&ipc_lists_futex);
+	futex_destroy(&main_runner.lock);
+	futex_destroy(&pool_futex);
+	futex_destroy(&park_futex);
 }
 
 void fibril_usleep(usec_t timeout)
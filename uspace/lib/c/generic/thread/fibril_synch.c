@@ -205,6 +205,53 @@ bool fibril_mutex_trylock(fibril_mutex_t *fm)
 	return locked;
 }
 
+/** Lock fibril mutex, giving up at a deadline.
+ *
+ * @param fm       Fibril mutex.
+ * @param expires  Absolute uptime at which to give up waiting,
+ *                 NULL to wait indefinitely.
+ *
+ * @return EOK if the mutex was acquired, ETIMEOUT if the deadline passed
+ *         before the mutex became available.
+ */
+errno_t fibril_mutex_lock_until(fibril_mutex_t *fm,
+    const struct timespec *expires)
+{
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	futex_lock(&fibril_synch_futex);
+
+	if (fm->counter-- > 0) {
+		fm->oi.owned_by = f;
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	awaiter_t wdata = AWAITER_INIT;
+	list_append(&wdata.link, &fm->waiters);
+	check_for_deadlock(&fm->oi);
+	f->waits_for = &fm->oi;
+
+	futex_unlock(&fibril_synch_futex);
+
+	(void) fibril_wait_timeout(&wdata.event, expires);
+
+	/*
+	 * The unlocking fibril removes us from the wait queue when it hands
+	 * the mutex over, so a link still in use means we timed out.
+	 */
+	futex_lock(&fibril_synch_futex);
+	bool timed_out = link_in_use(&wdata.link);
+	if (timed_out) {
+		list_remove(&wdata.link);
+		fm->counter++;
+		f->waits_for = NULL;
+	}
+	futex_unlock(&fibril_synch_futex);
+
+	return timed_out ? ETIMEOUT : EOK;
+}
+
 static void _fibril_mutex_unlock_unsafe(fibril_mutex_t *fm)
 {
 	assert(fm->oi.owned_by == (fibril_t *) fibril_get_id());
@@ -297,34 +344,45 @@ void fibril_rwlock_write_lock(fibril_rwlock_t *frw)
 	fibril_wait_for(&wdata.event);
 }
 
-static void _fibril_rwlock_common_unlock(fibril_rwlock_t *frw)
+bool fibril_rwlock_read_trylock(fibril_rwlock_t *frw)
 {
-	if (frw->readers) {
-		if (--frw->readers) {
-			if (frw->oi.owned_by == (fibril_t *) fibril_get_id()) {
-				/*
-				 * If this reader fibril was considered the
-				 * owner of this rwlock, clear the ownership
-				 * information even if there are still more
-				 * readers.
-				 *
-				 * This is the limitation of the detection
-				 * mechanism rooted in the fact that tracking
-				 * all readers would require dynamically
-				 * allocated memory for keeping linkage info.
-				 */
-				frw->oi.owned_by = NULL;
-			}
+	bool locked = false;
 
-			return;
-		}
-	} else {
-		frw->writers--;
+	futex_lock(&fibril_synch_futex);
+	if (!frw->writers) {
+		if (frw->readers++ == 0)
+			frw->oi.owned_by = (fibril_t *) fibril_get_id();
+		locked = true;
 	}
+	futex_unlock(&fibril_synch_futex);
 
-	assert(!frw->readers && !frw->writers);
+	return locked;
+}
 
-	frw->oi.owned_by = NULL;
+bool fibril_rwlock_write_trylock(fibril_rwlock_t *frw)
+{
+	bool locked = false;
+
+	futex_lock(&fibril_synch_futex);
+	if (!frw->writers && !frw->readers) {
+		frw->oi.owned_by = (fibril_t *) fibril_get_id();
+		frw->writers++;
+		locked = true;
+	}
+	futex_unlock(&fibril_synch_futex);
+
+	return locked;
+}
+
+/** Hand the rwlock over to the waiters at the head of the queue.
+ *
+ * Wakes either a single writer or the longest run of readers that can
+ * share the lock. Must be called with fibril_synch_futex held and with
+ * no writer holding the lock.
+ */
+static void _fibril_rwlock_wake_waiters(fibril_rwlock_t *frw)
+{
+	assert(!frw->writers);
 
 	while (!list_empty(&frw->waiters)) {
 		link_t *tmp = list_first(&frw->waiters);
@@ -352,6 +410,118 @@ static void _fibril_rwlock_common_unlock(fibril_rwlock_t *frw)
 	}
 }
 
+static errno_t _fibril_rwlock_wait_until(fibril_rwlock_t *frw, bool writer,
+    const struct timespec *expires)
+{
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	f->is_writer = writer;
+
+	awaiter_t wdata = AWAITER_INIT;
+	list_append(&wdata.link, &frw->waiters);
+	check_for_deadlock(&frw->oi);
+	f->waits_for = &frw->oi;
+
+	futex_unlock(&fibril_synch_futex);
+
+	(void) fibril_wait_timeout(&wdata.event, expires);
+
+	futex_lock(&fibril_synch_futex);
+	bool timed_out = link_in_use(&wdata.link);
+	if (timed_out) {
+		list_remove(&wdata.link);
+		f->waits_for = NULL;
+
+		/*
+		 * A writer that gives up may have been the only thing keeping
+		 * the readers queued behind it from sharing the lock.
+		 */
+		if (!frw->writers)
+			_fibril_rwlock_wake_waiters(frw);
+	}
+	futex_unlock(&fibril_synch_futex);
+
+	return timed_out ? ETIMEOUT : EOK;
+}
+
+/** Lock fibril rwlock for reading, giving up at a deadline.
+ *
+ * @param frw      Fibril rwlock.
+ * @param expires  Absolute uptime at which to give up waiting,
+ *                 NULL to wait indefinitely.
+ *
+ * @return EOK if the lock was acquired, ETIMEOUT otherwise.
+ */
+errno_t fibril_rwlock_read_lock_until(fibril_rwlock_t *frw,
+    const struct timespec *expires)
+{
+	futex_lock(&fibril_synch_futex);
+
+	if (!frw->writers) {
+		if (frw->readers++ == 0)
+			frw->oi.owned_by = (fibril_t *) fibril_get_id();
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	return _fibril_rwlock_wait_until(frw, false, expires);
+}
+
+/** Lock fibril rwlock for writing, giving up at a deadline.
+ *
+ * @param frw      Fibril rwlock.
+ * @param expires  Absolute uptime at which to give up waiting,
+ *                 NULL to wait indefinitely.
+ *
+ * @return EOK if the lock was acquired, ETIMEOUT otherwise.
+ */
+errno_t fibril_rwlock_write_lock_until(fibril_rwlock_t *frw,
+    const struct timespec *expires)
+{
+	futex_lock(&fibril_synch_futex);
+
+	if (!frw->writers && !frw->readers) {
+		frw->oi.owned_by = (fibril_t *) fibril_get_id();
+		frw->writers++;
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	return _fibril_rwlock_wait_until(frw, true, expires);
+}
+
+static void _fibril_rwlock_common_unlock(fibril_rwlock_t *frw)
+{
+	if (frw->readers) {
+		if (--frw->readers) {
+			if (frw->oi.owned_by == (fibril_t *) fibril_get_id()) {
+				/*
+				 * If this reader fibril was considered the
+				 * owner of this rwlock, clear the ownership
+				 * information even if there are still more
+				 * readers.
+				 *
+				 * This is the limitation of the detection
+				 * mechanism rooted in the fact that tracking
+				 * all readers would require dynamically
+				 * allocated memory for keeping linkage info.
+				 */
+				frw->oi.owned_by = NULL;
+			}
+
+			return;
+		}
+	} else {
+		frw->writers--;
+	}
+
+	assert(!frw->readers && !frw->writers);
+
+	frw->oi.owned_by = NULL;
+
+	_fibril_rwlock_wake_waiters(frw);
+}
+
 void fibril_rwlock_read_unlock(fibril_rwlock_t *frw)
 {
 	futex_lock(&fibril_synch_futex);
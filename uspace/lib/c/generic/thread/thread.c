@@ -73,6 +73,7 @@ void __thread_main(uspace_arg_t *uarg)
 	 * free(uarg);
 	 */
 
+	fibril_run_exit_hooks();
 	fibril_teardown(fibril);
 	thread_exit(0);
 }
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ */
+
+#ifndef _LIBC_CHT_H_
+#define _LIBC_CHT_H_
+
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <macros.h>
+
+/** Number of write lock stripes of a concurrent hash table. */
+#define CHT_STRIPES  32
+
+/** Number of reader counters of a concurrent hash table per grace period. */
+#define CHT_READER_SLOTS  16
+
+/** Concurrent hash table link. */
+typedef struct cht_link {
+	/** Next item of the bucket. */
+	_Atomic(struct cht_link *) next;
+	/** Next item removed but not yet passed to remove_callback(). */
+	struct cht_link *retired;
+} cht_link_t;
+
+/** Set of operations for a concurrent hash table.
+ *
+ * Unlike with hash_table_ops_t, the functions are called concurrently
+ * and with locks held, so they must not block.
+ */
+typedef struct {
+	/** Returns the hash of the key stored in the item (ie its lookup key). */
+	size_t (*hash)(const cht_link_t *item);
+
+	/** Returns the hash of the key. */
+	size_t (*key_hash)(const void *key);
+
+	/** True if the items are equal (have the same lookup keys). */
+	bool (*equal)(const cht_link_t *item1, const cht_link_t *item2);
+
+	/** Returns true if the key is equal to the item's lookup key. */
+	bool (*key_equal)(const void *key, const cht_link_t *item);
+
+	/** Concurrent hash table item removal callback.
+	 *
+	 * Called once no reader can reference the item any longer, which
+	 * may be some time after the item was removed.
+	 *
+	 * @param item Item that was removed from the hash table.
+	 */
+	void (*remove_callback)(cht_link_t *item);
+} cht_ops_t;
+
+/** Array of buckets of a concurrent hash table. */
+typedef struct {
+	/** Number of buckets, a power of two. */
+	size_t bucket_cnt;
+	_Atomic(cht_link_t *) bucket[];
+} cht_buckets_t;
+
+/** Reader counter, kept in a cache line of its own. */
+typedef struct {
+	atomic_size_t cnt;
+	uint8_t pad[64 - sizeof(atomic_size_t)];
+} cht_readers_t;
+
+/** Concurrent hash table.
+ *
+ * Lookups only run in read sections and do not lock, insertions and
+ * removals lock one of CHT_STRIPES stripes of buckets. Resizing is done
+ * incrementally: items are moved from the old bucket array to the new one
+ * a few buckets at a time by the insertions and removals following it.
+ */
+typedef struct {
+	cht_ops_t *op;
+
+	/** Current bucket array. */
+	_Atomic(cht_buckets_t *) cur;
+	/** Bucket array being moved to cur, NULL if not resizing. */
+	_Atomic(cht_buckets_t *) old;
+	/** Next bucket of old to move. */
+	size_t moved_cnt;
+	/** Odd while items are being moved between the bucket arrays. */
+	atomic_size_t move_seq;
+	/** Serializes resizing. */
+	atomic_bool resizing;
+
+	atomic_size_t item_cnt;
+	size_t max_load;
+
+	/** Write locks of the buckets. */
+	atomic_bool stripe[CHT_STRIPES];
+
+	/** Grace period, its parity selects the reader counters. */
+	atomic_size_t epoch;
+	cht_readers_t readers[2][CHT_READER_SLOTS];
+
+	/** Serializes waiting for grace periods and retiring items. */
+	fibril_mutex_t retire_lock;
+	/** Removed items waiting for the end of a grace period. */
+	cht_link_t *retired;
+	size_t retired_cnt;
+} cht_t;
+
+/** Read section of a concurrent hash table. */
+typedef struct {
+	atomic_size_t *cnt;
+} cht_read_t;
+
+#define cht_get_inst(item, type, member) \
+	member_to_inst((item), type, member)
+
+extern bool cht_create(cht_t *, size_t, size_t, cht_ops_t *);
+extern void cht_destroy(cht_t *);
+
+extern size_t cht_size(cht_t *);
+
+extern void cht_read_lock(cht_t *, cht_read_t *);
+extern void cht_read_unlock(cht_t *, cht_read_t *);
+
+extern void cht_insert(cht_t *, cht_link_t *);
+extern bool cht_insert_unique(cht_t *, cht_link_t *);
+extern cht_link_t *cht_find(cht_t *, const void *);
+extern size_t cht_remove(cht_t *, const void *);
+extern void cht_remove_item(cht_t *, cht_link_t *);
+extern void cht_synchronize(cht_t *);
+
+#endif
+
+/** @}
+ */
@@ -49,6 +49,9 @@
 #include <abi/cap.h>
 
 #include <_bits/__noreturn.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 typedef sysarg_t aid_t;
 typedef sysarg_t port_id_t;
@@ -68,6 +71,14 @@ typedef void (*async_port_handler_t)(ipc_call_t *, void *);
 /** Notification handler */
 typedef void (*async_notification_handler_t)(ipc_call_t *, void *);
 
+/** Reply callback, see async_wait_callback()
+ *
+ * @param arg    Local argument.
+ * @param retval Return value of the answer.
+ *
+ */
+typedef void (*async_reply_cb_t)(void *, errno_t);
+
 /** Exchange management style
  *
  */
@@ -124,6 +135,8 @@ extern aid_t async_send_5(async_exch_t *, sysarg_t, sysarg_t, sysarg_t,
 extern void async_wait_for(aid_t, errno_t *);
 extern errno_t async_wait_timeout(aid_t, errno_t *, usec_t);
 extern void async_forget(aid_t);
+extern void async_wait_callback(aid_t, async_reply_cb_t, void *);
+extern void async_flush(void);
 
 extern void async_set_client_data_constructor(async_client_data_ctor_t);
 extern void async_set_client_data_destructor(async_client_data_dtor_t);
@@ -149,6 +162,9 @@ extern errno_t async_event_unsubscribe(event_type_t);
 extern errno_t async_event_task_unsubscribe(event_task_type_t);
 extern errno_t async_event_unmask(event_type_t);
 extern errno_t async_event_task_unmask(event_task_type_t);
+extern errno_t async_notification_create(async_notification_handler_t,
+    void *, sysarg_t *);
+extern errno_t async_notification_post(ipc_call_t *);
 
 /*
  * Wrappers for simple communication.
@@ -382,6 +398,8 @@ extern void *async_as_area_create(void *, size_t, unsigned int, async_sess_t *,
 
 errno_t async_spawn_notification_handler(void);
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
@@ -35,6 +35,7 @@
 #ifndef _LIBC_FIBRIL_H_
 #define _LIBC_FIBRIL_H_
 
+#include <stdbool.h>
 #include <time.h>
 #include <_bits/errno.h>
 #include <_bits/__noreturn.h>
@@ -66,13 +67,17 @@ extern void fibril_usleep(usec_t);
 extern void fibril_sleep(sec_t);
 
 extern void fibril_enable_multithreaded(void);
+extern void fibril_enable_runner_pool(int, int);
 extern int fibril_test_spawn_runners(int);
+extern bool fibril_is_multithreaded(void);
 
 extern void fibril_detach(fid_t fid);
 
 extern void fibril_start(fid_t);
 extern __noreturn void fibril_exit(long);
 
+extern errno_t fibril_add_exit_hook(void (*)(void *), void *);
+
 __HELENOS_DECLS_END;
 
 #endif
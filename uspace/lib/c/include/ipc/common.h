@@ -37,11 +37,16 @@
 
 #include <types/common.h>
 #include <abi/ipc/ipc.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 #define IPC_FLAG_BLOCKING  0x01
 
 typedef ipc_data_t ipc_call_t;
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
@@ -36,15 +36,22 @@
 #define _LIBC_IPC_IPC_TEST_H_
 
 #include <ipc/common.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 typedef enum {
 	IPC_TEST_PING = IPC_FIRST_USER_METHOD,
 	IPC_TEST_GET_RO_AREA_SIZE,
 	IPC_TEST_GET_RW_AREA_SIZE,
 	IPC_TEST_SHARE_IN_RO,
-	IPC_TEST_SHARE_IN_RW
+	IPC_TEST_SHARE_IN_RW,
+	IPC_TEST_WRITE,
+	IPC_TEST_READ
 } ipc_test_request_t;
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
@@ -37,6 +37,12 @@
 
 #include <async.h>
 #include <errno.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
+
+/** Maximum number of pings sent by ipc_test_ping_batch() */
+#define IPC_TEST_PING_BATCH_MAX 64
 
 typedef struct {
 	async_sess_t *sess;
@@ -45,10 +51,15 @@ typedef struct {
 extern errno_t ipc_test_create(ipc_test_t **);
 extern void ipc_test_destroy(ipc_test_t *);
 extern errno_t ipc_test_ping(ipc_test_t *);
+extern errno_t ipc_test_ping_batch(ipc_test_t *, size_t);
 extern errno_t ipc_test_get_ro_area_size(ipc_test_t *, size_t *);
 extern errno_t ipc_test_get_rw_area_size(ipc_test_t *, size_t *);
 extern errno_t ipc_test_share_in_ro(ipc_test_t *, size_t, const void **);
 extern errno_t ipc_test_share_in_rw(ipc_test_t *, size_t, void **);
+extern errno_t ipc_test_write(ipc_test_t *, const void *, size_t);
+extern errno_t ipc_test_read(ipc_test_t *, void *, size_t);
+
+__HELENOS_DECLS_END;
 
 #endif
 
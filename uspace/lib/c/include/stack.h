@@ -36,9 +36,14 @@
 #define _LIBC_STACK_H_
 
 #include <types/common.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 extern size_t stack_size_get(void);
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
@@ -40,11 +40,15 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <abi/sysinfo.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 #define LOAD_UNIT  65536
 
 extern stats_cpu_t *stats_get_cpus(size_t *);
 extern stats_physmem_t *stats_get_physmem(void);
+extern stats_frames_t *stats_get_frames(void);
 extern load_t *stats_get_load(size_t *);
 
 extern stats_task_t *stats_get_tasks(size_t *);
@@ -58,6 +62,8 @@ extern stats_exc_t *stats_get_exception(unsigned int);
 extern void stats_print_load_fragment(load_t, unsigned int);
 extern const char *thread_get_state(state_t);
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
@@ -40,6 +40,9 @@
 #include <abi/proc/task.h>
 #include <async.h>
 #include <types/task.h>
+#include <_bits/decls.h>
+
+__HELENOS_DECLS_BEGIN;
 
 typedef struct {
 	ipc_call_t result;
@@ -68,6 +71,8 @@ extern errno_t task_wait(task_wait_t *, task_exit_t *, int *);
 extern errno_t task_wait_task_id(task_id_t, task_exit_t *, int *);
 extern errno_t task_retval(int);
 
+__HELENOS_DECLS_END;
+
 #endif
 
 /** @}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <adt/cht.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <pcut/pcut.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/** Test entry */
+typedef struct {
+	cht_link_t link;
+	size_t key;
+} test_entry_t;
+
+enum {
+	/** Number of entries, enough for the table to grow several times */
+	test_entry_cnt = 2000,
+	/** Runner threads spawned for the concurrent test */
+	test_runner_cnt = 4,
+	/** Reader fibrils in the concurrent test */
+	test_reader_cnt = 4,
+	/** Writer fibrils in the concurrent test */
+	test_writer_cnt = 2,
+	/** Times each writer grows and shrinks the table */
+	test_round_cnt = 4,
+	/** Keys present during the whole concurrent test */
+	test_stable_cnt = 128
+};
+
+/** Callbacks may run in several writer fibrils at once. */
+static atomic_size_t removed_cnt;
+
+/** State shared by the fibrils of the concurrent test. */
+typedef struct {
+	cht_t *h;
+	fibril_semaphore_t done;
+	atomic_size_t writers_left;
+	atomic_size_t misses;
+	atomic_size_t lookups;
+} test_shared_t;
+
+/** Writer of the concurrent test with its own range of keys. */
+typedef struct {
+	test_shared_t *shared;
+	size_t base;
+} test_writer_t;
+
+static size_t test_hash(const cht_link_t *item)
+{
+	return cht_get_inst(item, test_entry_t, link)->key;
+}
+
+static size_t test_key_hash(const void *key)
+{
+	return *(const size_t *) key;
+}
+
+static bool test_equal(const cht_link_t *item1, const cht_link_t *item2)
+{
+	return test_hash(item1) == test_hash(item2);
+}
+
+static bool test_key_equal(const void *key, const cht_link_t *item)
+{
+	return *(const size_t *) key == test_hash(item);
+}
+
+static void test_remove_callback(cht_link_t *item)
+{
+	removed_cnt++;
+	free(cht_get_inst(item, test_entry_t, link));
+}
+
+static cht_ops_t test_ops = {
+	.hash = test_hash,
+	.key_hash = test_key_hash,
+	.equal = test_equal,
+	.key_equal = test_key_equal,
+	.remove_callback = test_remove_callback
+};
+
+static test_entry_t *test_entry_create(size_t key)
+{
+	test_entry_t *e = calloc(1, sizeof(test_entry_t));
+	PCUT_ASSERT_NOT_NULL(e);
+	e->key = key;
+	return e;
+}
+
+static bool test_contains(cht_t *h, size_t key)
+{
+	cht_read_t rd;
+
+	cht_read_lock(h, &rd);
+	cht_link_t *item = cht_find(h, &key);
+	bool found = item != NULL && test_hash(item) == key;
+	cht_read_unlock(h, &rd);
+
+	return found;
+}
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(cht);
+
+/** Insertions and lookups while the table grows. */
+PCUT_TEST(insert_find)
+{
+	cht_t h;
+	size_t i;
+
+	removed_cnt = 0;
+	PCUT_ASSERT_TRUE(cht_create(&h, 0, 0, &test_ops));
+
+	for (i = 0; i < test_entry_cnt; i++) {
+		cht_insert(&h, &test_entry_create(i)->link);
+
+		/* Some of the items may be still in the old buckets. */
+		PCUT_ASSERT_TRUE(test_contains(&h, i / 2));
+		PCUT_ASSERT_TRUE(test_contains(&h, i));
+	}
+
+	PCUT_ASSERT_INT_EQUALS(test_entry_cnt, cht_size(&h));
+
+	for (i = 0; i < test_entry_cnt; i++)
+		PCUT_ASSERT_TRUE(test_contains(&h, i));
+	PCUT_ASSERT_FALSE(test_contains(&h, test_entry_cnt));
+
+	cht_destroy(&h);
+	PCUT_ASSERT_INT_EQUALS(test_entry_cnt, removed_cnt);
+}
+
+/** Only one item of a key is inserted by cht_insert_unique(). */
+PCUT_TEST(insert_unique)
+{
+	cht_t h;
+
+	removed_cnt = 0;
+	PCUT_ASSERT_TRUE(cht_create(&h, 0, 0, &test_ops));
+
+	test_entry_t *e1 = test_entry_create(42);
+	test_entry_t *e2 = test_entry_create(42);
+
+	PCUT_ASSERT_TRUE(cht_insert_unique(&h, &e1->link));
+	PCUT_ASSERT_FALSE(cht_insert_unique(&h, &e2->link));
+	PCUT_ASSERT_INT_EQUALS(1, cht_size(&h));
+	free(e2);
+
+	cht_destroy(&h);
+	PCUT_ASSERT_INT_EQUALS(1, removed_cnt);
+}
+
+/** Removed items are passed to remove_callback() after a grace period. */
+PCUT_TEST(remove)
+{
+	cht_t h;
+	size_t i;
+
+	removed_cnt = 0;
+	PCUT_ASSERT_TRUE(cht_create(&h, 0, 0, &test_ops));
+
+	for (i = 0; i < test_entry_cnt; i++)
+		cht_insert(&h, &test_entry_create(i)->link);
+
+	/* Remove the even keys. */
+	for (i = 0; i < test_entry_cnt; i += 2)
+		PCUT_ASSERT_INT_EQUALS(1, cht_remove(&h, &i));
+
+	PCUT_ASSERT_INT_EQUALS(0, cht_remove(&h, &(size_t) { 0 }));
+	PCUT_ASSERT_INT_EQUALS(test_entry_cnt / 2, cht_size(&h));
+
+	for (i = 0; i < test_entry_cnt; i++)
+		PCUT_ASSERT_INT_EQUALS(i % 2 == 1, test_contains(&h, i));
+
+	cht_synchronize(&h);
+	PCUT_ASSERT_INT_EQUALS(test_entry_cnt / 2, removed_cnt);
+
+	/* Remove the odd ones one by one, which shrinks the table back. */
+	for (i = 1; i < test_entry_cnt; i += 2) {
+		cht_read_t rd;
+
+		cht_read_lock(&h, &rd);
+		cht_link_t *item = cht_find(&h, &i);
+		cht_read_unlock(&h, &rd);
+
+		PCUT_ASSERT_NOT_NULL(item);
+		cht_remove_item(&h, item);
+	}
+
+	PCUT_ASSERT_INT_EQUALS(0, cht_size(&h));
+	cht_synchronize(&h);
+	PCUT_ASSERT_INT_EQUALS(test_entry_cnt, removed_cnt);
+
+	cht_destroy(&h);
+}
+
+static errno_t test_reader(void *arg)
+{
+	test_shared_t *shared = arg;
+
+	/* Keep looking until the last writer has finished. */
+	do {
+		for (size_t key = 0; key < test_stable_cnt; key++) {
+			if (!test_contains(shared->h, key))
+				atomic_fetch_add(&shared->misses, 1);
+			atomic_fetch_add(&shared->lookups, 1);
+		}
+
+		fibril_yield();
+	} while (atomic_load(&shared->writers_left) > 0);
+
+	fibril_semaphore_up(&shared->done);
+	return EOK;
+}
+
+static errno_t test_writer(void *arg)
+{
+	test_writer_t *writer = arg;
+	test_shared_t *shared = writer->shared;
+
+	for (size_t round = 0; round < test_round_cnt; round++) {
+		/* Grow the table several times over... */
+		for (size_t i = 0; i < test_entry_cnt; i++) {
+			test_entry_t *e = calloc(1, sizeof(test_entry_t));
+			if (e == NULL) {
+				/* Fails the test like a missed key would. */
+				atomic_fetch_add(&shared->misses, 1);
+				break;
+			}
+
+			e->key = writer->base + i;
+			cht_insert(shared->h, &e->link);
+		}
+
+		/* ...and shrink it back by removing everything again. */
+		for (size_t i = 0; i < test_entry_cnt; i++) {
+			size_t key = writer->base + i;
+			cht_remove(shared->h, &key);
+		}
+	}
+
+	atomic_fetch_sub(&shared->writers_left, 1);
+	fibril_semaphore_up(&shared->done);
+	return EOK;
+}
+
+/** Lookups racing with writers that make the table grow and shrink. */
+PCUT_TEST(concurrent)
+{
+	cht_t h;
+	test_shared_t shared;
+	test_writer_t writers[test_writer_cnt];
+	size_t started = 0;
+	size_t i;
+
+	removed_cnt = 0;
+	PCUT_ASSERT_TRUE(cht_create(&h, 0, 0, &test_ops));
+
+	for (i = 0; i < test_stable_cnt; i++)
+		cht_insert(&h, &test_entry_create(i)->link);
+
+	shared.h = &h;
+	fibril_semaphore_initialize(&shared.done, 0);
+	atomic_store(&shared.writers_left, test_writer_cnt);
+	atomic_store(&shared.misses, 0);
+	atomic_store(&shared.lookups, 0);
+
+	/* Run the fibrils in parallel where the runners can be had. */
+	(void) fibril_test_spawn_runners(test_runner_cnt);
+
+	for (i = 0; i < test_writer_cnt; i++) {
+		writers[i].shared = &shared;
+		writers[i].base = test_stable_cnt + i * test_entry_cnt;
+
+		fid_t fid = fibril_create(test_writer, &writers[i]);
+		if (fid == 0) {
+			/* Do not let the readers wait for it. */
+			atomic_fetch_sub(&shared.writers_left, 1);
+			continue;
+		}
+
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (i = 0; i < test_reader_cnt; i++) {
+		fid_t fid = fibril_create(test_reader, &shared);
+		if (fid == 0)
+			continue;
+
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (i = 0; i < started; i++)
+		fibril_semaphore_down(&shared.done);
+
+	PCUT_ASSERT_INT_EQUALS(test_writer_cnt + test_reader_cnt, started);
+	PCUT_ASSERT_INT_EQUALS(0, atomic_load(&shared.misses));
+	PCUT_ASSERT_TRUE(atomic_load(&shared.lookups) > 0);
+	PCUT_ASSERT_INT_EQUALS(test_stable_cnt, cht_size(&h));
+
+	cht_synchronize(&h);
+	PCUT_ASSERT_INT_EQUALS(test_writer_cnt * test_round_cnt *
+	    test_entry_cnt, atomic_load(&removed_cnt));
+
+	cht_destroy(&h);
+	PCUT_ASSERT_INT_EQUALS(test_writer_cnt * test_round_cnt *
+	    test_entry_cnt + test_stable_cnt, atomic_load(&removed_cnt));
+}
+
+PCUT_EXPORT(cht);
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <pcut/pcut.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(fibril_exit);
+
+typedef struct {
+	fibril_semaphore_t done;
+	int order[3];
+	int count;
+} hooks_t;
+
+static void record_hook(void *arg, int id)
+{
+	hooks_t *h = arg;
+
+	if (h->count < 3)
+		h->order[h->count] = id;
+	h->count++;
+}
+
+static void hook_first(void *arg)
+{
+	hooks_t *h = arg;
+
+	record_hook(h, 1);
+	fibril_semaphore_up(&h->done);
+}
+
+static void hook_nested(void *arg)
+{
+	record_hook(arg, 3);
+}
+
+static void hook_second(void *arg)
+{
+	record_hook(arg, 2);
+
+	/* Hooks registered while exiting run as well. */
+	(void) fibril_add_exit_hook(hook_nested, arg);
+}
+
+static errno_t hooks_fn(void *arg)
+{
+	hooks_t *h = arg;
+
+	if (fibril_add_exit_hook(hook_first, h) != EOK)
+		return ENOMEM;
+	if (fibril_add_exit_hook(hook_second, h) != EOK)
+		return ENOMEM;
+
+	return EOK;
+}
+
+/** Exit hooks run when the fibril exits, most recent first */
+PCUT_TEST(hooks_run_on_exit)
+{
+	hooks_t h;
+
+	fibril_semaphore_initialize(&h.done, 0);
+	h.count = 0;
+
+	fid_t fid = fibril_create(hooks_fn, &h);
+	PCUT_ASSERT_NOT_NULL((void *) fid);
+	fibril_add_ready(fid);
+
+	fibril_semaphore_down(&h.done);
+
+	PCUT_ASSERT_INT_EQUALS(3, h.count);
+	PCUT_ASSERT_INT_EQUALS(2, h.order[0]);
+	PCUT_ASSERT_INT_EQUALS(3, h.order[1]);
+	PCUT_ASSERT_INT_EQUALS(1, h.order[2]);
+}
+
+PCUT_EXPORT(fibril_exit);
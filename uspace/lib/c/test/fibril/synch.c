@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <pcut/pcut.h>
+#include <time.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(fibril_synch);
+
+typedef struct {
+	fibril_mutex_t *mutex;
+	fibril_rwlock_t *rwlock;
+	fibril_semaphore_t done;
+	bool acquired;
+	errno_t rc;
+} contender_t;
+
+static void contender_init(contender_t *c)
+{
+	c->mutex = NULL;
+	c->rwlock = NULL;
+	fibril_semaphore_initialize(&c->done, 0);
+	c->acquired = false;
+	c->rc = EOK;
+}
+
+static void deadline(struct timespec *ts, usec_t usec)
+{
+	getuptime(ts);
+	ts_add_diff(ts, USEC2NSEC(usec));
+}
+
+static errno_t mutex_trylock_fn(void *arg)
+{
+	contender_t *c = arg;
+
+	c->acquired = fibril_mutex_trylock(c->mutex);
+	if (c->acquired)
+		fibril_mutex_unlock(c->mutex);
+
+	fibril_semaphore_up(&c->done);
+	return EOK;
+}
+
+static errno_t mutex_lock_until_fn(void *arg)
+{
+	contender_t *c = arg;
+	struct timespec ts;
+
+	deadline(&ts, 1000);
+	c->rc = fibril_mutex_lock_until(c->mutex, &ts);
+	if (c->rc == EOK)
+		fibril_mutex_unlock(c->mutex);
+
+	fibril_semaphore_up(&c->done);
+	return EOK;
+}
+
+static errno_t read_trylock_fn(void *arg)
+{
+	contender_t *c = arg;
+
+	c->acquired = fibril_rwlock_read_trylock(c->rwlock);
+	if (c->acquired)
+		fibril_rwlock_read_unlock(c->rwlock);
+
+	fibril_semaphore_up(&c->done);
+	return EOK;
+}
+
+static errno_t write_trylock_fn(void *arg)
+{
+	contender_t *c = arg;
+
+	c->acquired = fibril_rwlock_write_trylock(c->rwlock);
+	if (c->acquired)
+		fibril_rwlock_write_unlock(c->rwlock);
+
+	fibril_semaphore_up(&c->done);
+	return EOK;
+}
+
+static errno_t write_lock_until_fn(void *arg)
+{
+	contender_t *c = arg;
+	struct timespec ts;
+
+	deadline(&ts, 1000);
+	c->rc = fibril_rwlock_write_lock_until(c->rwlock, &ts);
+	if (c->rc == EOK)
+		fibril_rwlock_write_unlock(c->rwlock);
+
+	fibril_semaphore_up(&c->done);
+	return EOK;
+}
+
+static errno_t read_lock_until_fn(void *arg)
+{
+	contender_t *c = arg;
+	struct timespec ts;
+
+	deadline(&ts, 100 * 1000);
+	c->rc = fibril_rwlock_read_lock_until(c->rwlock, &ts);
+	if (c->rc == EOK)
+		fibril_rwlock_read_unlock(c->rwlock);
+
+	fibril_semaphore_up(&c->done);
+	return EOK;
+}
+
+static void run_contender(errno_t (*fn)(void *), contender_t *c)
+{
+	fid_t fid = fibril_create(fn, c);
+	PCUT_ASSERT_TRUE(fid != 0);
+	fibril_add_ready(fid);
+	fibril_semaphore_down(&c->done);
+}
+
+PCUT_TEST(mutex_trylock)
+{
+	fibril_mutex_t mutex;
+	contender_t c;
+
+	fibril_mutex_initialize(&mutex);
+	contender_init(&c);
+	c.mutex = &mutex;
+
+	run_contender(mutex_trylock_fn, &c);
+	PCUT_ASSERT_TRUE(c.acquired);
+
+	fibril_mutex_lock(&mutex);
+	run_contender(mutex_trylock_fn, &c);
+	PCUT_ASSERT_FALSE(c.acquired);
+	fibril_mutex_unlock(&mutex);
+}
+
+PCUT_TEST(mutex_lock_until_timeout)
+{
+	fibril_mutex_t mutex;
+	contender_t c;
+
+	fibril_mutex_initialize(&mutex);
+	contender_init(&c);
+	c.mutex = &mutex;
+
+	fibril_mutex_lock(&mutex);
+	run_contender(mutex_lock_until_fn, &c);
+	PCUT_ASSERT_ERRNO_VAL(ETIMEOUT, c.rc);
+	fibril_mutex_unlock(&mutex);
+
+	/* The timed out waiter must not have left the mutex unbalanced. */
+	PCUT_ASSERT_TRUE(fibril_mutex_trylock(&mutex));
+	fibril_mutex_unlock(&mutex);
+
+	run_contender(mutex_lock_until_fn, &c);
+	PCUT_ASSERT_ERRNO_VAL(EOK, c.rc);
+}
+
+PCUT_TEST(rwlock_trylock)
+{
+	fibril_rwlock_t rwlock;
+	contender_t c;
+
+	fibril_rwlock_initialize(&rwlock);
+	contender_init(&c);
+	c.rwlock = &rwlock;
+
+	fibril_rwlock_read_lock(&rwlock);
+
+	run_contender(read_trylock_fn, &c);
+	PCUT_ASSERT_TRUE(c.acquired);
+
+	run_contender(write_trylock_fn, &c);
+	PCUT_ASSERT_FALSE(c.acquired);
+
+	fibril_rwlock_read_unlock(&rwlock);
+	fibril_rwlock_write_lock(&rwlock);
+
+	run_contender(read_trylock_fn, &c);
+	PCUT_ASSERT_FALSE(c.acquired);
+
+	fibril_rwlock_write_unlock(&rwlock);
+
+	run_contender(write_trylock_fn, &c);
+	PCUT_ASSERT_TRUE(c.acquired);
+}
+
+PCUT_TEST(rwlock_write_lock_until_timeout)
+{
+	fibril_rwlock_t rwlock;
+	contender_t c;
+
+	fibril_rwlock_initialize(&rwlock);
+	contender_init(&c);
+	c.rwlock = &rwlock;
+
+	fibril_rwlock_read_lock(&rwlock);
+	run_contender(write_lock_until_fn, &c);
+	PCUT_ASSERT_ERRNO_VAL(ETIMEOUT, c.rc);
+	fibril_rwlock_read_unlock(&rwlock);
+
+	PCUT_ASSERT_FALSE(fibril_rwlock_is_locked(&rwlock));
+
+	run_contender(write_lock_until_fn, &c);
+	PCUT_ASSERT_ERRNO_VAL(EOK, c.rc);
+}
+
+PCUT_TEST(rwlock_read_lock_until)
+{
+	fibril_rwlock_t rwlock;
+	contender_t c;
+
+	fibril_rwlock_initialize(&rwlock);
+	contender_init(&c);
+	c.rwlock = &rwlock;
+
+	fibril_rwlock_write_lock(&rwlock);
+
+	fid_t fid = fibril_create(read_lock_until_fn, &c);
+	PCUT_ASSERT_TRUE(fid != 0);
+	fibril_add_ready(fid);
+
+	fibril_usleep(1000);
+	fibril_rwlock_write_unlock(&rwlock);
+
+	fibril_semaphore_down(&c.done);
+	PCUT_ASSERT_ERRNO_VAL(EOK, c.rc);
+}
+
+PCUT_EXPORT(fibril_synch);
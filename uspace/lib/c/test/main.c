@@ -33,14 +33,18 @@ PCUT_INIT;
 
 PCUT_IMPORT(cap);
 PCUT_IMPORT(casting);
+PCUT_IMPORT(cht);
 PCUT_IMPORT(circ_buf);
 PCUT_IMPORT(double_to_str);
+PCUT_IMPORT(fibril_exit);
+PCUT_IMPORT(fibril_synch);
 PCUT_IMPORT(fibril_timer);
 PCUT_IMPORT(getopt);
 PCUT_IMPORT(gsort);
 PCUT_IMPORT(ieee_double);
 PCUT_IMPORT(imath);
 PCUT_IMPORT(inttypes);
+PCUT_IMPORT(malloc);
 PCUT_IMPORT(mem);
 PCUT_IMPORT(odict);
 PCUT_IMPORT(perf);
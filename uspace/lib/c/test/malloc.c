@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <macros.h>
+#include <malloc.h>
+#include <mem.h>
+#include <pcut/pcut.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(malloc);
+
+/** Fill a block with a pattern derived from its size */
+static void fill(unsigned char *block, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		block[i] = (unsigned char) (i * 7 + size);
+}
+
+/** Check the pattern written by fill() */
+static bool check(const unsigned char *block, size_t size, size_t pattern)
+{
+	for (size_t i = 0; i < size; i++) {
+		if (block[i] != (unsigned char) (i * 7 + pattern))
+			return false;
+	}
+
+	return true;
+}
+
+/** Blocks of all sizes are aligned and do not overlap */
+PCUT_TEST(malloc_sizes)
+{
+	static const size_t sizes[] = {
+		0, 1, 15, 16, 17, 100, 128, 129, 1000, 4096, 8191, 8192, 8193,
+		20000, 40000, 65536, 65537, 1000000
+	};
+	const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+	unsigned char *blocks[sizeof(sizes) / sizeof(sizes[0])];
+
+	for (size_t i = 0; i < count; i++) {
+		blocks[i] = malloc(sizes[i]);
+		PCUT_ASSERT_NOT_NULL(blocks[i]);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) blocks[i] % 16);
+		fill(blocks[i], sizes[i]);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		PCUT_ASSERT_TRUE(check(blocks[i], sizes[i], sizes[i]));
+		free(blocks[i]);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** memalign() honours alignments up to and beyond the span size */
+PCUT_TEST(memalign)
+{
+	for (size_t align = 1; align <= 1024 * 1024; align *= 4) {
+		unsigned char *small = memalign(align, 24);
+		unsigned char *large = memalign(align, 3 * align + 100);
+
+		PCUT_ASSERT_NOT_NULL(small);
+		PCUT_ASSERT_NOT_NULL(large);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) small % align);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) large % align);
+
+		fill(small, 24);
+		fill(large, 3 * align + 100);
+		PCUT_ASSERT_TRUE(check(small, 24, 24));
+		PCUT_ASSERT_TRUE(check(large, 3 * align + 100, 3 * align + 100));
+
+		free(small);
+		free(large);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** realloc() keeps the contents when moving between small and large blocks */
+PCUT_TEST(realloc)
+{
+	static const size_t sizes[] = {
+		10, 40, 200, 5000, 20000, 300000, 100000, 9000, 300, 8
+	};
+	const size_t count = sizeof(sizes) / sizeof(sizes[0]);
+
+	unsigned char *block = malloc(sizes[0]);
+	PCUT_ASSERT_NOT_NULL(block);
+	fill(block, sizes[0]);
+
+	for (size_t i = 1; i < count; i++) {
+		size_t kept = min(sizes[i - 1], sizes[i]);
+
+		block = realloc(block, sizes[i]);
+		PCUT_ASSERT_NOT_NULL(block);
+		PCUT_ASSERT_TRUE(check(block, kept, sizes[i - 1]));
+		fill(block, sizes[i]);
+	}
+
+	free(block);
+
+	PCUT_ASSERT_NULL(realloc(NULL, 0));
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** calloc() clears the memory and detects overflow */
+PCUT_TEST(calloc)
+{
+	unsigned char *dirty = malloc(256);
+	PCUT_ASSERT_NOT_NULL(dirty);
+	memset(dirty, 0xa5, 256);
+	free(dirty);
+
+	dirty = malloc(40000);
+	PCUT_ASSERT_NOT_NULL(dirty);
+	memset(dirty, 0xa5, 40000);
+	free(dirty);
+
+	unsigned char *small = calloc(16, 16);
+	unsigned char *mid = calloc(1000, 40);
+	unsigned char *large = calloc(1000, 100);
+	PCUT_ASSERT_NOT_NULL(small);
+	PCUT_ASSERT_NOT_NULL(mid);
+	PCUT_ASSERT_NOT_NULL(large);
+
+	for (size_t i = 0; i < 256; i++)
+		PCUT_ASSERT_INT_EQUALS(0, small[i]);
+	for (size_t i = 0; i < 40000; i++)
+		PCUT_ASSERT_INT_EQUALS(0, mid[i]);
+	for (size_t i = 0; i < 100000; i++)
+		PCUT_ASSERT_INT_EQUALS(0, large[i]);
+
+	free(small);
+	free(mid);
+	free(large);
+
+	PCUT_ASSERT_NULL(calloc(SIZE_MAX / 2, 3));
+}
+
+/** Many blocks freed in a different order than allocated */
+PCUT_TEST(many_blocks)
+{
+	const size_t count = 10000;
+	unsigned char **blocks = calloc(count, sizeof(unsigned char *));
+	PCUT_ASSERT_NOT_NULL(blocks);
+
+	for (size_t i = 0; i < count; i++) {
+		size_t size = (i * 37) % 3000;
+
+		blocks[i] = malloc(size);
+		PCUT_ASSERT_NOT_NULL(blocks[i]);
+		fill(blocks[i], size);
+	}
+
+	for (size_t step = 0; step < 7; step++) {
+		for (size_t i = step; i < count; i += 7) {
+			size_t size = (i * 37) % 3000;
+
+			PCUT_ASSERT_TRUE(check(blocks[i], size, size));
+			free(blocks[i]);
+		}
+	}
+
+	free(blocks);
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** Mid-size blocks fill several spans and are reused once freed */
+PCUT_TEST(mid_blocks)
+{
+	const size_t count = 64;
+	unsigned char *blocks[64];
+
+	for (size_t round = 0; round < 2; round++) {
+		for (size_t i = 0; i < count; i++) {
+			size_t size = 9000 + (i * 4001) % 56000;
+
+			blocks[i] = malloc(size);
+			PCUT_ASSERT_NOT_NULL(blocks[i]);
+			PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) blocks[i] % 16);
+			fill(blocks[i], size);
+		}
+
+		PCUT_ASSERT_NULL(heap_check());
+
+		for (size_t i = 0; i < count; i++) {
+			size_t size = 9000 + (i * 4001) % 56000;
+
+			PCUT_ASSERT_TRUE(check(blocks[i], size, size));
+			free(blocks[i]);
+		}
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+PCUT_EXPORT(malloc);
@@ -43,6 +43,8 @@ namespace __cxxabiv1
 
     extern "C" void __cxa_finalize(void*);
 
+    extern "C" int __cxa_thread_atexit(void (*)(void*), void*, void*);
+
     /**
      * Itanium C++ ABI type infos.
      * See section 2.9.4 (RTTI Layout) of the Itanium C++ ABI spec.
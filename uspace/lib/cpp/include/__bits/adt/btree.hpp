@@ -0,0 +1,1280 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_BTREE
+#define LIBCPP_BITS_ADT_BTREE
+
+#include <__bits/adt/btree_iterators.hpp>
+#include <__bits/adt/btree_node.hpp>
+#include <__bits/adt/key_extractors.hpp>
+#include <__bits/adt/vector.hpp>
+#include <__bits/algorithm.hpp>
+#include <iterator>
+#include <utility>
+
+namespace std::experimental
+{
+    /**
+     * Tag for constructors and functions of the B-tree
+     * containers that take a range sorted by key_comp,
+     * which is then loaded in linear time.
+     */
+    struct sorted_range_t
+    {
+        explicit sorted_range_t() = default;
+    };
+
+    inline constexpr sorted_range_t sorted_range{};
+}
+
+namespace std::aux
+{
+    /**
+     * B+ tree with wide nodes used to implement the btree_*
+     * containers, its interface mirrors that of rbtree.
+     * Multi selects whether equivalent keys are allowed,
+     * Fanout is the capacity of both kinds of nodes, zero
+     * sizes the nodes to about node_bytes each.
+     */
+    template<
+        class Value, class Key, class KeyExtractor,
+        class KeyComp, class Alloc, class Size,
+        bool Multi, size_t Fanout
+    >
+    class btree
+    {
+        static_assert(Fanout == 0 || Fanout >= 4);
+
+        static constexpr size_t node_bytes = 256;
+
+        static constexpr size_t clamp_cap_(size_t cap)
+        {
+            return cap < 8 ? 8 : (cap > 128 ? 128 : cap);
+        }
+
+        public:
+            static constexpr size_t leaf_capacity = Fanout ? Fanout :
+                clamp_cap_(node_bytes / sizeof(Value));
+            static constexpr size_t inner_capacity = Fanout ? Fanout :
+                clamp_cap_(node_bytes / (sizeof(Key) + sizeof(void*)));
+
+            using value_type     = Value;
+            using key_type       = Key;
+            using size_type      = Size;
+            using allocator_type = Alloc;
+            using key_compare    = KeyComp;
+            using key_extract    = KeyExtractor;
+
+            using node_type  = btree_node<Key, inner_capacity>;
+            using inner_type = btree_inner<Key, inner_capacity>;
+            using leaf_type  = btree_leaf<Value, Key, leaf_capacity, inner_capacity>;
+
+            using iterator       = btree_iterator<
+                value_type, value_type&, value_type*, size_type, leaf_type
+            >;
+            using const_iterator = btree_const_iterator<
+                value_type, const value_type&, const value_type*, size_type, leaf_type
+            >;
+
+            using reverse_iterator       = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+            btree(const key_compare& kcmp = key_compare{})
+                : root_{nullptr}, first_{nullptr}, last_{nullptr},
+                  size_{}, key_compare_{kcmp}, key_extractor_{}
+            { /* DUMMY BODY */ }
+
+            btree(const btree& other)
+                : btree{other.key_compare_}
+            {
+                assign_sorted(other.begin(), other.end());
+            }
+
+            btree(btree&& other)
+                : root_{other.root_}, first_{other.first_}, last_{other.last_},
+                  size_{other.size_}, key_compare_{move(other.key_compare_)},
+                  key_extractor_{move(other.key_extractor_)}
+            {
+                other.root_ = nullptr;
+                other.first_ = nullptr;
+                other.last_ = nullptr;
+                other.size_ = size_type{};
+            }
+
+            btree& operator=(const btree& other)
+            {
+                if (this == &other)
+                    return *this;
+
+                key_compare_ = other.key_compare_;
+                assign_sorted(other.begin(), other.end());
+
+                return *this;
+            }
+
+            btree& operator=(btree&& other)
+            {
+                swap(other);
+
+                return *this;
+            }
+
+            ~btree()
+            {
+                clear();
+            }
+
+            iterator begin()
+            {
+                return iterator{first_, 0, last_};
+            }
+
+            const_iterator begin() const
+            {
+                return cbegin();
+            }
+
+            iterator end()
+            {
+                return iterator{nullptr, 0, last_};
+            }
+
+            const_iterator end() const
+            {
+                return cend();
+            }
+
+            reverse_iterator rbegin()
+            {
+                return make_reverse_iterator(end());
+            }
+
+            const_reverse_iterator rbegin() const
+            {
+                return make_reverse_iterator(cend());
+            }
+
+            reverse_iterator rend()
+            {
+                return make_reverse_iterator(begin());
+            }
+
+            const_reverse_iterator rend() const
+            {
+                return make_reverse_iterator(cbegin());
+            }
+
+            const_iterator cbegin() const
+            {
+                return const_iterator{first_, 0, last_};
+            }
+
+            const_iterator cend() const
+            {
+                return const_iterator{nullptr, 0, last_};
+            }
+
+            const_reverse_iterator crbegin() const
+            {
+                return rbegin();
+            }
+
+            const_reverse_iterator crend() const
+            {
+                return rend();
+            }
+
+            bool empty() const noexcept
+            {
+                return size_ == 0U;
+            }
+
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            size_type max_size(allocator_type& alloc)
+            {
+                return allocator_traits<allocator_type>::max_size(alloc);
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                value_type val{forward<Args>(args)...};
+
+                return insert(move(val));
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                value_type tmp{val};
+
+                return insert(move(tmp));
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                const auto& key = get_key(val);
+
+                if constexpr (Multi)
+                {
+                    if (!root_)
+                        return make_pair(insert_at_(nullptr, 0, move(val)), true);
+
+                    auto pos = descend_<true>(key);
+
+                    return make_pair(insert_at_(pos.first, pos.second, move(val)), true);
+                }
+                else
+                {
+                    auto [leaf, idx, found] = find_for_insertion_(key);
+                    if (found)
+                        return make_pair(iterator{leaf, idx, last_}, false);
+
+                    return make_pair(insert_at_(leaf, idx, move(val)), true);
+                }
+            }
+
+            /**
+             * Constructs the value returned by make in place
+             * only if there is no value with the given key.
+             */
+            template<class K, class Factory>
+            pair<iterator, bool> emplace_key(const K& key, Factory&& make)
+            {
+                static_assert(!Multi);
+
+                auto [leaf, idx, found] = find_for_insertion_(key);
+                if (found)
+                    return make_pair(iterator{leaf, idx, last_}, false);
+
+                auto slot = make_slot_(leaf, idx);
+                ::new(static_cast<void*>(&slot.first->value(slot.second))) value_type(make());
+
+                return make_pair(iterator{slot.first, slot.second, last_}, true);
+            }
+
+            /**
+             * Replaces the content of the tree with the values
+             * in [first, last), which have to be sorted. Values
+             * with equivalent keys are skipped unless Multi.
+             * The leaves are filled completely, which is best
+             * for trees that are read more than modified.
+             */
+            template<class InputIterator>
+            void assign_sorted(InputIterator first, InputIterator last)
+            {
+                clear();
+
+                leaf_type* leaf{nullptr};
+                size_type leaves{};
+                for (; first != last; ++first)
+                {
+                    if constexpr (!Multi)
+                    {
+                        if (leaf && keys_equal(get_key(*first),
+                                               get_key(leaf->value(leaf->count - 1))))
+                            continue;
+                    }
+
+                    if (!leaf || leaf->count == leaf_capacity)
+                    {
+                        auto next = new leaf_type{};
+                        if (leaf)
+                        {
+                            leaf->next = next;
+                            next->prev = leaf;
+                        }
+                        else
+                            first_ = next;
+
+                        leaf = next;
+                        ++leaves;
+                    }
+
+                    ::new(static_cast<void*>(&leaf->value(leaf->count))) value_type(*first);
+                    ++leaf->count;
+                    ++size_;
+                }
+
+                if (!leaf)
+                    return;
+                last_ = leaf;
+
+                // The last leaf might be underfull.
+                if (leaf->prev && leaf->count < leaf_min_)
+                {
+                    auto prev = leaf->prev;
+                    auto moved = leaf_min_ - leaf->count;
+
+                    for (size_t i = leaf->count; i > 0; --i)
+                        btree_relocate(&leaf->value(i - 1 + moved), &leaf->value(i - 1));
+                    for (size_t i = 0; i < moved; ++i)
+                    {
+                        btree_relocate(
+                            &leaf->value(i),
+                            &prev->value(prev->count - moved + i)
+                        );
+                    }
+
+                    leaf->count += moved;
+                    prev->count -= moved;
+                }
+
+                vector<node_type*> level{};
+                vector<key_type> mins{};
+                level.reserve(leaves);
+                mins.reserve(leaves);
+                for (auto l = first_; l; l = l->next)
+                {
+                    level.push_back(l);
+                    mins.push_back(get_key(l->value(0)));
+                }
+
+                while (level.size() > 1)
+                {
+                    auto count = level.size();
+                    auto chunks = (count + inner_capacity - 1) / inner_capacity;
+                    auto last_size = count - (chunks - 1) * inner_capacity;
+                    auto moved = (chunks > 1 && last_size < inner_min_) ?
+                        inner_min_ - last_size : 0;
+
+                    vector<node_type*> next_level{};
+                    vector<key_type> next_mins{};
+                    next_level.reserve(chunks);
+                    next_mins.reserve(chunks);
+
+                    size_t start{};
+                    for (size_t c = 0; c < chunks; ++c)
+                    {
+                        size_t size = (c + 1 < chunks) ? inner_capacity : last_size;
+                        if (c + 2 == chunks)
+                            size -= moved;
+                        else if (c + 1 == chunks)
+                            size += moved;
+
+                        auto inner = new inner_type{};
+                        inner->set_child(0, level[start]);
+                        inner->count = 1;
+                        for (size_t i = 1; i < size; ++i)
+                        {
+                            ::new(static_cast<void*>(&inner->key(i - 1))) key_type(mins[start + i]);
+                            inner->set_child(i, level[start + i]);
+                            ++inner->count;
+                        }
+
+                        next_level.push_back(inner);
+                        next_mins.push_back(mins[start]);
+                        start += size;
+                    }
+
+                    level = move(next_level);
+                    mins = move(next_mins);
+                }
+
+                root_ = level[0];
+            }
+
+            size_type erase(const key_type& key)
+            {
+                if constexpr (Multi)
+                {
+                    size_type res{};
+                    auto it = lower_bound(key);
+                    while (it != end() && keys_equal(get_key(*it), key))
+                    {
+                        it = erase(it);
+                        ++res;
+                    }
+
+                    return res;
+                }
+                else
+                {
+                    auto it = find(key);
+                    if (it == end())
+                        return 0;
+
+                    erase(it);
+
+                    return 1;
+                }
+            }
+
+            iterator erase(const_iterator it)
+            {
+                auto leaf = const_cast<leaf_type*>(it.leaf());
+                if (!leaf)
+                    return end();
+
+                return erase_at_(leaf, it.index());
+            }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                // Erasure invalidates iterators, so count first.
+                auto n = distance(first, last);
+
+                auto it = iterator{
+                    const_cast<leaf_type*>(first.leaf()), first.index(), last_
+                };
+                while (n-- > 0)
+                    it = erase(it);
+
+                return it;
+            }
+
+            void clear() noexcept
+            {
+                if (root_)
+                    destroy_(root_);
+
+                root_ = nullptr;
+                first_ = nullptr;
+                last_ = nullptr;
+                size_ = size_type{};
+            }
+
+            void swap(btree& other)
+            {
+                std::swap(root_, other.root_);
+                std::swap(first_, other.first_);
+                std::swap(last_, other.last_);
+                std::swap(size_, other.size_);
+                std::swap(key_compare_, other.key_compare_);
+                std::swap(key_extractor_, other.key_extractor_);
+            }
+
+            key_compare key_comp() const
+            {
+                return key_compare_;
+            }
+
+            iterator find(const key_type& key)
+            {
+                auto it = lower_bound(key);
+                if (it != end() && keys_equal(get_key(*it), key))
+                    return it;
+                else
+                    return end();
+            }
+
+            const_iterator find(const key_type& key) const
+            {
+                return const_cast<btree*>(this)->find(key);
+            }
+
+            size_type count(const key_type& key) const
+            {
+                if constexpr (Multi)
+                {
+                    auto range = equal_range(key);
+
+                    return static_cast<size_type>(distance(range.first, range.second));
+                }
+                else
+                    return find(key) != end() ? 1 : 0;
+            }
+
+            iterator lower_bound(const key_type& key)
+            {
+                return bound_<false>(key);
+            }
+
+            const_iterator lower_bound(const key_type& key) const
+            {
+                return const_cast<btree*>(this)->lower_bound(key);
+            }
+
+            iterator upper_bound(const key_type& key)
+            {
+                return bound_<true>(key);
+            }
+
+            const_iterator upper_bound(const key_type& key) const
+            {
+                return const_cast<btree*>(this)->upper_bound(key);
+            }
+
+            pair<iterator, iterator> equal_range(const key_type& key)
+            {
+                return make_pair(lower_bound(key), upper_bound(key));
+            }
+
+            pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+            {
+                return make_pair(lower_bound(key), upper_bound(key));
+            }
+
+            bool is_eq_to(const btree& other) const
+            {
+                if (size() != other.size())
+                    return false;
+
+                auto it1 = begin();
+                auto it2 = other.begin();
+
+                // Bidirectional iterators, this is fine.
+                while (it1 != end() && it2 != other.end() && *it1 == *it2)
+                {
+                    ++it1;
+                    ++it2;
+                }
+
+                return it1 == end() && it2 == other.end();
+            }
+
+            const key_type& get_key(const value_type& val) const
+            {
+                return key_extractor_(val);
+            }
+
+            bool keys_comp(const key_type& key, const value_type& val) const
+            {
+                return key_compare_(key, key_extractor_(val));
+            }
+
+            bool keys_equal(const key_type& k1, const key_type& k2) const
+            {
+                return !key_compare_(k1, k2) && !key_compare_(k2, k1);
+            }
+
+            /**
+             * Number of levels, used for testing.
+             */
+            size_type height() const
+            {
+                size_type res{};
+                for (auto node = root_; node; ++res)
+                {
+                    if (node->leaf)
+                        break;
+                    node = static_cast<inner_type*>(node)->children[0];
+                }
+
+                return root_ ? res + 1 : 0;
+            }
+
+        private:
+            node_type* root_;
+            leaf_type* first_;
+            leaf_type* last_;
+            size_type size_;
+            key_compare key_compare_;
+            key_extract key_extractor_;
+
+            static constexpr size_t leaf_min_ = leaf_capacity / 2;
+            static constexpr size_t inner_min_ = inner_capacity / 2;
+
+            /**
+             * Nodes are small enough to be scanned linearly,
+             * which is branch predictor friendly, larger nodes
+             * are searched using binary search.
+             */
+            static constexpr size_t linear_search_max_ = 16;
+
+            /**
+             * Returns the first index in [0, n) for which
+             * the monotone predicate holds, or n.
+             */
+            template<class Predicate>
+            static size_t search_(size_t n, Predicate pred)
+            {
+                if (n <= linear_search_max_)
+                {
+                    size_t i{};
+                    while (i < n && !pred(i))
+                        ++i;
+
+                    return i;
+                }
+
+                size_t lo{}, hi{n};
+                while (lo < hi)
+                {
+                    auto mid = lo + (hi - lo) / 2;
+                    if (pred(mid))
+                        hi = mid;
+                    else
+                        lo = mid + 1;
+                }
+
+                return lo;
+            }
+
+            /**
+             * Finds the leaf and index of the first value
+             * not less than key, or greater than key if Upper.
+             * The index can be equal to the number of values
+             * in the leaf, in which case the value is the first
+             * value of the next leaf.
+             */
+            template<bool Upper, class K>
+            pair<leaf_type*, size_t> descend_(const K& key) const
+            {
+                auto node = root_;
+                while (!node->leaf)
+                {
+                    auto inner = static_cast<inner_type*>(node);
+                    auto idx = search_(inner->count - 1, [&](size_t i) {
+                        if constexpr (Upper)
+                            return key_compare_(key, inner->key(i));
+                        else
+                            return !key_compare_(inner->key(i), key);
+                    });
+
+                    node = inner->children[idx];
+                }
+
+                auto leaf = static_cast<leaf_type*>(node);
+                auto idx = search_(leaf->count, [&](size_t i) {
+                    if constexpr (Upper)
+                        return key_compare_(key, get_key(leaf->value(i)));
+                    else
+                        return !key_compare_(get_key(leaf->value(i)), key);
+                });
+
+                return make_pair(leaf, idx);
+            }
+
+            template<bool Upper>
+            iterator bound_(const key_type& key)
+            {
+                if (!root_)
+                    return end();
+
+                auto pos = descend_<Upper>(key);
+                if (pos.second == pos.first->count)
+                    return iterator{pos.first->next, 0, last_};
+                else
+                    return iterator{pos.first, pos.second, last_};
+            }
+
+            struct insertion_point
+            {
+                leaf_type* leaf;
+                size_t idx;
+                bool found;
+            };
+
+            /**
+             * Finds where a value with the given key is to be
+             * inserted, found is set if it already exists (and
+             * the position is its position then).
+             */
+            template<class K>
+            insertion_point find_for_insertion_(const K& key)
+            {
+                if (!root_)
+                    return insertion_point{nullptr, 0, false};
+
+                auto pos = descend_<false>(key);
+                auto leaf = pos.first;
+                auto idx = pos.second;
+                if (idx < leaf->count)
+                {
+                    auto found = !key_compare_(key, get_key(leaf->value(idx)));
+
+                    return insertion_point{leaf, idx, found};
+                }
+
+                /**
+                 * The separators are only bounds, so the
+                 * key can be the first one of the next leaf.
+                 */
+                auto next = leaf->next;
+                if (next && !key_compare_(key, get_key(next->value(0))))
+                    return insertion_point{next, 0, true};
+
+                return insertion_point{leaf, idx, false};
+            }
+
+            template<class... Args>
+            iterator insert_at_(leaf_type* leaf, size_t idx, Args&&... args)
+            {
+                auto slot = make_slot_(leaf, idx);
+                ::new(static_cast<void*>(&slot.first->value(slot.second))) value_type(
+                    forward<Args>(args)...
+                );
+
+                return iterator{slot.first, slot.second, last_};
+            }
+
+            /**
+             * Makes room for a value at the given position,
+             * splitting the leaf if it is full, and returns
+             * the (uninitialized) slot for the value.
+             */
+            pair<leaf_type*, size_t> make_slot_(leaf_type* leaf, size_t idx)
+            {
+                if (!leaf)
+                {
+                    leaf = new leaf_type{};
+                    root_ = leaf;
+                    first_ = leaf;
+                    last_ = leaf;
+                }
+                else if (leaf->count == leaf_capacity)
+                {
+                    auto half = leaf_capacity / 2;
+                    auto right = new leaf_type{};
+
+                    for (size_t i = half; i < leaf_capacity; ++i)
+                        btree_relocate(&right->value(i - half), &leaf->value(i));
+                    right->count = leaf_capacity - half;
+                    leaf->count = half;
+
+                    right->next = leaf->next;
+                    right->prev = leaf;
+                    if (leaf->next)
+                        leaf->next->prev = right;
+                    else
+                        last_ = right;
+                    leaf->next = right;
+
+                    key_type sep{get_key(right->value(0))};
+                    insert_into_parent_(leaf, sep, right);
+
+                    if (idx > half)
+                    {
+                        leaf = right;
+                        idx -= half;
+                    }
+                }
+
+                leaf->open(idx);
+                ++size_;
+
+                return make_pair(leaf, idx);
+            }
+
+            void insert_into_parent_(node_type* left, const key_type& sep, node_type* right)
+            {
+                if (left == root_)
+                {
+                    auto root = new inner_type{};
+                    root->set_child(0, left);
+                    root->count = 1;
+                    root->insert(0, sep, right);
+                    root_ = root;
+
+                    return;
+                }
+
+                auto parent = left->parent;
+                if (parent->count == inner_capacity)
+                {
+                    auto half = inner_capacity / 2;
+                    auto sibling = new inner_type{};
+
+                    for (size_t i = half; i < inner_capacity; ++i)
+                        sibling->set_child(i - half, parent->children[i]);
+                    for (size_t i = half; i + 1 < inner_capacity; ++i)
+                        btree_relocate(&sibling->key(i - half), &parent->key(i));
+                    sibling->count = inner_capacity - half;
+
+                    key_type middle{move(parent->key(half - 1))};
+                    parent->key(half - 1).~key_type();
+                    parent->count = half;
+
+                    insert_into_parent_(parent, middle, sibling);
+
+                    // Might have moved to the sibling.
+                    parent = left->parent;
+                }
+
+                parent->insert(left->pos, sep, right);
+            }
+
+            iterator erase_at_(leaf_type* leaf, size_t idx)
+            {
+                leaf->remove(idx);
+                --size_;
+
+                auto succ_leaf = leaf;
+                auto succ_idx = idx;
+
+                if (leaf == root_)
+                {
+                    if (leaf->count == 0)
+                    {
+                        delete leaf;
+                        root_ = nullptr;
+                        first_ = nullptr;
+                        last_ = nullptr;
+
+                        return end();
+                    }
+                }
+                else if (leaf->count < leaf_min_)
+                    rebalance_leaf_(leaf, succ_leaf, succ_idx);
+
+                if (succ_idx == succ_leaf->count)
+                    return iterator{succ_leaf->next, 0, last_};
+                else
+                    return iterator{succ_leaf, succ_idx, last_};
+            }
+
+            /**
+             * Refills an underfull leaf from one of its siblings,
+             * or merges it with one. The position of the value
+             * following the erased one is updated if it moves,
+             * an index equal to the number of values in the leaf
+             * denotes the first value of the next leaf.
+             */
+            void rebalance_leaf_(leaf_type* leaf, leaf_type*& succ_leaf, size_t& succ_idx)
+            {
+                auto parent = leaf->parent;
+                auto pos = leaf->pos;
+
+                auto left = pos > 0 ?
+                    static_cast<leaf_type*>(parent->children[pos - 1]) : nullptr;
+                auto right = pos + 1 < parent->count ?
+                    static_cast<leaf_type*>(parent->children[pos + 1]) : nullptr;
+
+                if (left && left->count > leaf_min_)
+                {
+                    leaf->open(0);
+                    btree_relocate(&leaf->value(0), &left->value(left->count - 1));
+                    --left->count;
+
+                    parent->key(pos - 1) = get_key(leaf->value(0));
+                    ++succ_idx;
+                }
+                else if (right && right->count > leaf_min_)
+                {
+                    btree_relocate(&leaf->value(leaf->count), &right->value(0));
+                    ++leaf->count;
+
+                    for (size_t i = 0; i + 1 < right->count; ++i)
+                        btree_relocate(&right->value(i), &right->value(i + 1));
+                    --right->count;
+
+                    parent->key(pos) = get_key(right->value(0));
+                }
+                else if (left)
+                {
+                    succ_leaf = left;
+                    succ_idx += left->count;
+
+                    merge_leaves_(left, leaf);
+                }
+                else
+                    merge_leaves_(leaf, right);
+            }
+
+            /**
+             * Moves all values of right to left, which
+             * are siblings, and deletes right.
+             */
+            void merge_leaves_(leaf_type* left, leaf_type* right)
+            {
+                for (size_t i = 0; i < right->count; ++i)
+                    btree_relocate(&left->value(left->count + i), &right->value(i));
+                left->count += right->count;
+                right->count = 0;
+
+                left->next = right->next;
+                if (right->next)
+                    right->next->prev = left;
+                else
+                    last_ = left;
+
+                auto parent = left->parent;
+                parent->remove(left->pos);
+                delete right;
+
+                rebalance_inner_(parent);
+            }
+
+            void rebalance_inner_(inner_type* node)
+            {
+                if (node == root_)
+                {
+                    if (node->count == 1)
+                    {
+                        root_ = node->children[0];
+                        root_->parent = nullptr;
+                        root_->pos = 0;
+                        delete node;
+                    }
+
+                    return;
+                }
+
+                if (node->count >= inner_min_)
+                    return;
+
+                auto parent = node->parent;
+                auto pos = node->pos;
+
+                auto left = pos > 0 ?
+                    static_cast<inner_type*>(parent->children[pos - 1]) : nullptr;
+                auto right = pos + 1 < parent->count ?
+                    static_cast<inner_type*>(parent->children[pos + 1]) : nullptr;
+
+                if (left && left->count > inner_min_)
+                {
+                    for (size_t i = node->count - 1; i > 0; --i)
+                        btree_relocate(&node->key(i), &node->key(i - 1));
+                    for (size_t i = node->count; i > 0; --i)
+                        node->set_child(i, node->children[i - 1]);
+
+                    ::new(static_cast<void*>(&node->key(0))) key_type(move(parent->key(pos - 1)));
+                    node->set_child(0, left->children[left->count - 1]);
+                    ++node->count;
+
+                    parent->key(pos - 1) = move(left->key(left->count - 2));
+                    left->key(left->count - 2).~key_type();
+                    --left->count;
+                }
+                else if (right && right->count > inner_min_)
+                {
+                    ::new(static_cast<void*>(&node->key(node->count - 1))) key_type(move(parent->key(pos)));
+                    node->set_child(node->count, right->children[0]);
+                    ++node->count;
+
+                    parent->key(pos) = move(right->key(0));
+                    right->key(0).~key_type();
+                    for (size_t i = 0; i + 2 < right->count; ++i)
+                        btree_relocate(&right->key(i), &right->key(i + 1));
+                    for (size_t i = 0; i + 1 < right->count; ++i)
+                        right->set_child(i, right->children[i + 1]);
+                    --right->count;
+                }
+                else if (left)
+                    merge_inner_(left, node);
+                else
+                    merge_inner_(node, right);
+            }
+
+            void merge_inner_(inner_type* left, inner_type* right)
+            {
+                auto parent = left->parent;
+                auto pos = left->pos;
+
+                ::new(static_cast<void*>(&left->key(left->count - 1))) key_type(parent->key(pos));
+                for (size_t i = 0; i + 1 < right->count; ++i)
+                    btree_relocate(&left->key(left->count + i), &right->key(i));
+                for (size_t i = 0; i < right->count; ++i)
+                    left->set_child(left->count + i, right->children[i]);
+                left->count += right->count;
+                right->count = 0;
+
+                parent->remove(pos);
+                delete right;
+
+                rebalance_inner_(parent);
+            }
+
+            void destroy_(node_type* node)
+            {
+                if (node->leaf)
+                {
+                    delete static_cast<leaf_type*>(node);
+
+                    return;
+                }
+
+                auto inner = static_cast<inner_type*>(node);
+                for (size_t i = 0; i < inner->count; ++i)
+                    destroy_(inner->children[i]);
+                delete inner;
+            }
+    };
+
+    /**
+     * Members common to all of the btree_* containers,
+     * the insertion functions differ in their return types
+     * and are provided by the containers themselves.
+     */
+    template<class Tree, bool ConstIterators>
+    class btree_container
+    {
+        public:
+            using key_type        = typename Tree::key_type;
+            using value_type      = typename Tree::value_type;
+            using key_compare     = typename Tree::key_compare;
+            using allocator_type  = typename Tree::allocator_type;
+            using pointer         = typename allocator_traits<allocator_type>::pointer;
+            using const_pointer   = typename allocator_traits<allocator_type>::const_pointer;
+            using reference       = value_type&;
+            using const_reference = const value_type&;
+            using size_type       = typename Tree::size_type;
+            using difference_type = ptrdiff_t;
+
+            using iterator       = conditional_t<
+                ConstIterators, typename Tree::const_iterator, typename Tree::iterator
+            >;
+            using const_iterator = typename Tree::const_iterator;
+
+            using reverse_iterator       = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+            static constexpr size_t leaf_capacity = Tree::leaf_capacity;
+            static constexpr size_t inner_capacity = Tree::inner_capacity;
+
+            btree_container()
+                : btree_container{key_compare{}}
+            { /* DUMMY BODY */ }
+
+            explicit btree_container(const key_compare& comp,
+                                     const allocator_type& alloc = allocator_type{})
+                : tree_{comp}, allocator_{alloc}
+            { /* DUMMY BODY */ }
+
+            explicit btree_container(const allocator_type& alloc)
+                : tree_{}, allocator_{alloc}
+            { /* DUMMY BODY */ }
+
+            template<class InputIterator>
+            btree_container(experimental::sorted_range_t,
+                            InputIterator first, InputIterator last,
+                            const key_compare& comp = key_compare{},
+                            const allocator_type& alloc = allocator_type{})
+                : btree_container{comp, alloc}
+            {
+                tree_.assign_sorted(first, last);
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_;
+            }
+
+            iterator begin() noexcept
+            {
+                return tree_.begin();
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return tree_.begin();
+            }
+
+            iterator end() noexcept
+            {
+                return tree_.end();
+            }
+
+            const_iterator end() const noexcept
+            {
+                return tree_.end();
+            }
+
+            reverse_iterator rbegin() noexcept
+            {
+                return make_reverse_iterator(end());
+            }
+
+            const_reverse_iterator rbegin() const noexcept
+            {
+                return make_reverse_iterator(cend());
+            }
+
+            reverse_iterator rend() noexcept
+            {
+                return make_reverse_iterator(begin());
+            }
+
+            const_reverse_iterator rend() const noexcept
+            {
+                return make_reverse_iterator(cbegin());
+            }
+
+            const_iterator cbegin() const noexcept
+            {
+                return tree_.cbegin();
+            }
+
+            const_iterator cend() const noexcept
+            {
+                return tree_.cend();
+            }
+
+            const_reverse_iterator crbegin() const noexcept
+            {
+                return rbegin();
+            }
+
+            const_reverse_iterator crend() const noexcept
+            {
+                return rend();
+            }
+
+            bool empty() const noexcept
+            {
+                return tree_.empty();
+            }
+
+            size_type size() const noexcept
+            {
+                return tree_.size();
+            }
+
+            size_type max_size() const noexcept
+            {
+                return allocator_traits<allocator_type>::max_size(allocator_);
+            }
+
+            /**
+             * Replaces the content with the values in [first, last),
+             * which have to be sorted by key_comp, in linear time.
+             */
+            template<class InputIterator>
+            void assign_sorted(InputIterator first, InputIterator last)
+            {
+                tree_.assign_sorted(first, last);
+            }
+
+            iterator erase(const_iterator position)
+            {
+                return tree_.erase(position);
+            }
+
+            size_type erase(const key_type& key)
+            {
+                return tree_.erase(key);
+            }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                return tree_.erase(first, last);
+            }
+
+            void clear() noexcept
+            {
+                tree_.clear();
+            }
+
+            key_compare key_comp() const
+            {
+                return tree_.key_comp();
+            }
+
+            iterator find(const key_type& key)
+            {
+                return tree_.find(key);
+            }
+
+            const_iterator find(const key_type& key) const
+            {
+                return tree_.find(key);
+            }
+
+            size_type count(const key_type& key) const
+            {
+                return tree_.count(key);
+            }
+
+            iterator lower_bound(const key_type& key)
+            {
+                return tree_.lower_bound(key);
+            }
+
+            const_iterator lower_bound(const key_type& key) const
+            {
+                return tree_.lower_bound(key);
+            }
+
+            iterator upper_bound(const key_type& key)
+            {
+                return tree_.upper_bound(key);
+            }
+
+            const_iterator upper_bound(const key_type& key) const
+            {
+                return tree_.upper_bound(key);
+            }
+
+            pair<iterator, iterator> equal_range(const key_type& key)
+            {
+                return make_pair(lower_bound(key), upper_bound(key));
+            }
+
+            pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+            {
+                return tree_.equal_range(key);
+            }
+
+            /**
+             * Number of levels of the tree, used for testing.
+             */
+            size_type __height() const noexcept
+            {
+                return tree_.height();
+            }
+
+            friend bool operator==(const btree_container& lhs, const btree_container& rhs)
+            {
+                return lhs.tree_.is_eq_to(rhs.tree_);
+            }
+
+            friend bool operator!=(const btree_container& lhs, const btree_container& rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+            friend bool operator<(const btree_container& lhs, const btree_container& rhs)
+            {
+                return lexicographical_compare(
+                    lhs.begin(), lhs.end(),
+                    rhs.begin(), rhs.end()
+                );
+            }
+
+            friend bool operator>(const btree_container& lhs, const btree_container& rhs)
+            {
+                return rhs < lhs;
+            }
+
+            friend bool operator<=(const btree_container& lhs, const btree_container& rhs)
+            {
+                return !(rhs < lhs);
+            }
+
+            friend bool operator>=(const btree_container& lhs, const btree_container& rhs)
+            {
+                return !(lhs < rhs);
+            }
+
+        protected:
+            Tree tree_;
+            allocator_type allocator_;
+
+            void swap_(btree_container& other)
+            {
+                tree_.swap(other.tree_);
+                std::swap(allocator_, other.allocator_);
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_BTREE_ITERATORS
+#define LIBCPP_BITS_ADT_BTREE_ITERATORS
+
+#include <__bits/adt/btree_node.hpp>
+#include <__bits/iterator_helpers.hpp>
+#include <iterator>
+
+namespace std::aux
+{
+    /**
+     * Note: An iterator is a leaf and an index into it, the end
+     *       iterator has no leaf and remembers the last leaf
+     *       of the tree so that it can be decremented.
+     *       Unlike in the red-black tree, values move between
+     *       nodes when the tree is modified, so insertions and
+     *       erasures invalidate all iterators.
+     */
+
+    template<class Value, class Reference, class Pointer, class Size, class Leaf>
+    class btree_iterator
+    {
+        public:
+            using value_type      = Value;
+            using size_type       = Size;
+            using reference       = Reference;
+            using pointer         = Pointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = bidirectional_iterator_tag;
+
+            using leaf_type = Leaf;
+
+            btree_iterator(leaf_type* leaf = nullptr, size_type idx = 0,
+                           leaf_type* last = nullptr)
+                : leaf_{leaf}, idx_{idx}, last_{last}
+            { /* DUMMY BODY */ }
+
+            btree_iterator(const btree_iterator&) = default;
+            btree_iterator& operator=(const btree_iterator&) = default;
+
+            reference operator*() const
+            {
+                return leaf_->value(idx_);
+            }
+
+            pointer operator->() const
+            {
+                return &leaf_->value(idx_);
+            }
+
+            btree_iterator& operator++()
+            {
+                if (!leaf_)
+                    return *this;
+
+                if (++idx_ == leaf_->count)
+                {
+                    if (!leaf_->next)
+                        last_ = leaf_;
+                    leaf_ = leaf_->next;
+                    idx_ = 0;
+                }
+
+                return *this;
+            }
+
+            btree_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            btree_iterator& operator--()
+            {
+                if (!leaf_)
+                {
+                    leaf_ = last_;
+                    idx_ = leaf_ ? leaf_->count - 1 : 0;
+                }
+                else if (idx_ == 0)
+                {
+                    if (leaf_->prev)
+                    {
+                        leaf_ = leaf_->prev;
+                        idx_ = leaf_->count - 1;
+                    }
+                }
+                else
+                    --idx_;
+
+                return *this;
+            }
+
+            btree_iterator operator--(int)
+            {
+                auto tmp = *this;
+                --(*this);
+
+                return tmp;
+            }
+
+            leaf_type* leaf() const
+            {
+                return leaf_;
+            }
+
+            size_type index() const
+            {
+                return idx_;
+            }
+
+            leaf_type* last() const
+            {
+                return last_;
+            }
+
+        private:
+            leaf_type* leaf_;
+            size_type idx_;
+            leaf_type* last_;
+    };
+
+    template<class Val, class Ref, class Ptr, class Sz, class L>
+    bool operator==(const btree_iterator<Val, Ref, Ptr, Sz, L>& lhs,
+                    const btree_iterator<Val, Ref, Ptr, Sz, L>& rhs)
+    {
+        return lhs.leaf() == rhs.leaf() && lhs.index() == rhs.index();
+    }
+
+    template<class Val, class Ref, class Ptr, class Sz, class L>
+    bool operator!=(const btree_iterator<Val, Ref, Ptr, Sz, L>& lhs,
+                    const btree_iterator<Val, Ref, Ptr, Sz, L>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Value, class ConstReference, class ConstPointer, class Size, class Leaf>
+    class btree_const_iterator
+    {
+        using non_const_iterator_type = btree_iterator<
+            Value, get_non_const_ref_t<ConstReference>,
+            get_non_const_ptr_t<ConstPointer>, Size, Leaf
+        >;
+
+        public:
+            using value_type      = Value;
+            using size_type       = Size;
+            using const_reference = ConstReference;
+            using const_pointer   = ConstPointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = bidirectional_iterator_tag;
+
+            // For iterator_traits.
+            using reference = ConstReference;
+            using pointer   = ConstPointer;
+
+            using leaf_type = Leaf;
+
+            btree_const_iterator(const leaf_type* leaf = nullptr, size_type idx = 0,
+                                 const leaf_type* last = nullptr)
+                : it_{const_cast<leaf_type*>(leaf), idx, const_cast<leaf_type*>(last)}
+            { /* DUMMY BODY */ }
+
+            btree_const_iterator(const btree_const_iterator&) = default;
+            btree_const_iterator& operator=(const btree_const_iterator&) = default;
+
+            btree_const_iterator(const non_const_iterator_type& other)
+                : it_{other}
+            { /* DUMMY BODY */ }
+
+            btree_const_iterator& operator=(const non_const_iterator_type& other)
+            {
+                it_ = other;
+
+                return *this;
+            }
+
+            const_reference operator*() const
+            {
+                return *it_;
+            }
+
+            const_pointer operator->() const
+            {
+                return it_.operator->();
+            }
+
+            btree_const_iterator& operator++()
+            {
+                ++it_;
+
+                return *this;
+            }
+
+            btree_const_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            btree_const_iterator& operator--()
+            {
+                --it_;
+
+                return *this;
+            }
+
+            btree_const_iterator operator--(int)
+            {
+                auto tmp = *this;
+                --(*this);
+
+                return tmp;
+            }
+
+            const leaf_type* leaf() const
+            {
+                return it_.leaf();
+            }
+
+            size_type index() const
+            {
+                return it_.index();
+            }
+
+            const leaf_type* last() const
+            {
+                return it_.last();
+            }
+
+        private:
+            non_const_iterator_type it_;
+    };
+
+    template<class Val, class CRef, class CPtr, class Sz, class L>
+    bool operator==(const btree_const_iterator<Val, CRef, CPtr, Sz, L>& lhs,
+                    const btree_const_iterator<Val, CRef, CPtr, Sz, L>& rhs)
+    {
+        return lhs.leaf() == rhs.leaf() && lhs.index() == rhs.index();
+    }
+
+    template<class Val, class CRef, class CPtr, class Sz, class L>
+    bool operator!=(const btree_const_iterator<Val, CRef, CPtr, Sz, L>& lhs,
+                    const btree_const_iterator<Val, CRef, CPtr, Sz, L>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Val, class Ref, class Ptr, class CRef, class CPtr, class Sz, class L>
+    bool operator==(const btree_iterator<Val, Ref, Ptr, Sz, L>& lhs,
+                    const btree_const_iterator<Val, CRef, CPtr, Sz, L>& rhs)
+    {
+        return lhs.leaf() == rhs.leaf() && lhs.index() == rhs.index();
+    }
+
+    template<class Val, class Ref, class Ptr, class CRef, class CPtr, class Sz, class L>
+    bool operator!=(const btree_iterator<Val, Ref, Ptr, Sz, L>& lhs,
+                    const btree_const_iterator<Val, CRef, CPtr, Sz, L>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class Val, class CRef, class CPtr, class Ref, class Ptr, class Sz, class L>
+    bool operator==(const btree_const_iterator<Val, CRef, CPtr, Sz, L>& lhs,
+                    const btree_iterator<Val, Ref, Ptr, Sz, L>& rhs)
+    {
+        return lhs.leaf() == rhs.leaf() && lhs.index() == rhs.index();
+    }
+
+    template<class Val, class CRef, class CPtr, class Ref, class Ptr, class Sz, class L>
+    bool operator!=(const btree_const_iterator<Val, CRef, CPtr, Sz, L>& lhs,
+                    const btree_iterator<Val, Ref, Ptr, Sz, L>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_BTREE_MAP
+#define LIBCPP_BITS_ADT_BTREE_MAP
+
+#include <__bits/adt/btree.hpp>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace std::experimental
+{
+    /**
+     * Extension: Ordered maps backed by a B-tree with wide
+     * nodes, which need far fewer cache misses per lookup
+     * and less memory per element than map and multimap.
+     * The interface mirrors theirs except that all iterators
+     * are invalidated by insertions and erasures. Fanout
+     * sets the capacity of the nodes, zero sizes them
+     * to a few cache lines.
+     */
+
+    template<
+        class Key, class Value,
+        class Compare = less<Key>,
+        class Alloc = allocator<pair<const Key, Value>>,
+        size_t Fanout = 0
+    >
+    class btree_map: public aux::btree_container<
+        aux::btree<
+            pair<const Key, Value>, Key, aux::key_value_key_extractor<Key, Value>,
+            Compare, Alloc, size_t, false, Fanout
+        >, false
+    >
+    {
+        using base_t = aux::btree_container<
+            aux::btree<
+                pair<const Key, Value>, Key, aux::key_value_key_extractor<Key, Value>,
+                Compare, Alloc, size_t, false, Fanout
+            >, false
+        >;
+
+        public:
+            using mapped_type = Value;
+
+            using typename base_t::key_type;
+            using typename base_t::value_type;
+            using typename base_t::key_compare;
+            using typename base_t::allocator_type;
+            using typename base_t::size_type;
+            using typename base_t::iterator;
+            using typename base_t::const_iterator;
+
+            class value_compare
+            {
+                friend class btree_map;
+
+                protected:
+                    key_compare comp;
+
+                    value_compare(key_compare c)
+                        : comp{c}
+                    { /* DUMMY BODY */ }
+
+                public:
+                    using result_type          = bool;
+                    using first_argument_type  = value_type;
+                    using second_argument_type = value_type;
+
+                    bool operator()(const value_type& lhs, const value_type& rhs) const
+                    {
+                        return comp(lhs.first, rhs.first);
+                    }
+            };
+
+            using base_t::base_t;
+
+            template<class InputIterator>
+            btree_map(InputIterator first, InputIterator last,
+                      const key_compare& comp = key_compare{},
+                      const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(first, last);
+            }
+
+            btree_map(initializer_list<value_type> init,
+                      const key_compare& comp = key_compare{},
+                      const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            btree_map& operator=(initializer_list<value_type> init)
+            {
+                this->clear();
+                insert(init.begin(), init.end());
+
+                return *this;
+            }
+
+            mapped_type& operator[](const key_type& key)
+            {
+                return try_emplace(key).first->second;
+            }
+
+            mapped_type& operator[](key_type&& key)
+            {
+                return try_emplace(move(key)).first->second;
+            }
+
+            mapped_type& at(const key_type& key)
+            {
+                auto it = this->find(key);
+
+                // TODO: throw out_of_range if it == end()
+                return it->second;
+            }
+
+            const mapped_type& at(const key_type& key) const
+            {
+                auto it = this->find(key);
+
+                // TODO: throw out_of_range if it == end()
+                return it->second;
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                return this->tree_.emplace(forward<Args>(args)...);
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args&&... args)
+            {
+                return emplace(forward<Args>(args)...).first;
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                return this->tree_.insert(val);
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                return this->tree_.insert(forward<value_type>(val));
+            }
+
+            template<class T>
+            pair<iterator, bool> insert(
+                T&& val,
+                enable_if_t<is_constructible_v<value_type, T&&>>* = nullptr
+            )
+            {
+                return emplace(forward<T>(val));
+            }
+
+            iterator insert(const_iterator, const value_type& val)
+            {
+                return insert(val).first;
+            }
+
+            iterator insert(const_iterator, value_type&& val)
+            {
+                return insert(forward<value_type>(val)).first;
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            void insert(initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            template<class... Args>
+            pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+            {
+                return this->tree_.emplace_key(key, [&]() {
+                    return value_type{key, mapped_type(forward<Args>(args)...)};
+                });
+            }
+
+            template<class... Args>
+            pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+            {
+                // The position is found before the key is moved.
+                return this->tree_.emplace_key(key, [&]() {
+                    return value_type{move(key), mapped_type(forward<Args>(args)...)};
+                });
+            }
+
+            template<class T>
+            pair<iterator, bool> insert_or_assign(const key_type& key, T&& val)
+            {
+                auto it = this->find(key);
+                if (it != this->end())
+                {
+                    it->second = forward<T>(val);
+
+                    return make_pair(it, false);
+                }
+
+                return try_emplace(key, forward<T>(val));
+            }
+
+            template<class T>
+            pair<iterator, bool> insert_or_assign(key_type&& key, T&& val)
+            {
+                auto it = this->find(key);
+                if (it != this->end())
+                {
+                    it->second = forward<T>(val);
+
+                    return make_pair(it, false);
+                }
+
+                return try_emplace(move(key), forward<T>(val));
+            }
+
+            void swap(btree_map& other)
+            {
+                this->swap_(other);
+            }
+
+            value_compare value_comp() const
+            {
+                return value_compare{this->key_comp()};
+            }
+    };
+
+    template<
+        class Key, class Value,
+        class Compare = less<Key>,
+        class Alloc = allocator<pair<const Key, Value>>,
+        size_t Fanout = 0
+    >
+    class btree_multimap: public aux::btree_container<
+        aux::btree<
+            pair<const Key, Value>, Key, aux::key_value_key_extractor<Key, Value>,
+            Compare, Alloc, size_t, true, Fanout
+        >, false
+    >
+    {
+        using base_t = aux::btree_container<
+            aux::btree<
+                pair<const Key, Value>, Key, aux::key_value_key_extractor<Key, Value>,
+                Compare, Alloc, size_t, true, Fanout
+            >, false
+        >;
+
+        public:
+            using mapped_type = Value;
+
+            using typename base_t::key_type;
+            using typename base_t::value_type;
+            using typename base_t::key_compare;
+            using typename base_t::allocator_type;
+            using typename base_t::iterator;
+            using typename base_t::const_iterator;
+
+            class value_compare
+            {
+                friend class btree_multimap;
+
+                protected:
+                    key_compare comp;
+
+                    value_compare(key_compare c)
+                        : comp{c}
+                    { /* DUMMY BODY */ }
+
+                public:
+                    using result_type          = bool;
+                    using first_argument_type  = value_type;
+                    using second_argument_type = value_type;
+
+                    bool operator()(const value_type& lhs, const value_type& rhs) const
+                    {
+                        return comp(lhs.first, rhs.first);
+                    }
+            };
+
+            using base_t::base_t;
+
+            template<class InputIterator>
+            btree_multimap(InputIterator first, InputIterator last,
+                           const key_compare& comp = key_compare{},
+                           const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(first, last);
+            }
+
+            btree_multimap(initializer_list<value_type> init,
+                           const key_compare& comp = key_compare{},
+                           const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            btree_multimap& operator=(initializer_list<value_type> init)
+            {
+                this->clear();
+                insert(init.begin(), init.end());
+
+                return *this;
+            }
+
+            template<class... Args>
+            iterator emplace(Args&&... args)
+            {
+                return this->tree_.emplace(forward<Args>(args)...).first;
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args&&... args)
+            {
+                return emplace(forward<Args>(args)...);
+            }
+
+            iterator insert(const value_type& val)
+            {
+                return this->tree_.insert(val).first;
+            }
+
+            iterator insert(value_type&& val)
+            {
+                return this->tree_.insert(forward<value_type>(val)).first;
+            }
+
+            template<class T>
+            iterator insert(
+                T&& val,
+                enable_if_t<is_constructible_v<value_type, T&&>>* = nullptr
+            )
+            {
+                return emplace(forward<T>(val));
+            }
+
+            iterator insert(const_iterator, const value_type& val)
+            {
+                return insert(val);
+            }
+
+            iterator insert(const_iterator, value_type&& val)
+            {
+                return insert(forward<value_type>(val));
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            void insert(initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            void swap(btree_multimap& other)
+            {
+                this->swap_(other);
+            }
+
+            value_compare value_comp() const
+            {
+                return value_compare{this->key_comp()};
+            }
+    };
+}
+
+#endif
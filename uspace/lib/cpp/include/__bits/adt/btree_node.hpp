@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_BTREE_NODE
+#define LIBCPP_BITS_ADT_BTREE_NODE
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Note: The B-tree stores all values in its leaves, which
+     *       are linked for iteration. Inner nodes store copies
+     *       of the keys of their children as separators in
+     *       a contiguous array, so that descending the tree
+     *       touches only a couple of cache lines per level.
+     *       Both kinds of nodes construct their elements in raw
+     *       storage, so neither the values nor the keys need
+     *       to be default constructible.
+     */
+
+    template<class Key, size_t InnerCap>
+    struct btree_inner;
+
+    template<class Key, size_t InnerCap>
+    struct btree_node
+    {
+        btree_inner<Key, InnerCap>* parent;
+
+        /**
+         * Index of this node in the children
+         * array of its parent.
+         */
+        size_t pos;
+
+        /**
+         * Number of values in a leaf,
+         * number of children in an inner node.
+         */
+        size_t count;
+
+        bool leaf;
+
+        explicit btree_node(bool is_leaf)
+            : parent{nullptr}, pos{}, count{}, leaf{is_leaf}
+        { /* DUMMY BODY */ }
+    };
+
+    /**
+     * Moves the object at src to the uninitialized
+     * storage at dst, src is left uninitialized.
+     */
+    template<class T>
+    void btree_relocate(T* dst, T* src)
+    {
+        ::new(static_cast<void*>(dst)) T(move(*src));
+        src->~T();
+    }
+
+    template<class Key, size_t InnerCap>
+    struct btree_inner: btree_node<Key, InnerCap>
+    {
+        using node_type = btree_node<Key, InnerCap>;
+
+        /**
+         * Invariant: All keys in children[i] are less than
+         *            or equivalent to key(i) and all keys in
+         *            children[i + 1] are greater than or
+         *            equivalent to it.
+         */
+        alignas(Key) unsigned char keys[sizeof(Key) * (InnerCap - 1)];
+        node_type* children[InnerCap];
+
+        btree_inner()
+            : node_type{false}, children{}
+        { /* DUMMY BODY */ }
+
+        ~btree_inner()
+        {
+            for (size_t i = 0; i + 1 < this->count; ++i)
+                key(i).~Key();
+        }
+
+        Key& key(size_t i)
+        {
+            return reinterpret_cast<Key*>(keys)[i];
+        }
+
+        const Key& key(size_t i) const
+        {
+            return reinterpret_cast<const Key*>(keys)[i];
+        }
+
+        void set_child(size_t i, node_type* child)
+        {
+            children[i] = child;
+            child->parent = this;
+            child->pos = i;
+        }
+
+        /**
+         * Inserts the separator key at index i and the child
+         * to the right of it at index i + 1.
+         */
+        void insert(size_t i, const Key& k, node_type* child)
+        {
+            for (size_t j = this->count - 1; j > i; --j)
+                btree_relocate(&key(j), &key(j - 1));
+            for (size_t j = this->count; j > i + 1; --j)
+                set_child(j, children[j - 1]);
+
+            ::new(static_cast<void*>(&key(i))) Key(k);
+            set_child(i + 1, child);
+            ++this->count;
+        }
+
+        /**
+         * Removes the separator key at index i and the child
+         * to the right of it at index i + 1.
+         */
+        void remove(size_t i)
+        {
+            key(i).~Key();
+            for (size_t j = i; j + 2 < this->count; ++j)
+                btree_relocate(&key(j), &key(j + 1));
+            for (size_t j = i + 1; j + 1 < this->count; ++j)
+                set_child(j, children[j + 1]);
+
+            --this->count;
+        }
+    };
+
+    template<class Value, class Key, size_t LeafCap, size_t InnerCap>
+    struct btree_leaf: btree_node<Key, InnerCap>
+    {
+        using node_type = btree_node<Key, InnerCap>;
+
+        btree_leaf* prev;
+        btree_leaf* next;
+
+        alignas(Value) unsigned char values[sizeof(Value) * LeafCap];
+
+        btree_leaf()
+            : node_type{true}, prev{nullptr}, next{nullptr}
+        { /* DUMMY BODY */ }
+
+        ~btree_leaf()
+        {
+            for (size_t i = 0; i < this->count; ++i)
+                value(i).~Value();
+        }
+
+        Value& value(size_t i)
+        {
+            return reinterpret_cast<Value*>(values)[i];
+        }
+
+        const Value& value(size_t i) const
+        {
+            return reinterpret_cast<const Value*>(values)[i];
+        }
+
+        /**
+         * Shifts the values at indices [i, count) one slot
+         * to the right, the caller constructs the new value
+         * at index i.
+         */
+        void open(size_t i)
+        {
+            for (size_t j = this->count; j > i; --j)
+                btree_relocate(&value(j), &value(j - 1));
+            ++this->count;
+        }
+
+        void remove(size_t i)
+        {
+            value(i).~Value();
+            for (size_t j = i; j + 1 < this->count; ++j)
+                btree_relocate(&value(j), &value(j + 1));
+            --this->count;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_BTREE_SET
+#define LIBCPP_BITS_ADT_BTREE_SET
+
+#include <__bits/adt/btree.hpp>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace std::experimental
+{
+    /**
+     * Extension: Ordered sets backed by a B-tree, see
+     * btree_map for details.
+     */
+
+    template<
+        class Key,
+        class Compare = less<Key>,
+        class Alloc = allocator<Key>,
+        size_t Fanout = 0
+    >
+    class btree_set: public aux::btree_container<
+        aux::btree<
+            Key, Key, aux::key_no_value_key_extractor<Key>,
+            Compare, Alloc, size_t, false, Fanout
+        >, true
+    >
+    {
+        using base_t = aux::btree_container<
+            aux::btree<
+                Key, Key, aux::key_no_value_key_extractor<Key>,
+                Compare, Alloc, size_t, false, Fanout
+            >, true
+        >;
+
+        public:
+            using typename base_t::key_type;
+            using typename base_t::value_type;
+            using typename base_t::key_compare;
+            using typename base_t::allocator_type;
+            using typename base_t::iterator;
+            using typename base_t::const_iterator;
+
+            using value_compare = Compare;
+
+            using base_t::base_t;
+
+            template<class InputIterator>
+            btree_set(InputIterator first, InputIterator last,
+                      const key_compare& comp = key_compare{},
+                      const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(first, last);
+            }
+
+            btree_set(initializer_list<value_type> init,
+                      const key_compare& comp = key_compare{},
+                      const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            btree_set& operator=(initializer_list<value_type> init)
+            {
+                this->clear();
+                insert(init.begin(), init.end());
+
+                return *this;
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                return this->tree_.emplace(forward<Args>(args)...);
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args&&... args)
+            {
+                return emplace(forward<Args>(args)...).first;
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                return this->tree_.insert(val);
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                return this->tree_.insert(forward<value_type>(val));
+            }
+
+            iterator insert(const_iterator, const value_type& val)
+            {
+                return insert(val).first;
+            }
+
+            iterator insert(const_iterator, value_type&& val)
+            {
+                return insert(forward<value_type>(val)).first;
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            void insert(initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            void swap(btree_set& other)
+            {
+                this->swap_(other);
+            }
+
+            value_compare value_comp() const
+            {
+                return this->key_comp();
+            }
+    };
+
+    template<
+        class Key,
+        class Compare = less<Key>,
+        class Alloc = allocator<Key>,
+        size_t Fanout = 0
+    >
+    class btree_multiset: public aux::btree_container<
+        aux::btree<
+            Key, Key, aux::key_no_value_key_extractor<Key>,
+            Compare, Alloc, size_t, true, Fanout
+        >, true
+    >
+    {
+        using base_t = aux::btree_container<
+            aux::btree<
+                Key, Key, aux::key_no_value_key_extractor<Key>,
+                Compare, Alloc, size_t, true, Fanout
+            >, true
+        >;
+
+        public:
+            using typename base_t::key_type;
+            using typename base_t::value_type;
+            using typename base_t::key_compare;
+            using typename base_t::allocator_type;
+            using typename base_t::iterator;
+            using typename base_t::const_iterator;
+
+            using value_compare = Compare;
+
+            using base_t::base_t;
+
+            template<class InputIterator>
+            btree_multiset(InputIterator first, InputIterator last,
+                           const key_compare& comp = key_compare{},
+                           const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(first, last);
+            }
+
+            btree_multiset(initializer_list<value_type> init,
+                           const key_compare& comp = key_compare{},
+                           const allocator_type& alloc = allocator_type{})
+                : base_t{comp, alloc}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            btree_multiset& operator=(initializer_list<value_type> init)
+            {
+                this->clear();
+                insert(init.begin(), init.end());
+
+                return *this;
+            }
+
+            template<class... Args>
+            iterator emplace(Args&&... args)
+            {
+                return this->tree_.emplace(forward<Args>(args)...).first;
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args&&... args)
+            {
+                return emplace(forward<Args>(args)...);
+            }
+
+            iterator insert(const value_type& val)
+            {
+                return this->tree_.insert(val).first;
+            }
+
+            iterator insert(value_type&& val)
+            {
+                return this->tree_.insert(forward<value_type>(val)).first;
+            }
+
+            iterator insert(const_iterator, const value_type& val)
+            {
+                return insert(val);
+            }
+
+            iterator insert(const_iterator, value_type&& val)
+            {
+                return insert(forward<value_type>(val));
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            void insert(initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            void swap(btree_multiset& other)
+            {
+                this->swap_(other);
+            }
+
+            value_compare value_comp() const
+            {
+                return this->key_comp();
+            }
+    };
+}
+
+#endif
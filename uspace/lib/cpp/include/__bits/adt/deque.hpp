@@ -42,9 +42,24 @@ namespace std
 
     namespace aux
     {
+        /**
+         * Blocks hold a power of two number of elements so that
+         * indexing is a shift and a mask. We aim for blocks of
+         * about 512 bytes, but at least 16 elements each.
+         */
+        template<class T>
+        constexpr size_t deque_block_shift()
+        {
+            size_t shift{4};
+            while ((sizeof(T) << (shift + 1)) <= 512)
+                ++shift;
+
+            return shift;
+        }
+
         /**
          * Note: We decided that these iterators contain a
-         *       reference to the container and an index, which
+         *       pointer to the container and an index, which
          *       allows us to use the already implemented operator[]
          *       on deque and also allows us to conform to the requirement
          *       of the standard that functions such as push_back
@@ -61,34 +76,29 @@ namespace std
                 using size_type         = typename deque<T, Allocator>::size_type;
                 using value_type        = typename deque<T, Allocator>::value_type;
                 using reference         = typename deque<T, Allocator>::const_reference;
-                using difference_type   = size_type;
+                using difference_type   = typename deque<T, Allocator>::difference_type;
                 using pointer           = const value_type*;
                 using iterator_category = random_access_iterator_tag;
 
-                deque_const_iterator(const deque<T, Allocator>& deq, size_type idx)
-                    : deq_{deq}, idx_{idx}
+                deque_const_iterator()
+                    : deq_{}, idx_{}
                 { /* DUMMY BODY */ }
 
-                deque_const_iterator(const deque_const_iterator& other)
-                    : deq_{other.deq_}, idx_{other.idx_}
+                deque_const_iterator(const deque<T, Allocator>& deq, size_type idx)
+                    : deq_{&deq}, idx_{idx}
                 { /* DUMMY BODY */ }
 
-                deque_const_iterator& operator=(const deque_const_iterator& other)
-                {
-                    deq_ = other.deq_;
-                    idx_ = other.idx_;
-
-                    return *this;
-                }
+                deque_const_iterator(const deque_const_iterator&) = default;
+                deque_const_iterator& operator=(const deque_const_iterator&) = default;
 
                 reference operator*() const
                 {
-                    return deq_[idx_];
+                    return (*deq_)[idx_];
                 }
 
                 pointer operator->() const
                 {
-                    return addressof(deq_[idx_]);
+                    return addressof((*deq_)[idx_]);
                 }
 
                 deque_const_iterator& operator++()
@@ -100,7 +110,7 @@ namespace std
 
                 deque_const_iterator operator++(int)
                 {
-                    return deque_const_iterator{deq_, idx_++};
+                    return deque_const_iterator{*deq_, idx_++};
                 }
 
                 deque_const_iterator& operator--()
@@ -112,12 +122,12 @@ namespace std
 
                 deque_const_iterator operator--(int)
                 {
-                    return deque_const_iterator{deq_, idx_--};
+                    return deque_const_iterator{*deq_, idx_--};
                 }
 
-                deque_const_iterator operator+(difference_type n)
+                deque_const_iterator operator+(difference_type n) const
                 {
-                    return deque_const_iterator{deq_, idx_ + n};
+                    return deque_const_iterator{*deq_, idx_ + n};
                 }
 
                 deque_const_iterator& operator+=(difference_type n)
@@ -127,9 +137,9 @@ namespace std
                     return *this;
                 }
 
-                deque_const_iterator operator-(difference_type n)
+                deque_const_iterator operator-(difference_type n) const
                 {
-                    return deque_const_iterator{deq_, idx_ - n};
+                    return deque_const_iterator{*deq_, idx_ - n};
                 }
 
                 deque_const_iterator& operator-=(difference_type n)
@@ -141,12 +151,12 @@ namespace std
 
                 reference operator[](difference_type n) const
                 {
-                    return deq_[idx_ + n];
+                    return (*deq_)[idx_ + n];
                 }
 
-                difference_type operator-(const deque_const_iterator& rhs)
+                difference_type operator-(const deque_const_iterator& rhs) const
                 {
-                    return idx_ - rhs.idx_;
+                    return static_cast<difference_type>(idx_ - rhs.idx_);
                 }
 
                 size_type idx() const
@@ -154,15 +164,20 @@ namespace std
                     return idx_;
                 }
 
-                operator deque_iterator<T, Allocator>()
+                const deque<T, Allocator>* deq() const
+                {
+                    return deq_;
+                }
+
+                operator deque_iterator<T, Allocator>() const
                 {
                     return deque_iterator{
-                        const_cast<deque<T, Allocator>&>(deq_), idx_
+                        const_cast<deque<T, Allocator>&>(*deq_), idx_
                     };
                 }
 
             private:
-                const deque<T, Allocator>& deq_;
+                const deque<T, Allocator>* deq_;
                 size_type idx_;
         };
 
@@ -180,6 +195,13 @@ namespace std
             return !(lhs == rhs);
         }
 
+        template<class T, class Allocator>
+        bool operator<(const deque_const_iterator<T, Allocator>& lhs,
+                       const deque_const_iterator<T, Allocator>& rhs)
+        {
+            return lhs.idx() < rhs.idx();
+        }
+
         template<class T, class Allocator>
         class deque_iterator
         {
@@ -187,46 +209,42 @@ namespace std
                 using size_type         = typename deque<T, Allocator>::size_type;
                 using value_type        = typename deque<T, Allocator>::value_type;
                 using reference         = typename deque<T, Allocator>::reference;
-                using difference_type   = size_type;
+                using difference_type   = typename deque<T, Allocator>::difference_type;
                 using pointer           = value_type*;
                 using iterator_category = random_access_iterator_tag;
 
-                deque_iterator(deque<T, Allocator>& deq, size_type idx)
-                    : deq_{deq}, idx_{idx}
+                deque_iterator()
+                    : deq_{}, idx_{}
                 { /* DUMMY BODY */ }
 
-                deque_iterator(const deque_iterator& other)
-                    : deq_{other.deq_}, idx_{other.idx_}
+                deque_iterator(deque<T, Allocator>& deq, size_type idx)
+                    : deq_{&deq}, idx_{idx}
                 { /* DUMMY BODY */ }
 
+                deque_iterator(const deque_iterator&) = default;
+                deque_iterator& operator=(const deque_iterator&) = default;
+
                 deque_iterator(const deque_const_iterator<T, Allocator>& other)
-                    : deq_{other.deq_}, idx_{other.idx_}
+                    : deq_{const_cast<deque<T, Allocator>*>(other.deq())},
+                      idx_{other.idx()}
                 { /* DUMMY BODY */ }
 
-                deque_iterator& operator=(const deque_iterator& other)
-                {
-                    deq_ = other.deq_;
-                    idx_ = other.idx_;
-
-                    return *this;
-                }
-
                 deque_iterator& operator=(const deque_const_iterator<T, Allocator>& other)
                 {
-                    deq_ = other.deq_;
-                    idx_ = other.idx_;
+                    deq_ = const_cast<deque<T, Allocator>*>(other.deq());
+                    idx_ = other.idx();
 
                     return *this;
                 }
 
-                reference operator*()
+                reference operator*() const
                 {
-                    return deq_[idx_];
+                    return (*deq_)[idx_];
                 }
 
-                pointer operator->()
+                pointer operator->() const
                 {
-                    return addressof(deq_[idx_]);
+                    return addressof((*deq_)[idx_]);
                 }
 
                 deque_iterator& operator++()
@@ -238,7 +256,7 @@ namespace std
 
                 deque_iterator operator++(int)
                 {
-                    return deque_iterator{deq_, idx_++};
+                    return deque_iterator{*deq_, idx_++};
                 }
 
                 deque_iterator& operator--()
@@ -250,12 +268,12 @@ namespace std
 
                 deque_iterator operator--(int)
                 {
-                    return deque_iterator{deq_, idx_--};
+                    return deque_iterator{*deq_, idx_--};
                 }
 
-                deque_iterator operator+(difference_type n)
+                deque_iterator operator+(difference_type n) const
                 {
-                    return deque_iterator{deq_, idx_ + n};
+                    return deque_iterator{*deq_, idx_ + n};
                 }
 
                 deque_iterator& operator+=(difference_type n)
@@ -265,9 +283,9 @@ namespace std
                     return *this;
                 }
 
-                deque_iterator operator-(difference_type n)
+                deque_iterator operator-(difference_type n) const
                 {
-                    return deque_iterator{deq_, idx_ - n};
+                    return deque_iterator{*deq_, idx_ - n};
                 }
 
                 deque_iterator& operator-=(difference_type n)
@@ -279,12 +297,12 @@ namespace std
 
                 reference operator[](difference_type n) const
                 {
-                    return deq_[idx_ + n];
+                    return (*deq_)[idx_ + n];
                 }
 
-                difference_type operator-(const deque_iterator& rhs)
+                difference_type operator-(const deque_iterator& rhs) const
                 {
-                    return idx_ - rhs.idx_;
+                    return static_cast<difference_type>(idx_ - rhs.idx_);
                 }
 
                 size_type idx() const
@@ -292,13 +310,13 @@ namespace std
                     return idx_;
                 }
 
-                operator deque_const_iterator<T, Allocator>()
+                operator deque_const_iterator<T, Allocator>() const
                 {
-                    return deque_const_iterator{deq_, idx_};
+                    return deque_const_iterator{*deq_, idx_};
                 }
 
             private:
-                deque<T, Allocator>& deq_;
+                deque<T, Allocator>* deq_;
                 size_type idx_;
         };
 
@@ -315,6 +333,13 @@ namespace std
         {
             return !(lhs == rhs);
         }
+
+        template<class T, class Allocator>
+        bool operator<(const deque_iterator<T, Allocator>& lhs,
+                       const deque_iterator<T, Allocator>& rhs)
+        {
+            return lhs.idx() < rhs.idx();
+        }
     }
 
     /**
@@ -349,47 +374,28 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit deque(const allocator_type& alloc)
-                : allocator_{alloc}, front_bucket_idx_{bucket_size_},
-                  back_bucket_idx_{0}, front_bucket_{default_front_},
-                  back_bucket_{default_back_}, bucket_count_{default_bucket_count_},
-                  bucket_capacity_{default_bucket_capacity_}, size_{}, data_{}
-            {
-                init_();
-            }
+                : allocator_{alloc}, map_{}, map_capacity_{}, map_head_{},
+                  map_size_{}, start_{}, size_{}
+            { /* DUMMY BODY */ }
 
             explicit deque(size_type n, const allocator_type& alloc = allocator_type{})
-                : allocator_{alloc}, front_bucket_idx_{bucket_size_}, back_bucket_idx_{},
-                  front_bucket_{}, back_bucket_{}, bucket_count_{},
-                  bucket_capacity_{}, size_{n}, data_{}
+                : deque{alloc}
             {
-                prepare_for_size_(n);
-                init_();
-
-                for (size_type i = 0; i < size_; ++i)
-                    allocator_.construct(&(*this)[i]);
-                back_bucket_idx_ = size_ % bucket_size_;
+                for (size_type i = 0; i < n; ++i)
+                    emplace_back();
             }
 
             deque(size_type n, const value_type& value, const allocator_type& alloc = allocator_type{})
-                : allocator_{alloc}, front_bucket_idx_{bucket_size_}, back_bucket_idx_{},
-                  front_bucket_{}, back_bucket_{}, bucket_count_{},
-                  bucket_capacity_{}, size_{n}, data_{}
+                : deque{alloc}
             {
-                prepare_for_size_(n);
-                init_();
-
-                for (size_type i = 0; i < size_; ++i)
-                    (*this)[i] = value;
-                back_bucket_idx_ = size_ % bucket_size_;
+                for (size_type i = 0; i < n; ++i)
+                    emplace_back(value);
             }
 
             template<class InputIterator>
             deque(InputIterator first, InputIterator last,
                   const allocator_type& alloc = allocator_type{})
-                : allocator_{alloc}, front_bucket_idx_{bucket_size_},
-                  back_bucket_idx_{}, front_bucket_{}, back_bucket_{},
-                  bucket_count_{}, bucket_capacity_{}, size_{},
-                  data_{}
+                : deque{alloc}
             {
                 copy_from_range_(first, last);
             }
@@ -400,16 +406,11 @@ namespace std
 
             deque(deque&& other)
                 : allocator_{move(other.allocator_)},
-                  front_bucket_idx_{other.front_bucket_idx_},
-                  back_bucket_idx_{other.back_bucket_idx_},
-                  front_bucket_{other.front_bucket_},
-                  back_bucket_{other.back_bucket_},
-                  bucket_count_{other.bucket_count_},
-                  bucket_capacity_{other.bucket_capacity_},
-                  size_{other.size_}, data_{other.data_}
-            {
-                other.data_ = nullptr;
-                other.clear();
+                  map_{other.map_}, map_capacity_{other.map_capacity_},
+                  map_head_{other.map_head_}, map_size_{other.map_size_},
+                  start_{other.start_}, size_{other.size_}
+            {
+                other.reset_();
             }
 
             deque(const deque& other, const allocator_type& alloc)
@@ -418,23 +419,15 @@ namespace std
 
             deque(deque&& other, const allocator_type& alloc)
                 : allocator_{alloc},
-                  front_bucket_idx_{other.front_bucket_idx_},
-                  back_bucket_idx_{other.front_bucket_idx_},
-                  front_bucket_{other.front_bucket_},
-                  back_bucket_{other.back_bucket_},
-                  bucket_count_{other.bucket_count_},
-                  bucket_capacity_{other.bucket_capacity_},
-                  size_{other.size_}, data_{other.data_}
-            {
-                other.data_ = nullptr;
-                other.clear();
+                  map_{other.map_}, map_capacity_{other.map_capacity_},
+                  map_head_{other.map_head_}, map_size_{other.map_size_},
+                  start_{other.start_}, size_{other.size_}
+            {
+                other.reset_();
             }
 
             deque(initializer_list<T> init, const allocator_type& alloc = allocator_type{})
-                : allocator_{alloc}, front_bucket_idx_{bucket_size_},
-                  back_bucket_idx_{}, front_bucket_{}, back_bucket_{},
-                  bucket_count_{}, bucket_capacity_{}, size_{},
-                  data_{}
+                : deque{alloc}
             {
                 copy_from_range_(init.begin(), init.end());
             }
@@ -446,10 +439,8 @@ namespace std
 
             deque& operator=(const deque& other)
             {
-                if (data_)
-                    fini_();
-
-                copy_from_range_(other.begin(), other.end());
+                if (this != &other)
+                    copy_from_range_(other.begin(), other.end());
 
                 return *this;
             }
@@ -465,9 +456,6 @@ namespace std
 
             deque& operator=(initializer_list<T> init)
             {
-                if (data_)
-                    fini_();
-
                 copy_from_range_(init.begin(), init.end());
 
                 return *this;
@@ -481,13 +469,10 @@ namespace std
 
             void assign(size_type n, const T& value)
             {
-                prepare_for_size_(n);
-                init_();
-                size_ = n;
+                clear();
 
-                auto it = begin();
                 for (size_type i = size_type{}; i < n; ++i)
-                    *it++ = value;
+                    emplace_back(value);
             }
 
             void assign(initializer_list<T> init)
@@ -576,45 +561,33 @@ namespace std
 
             void resize(size_type sz)
             {
-                if (sz <= size_)
-                {
-                    auto count = size_ - sz;
-                    for (size_type i = 0; i < count; ++i)
-                        pop_back();
-                }
-                else
-                {
-                    value_type value{};
-                    auto count = sz - size_;
-                    for (size_type i = 0; i < count; ++i)
-                        push_back(value);
-                }
+                while (sz < size_)
+                    pop_back();
+
+                while (sz > size_)
+                    emplace_back();
             }
 
             void resize(size_type sz, const value_type& value)
             {
-                if (sz <= size_)
-                {
-                    auto count = size_ - sz;
-                    for (size_type i = 0; i < count; ++i)
-                        pop_back();
-                }
-                else
-                {
-                    auto count = sz - size_;
-                    for (size_type i = 0; i < count; ++i)
-                        push_back(value);
-                }
+                while (sz < size_)
+                    pop_back();
+
+                while (sz > size_)
+                    emplace_back(value);
             }
 
             void shrink_to_fit()
             {
                 /**
-                 * We lazily allocate buckets and eagerily deallocate them.
-                 * We cannot go into smaller pieces as buckets have fixed size.
-                 * Because of this, shrink_to_fit has no effect (as permitted
-                 * by the standard).
+                 * Frees the spare blocks we keep at both ends,
+                 * the block map itself is kept.
                  */
+                while (front_spares_() > 0)
+                    free_block_(take_front_block_());
+
+                while (back_spares_() > 0)
+                    free_block_(take_back_block_());
             }
 
             bool empty() const noexcept
@@ -624,12 +597,16 @@ namespace std
 
             reference operator[](size_type idx)
             {
-                return data_[get_bucket_index_(idx)][get_element_index_(idx)];
+                auto pos = start_ + idx;
+
+                return block_(pos >> block_shift_)[pos & block_mask_];
             }
 
             const_reference operator[](size_type idx) const
             {
-                return data_[get_bucket_index_(idx)][get_element_index_(idx)];
+                auto pos = start_ + idx;
+
+                return block_(pos >> block_shift_)[pos & block_mask_];
             }
 
             reference at(size_type idx)
@@ -646,26 +623,22 @@ namespace std
 
             reference front()
             {
-                return *begin();
+                return (*this)[0];
             }
 
             const_reference front() const
             {
-                return *cbegin();
+                return (*this)[0];
             }
 
             reference back()
             {
-                auto tmp = end();
-
-                return *(--tmp);
+                return (*this)[size_ - 1];
             }
 
             const_reference back() const
             {
-                auto tmp = cend();
-
-                return *(--tmp);
+                return (*this)[size_ - 1];
             }
 
             /**
@@ -673,122 +646,119 @@ namespace std
              */
 
             template<class... Args>
-            void emplace_front(Args&&... args)
+            reference emplace_front(Args&&... args)
             {
-                if (front_bucket_idx_ == 0)
-                    add_new_bucket_front_();
+                if (start_ == 0)
+                    add_block_front_();
 
+                --start_;
                 allocator_traits<allocator_type>::construct(
                     allocator_,
-                    &data_[front_bucket_][--front_bucket_idx_],
+                    &(*this)[0],
                     forward<Args>(args)...
                 );
 
                 ++size_;
+
+                return front();
             }
 
             template<class... Args>
-            void emplace_back(Args&&... args)
+            reference emplace_back(Args&&... args)
             {
+                if (start_ + size_ == (map_size_ << block_shift_))
+                    add_block_back_();
+
                 allocator_traits<allocator_type>::construct(
                     allocator_,
-                    &data_[back_bucket_][back_bucket_idx_++],
+                    &(*this)[size_],
                     forward<Args>(args)...
                 );
 
                 ++size_;
 
-                if (back_bucket_idx_ >= bucket_size_)
-                    add_new_bucket_back_();
+                return back();
             }
 
             template<class... Args>
             iterator emplace(const_iterator position, Args&&... args)
             {
                 auto idx = position.idx();
-                shift_right_(idx, 1);
 
-                allocator_traits<allocator_type>::construct(
-                    allocator_,
-                    &data_[get_bucket_index_(idx)][get_element_index_(idx)],
-                    forward<Args>(args)...
-                );
-                ++size_;
+                if (idx == size_)
+                {
+                    emplace_back(forward<Args>(args)...);
+
+                    return iterator{*this, idx};
+                }
+                else if (idx == 0)
+                {
+                    emplace_front(forward<Args>(args)...);
+
+                    return begin();
+                }
+
+                /**
+                 * The new value is created before we shift any
+                 * elements as args may refer to one of them.
+                 * We shift towards the nearer end.
+                 */
+                value_type tmp(forward<Args>(args)...);
+
+                if (idx < size_ - idx)
+                {
+                    emplace_front(move(front()));
+                    for (size_type i = 1; i < idx; ++i)
+                        (*this)[i] = move((*this)[i + 1]);
+                }
+                else
+                {
+                    emplace_back(move(back()));
+                    for (size_type i = size_ - 2; i > idx; --i)
+                        (*this)[i] = move((*this)[i - 1]);
+                }
+
+                (*this)[idx] = move(tmp);
 
                 return iterator{*this, idx};
             }
 
             void push_front(const value_type& value)
             {
-                if (front_bucket_idx_ == 0)
-                    add_new_bucket_front_();
-
-                data_[front_bucket_][--front_bucket_idx_] = value;
-                ++size_;
+                emplace_front(value);
             }
 
             void push_front(value_type&& value)
             {
-                if (front_bucket_idx_ == 0)
-                    add_new_bucket_front_();
-
-                data_[front_bucket_][--front_bucket_idx_] = forward<value_type>(value);
-                ++size_;
+                emplace_front(forward<value_type>(value));
             }
 
             void push_back(const value_type& value)
             {
-                data_[back_bucket_][back_bucket_idx_++] = value;
-                ++size_;
-
-                if (back_bucket_idx_ >= bucket_size_)
-                    add_new_bucket_back_();
+                emplace_back(value);
             }
 
             void push_back(value_type&& value)
             {
-                data_[back_bucket_][back_bucket_idx_++] = forward<value_type>(value);
-                ++size_;
-
-                if (back_bucket_idx_ >= bucket_size_)
-                    add_new_bucket_back_();
+                emplace_back(forward<value_type>(value));
             }
 
             iterator insert(const_iterator position, const value_type& value)
             {
-                auto idx = position.idx();
-                shift_right_(idx, 1);
-
-                /**
-                 * Note: One may notice that when working with the deque
-                 *       iterator, we use its index without any checks.
-                 *       This is because a valid iterator will always have
-                 *       a valid index as functions like pop_back or erase
-                 *       invalidate iterators.
-                 */
-                data_[get_bucket_index_(idx)][get_element_index_(idx)] = value;
-                ++size_;
-
-                return iterator{*this, idx};
+                return emplace(position, value);
             }
 
             iterator insert(const_iterator position, value_type&& value)
             {
-                auto idx = position.idx();
-                shift_right_(idx, 1);
-
-                data_[get_bucket_index_(idx)][get_element_index_(idx)] = forward<value_type>(value);
-                ++size_;
-
-                return iterator{*this, idx};
+                return emplace(position, forward<value_type>(value));
             }
 
             iterator insert(const_iterator position, size_type n, const value_type& value)
             {
                 return insert(
                     position,
-                    aux::insert_iterator<int>{0u, value},
-                    aux::insert_iterator<int>{n}
+                    aux::insert_iterator<value_type>{0u, value},
+                    aux::insert_iterator<value_type>{n}
                 );
             }
 
@@ -796,26 +766,30 @@ namespace std
             iterator insert(const_iterator position, InputIterator first, InputIterator last)
             {
                 auto idx = position.idx();
-                auto count = distance(first, last);
+                auto old_size = size_;
 
-                if (idx < size_ / 2)
+                /**
+                 * The new elements are added at the nearer end
+                 * and then rotated into place by reversals.
+                 */
+                if (idx < size_ - idx)
                 {
-                    shift_left_(idx, count);
-
-                    iterator it{*this, idx - 1};
                     while (first != last)
-                        *it++ = *first++;
+                        emplace_front(*first++);
+
+                    auto count = size_ - old_size;
+                    reverse_(count, count + idx);
+                    reverse_(0, count + idx);
                 }
                 else
                 {
-                    shift_right_(idx, count);
-
-                    iterator it{*this, idx};
                     while (first != last)
-                        *it++ = *first++;
-                }
+                        emplace_back(*first++);
 
-                size_ += count;
+                    reverse_(idx, old_size);
+                    reverse_(old_size, size_);
+                    reverse_(idx, size_);
+                }
 
                 return iterator{*this, idx};
             }
@@ -830,19 +804,13 @@ namespace std
                 if (empty())
                     return;
 
-                if (back_bucket_idx_ == 0)
-                { // Means we gotta pop data_[back_bucket_ - 1][bucket_size_ - 1]!
-                    if (data_[back_bucket_])
-                        allocator_.deallocate(data_[back_bucket_], bucket_size_);
-
-                    --back_bucket_;
-                    back_bucket_idx_ = bucket_size_ - 1;
-                }
-                else
-                    --back_bucket_idx_;
-
-                allocator_.destroy(&data_[back_bucket_][back_bucket_idx_]);
+                allocator_traits<allocator_type>::destroy(
+                    allocator_, &(*this)[size_ - 1]
+                );
                 --size_;
+
+                if (back_spares_() > 1)
+                    recycle_back_block_();
             }
 
             void pop_front()
@@ -850,63 +818,49 @@ namespace std
                 if (empty())
                     return;
 
-                if (front_bucket_idx_ >= bucket_size_)
-                { // Means we gotta pop data_[front_bucket_ + 1][0]!
-                    if (data_[front_bucket_])
-                        allocator_.deallocate(data_[front_bucket_], bucket_size_);
-
-                    ++front_bucket_;
-                    front_bucket_idx_ = 1;
-
-                    allocator_.destroy(&data_[front_bucket_][0]);
-                }
-                else
-                {
-                    allocator_.destroy(&data_[front_bucket_][front_bucket_idx_]);
-
-                    ++front_bucket_idx_;
-                }
-
+                allocator_traits<allocator_type>::destroy(
+                    allocator_, &(*this)[0]
+                );
+                ++start_;
                 --size_;
+
+                if (front_spares_() > 1)
+                    recycle_front_block_();
             }
 
             iterator erase(const_iterator position)
             {
-                auto idx = position.idx();
-                copy(
-                    iterator{*this, idx + 1},
-                    end(),
-                    iterator{*this, idx}
-                );
-
-                /**
-                 * Note: We need to not only decrement size,
-                 *       but also take care of any issues caused
-                 *       by decrement bucket indices, which pop_back
-                 *       does for us.
-                 */
-                pop_back();
-
-                return iterator{*this, idx};
+                return erase(position, position + 1);
             }
 
             iterator erase(const_iterator first, const_iterator last)
             {
-                if (first == last)
-                    return first;
-
                 auto first_idx = first.idx();
                 auto last_idx = last.idx();
-                auto count = distance(first, last);
+                auto count = last_idx - first_idx;
 
-                copy(
-                    iterator{*this, last_idx},
-                    end(),
-                    iterator{*this, first_idx}
-                );
+                if (count == 0)
+                    return iterator{*this, first_idx};
 
-                for (size_type i = 0; i < count; ++i)
-                    pop_back();
+                /**
+                 * Only the shorter side of the deque is moved.
+                 */
+                if (first_idx < size_ - last_idx)
+                {
+                    for (size_type i = first_idx; i > 0; --i)
+                        (*this)[i - 1 + count] = move((*this)[i - 1]);
+
+                    for (size_type i = 0; i < count; ++i)
+                        pop_front();
+                }
+                else
+                {
+                    for (size_type i = last_idx; i < size_; ++i)
+                        (*this)[i - count] = move((*this)[i]);
+
+                    for (size_type i = 0; i < count; ++i)
+                        pop_back();
+                }
 
                 return iterator{*this, first_idx};
             }
@@ -915,236 +869,217 @@ namespace std
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value)
             {
                 std::swap(allocator_, other.allocator_);
-                std::swap(front_bucket_idx_, other.front_bucket_idx_);
-                std::swap(back_bucket_idx_, other.back_bucket_idx_);
-                std::swap(front_bucket_, other.front_bucket_);
-                std::swap(back_bucket_, other.back_bucket_);
-                std::swap(bucket_count_, other.bucket_count_);
-                std::swap(bucket_capacity_, other.bucket_capacity_);
+                std::swap(map_, other.map_);
+                std::swap(map_capacity_, other.map_capacity_);
+                std::swap(map_head_, other.map_head_);
+                std::swap(map_size_, other.map_size_);
+                std::swap(start_, other.start_);
                 std::swap(size_, other.size_);
-                std::swap(data_, other.data_);
             }
 
             void clear() noexcept
             {
-                if (data_)
-                    fini_();
+                destroy_elements_();
 
-                front_bucket_ = default_front_;
-                back_bucket_ = default_back_;
-                bucket_count_ = default_bucket_count_;
-                bucket_capacity_ = default_bucket_capacity_;
-                size_ = size_type{};
-
-                init_();
+                /**
+                 * We keep one block with the first element
+                 * in its middle, so that both push_front and
+                 * push_back can follow without allocating.
+                 */
+                while (map_size_ > 1)
+                    free_block_(take_back_block_());
+                start_ = map_size_ > 0 ? block_size_ / 2 : 0;
             }
 
         private:
             allocator_type allocator_;
 
             /**
-             * Note: In our implementation, front_bucket_idx_
-             *       points at the first element and back_bucket_idx_
-             *       points at the one past last element. Because of this,
-             *       some operations may be done in inverse order
-             *       depending on the side they are applied to.
+             * Note: The block map is a circular buffer of block
+             *       pointers with a power of two capacity. Blocks
+             *       [map_head_, map_head_ + map_size_) (modulo the
+             *       capacity) are allocated, the first element is
+             *       at offset start_ from the beginning of the
+             *       first of them. We keep at most one spare
+             *       block at each end, spare blocks are moved
+             *       from one end to the other instead of being
+             *       freed and allocated again, so queue like use
+             *       does not touch the allocator at all.
              */
-            size_type front_bucket_idx_;
-            size_type back_bucket_idx_;
-            size_type front_bucket_;
-            size_type back_bucket_;
+            value_type** map_;
+            size_type map_capacity_;
+            size_type map_head_;
+            size_type map_size_;
+            size_type start_;
+            size_type size_;
 
-            static constexpr size_type bucket_size_{16};
-            static constexpr size_type default_bucket_count_{2};
-            static constexpr size_type default_bucket_capacity_{4};
-            static constexpr size_type default_front_{1};
-            static constexpr size_type default_back_{2};
+            static constexpr size_type block_shift_{aux::deque_block_shift<T>()};
+            static constexpr size_type block_size_{size_type{1} << block_shift_};
+            static constexpr size_type block_mask_{block_size_ - 1};
+            static constexpr size_type min_map_capacity_{8};
 
-            size_type bucket_count_;
-            size_type bucket_capacity_;
-            size_type size_{};
-
-            value_type** data_;
-
-            void init_()
+            value_type*& block_(size_type idx)
             {
-                data_ = new value_type*[bucket_capacity_];
-
-                for (size_type i = front_bucket_; i <= back_bucket_; ++i)
-                    data_[i] = allocator_.allocate(bucket_size_);
+                return map_[(map_head_ + idx) & (map_capacity_ - 1)];
             }
 
-            void prepare_for_size_(size_type size)
+            value_type* block_(size_type idx) const
             {
-                if (data_)
-                    fini_();
-
-                bucket_count_ = bucket_capacity_ = size / bucket_size_ + 2;
-
-                front_bucket_ = 0;
-                back_bucket_ = bucket_capacity_ - 1;
-
-                front_bucket_idx_ = bucket_size_;
-                back_bucket_idx_ = size % bucket_size_;
+                return map_[(map_head_ + idx) & (map_capacity_ - 1)];
             }
 
-            template<class Iterator>
-            void copy_from_range_(Iterator first, Iterator last)
+            size_type front_spares_() const
             {
-                size_ = distance(first, last);
-                prepare_for_size_(size_);
-                init_();
-
-                auto it = begin();
-                while (first != last)
-                    *it++ = *first++;
+                return start_ >> block_shift_;
             }
 
-            void ensure_space_front_(size_type idx, size_type count)
+            size_type back_spares_() const
             {
-                auto free_space = bucket_size_ - elements_in_front_bucket_();
-                if (front_bucket_idx_ == 0)
-                    free_space = 0;
-
-                if (count <= free_space)
-                {
-                    front_bucket_idx_ -= count;
-                    return;
-                }
-
-                count -= free_space;
-
-                auto buckets_needed = count / bucket_size_;
-                if (count % bucket_size_ != 0)
-                    ++buckets_needed;
-
-                for (size_type i = size_type{}; i < buckets_needed; ++i)
-                    add_new_bucket_front_();
-
-                front_bucket_idx_ = bucket_size_ - (count % bucket_size_);
+                return map_size_ - ((start_ + size_ + block_mask_) >> block_shift_);
             }
 
-            void ensure_space_back_(size_type idx, size_type count)
+            value_type* allocate_block_()
             {
-                auto free_space = bucket_size_ - back_bucket_idx_;
-                if (count < free_space)
-                    return;
+                return allocator_traits<allocator_type>::allocate(
+                    allocator_, block_size_
+                );
+            }
 
-                count -= free_space;
-                auto buckets_needed = count / bucket_size_;
-                if (count % bucket_size_ != 0)
-                    ++buckets_needed;
+            void free_block_(value_type* block)
+            {
+                allocator_traits<allocator_type>::deallocate(
+                    allocator_, block, block_size_
+                );
+            }
 
-                for (size_type i = size_type{}; i < buckets_needed; ++i)
-                    add_new_bucket_back_();
+            value_type* take_front_block_()
+            {
+                auto block = block_(0);
+                map_head_ = (map_head_ + 1) & (map_capacity_ - 1);
+                --map_size_;
+                start_ -= block_size_;
 
-                back_bucket_idx_ = (back_bucket_idx_ + count) % bucket_size_;
+                return block;
             }
 
-            void shift_right_(size_type idx, size_type count)
+            value_type* take_back_block_()
             {
-                ensure_space_back_(idx, count);
-
-                iterator it{*this, idx};
-                copy_backward(it, end(), end() + count - 1);
+                --map_size_;
 
+                return block_(map_size_);
             }
 
-            void shift_left_(size_type idx, size_type count)
+            void put_front_block_(value_type* block)
             {
-                ensure_space_front_(idx, count);
+                if (map_size_ == map_capacity_)
+                    grow_map_();
 
-                copy(
-                    iterator{*this, count},
-                    iterator{*this, idx + count - 1},
-                    iterator{*this, 0}
-                );
+                map_head_ = (map_head_ - 1) & (map_capacity_ - 1);
+                block_(0) = block;
+                ++map_size_;
+                start_ += block_size_;
             }
 
-            void fini_()
+            void put_back_block_(value_type* block)
             {
-                for (size_type i = front_bucket_; i <= back_bucket_; ++i)
-                    allocator_.deallocate(data_[i], bucket_size_);
+                if (map_size_ == map_capacity_)
+                    grow_map_();
 
-                delete[] data_;
-                data_ = nullptr;
+                block_(map_size_) = block;
+                ++map_size_;
             }
 
-            bool has_bucket_space_back_() const
+            void add_block_front_()
             {
-                return back_bucket_ < bucket_capacity_ - 1;
+                if (back_spares_() > 0)
+                    put_front_block_(take_back_block_());
+                else
+                    put_front_block_(allocate_block_());
             }
 
-            bool has_bucket_space_front_() const
+            void add_block_back_()
             {
-                return front_bucket_ > 0;
+                if (front_spares_() > 0)
+                    put_back_block_(take_front_block_());
+                else
+                    put_back_block_(allocate_block_());
             }
 
-            void add_new_bucket_back_()
+            void recycle_front_block_()
             {
-                if (!has_bucket_space_back_())
-                    expand_();
+                auto block = take_front_block_();
 
-                ++back_bucket_;
-                ++bucket_count_;
-                data_[back_bucket_] = allocator_.allocate(bucket_size_);
-                back_bucket_idx_ = size_type{};
+                if (back_spares_() == 0)
+                    put_back_block_(block);
+                else
+                    free_block_(block);
             }
 
-            void add_new_bucket_front_()
+            void recycle_back_block_()
             {
-                if (!has_bucket_space_front_())
-                    expand_();
+                auto block = take_back_block_();
 
-                --front_bucket_;
-                ++bucket_count_;
-                data_[front_bucket_] = allocator_.allocate(bucket_size_);
-                front_bucket_idx_ = bucket_size_;
+                if (front_spares_() == 0)
+                    put_front_block_(block);
+                else
+                    free_block_(block);
             }
 
-            void expand_()
+            void grow_map_()
             {
-                bucket_capacity_ *= 2;
-                value_type** new_data = new value_type*[bucket_capacity_];
-
-                /**
-                 * Note: This currently expands both sides whenever one reaches
-                 *       its limit. Might be better to expand only one (or both when
-                 *       the other is near its limit)?
-                 */
-                size_type new_front = bucket_capacity_ / 4;
-                size_type new_back = new_front + bucket_count_ - 1;
+                auto new_capacity = map_capacity_ ? map_capacity_ * 2 : min_map_capacity_;
+                auto new_map = new value_type*[new_capacity];
 
-                for (size_type i = new_front, j = front_bucket_; i <= new_back; ++i, ++j)
-                    new_data[i] = move(data_[j]);
-                std::swap(data_, new_data);
+                for (size_type i = 0; i < map_size_; ++i)
+                    new_map[i] = block_(i);
 
-                delete[] new_data;
-                front_bucket_ = new_front;
-                back_bucket_ = new_back;
+                delete[] map_;
+                map_ = new_map;
+                map_capacity_ = new_capacity;
+                map_head_ = 0;
             }
 
-            size_type get_bucket_index_(size_type idx) const
+            void reverse_(size_type first, size_type last)
             {
-                if (idx < elements_in_front_bucket_())
-                    return front_bucket_;
+                while (first + 1 < last)
+                    std::swap((*this)[first++], (*this)[--last]);
+            }
 
-                idx -= elements_in_front_bucket_();
-                return idx / bucket_size_ + front_bucket_ + 1;
+            void destroy_elements_()
+            {
+                for (size_type i = 0; i < size_; ++i)
+                    allocator_traits<allocator_type>::destroy(allocator_, &(*this)[i]);
+                size_ = size_type{};
             }
 
-            size_type get_element_index_(size_type idx) const
+            template<class Iterator>
+            void copy_from_range_(Iterator first, Iterator last)
             {
-                if (idx < elements_in_front_bucket_())
-                    return bucket_size_ - elements_in_front_bucket_() + idx;
+                clear();
 
-                idx -= elements_in_front_bucket_();
-                return idx % bucket_size_;
+                while (first != last)
+                    emplace_back(*first++);
             }
 
-            size_type elements_in_front_bucket_() const
+            void reset_()
             {
-                return bucket_size_ - front_bucket_idx_;
+                map_ = nullptr;
+                map_capacity_ = size_type{};
+                map_head_ = size_type{};
+                map_size_ = size_type{};
+                start_ = size_type{};
+                size_ = size_type{};
+            }
+
+            void fini_()
+            {
+                destroy_elements_();
+
+                while (map_size_ > 0)
+                    free_block_(take_back_block_());
+
+                delete[] map_;
+                reset_();
             }
     };
 
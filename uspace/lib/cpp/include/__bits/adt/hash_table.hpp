@@ -33,6 +33,7 @@
 #include <__bits/adt/key_extractors.hpp>
 #include <__bits/adt/hash_table_iterators.hpp>
 #include <__bits/adt/hash_table_policies.hpp>
+#include <__bits/adt/node_cache.hpp>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
@@ -89,20 +90,24 @@ namespace std::aux
             hash_table(size_type buckets, float max_load_factor = 1.f)
                 : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
                   bucket_count_{buckets}, size_{}, hasher_{}, key_eq_{},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
+                  key_extractor_{}, max_load_factor_{max_load_factor},
+                  node_cache_{}
             { /* DUMMY BODY */ }
 
             hash_table(size_type buckets, const hasher& hf, const key_equal& eql,
                        float max_load_factor = 1.f)
                 : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
                   bucket_count_{buckets}, size_{}, hasher_{hf}, key_eq_{eql},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
+                  key_extractor_{}, max_load_factor_{max_load_factor},
+                  node_cache_{}
             { /* DUMMY BODY */ }
 
             hash_table(const hash_table& other)
                 : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
                              other.max_load_factor_}
             {
+                node_cache_.limit(other.node_cache_.limit());
+
                 for (const auto& x: other)
                     insert(x);
             }
@@ -111,7 +116,8 @@ namespace std::aux
                 : table_{other.table_}, bucket_count_{other.bucket_count_},
                   size_{other.size_}, hasher_{move(other.hasher_)},
                   key_eq_{move(other.key_eq_)}, key_extractor_{move(other.key_extractor_)},
-                  max_load_factor_{other.max_load_factor_}
+                  max_load_factor_{other.max_load_factor_},
+                  node_cache_{move(other.node_cache_)}
             {
                 other.table_ = nullptr;
                 other.bucket_count_ = size_type{};
@@ -214,16 +220,34 @@ namespace std::aux
                 if (it == cend())
                     return end();
 
-                auto node = it.node();
-                auto idx = it.idx();
-
                 /**
                  * Note: This way we will continue on the next bucket
                  *       if this is the last element in its bucket.
                  */
-                iterator res{table_, idx, size_, node};
+                iterator res{table_, it.idx(), bucket_count_, it.node()};
                 ++res;
 
+                free_node(extract_node(it));
+
+                if (empty())
+                    return end();
+                else
+                    return res;
+            }
+
+            /**
+             * Unlinks the node from its bucket without destroying
+             * it, other nodes (and iterators to them) are not
+             * affected.
+             */
+            node_type* extract_node(const_iterator it)
+            {
+                if (it == cend())
+                    return nullptr;
+
+                auto node = it.node();
+                auto idx = it.idx();
+
                 if (table_[idx].head == node)
                 {
                     if (node->next != node)
@@ -234,12 +258,39 @@ namespace std::aux
                 --size_;
 
                 node->unlink();
-                delete node;
 
-                if (empty())
-                    return end();
-                else
-                    return res;
+                return node;
+            }
+
+            auto insert_node(node_type* node)
+            {
+                return Policy::insert_node(*this, node);
+            }
+
+            template<class... Args>
+            node_type* make_node(Args&&... args)
+            {
+                return node_cache_.make(forward<Args>(args)...);
+            }
+
+            void free_node(node_type* node)
+            {
+                node_cache_.recycle(node);
+            }
+
+            size_type node_cache_limit() const noexcept
+            {
+                return node_cache_.limit();
+            }
+
+            void node_cache_limit(size_type limit)
+            {
+                node_cache_.limit(limit);
+            }
+
+            size_type node_cache_size() const noexcept
+            {
+                return node_cache_.size();
             }
 
             void clear() noexcept
@@ -251,8 +302,8 @@ namespace std::aux
 
             void swap(hash_table& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(swap(declval<Hasher&>(), declval<Hasher&>())) &&
-                         noexcept(swap(declval<KeyEq&>(), declval<KeyEq&>())))
+                         noexcept(std::swap(declval<Hasher&>(), declval<Hasher&>())) &&
+                         noexcept(std::swap(declval<KeyEq&>(), declval<KeyEq&>())))
             {
                 std::swap(table_, other.table_);
                 std::swap(bucket_count_, other.bucket_count_);
@@ -260,6 +311,7 @@ namespace std::aux
                 std::swap(hasher_, other.hasher_);
                 std::swap(key_eq_, other.key_eq_);
                 std::swap(max_load_factor_, other.max_load_factor_);
+                node_cache_.swap(other.node_cache_);
             }
 
             hasher hash_function() const
@@ -284,7 +336,7 @@ namespace std::aux
                 do
                 {
                     if (key_eq_(key, key_extractor_(current->value)))
-                        return iterator{table_, idx, size_, current};
+                        return iterator{table_, idx, bucket_count_, current};
                     current = current->next;
                 }
                 while (current && current != head);
@@ -304,7 +356,7 @@ namespace std::aux
                 do
                 {
                     if (key_eq_(key, key_extractor_(current->value)))
-                        return iterator{table_, idx, size_, current};
+                        return iterator{table_, idx, bucket_count_, current};
                     current = current->next;
                 }
                 while (current != head);
@@ -449,6 +501,7 @@ namespace std::aux
 
                 new_table.size_ = size_;
                 swap(new_table);
+                node_cache_.swap(new_table.node_cache_); // Keep our cache.
 
                 delete[] new_table.table_;
                 new_table.table_ = nullptr;
@@ -565,6 +618,7 @@ namespace std::aux
             key_equal key_eq_;
             key_extract key_extractor_;
             float max_load_factor_;
+            node_cache<node_type> node_cache_;
 
             static constexpr float bucket_count_growth_factor_{1.25};
 
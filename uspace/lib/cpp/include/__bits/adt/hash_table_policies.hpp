@@ -98,7 +98,7 @@ namespace std::aux
                     }
 
                     current->unlink();
-                    delete current;
+                    table.free_node(current);
 
                     return 1;
                 }
@@ -143,7 +143,6 @@ namespace std::aux
         > emplace(Table& table, Args&&... args)
         {
             using value_type = typename Table::value_type;
-            using node_type  = typename Table::node_type;
             using iterator   = typename Table::iterator;
 
             table.increment_size();
@@ -169,7 +168,7 @@ namespace std::aux
             }
             else
             {
-                auto node = new node_type{move(val)};
+                auto node = table.make_node(move(val));
                 bucket->prepend(node);
 
                 return make_pair(iterator{
@@ -185,7 +184,6 @@ namespace std::aux
             typename Table::iterator, bool
         > insert(Table& table, const Value& val)
         {
-            using node_type  = typename Table::node_type;
             using iterator   = typename Table::iterator;
 
             table.increment_size();
@@ -210,7 +208,7 @@ namespace std::aux
             }
             else
             {
-                auto node = new node_type{val};
+                auto node = table.make_node(val);
                 bucket->prepend(node);
 
                 return make_pair(iterator{
@@ -227,7 +225,6 @@ namespace std::aux
         > insert(Table& table, Value&& val)
         {
             using value_type = typename Table::value_type;
-            using node_type  = typename Table::node_type;
             using iterator   = typename Table::iterator;
 
             table.increment_size();
@@ -252,7 +249,46 @@ namespace std::aux
             }
             else
             {
-                auto node = new node_type{forward<value_type>(val)};
+                auto node = table.make_node(forward<value_type>(val));
+                bucket->prepend(node);
+
+                return make_pair(iterator{
+                    table.table(), idx,
+                    table.bucket_count(),
+                    node
+                }, true);
+            }
+        }
+
+        template<class Table>
+        static pair<
+            typename Table::iterator, bool
+        > insert_node(Table& table, typename Table::node_type* node)
+        {
+            using iterator   = typename Table::iterator;
+
+            table.increment_size();
+
+            const auto& key = table.get_key(node->value);
+            auto [bucket, target, idx] = table.find_insertion_spot(key);
+
+            if (!bucket)
+                return make_pair(table.end(), false);
+
+            if (target && table.keys_equal(key, target->value))
+            {
+                table.decrement_size();
+
+                return make_pair(
+                    iterator{
+                        table.table(), idx, table.bucket_count(),
+                        target
+                    },
+                    false
+                );
+            }
+            else
+            {
                 bucket->prepend(node);
 
                 return make_pair(iterator{
@@ -357,7 +393,7 @@ namespace std::aux
                     --table.size_;
                     ++res;
 
-                    delete tmp;
+                    table.free_node(tmp);
                 }
             }
             while (current && current != head);
@@ -406,36 +442,31 @@ namespace std::aux
         template<class Table, class... Args>
         static typename Table::iterator emplace(Table& table, Args&&... args)
         {
-            using node_type  = typename Table::node_type;
+            auto node = table.make_node(forward<Args>(args)...);
 
-            auto node = new node_type{forward<Args>(args)...};
-
-            return insert(table, node);
+            return insert_node(table, node);
         }
 
         template<class Table, class Value>
         static typename Table::iterator insert(Table& table, const Value& val)
         {
-            using node_type  = typename Table::node_type;
-
-            auto node = new node_type{val};
+            auto node = table.make_node(val);
 
-            return insert(table, node);
+            return insert_node(table, node);
         }
 
         template<class Table, class Value>
         static typename Table::iterator insert(Table& table, Value&& val)
         {
             using value_type = typename Table::value_type;
-            using node_type  = typename Table::node_type;
 
-            auto node = new node_type{forward<value_type>(val)};
+            auto node = table.make_node(forward<value_type>(val));
 
-            return insert(table, node);
+            return insert_node(table, node);
         }
 
         template<class Table>
-        static typename Table::iterator insert(Table& table, typename Table::node_type* node)
+        static typename Table::iterator insert_node(Table& table, typename Table::node_type* node)
         {
             using iterator   = typename Table::iterator;
 
@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_ADT_MAP
 #define LIBCPP_BITS_ADT_MAP
 
+#include <__bits/adt/node_handle.hpp>
 #include <__bits/adt/rbtree.hpp>
 #include <functional>
 #include <iterator>
@@ -38,6 +39,9 @@
 
 namespace std
 {
+    template<class Key, class Value, class Compare, class Alloc>
+    class multimap;
+
     /**
      * 23.4.4, class template map:
      */
@@ -62,18 +66,24 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_single_node<value_type>;
+            using tree_node_type = aux::rbtree_single_node<value_type>;
+
+            using node_type = aux::map_node_handle<
+                tree_node_type, key_type, mapped_type, allocator_type
+            >;
 
             using iterator             = aux::rbtree_iterator<
-                value_type, reference, pointer, size_type, node_type
+                value_type, reference, pointer, size_type, tree_node_type
             >;
             using const_iterator       = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using insert_return_type = aux::node_insert_return<iterator, node_type>;
+
             class value_compare
             {
                 friend class map;
@@ -277,7 +287,7 @@ namespace std
                 if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
                     return parent->value.second;
 
-                auto node = new node_type{value_type{key, mapped_type{}}};
+                auto node = tree_.make_node(value_type{key, mapped_type{}});
                 tree_.insert_node(node, parent);
 
                 return node->value.second;
@@ -289,7 +299,7 @@ namespace std
                 if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
                     return parent->value.second;
 
-                auto node = new node_type{value_type{move(key), mapped_type{}}};
+                auto node = tree_.make_node(value_type{move(key), mapped_type{}});
                 tree_.insert_node(node, parent);
 
                 return node->value.second;
@@ -378,6 +388,48 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            insert_return_type insert(node_type&& nh)
+            {
+                if (!nh)
+                    return insert_return_type{end(), false, node_type{}};
+
+                auto node = aux::node_handle_access::node(nh);
+                const auto& key = node->value.first;
+
+                auto parent = tree_.find_parent_for_insertion(key);
+                if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
+                    return insert_return_type{iterator{parent, false}, false, move(nh)};
+
+                aux::node_handle_access::release(nh);
+                tree_.insert_node(node, parent);
+
+                return insert_return_type{iterator{node, false}, true, node_type{}};
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh)).position;
+            }
+
+            node_type extract(const_iterator position)
+            {
+                if (position == cend())
+                    return node_type{};
+
+                return aux::node_handle_access::make<node_type>(
+                    tree_.extract_node(position.node()), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             template<class... Args>
             pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
             {
@@ -386,7 +438,7 @@ namespace std
                     return make_pair(iterator{parent, false}, false);
                 else
                 {
-                    auto node = new node_type{value_type{key, forward<Args>(args)...}};
+                    auto node = tree_.make_node(value_type{key, forward<Args>(args)...});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -401,7 +453,7 @@ namespace std
                     return make_pair(iterator{parent, false}, false);
                 else
                 {
-                    auto node = new node_type{value_type{move(key), forward<Args>(args)...}};
+                    auto node = tree_.make_node(value_type{move(key), forward<Args>(args)...});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -432,7 +484,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{value_type{key, forward<T>(val)}};
+                    auto node = tree_.make_node(value_type{key, forward<T>(val)});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -451,7 +503,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{value_type{move(key), forward<T>(val)}};
+                    auto node = tree_.make_node(value_type{move(key), forward<T>(val)});
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -503,6 +555,50 @@ namespace std
                 tree_.clear();
             }
 
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                tree_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return tree_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return tree_.node_cache_size();
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -644,12 +740,42 @@ namespace std
                 value_type, key_type, aux::key_value_key_extractor<key_type, mapped_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_single_policy, node_type
+                aux::rbtree_single_policy, tree_node_type
             >;
 
             tree_type tree_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                /**
+                 * Note: Extraction does not invalidate iterators
+                 *       to other elements, but the end iterator
+                 *       may change, so we count the elements
+                 *       instead of comparing with end().
+                 */
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                {
+                    auto current = it++;
+                    if (find(current->first) == end())
+                        merge_insert_(source.extract(current));
+                }
+            }
+
+            void merge_insert_(node_type&& nh)
+            {
+                insert(move(nh));
+            }
+
+            template<class NodeHandle>
+            void merge_insert_(NodeHandle&& nh)
+            {
+                // Different node type, so only the value can be moved.
+                emplace(move(nh.key()), move(nh.mapped()));
+            }
+
             template<class K, class C, class A>
             friend bool operator==(const map<K, C, A>&,
                                    const map<K, C, A>&);
@@ -725,7 +851,11 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_multi_node<value_type>;
+            using tree_node_type = aux::rbtree_multi_node<value_type>;
+
+            using node_type = aux::map_node_handle<
+                tree_node_type, key_type, mapped_type, allocator_type
+            >;
 
             class value_compare
             {
@@ -750,10 +880,10 @@ namespace std
             };
 
             using iterator             = aux::rbtree_iterator<
-                value_type, reference, pointer, size_type, node_type
+                value_type, reference, pointer, size_type, tree_node_type
             >;
             using const_iterator       = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
@@ -989,6 +1119,40 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            iterator insert(node_type&& nh)
+            {
+                if (!nh)
+                    return end();
+
+                auto node = aux::node_handle_access::release(nh);
+
+                return tree_.insert_node(node, nullptr);
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh));
+            }
+
+            node_type extract(const_iterator position)
+            {
+                if (position == cend())
+                    return node_type{};
+
+                return aux::node_handle_access::make<node_type>(
+                    tree_.extract_node(position.node()), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             iterator erase(const_iterator position)
             {
                 return tree_.erase(position);
@@ -1022,6 +1186,50 @@ namespace std
                 tree_.clear();
             }
 
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(multimap<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(map<key_type, mapped_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                tree_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return tree_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return tree_.node_cache_size();
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -1163,12 +1371,34 @@ namespace std
                 value_type, key_type, aux::key_value_key_extractor<key_type, mapped_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_multi_policy, node_type
+                aux::rbtree_multi_policy, tree_node_type
             >;
 
             tree_type tree_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                if (static_cast<void*>(&source) == static_cast<void*>(this))
+                    return;
+
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                    merge_insert_(source.extract(it++));
+            }
+
+            void merge_insert_(node_type&& nh)
+            {
+                insert(move(nh));
+            }
+
+            template<class NodeHandle>
+            void merge_insert_(NodeHandle&& nh)
+            {
+                emplace(move(nh.key()), move(nh.mapped()));
+            }
+
             template<class K, class C, class A>
             friend bool operator==(const multimap<K, C, A>&,
                                    const multimap<K, C, A>&);
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_NODE_CACHE
+#define LIBCPP_BITS_ADT_NODE_CACHE
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Per container cache of node sized memory blocks.
+     * Workloads that keep erasing and inserting elements
+     * (LRU caches, schedulers, ...) would otherwise pay for
+     * one delete and one new per operation, with the cache
+     * the memory of a destroyed node is kept on an intrusive
+     * free list and reused by the next insertion.
+     * The cache is disabled (limit of zero) by default, in
+     * which case nodes are deleted right away as before.
+     */
+    template<class Node>
+    class node_cache
+    {
+        public:
+            node_cache() noexcept
+                : free_{}, size_{}, limit_{}
+            { /* DUMMY BODY */ }
+
+            node_cache(const node_cache& other) noexcept
+                : free_{}, size_{}, limit_{other.limit_}
+            { /* DUMMY BODY */ }
+
+            node_cache(node_cache&& other) noexcept
+                : free_{other.free_}, size_{other.size_}, limit_{other.limit_}
+            {
+                other.free_ = nullptr;
+                other.size_ = 0U;
+            }
+
+            node_cache& operator=(const node_cache& other) noexcept
+            {
+                limit(other.limit_);
+
+                return *this;
+            }
+
+            node_cache& operator=(node_cache&& other) noexcept
+            {
+                swap(other);
+
+                return *this;
+            }
+
+            template<class... Args>
+            Node* make(Args&&... args)
+            {
+                if (free_)
+                {
+                    auto mem = free_;
+                    free_ = free_->next;
+                    --size_;
+
+                    return new(mem) Node{forward<Args>(args)...};
+                }
+                else
+                    return new Node{forward<Args>(args)...};
+            }
+
+            void recycle(Node* node)
+            {
+                if (!node)
+                    return;
+
+                if (size_ < limit_)
+                {
+                    node->~Node();
+
+                    auto entry = new(node) free_entry{free_};
+                    free_ = entry;
+                    ++size_;
+                }
+                else
+                    delete node;
+            }
+
+            size_t limit() const noexcept
+            {
+                return limit_;
+            }
+
+            void limit(size_t limit)
+            {
+                limit_ = limit;
+
+                while (size_ > limit_)
+                {
+                    auto tmp = free_;
+                    free_ = free_->next;
+                    --size_;
+
+                    ::operator delete(tmp);
+                }
+            }
+
+            size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            void swap(node_cache& other) noexcept
+            {
+                std::swap(free_, other.free_);
+                std::swap(size_, other.size_);
+                std::swap(limit_, other.limit_);
+            }
+
+            ~node_cache()
+            {
+                limit(0U);
+            }
+
+        private:
+            struct free_entry
+            {
+                free_entry* next;
+            };
+
+            static_assert(sizeof(Node) >= sizeof(free_entry));
+
+            free_entry* free_;
+            size_t size_;
+            size_t limit_;
+    };
+}
+
+#endif
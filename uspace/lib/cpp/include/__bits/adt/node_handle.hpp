@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_NODE_HANDLE
+#define LIBCPP_BITS_ADT_NODE_HANDLE
+
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * 26.2.4, node handles:
+     * A node handle owns a single node that has been
+     * extracted from a node based associative or unordered
+     * container. The node can be reinserted into a compatible
+     * container without copying or moving the value and
+     * without touching the allocator.
+     */
+
+    struct node_handle_access;
+
+    template<class Node, class Alloc>
+    class node_handle_base
+    {
+        public:
+            using allocator_type = Alloc;
+
+            constexpr node_handle_base() noexcept
+                : node_{}, alloc_{}
+            { /* DUMMY BODY */ }
+
+            node_handle_base(node_handle_base&& other) noexcept
+                : node_{other.node_}, alloc_{move(other.alloc_)}
+            {
+                other.node_ = nullptr;
+            }
+
+            node_handle_base& operator=(node_handle_base&& other)
+            {
+                if (this != &other)
+                {
+                    reset_();
+
+                    node_ = other.node_;
+                    alloc_ = move(other.alloc_);
+                    other.node_ = nullptr;
+                }
+
+                return *this;
+            }
+
+            allocator_type get_allocator() const
+            {
+                return alloc_;
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return node_ != nullptr;
+            }
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return node_ == nullptr;
+            }
+
+            void swap(node_handle_base& other) noexcept
+            {
+                std::swap(node_, other.node_);
+                std::swap(alloc_, other.alloc_);
+            }
+
+            ~node_handle_base()
+            {
+                reset_();
+            }
+
+        protected:
+            Node* node_;
+            allocator_type alloc_;
+
+            node_handle_base(Node* node, const allocator_type& alloc)
+                : node_{node}, alloc_{alloc}
+            { /* DUMMY BODY */ }
+
+            void reset_()
+            {
+                if (node_)
+                    delete node_;
+                node_ = nullptr;
+            }
+
+            friend struct node_handle_access;
+    };
+
+    template<class Node, class Key, class Mapped, class Alloc>
+    class map_node_handle: public node_handle_base<Node, Alloc>
+    {
+        using base = node_handle_base<Node, Alloc>;
+
+        public:
+            using key_type    = Key;
+            using mapped_type = Mapped;
+
+            constexpr map_node_handle() noexcept = default;
+            map_node_handle(map_node_handle&&) noexcept = default;
+            map_node_handle& operator=(map_node_handle&&) = default;
+
+            key_type& key() const
+            {
+                /**
+                 * Note: The handle owns the node, so the key
+                 *       is no longer part of any container and
+                 *       can be modified before reinsertion.
+                 */
+                return const_cast<key_type&>(base::node_->value.first);
+            }
+
+            mapped_type& mapped() const
+            {
+                return base::node_->value.second;
+            }
+
+            void swap(map_node_handle& other) noexcept
+            {
+                base::swap(other);
+            }
+
+        private:
+            map_node_handle(Node* node, const Alloc& alloc)
+                : base{node, alloc}
+            { /* DUMMY BODY */ }
+
+            friend struct node_handle_access;
+    };
+
+    template<class Node, class Value, class Alloc>
+    class set_node_handle: public node_handle_base<Node, Alloc>
+    {
+        using base = node_handle_base<Node, Alloc>;
+
+        public:
+            using value_type = Value;
+
+            constexpr set_node_handle() noexcept = default;
+            set_node_handle(set_node_handle&&) noexcept = default;
+            set_node_handle& operator=(set_node_handle&&) = default;
+
+            value_type& value() const
+            {
+                return base::node_->value;
+            }
+
+            void swap(set_node_handle& other) noexcept
+            {
+                base::swap(other);
+            }
+
+        private:
+            set_node_handle(Node* node, const Alloc& alloc)
+                : base{node, alloc}
+            { /* DUMMY BODY */ }
+
+            friend struct node_handle_access;
+    };
+
+    template<class Node, class K, class M, class A>
+    void swap(map_node_handle<Node, K, M, A>& lhs,
+              map_node_handle<Node, K, M, A>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class Node, class V, class A>
+    void swap(set_node_handle<Node, V, A>& lhs,
+              set_node_handle<Node, V, A>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /**
+     * Containers use this to wrap extracted nodes
+     * and to take them back on insertion, the node
+     * pointer itself is not accessible to users.
+     */
+    struct node_handle_access
+    {
+        template<class Handle, class Node, class Alloc>
+        static Handle make(Node* node, const Alloc& alloc)
+        {
+            if (node)
+                return Handle{node, alloc};
+            else
+                return Handle{};
+        }
+
+        template<class Handle>
+        static auto node(Handle& handle)
+        {
+            return handle.node_;
+        }
+
+        template<class Handle>
+        static auto release(Handle& handle)
+        {
+            auto res = handle.node_;
+            handle.node_ = nullptr;
+
+            return res;
+        }
+    };
+
+    template<class Iterator, class NodeHandle>
+    struct node_insert_return
+    {
+        Iterator position;
+        bool inserted;
+        NodeHandle node;
+    };
+}
+
+#endif
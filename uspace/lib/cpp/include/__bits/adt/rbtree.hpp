@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_RBTREE
 
 #include <__bits/adt/key_extractors.hpp>
+#include <__bits/adt/node_cache.hpp>
 #include <__bits/adt/rbtree_iterators.hpp>
 #include <__bits/adt/rbtree_node.hpp>
 #include <__bits/adt/rbtree_policies.hpp>
@@ -61,13 +62,15 @@ namespace std::aux
             using node_type = Node;
 
             rbtree(const key_compare& kcmp = key_compare{})
-                : root_{nullptr}, size_{}, key_compare_{},
-                  key_extractor_{}
+                : root_{nullptr}, size_{}, key_compare_{kcmp},
+                  key_extractor_{}, node_cache_{}
             { /* DUMMY BODY */ }
 
             rbtree(const rbtree& other)
                 : rbtree{other.key_compare_}
             {
+                node_cache_.limit(other.node_cache_.limit());
+
                 for (const auto& x: other)
                     insert(x);
             }
@@ -75,7 +78,8 @@ namespace std::aux
             rbtree(rbtree&& other)
                 : root_{other.root_}, size_{other.size_},
                   key_compare_{move(other.key_compare_)},
-                  key_extractor_{move(other.key_extractor_)}
+                  key_extractor_{move(other.key_extractor_)},
+                  node_cache_{move(other.node_cache_)}
             {
                 other.root_ = nullptr;
                 other.size_ = size_type{};
@@ -97,6 +101,11 @@ namespace std::aux
                 return *this;
             }
 
+            ~rbtree()
+            {
+                clear();
+            }
+
             bool empty() const noexcept
             {
                 return size_ == 0U;
@@ -114,6 +123,9 @@ namespace std::aux
 
             iterator begin()
             {
+                if (!root_)
+                    return end();
+
                 return iterator{find_smallest_(), false};
             }
 
@@ -163,6 +175,9 @@ namespace std::aux
 
             const_iterator cbegin() const
             {
+                if (!root_)
+                    return cend();
+
                 return const_iterator{find_smallest_(), false};
             }
 
@@ -222,22 +237,43 @@ namespace std::aux
 
             void clear() noexcept
             {
-                if (root_)
+                /**
+                 * The tree is not guaranteed to be balanced,
+                 * so instead of the recursive node destructor
+                 * we flatten it by rotating left children up
+                 * and delete the nodes one by one.
+                 */
+                auto node = root_;
+                while (node)
                 {
-                    delete root_;
-                    root_ = nullptr;
-                    size_ = size_type{};
+                    if (auto left = node->left(); left)
+                    {
+                        node->left(left->right());
+                        left->right(node);
+                        node = left;
+                    }
+                    else
+                    {
+                        auto right = node->right();
+                        node->right(nullptr);
+                        delete node;
+                        node = right;
+                    }
                 }
+
+                root_ = nullptr;
+                size_ = size_type{};
             }
 
             void swap(rbtree& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
-                         noexcept(swap(declval<KeyComp&>(), declval<KeyComp&>())))
+                         noexcept(std::swap(declval<KeyComp&>(), declval<KeyComp&>())))
             {
                 std::swap(root_, other.root_);
                 std::swap(size_, other.size_);
                 std::swap(key_compare_, other.key_compare_);
                 std::swap(key_extractor_, other.key_extractor_);
+                node_cache_.swap(other.node_cache_);
             }
 
             key_compare key_comp() const
@@ -348,6 +384,22 @@ namespace std::aux
             }
 
             node_type* delete_node(const node_type* n)
+            {
+                if (!n)
+                    return nullptr;
+
+                auto succ = const_cast<node_type*>(n)->successor();
+                free_node(extract_node(n));
+
+                return succ;
+            }
+
+            /**
+             * Unlinks the node from the tree without destroying
+             * it, the returned node has no parent, children or
+             * equivalent siblings and can be inserted again.
+             */
+            node_type* extract_node(const node_type* n)
             {
                 auto node = const_cast<node_type*>(n);
                 if (!node)
@@ -361,69 +413,72 @@ namespace std::aux
                     /**
                      * This will kick in multi containers,
                      * we popped one node from a list of nodes
-                     * with equivalent keys and we can delete it
-                     * and return the successor which was the next
-                     * in the list.
+                     * with equivalent keys. If it was the head,
+                     * its successor is the new head.
                      */
-                    delete tmp;
-
-                    update_root_(succ); // Incase the first in list was root.
-                    return succ;
-                }
-                else if (node == root_)
-                { // Only executed if root_ is unique.
-                    root_ = nullptr;
-                    delete node;
-
-                    return nullptr;
-                }
-
-                if (node->left() && node->right())
-                {
-                    node->swap(succ);
-                    if (succ && !succ->parent())
+                    if (root_ == tmp)
                         root_ = succ;
 
-                    // Node now has at most one child.
-                    // Also: If succ was nullptr, the swap
-                    //       didn't do anything and we can
-                    //       safely delete node.
-                    return delete_node(node);
+                    tmp->isolate();
+                    return tmp;
                 }
 
-                auto child = node->right() ? node->right() : node->left();
-                if (!child)
+                if (node->left() && node->right())
                 {
-                    // Simply remove the node.
-                    // TODO: repair here too?
-                    node->unlink();
-                    delete node;
+                    /**
+                     * Replace the node with its successor, which
+                     * is the smallest node in the right subtree
+                     * and thus has no left child.
+                     */
+                    auto repl = node->right()->find_smallest();
+                    if (repl != node->right())
+                    {
+                        replace_child_(repl, repl->right());
+                        repl->right(node->right());
+                        repl->right()->parent(repl);
+                    }
+
+                    repl->left(node->left());
+                    repl->left()->parent(repl);
+                    replace_child_(node, repl);
                 }
                 else
-                {
-                    // Replace with the child.
-                    child->parent(node->parent());
-                    if (node->is_left_child())
-                        child->parent()->left(child);
-                    else if (node->is_right_child())
-                        child->parent()->right(child);
-                    node->parent(nullptr);
-                    node->left(nullptr);
-                    node->right(nullptr);
-
-                    // Repair if needed.
-                    repair_after_erase_(node, child);
-                    update_root_(child);
-
-                    delete node;
-                }
+                    replace_child_(node, node->right() ? node->right() : node->left());
 
-                return succ;
+                node->isolate();
+
+                return node;
+            }
+
+            template<class... Args>
+            node_type* make_node(Args&&... args)
+            {
+                return node_cache_.make(forward<Args>(args)...);
             }
 
-            void insert_node(node_type* node, node_type* parent)
+            void free_node(node_type* node)
             {
-                Policy::insert(*this, node, parent);
+                node_cache_.recycle(node);
+            }
+
+            size_type node_cache_limit() const noexcept
+            {
+                return node_cache_.limit();
+            }
+
+            void node_cache_limit(size_type limit)
+            {
+                node_cache_.limit(limit);
+            }
+
+            size_type node_cache_size() const noexcept
+            {
+                return node_cache_.size();
+            }
+
+            auto insert_node(node_type* node, node_type* parent)
+            {
+                return Policy::insert(*this, node, parent);
             }
 
         private:
@@ -431,6 +486,7 @@ namespace std::aux
             size_type size_;
             key_compare key_compare_;
             key_extract key_extractor_;
+            node_cache<node_type> node_cache_;
 
             node_type* find_(const key_type& key) const
             {
@@ -474,6 +530,20 @@ namespace std::aux
                     root_ = root_->parent();
             }
 
+            void replace_child_(node_type* node, node_type* child)
+            {
+                auto parent = node->parent();
+                if (child)
+                    child->parent(parent);
+
+                if (!parent)
+                    root_ = child;
+                else if (parent->left() == node)
+                    parent->left(child);
+                else
+                    parent->right(child);
+            }
+
             void repair_after_insert_(const node_type* node)
             {
                 // TODO: implement
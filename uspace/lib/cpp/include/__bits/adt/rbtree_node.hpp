@@ -400,6 +400,14 @@ namespace std::aux
                 return nullptr;
             }
 
+            void isolate()
+            {
+                parent_ = nullptr;
+                left_ = nullptr;
+                right_ = nullptr;
+                color = rbcolor::red;
+            }
+
             rbtree_single_node* get_end()
             {
                 return this;
@@ -559,8 +567,8 @@ namespace std::aux
             {
                 if (next_)
                     return next_;
-                else
-                    return utils::successor(this);
+                else // Tree links are only valid for the head of the list.
+                    return utils::successor(first_);
             }
 
             rbtree_multi_node* predecessor()
@@ -620,19 +628,35 @@ namespace std::aux
                  * update then list and return this
                  * for deletion.
                  */
-                if (next_)
+                if (this != first_)
+                {
+                    // Not the head, just leave the list.
+                    auto prev = first_;
+                    while (prev->next_ != this)
+                        prev = prev->next_;
+                    prev->next_ = next_;
+
+                    parent_ = nullptr;
+                    left_ = nullptr;
+                    right_ = nullptr;
+                    next_ = nullptr;
+                    first_ = nullptr;
+
+                    return this;
+                }
+                else if (next_)
                 {
                     // Make next the new this.
                     next_->first_ = next_;
                     if (is_left_child())
-                        parent_->left_ = next_;
+                        parent_->left(next_);
                     else if (is_right_child())
-                        parent_->right_ = next_;
+                        parent_->right(next_);
 
                     if (left_)
-                        left_->parent_ = next_;
+                        left_->parent(next_);
                     if (right_)
-                        right_->parent_ = next_;
+                        right_->parent(next_);
 
                     /**
                      * Update the first_ pointer
@@ -669,6 +693,16 @@ namespace std::aux
                     parent_->right_ = nullptr;
             }
 
+            void isolate()
+            {
+                parent_ = nullptr;
+                left_ = nullptr;
+                right_ = nullptr;
+                next_ = nullptr;
+                first_ = this;
+                color = rbcolor::red;
+            }
+
             void add(rbtree_multi_node* node)
             {
                 if (next_)
@@ -712,7 +746,27 @@ namespace std::aux
                 if (right_)
                     delete right_;
 
-                // TODO: delete the list
+                if (first_ == this)
+                {
+                    /**
+                     * The rest of the list shares our children,
+                     * so we unlink them first to avoid deleting
+                     * the subtrees multiple times.
+                     */
+                    auto tmp = next_;
+                    while (tmp)
+                    {
+                        auto next = tmp->next_;
+
+                        tmp->left_ = nullptr;
+                        tmp->right_ = nullptr;
+                        tmp->next_ = nullptr;
+                        tmp->first_ = nullptr;
+                        delete tmp;
+
+                        tmp = next;
+                    }
+                }
             }
 
         private:
@@ -164,7 +164,6 @@ namespace std::aux
         {
             using value_type = typename Tree::value_type;
             using iterator   = typename Tree::iterator;
-            using node_type  = typename Tree::node_type;
 
             auto val = value_type{forward<Args>(args)...};
             auto parent = tree.find_parent_for_insertion(tree.get_key(val));
@@ -172,7 +171,7 @@ namespace std::aux
             if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(val)))
                 return make_pair(iterator{parent, false}, false);
 
-            auto node = new node_type{move(val)};
+            auto node = tree.make_node(move(val));
 
             return insert(tree, node, parent);
         }
@@ -183,13 +182,12 @@ namespace std::aux
         > insert(Tree& tree, const Value& val)
         {
             using iterator  = typename Tree::iterator;
-            using node_type = typename Tree::node_type;
 
             auto parent = tree.find_parent_for_insertion(tree.get_key(val));
             if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(val)))
                 return make_pair(iterator{parent, false}, false);
 
-            auto node = new node_type{val};
+            auto node = tree.make_node(val);
 
             return insert(tree, node, parent);
         }
@@ -200,13 +198,12 @@ namespace std::aux
         > insert(Tree& tree, Value&& val)
         {
             using iterator  = typename Tree::iterator;
-            using node_type = typename Tree::node_type;
 
             auto parent = tree.find_parent_for_insertion(tree.get_key(val));
             if (parent && tree.keys_equal(tree.get_key(parent->value), tree.get_key(val)))
                 return make_pair(iterator{parent, false}, false);
 
-            auto node = new node_type{forward<Value>(val)};
+            auto node = tree.make_node(forward<Value>(val));
 
             return insert(tree, node, parent);
         }
@@ -385,9 +382,7 @@ namespace std::aux
         template<class Tree, class... Args>
         static typename Tree::iterator emplace(Tree& tree, Args&&... args)
         {
-            using node_type  = typename Tree::node_type;
-
-            auto node = new node_type{forward<Args>(args)...};
+            auto node = tree.make_node(forward<Args>(args)...);
 
             return insert(tree, node);
         }
@@ -395,9 +390,7 @@ namespace std::aux
         template<class Tree, class Value>
         static typename Tree::iterator insert(Tree& tree, const Value& val)
         {
-            using node_type = typename Tree::node_type;
-
-            auto node = new node_type{val};
+            auto node = tree.make_node(val);
 
             return insert(tree, node);
         }
@@ -405,9 +398,7 @@ namespace std::aux
         template<class Tree, class Value>
         static typename Tree::iterator insert(Tree& tree, Value&& val)
         {
-            using node_type = typename Tree::node_type;
-
-            auto node = new node_type{forward<Value>(val)};
+            auto node = tree.make_node(forward<Value>(val));
 
             return insert(tree, node);
         }
@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_ADT_SET
 #define LIBCPP_BITS_ADT_SET
 
+#include <__bits/adt/node_handle.hpp>
 #include <__bits/adt/rbtree.hpp>
 #include <functional>
 #include <iterator>
@@ -37,6 +38,9 @@
 
 namespace std
 {
+    template<class Key, class Compare, class Alloc>
+    class multiset;
+
     /**
      * 23.4.6, class template set:
      */
@@ -61,7 +65,11 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_single_node<value_type>;
+            using tree_node_type = aux::rbtree_single_node<value_type>;
+
+            using node_type = aux::set_node_handle<
+                tree_node_type, value_type, allocator_type
+            >;
 
             /**
              * Note: Both the iterator and const_iterator (and their local variants)
@@ -69,13 +77,15 @@ namespace std
              *       to be the same type, but why not? :)
              */
             using iterator             = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
             using const_iterator       = iterator;
 
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using insert_return_type = aux::node_insert_return<iterator, node_type>;
+
             set()
                 : set{key_compare{}}
             { /* DUMMY BODY */ }
@@ -287,6 +297,48 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            insert_return_type insert(node_type&& nh)
+            {
+                if (!nh)
+                    return insert_return_type{end(), false, node_type{}};
+
+                auto node = aux::node_handle_access::node(nh);
+                const auto& key = node->value;
+
+                auto parent = tree_.find_parent_for_insertion(key);
+                if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
+                    return insert_return_type{iterator{parent, false}, false, move(nh)};
+
+                aux::node_handle_access::release(nh);
+                tree_.insert_node(node, parent);
+
+                return insert_return_type{iterator{node, false}, true, node_type{}};
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh)).position;
+            }
+
+            node_type extract(const_iterator position)
+            {
+                if (position == cend())
+                    return node_type{};
+
+                return aux::node_handle_access::make<node_type>(
+                    tree_.extract_node(position.node()), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             iterator erase(const_iterator position)
             {
                 return tree_.erase(position);
@@ -320,6 +372,50 @@ namespace std
                 tree_.clear();
             }
 
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                tree_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return tree_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return tree_.node_cache_size();
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -461,12 +557,42 @@ namespace std
                 key_type, key_type, aux::key_no_value_key_extractor<key_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_single_policy, node_type
+                aux::rbtree_single_policy, tree_node_type
             >;
 
             tree_type tree_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                /**
+                 * Note: Extraction does not invalidate iterators
+                 *       to other elements, but the end iterator
+                 *       may change, so we count the elements
+                 *       instead of comparing with end().
+                 */
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                {
+                    auto current = it++;
+                    if (find(*current) == end())
+                        merge_insert_(source.extract(current));
+                }
+            }
+
+            void merge_insert_(node_type&& nh)
+            {
+                insert(move(nh));
+            }
+
+            template<class NodeHandle>
+            void merge_insert_(NodeHandle&& nh)
+            {
+                // Different node type, so only the value can be moved.
+                emplace(move(nh.value()));
+            }
+
             template<class K, class C, class A>
             friend bool operator==(const set<K, C, A>&,
                                    const set<K, C, A>&);
@@ -542,7 +668,11 @@ namespace std
             using size_type       = size_t;
             using difference_type = ptrdiff_t;
 
-            using node_type = aux::rbtree_multi_node<value_type>;
+            using tree_node_type = aux::rbtree_multi_node<value_type>;
+
+            using node_type = aux::set_node_handle<
+                tree_node_type, value_type, allocator_type
+            >;
 
             /**
              * Note: Both the iterator and const_iterator types are constant
@@ -550,7 +680,7 @@ namespace std
              *       to be the same type, but why not? :)
              */
             using iterator             = aux::rbtree_const_iterator<
-                value_type, const_reference, const_pointer, size_type, node_type
+                value_type, const_reference, const_pointer, size_type, tree_node_type
             >;
             using const_iterator       = iterator;
 
@@ -768,6 +898,40 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            iterator insert(node_type&& nh)
+            {
+                if (!nh)
+                    return end();
+
+                auto node = aux::node_handle_access::release(nh);
+
+                return tree_.insert_node(node, nullptr);
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh));
+            }
+
+            node_type extract(const_iterator position)
+            {
+                if (position == cend())
+                    return node_type{};
+
+                return aux::node_handle_access::make<node_type>(
+                    tree_.extract_node(position.node()), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             iterator erase(const_iterator position)
             {
                 return tree_.erase(position);
@@ -801,6 +965,50 @@ namespace std
                 tree_.clear();
             }
 
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(multiset<key_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class C2>
+            void merge(set<key_type, C2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                tree_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return tree_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return tree_.node_cache_size();
+            }
+
             key_compare key_comp() const
             {
                 return tree_.key_comp();
@@ -942,12 +1150,34 @@ namespace std
                 key_type, key_type, aux::key_no_value_key_extractor<key_type>,
                 key_compare, allocator_type, size_type,
                 iterator, const_iterator,
-                aux::rbtree_multi_policy, node_type
+                aux::rbtree_multi_policy, tree_node_type
             >;
 
             tree_type tree_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                if (static_cast<void*>(&source) == static_cast<void*>(this))
+                    return;
+
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                    merge_insert_(source.extract(it++));
+            }
+
+            void merge_insert_(node_type&& nh)
+            {
+                insert(move(nh));
+            }
+
+            template<class NodeHandle>
+            void merge_insert_(NodeHandle&& nh)
+            {
+                emplace(move(nh.value()));
+            }
+
             template<class K, class C, class A>
             friend bool operator==(const multiset<K, C, A>&,
                                    const multiset<K, C, A>&);
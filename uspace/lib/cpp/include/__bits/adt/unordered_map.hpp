@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_UNORDERED_MAP
 
 #include <__bits/adt/hash_table.hpp>
+#include <__bits/adt/node_handle.hpp>
 #include <initializer_list>
 #include <functional>
 #include <memory>
@@ -38,6 +39,9 @@
 
 namespace std
 {
+    template<class Key, class Value, class Hash, class Pred, class Alloc>
+    class unordered_multimap;
+
     /**
      * 23.5.4, class template unordered_map:
      */
@@ -77,6 +81,11 @@ namespace std
                 value_type, const_reference, const_pointer
             >;
 
+            using node_type = aux::map_node_handle<
+                aux::list_node<value_type>, key_type, mapped_type, allocator_type
+            >;
+            using insert_return_type = aux::node_insert_return<iterator, node_type>;
+
             unordered_map()
                 : unordered_map{default_bucket_count_}
             { /* DUMMY BODY */ }
@@ -304,6 +313,39 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            insert_return_type insert(node_type&& nh)
+            {
+                if (!nh)
+                    return insert_return_type{end(), false, node_type{}};
+
+                auto res = table_.insert_node(aux::node_handle_access::node(nh));
+                if (res.second)
+                    aux::node_handle_access::release(nh);
+
+                return insert_return_type{res.first, res.second, move(nh)};
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh)).position;
+            }
+
+            node_type extract(const_iterator position)
+            {
+                return aux::node_handle_access::make<node_type>(
+                    table_.extract_node(position), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             template<class... Args>
             pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
             {
@@ -335,7 +377,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{key, forward<Args>(args)...};
+                    auto node = table_.make_node(key, forward<Args>(args)...);
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -370,7 +412,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{move(key), forward<Args>(args)...};
+                    auto node = table_.make_node(move(key), forward<Args>(args)...);
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -418,7 +460,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{key, forward<T>(val)};
+                    auto node = table_.make_node(key, forward<T>(val));
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -454,7 +496,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{move(key), forward<T>(val)};
+                    auto node = table_.make_node(move(key), forward<T>(val));
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -503,6 +545,50 @@ namespace std
                 table_.clear();
             }
 
+            template<class H2, class P2>
+            void merge(unordered_map<key_type, mapped_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_map<key_type, mapped_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_multimap<key_type, mapped_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_multimap<key_type, mapped_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                table_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return table_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return table_.node_cache_size();
+            }
+
             void swap(unordered_map& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
                          noexcept(std::swap(declval<hasher>(), declval<hasher>())) &&
@@ -567,7 +653,7 @@ namespace std
                     while (current != head);
                 }
 
-                auto node = new node_type{key, mapped_type{}};
+                auto node = table_.make_node(key, mapped_type{});
                 bucket->append(node);
 
                 table_.increment_size();
@@ -595,7 +681,7 @@ namespace std
                     while (current != head);
                 }
 
-                auto node = new node_type{move(key), mapped_type{}};
+                auto node = table_.make_node(move(key), mapped_type{});
                 bucket->append(node);
 
                 table_.increment_size();
@@ -701,11 +787,28 @@ namespace std
                 iterator, const_iterator, local_iterator, const_local_iterator,
                 aux::hash_single_policy
             >;
-            using node_type = typename table_type::node_type;
 
             table_type table_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                /**
+                 * Note: Extraction does not invalidate iterators
+                 *       to other elements, so we can keep walking
+                 *       the source, but we count the elements
+                 *       to visit each of them exactly once.
+                 */
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                {
+                    auto current = it++;
+                    if (find(current->first) == end())
+                        insert(source.extract(current));
+                }
+            }
+
             static constexpr size_type default_bucket_count_{16};
 
             template<class K, class V, class H, class P, class A>
@@ -752,6 +855,10 @@ namespace std
                 value_type, const_reference, const_pointer
             >;
 
+            using node_type = aux::map_node_handle<
+                aux::list_node<value_type>, key_type, mapped_type, allocator_type
+            >;
+
             unordered_multimap()
                 : unordered_multimap{default_bucket_count_}
             { /* DUMMY BODY */ }
@@ -981,6 +1088,35 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            iterator insert(node_type&& nh)
+            {
+                if (!nh)
+                    return end();
+
+                return table_.insert_node(aux::node_handle_access::release(nh));
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh));
+            }
+
+            node_type extract(const_iterator position)
+            {
+                return aux::node_handle_access::make<node_type>(
+                    table_.extract_node(position), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             iterator erase(const_iterator position)
             {
                 return table_.erase(position);
@@ -1007,6 +1143,50 @@ namespace std
                 table_.clear();
             }
 
+            template<class H2, class P2>
+            void merge(unordered_multimap<key_type, mapped_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_multimap<key_type, mapped_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_map<key_type, mapped_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_map<key_type, mapped_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                table_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return table_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return table_.node_cache_size();
+            }
+
             void swap(unordered_multimap& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
                          noexcept(std::swap(declval<hasher>(), declval<hasher>())) &&
@@ -1137,6 +1317,17 @@ namespace std
             table_type table_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                if (static_cast<void*>(&source) == static_cast<void*>(this))
+                    return;
+
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                    insert(source.extract(it++));
+            }
+
             static constexpr size_type default_bucket_count_{16};
 
             template<class K, class V, class H, class P, class A>
@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_UNORDERED_SET
 
 #include <__bits/adt/hash_table.hpp>
+#include <__bits/adt/node_handle.hpp>
 #include <initializer_list>
 #include <functional>
 #include <memory>
@@ -37,6 +38,9 @@
 
 namespace std
 {
+    template<class Key, class Hash, class Pred, class Alloc>
+    class unordered_multiset;
+
     /**
      * 23.5.6, class template unordered_set:
      */
@@ -76,6 +80,11 @@ namespace std
             >;
             using const_local_iterator = local_iterator;
 
+            using node_type = aux::set_node_handle<
+                aux::list_node<value_type>, value_type, allocator_type
+            >;
+            using insert_return_type = aux::node_insert_return<iterator, node_type>;
+
             /**
              * Note: We need () to delegate the constructor,
              *       otherwise it could be deduced as the initializer
@@ -290,6 +299,39 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            insert_return_type insert(node_type&& nh)
+            {
+                if (!nh)
+                    return insert_return_type{end(), false, node_type{}};
+
+                auto res = table_.insert_node(aux::node_handle_access::node(nh));
+                if (res.second)
+                    aux::node_handle_access::release(nh);
+
+                return insert_return_type{res.first, res.second, move(nh)};
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh)).position;
+            }
+
+            node_type extract(const_iterator position)
+            {
+                return aux::node_handle_access::make<node_type>(
+                    table_.extract_node(position), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             iterator erase(const_iterator position)
             {
                 return table_.erase(position);
@@ -316,6 +358,50 @@ namespace std
                 table_.clear();
             }
 
+            template<class H2, class P2>
+            void merge(unordered_set<key_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_set<key_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_multiset<key_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_multiset<key_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                table_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return table_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return table_.node_cache_size();
+            }
+
             void swap(unordered_set& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
                          noexcept(std::swap(declval<hasher>(), declval<hasher>())) &&
@@ -446,6 +532,24 @@ namespace std
             table_type table_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                /**
+                 * Note: Extraction does not invalidate iterators
+                 *       to other elements, so we can keep walking
+                 *       the source, but we count the elements
+                 *       to visit each of them exactly once.
+                 */
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                {
+                    auto current = it++;
+                    if (find(*current) == end())
+                        insert(source.extract(current));
+                }
+            }
+
             static constexpr size_type default_bucket_count_{16};
 
             template<class K, class H, class P, class A>
@@ -492,6 +596,10 @@ namespace std
             >;
             using const_local_iterator = local_iterator;
 
+            using node_type = aux::set_node_handle<
+                aux::list_node<value_type>, value_type, allocator_type
+            >;
+
             /**
              * Note: We need () to delegate the constructor,
              *       otherwise it could be deduced as the initializer
@@ -706,6 +814,35 @@ namespace std
                 insert(init.begin(), init.end());
             }
 
+            iterator insert(node_type&& nh)
+            {
+                if (!nh)
+                    return end();
+
+                return table_.insert_node(aux::node_handle_access::release(nh));
+            }
+
+            iterator insert(const_iterator, node_type&& nh)
+            {
+                return insert(move(nh));
+            }
+
+            node_type extract(const_iterator position)
+            {
+                return aux::node_handle_access::make<node_type>(
+                    table_.extract_node(position), allocator_
+                );
+            }
+
+            node_type extract(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return node_type{};
+                else
+                    return extract(it);
+            }
+
             iterator erase(const_iterator position)
             {
                 return table_.erase(position);
@@ -732,6 +869,50 @@ namespace std
                 table_.clear();
             }
 
+            template<class H2, class P2>
+            void merge(unordered_multiset<key_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_multiset<key_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_set<key_type, H2, P2, allocator_type>& source)
+            {
+                merge_(source);
+            }
+
+            template<class H2, class P2>
+            void merge(unordered_set<key_type, H2, P2, allocator_type>&& source)
+            {
+                merge_(source);
+            }
+
+            /**
+             * Extension: Keep up to limit nodes of erased elements
+             * for reuse by subsequent insertions, 0 (the default)
+             * disables the cache.
+             */
+            void __node_cache_limit(size_type limit)
+            {
+                table_.node_cache_limit(limit);
+            }
+
+            size_type __node_cache_limit() const noexcept
+            {
+                return table_.node_cache_limit();
+            }
+
+            size_type __node_cache_size() const noexcept
+            {
+                return table_.node_cache_size();
+            }
+
             void swap(unordered_multiset& other)
                 noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
                          noexcept(std::swap(declval<hasher>(), declval<hasher>())) &&
@@ -862,6 +1043,17 @@ namespace std
             table_type table_;
             allocator_type allocator_;
 
+            template<class Source>
+            void merge_(Source& source)
+            {
+                if (static_cast<void*>(&source) == static_cast<void*>(this))
+                    return;
+
+                auto it = source.begin();
+                for (auto n = source.size(); n > 0; --n)
+                    insert(source.extract(it++));
+            }
+
             static constexpr size_type default_bucket_count_{16};
 
             template<class K, class H, class P, class A>
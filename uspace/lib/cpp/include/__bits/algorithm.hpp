@@ -816,7 +816,51 @@ namespace std
      * 25.4.4, merge:
      */
 
-    // TODO: implement
+    template<class InputIterator1, class InputIterator2,
+             class OutputIterator, class Compare>
+    OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result, Compare comp)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (comp(*first2, *first1))
+                *result++ = *first2++;
+            else
+                *result++ = *first1++;
+        }
+
+        while (first1 != last1)
+            *result++ = *first1++;
+
+        while (first2 != last2)
+            *result++ = *first2++;
+
+        return result;
+    }
+
+    template<class InputIterator1, class InputIterator2,
+             class OutputIterator>
+    OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                         InputIterator2 first2, InputIterator2 last2,
+                         OutputIterator result)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (*first2 < *first1)
+                *result++ = *first2++;
+            else
+                *result++ = *first1++;
+        }
+
+        while (first1 != last1)
+            *result++ = *first1++;
+
+        while (first2 != last2)
+            *result++ = *first2++;
+
+        return result;
+    }
 
     /**
      * 25.4.5, set operations on sorted structures:
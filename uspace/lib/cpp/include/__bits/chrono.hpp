@@ -605,8 +605,7 @@ namespace std::chrono
             using duration   = chrono::duration<rep, period>;
             using time_point = chrono::time_point<system_clock>;
 
-            // TODO: is it steady?
-            static constexpr bool is_steady = true;
+            static constexpr bool is_steady = false;
 
             static time_point now()
             {
@@ -621,20 +620,16 @@ namespace std::chrono
 
             static time_t to_time_t(const time_point& tp)
             {
-                /* auto dur = tp.time_since_epoch(); */
-                /* auto time_t_dur = duration_cast<chrono::duration<time_t, seconds>>(dur); */
+                auto usecs = tp.time_since_epoch().count() + epoch_usecs;
 
-                /* return time_t{time_t_dur.count()}; */
-                return time_t{};
+                return static_cast<time_t>(usecs / 1'000'000);
             }
 
             static time_point from_time_t(time_t tt)
             {
-                /* auto time_t_dur = chrono::duration<time_t, seconds>{tt}; */
-                /* auto dur = duration_cast<duration>(time_t_dur); */
+                auto usecs = static_cast<rep>(tt) * 1'000'000;
 
-                /* return time_point{duration_cast<duration>(chrono::duration<time_t, seconds>{tt})}; */
-                return time_point{};
+                return time_point{duration{usecs - epoch_usecs}};
             }
 
         private:
@@ -663,7 +658,27 @@ namespace std::chrono
             }
     };
 
-    using high_resolution_clock = system_clock;
+    /**
+     * Steady clock with nanosecond resolution. Where the
+     * processor has a cycle counter that runs at a constant
+     * rate and can be read from userspace, the clock reads it
+     * directly instead of making a syscall. The counter is
+     * calibrated against the uptime on first use, which
+     * takes a little over 100 milliseconds, and the clock
+     * falls back to the uptime otherwise.
+     */
+    class high_resolution_clock
+    {
+        public:
+            using rep        = int64_t;
+            using period     = nano;
+            using duration   = chrono::duration<rep, period>;
+            using time_point = chrono::time_point<high_resolution_clock>;
+
+            static constexpr bool is_steady = true;
+
+            static time_point now();
+    };
 }
 
 namespace std
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_COROUTINE
+#define LIBCPP_BITS_COROUTINE
+
+#include <__bits/functional/hash.hpp>
+#include <__bits/type_traits/type_traits.hpp>
+#include <cstddef>
+
+/**
+ * Only compilers with coroutine support (GCC 10 with -fcoroutines
+ * and newer) can define coroutines. Without it the library types
+ * are still available, but the only frames that exist are those
+ * of no-op coroutines, so the handles fall back to accessing the
+ * frame layout directly instead of using the compiler builtins.
+ */
+#if defined(__cpp_impl_coroutine) || defined(__cpp_coroutines)
+#define LIBCPP_COROUTINES_SUPPORTED 1
+#define __cpp_lib_coroutine 201902L
+#else
+#define LIBCPP_COROUTINES_SUPPORTED 0
+#endif
+
+namespace std
+{
+    namespace aux
+    {
+        /**
+         * Start of a coroutine frame as laid out by both GCC
+         * and Clang, the promise follows suitably aligned.
+         */
+        struct coroutine_frame
+        {
+            void (*resume)(void*);
+            void (*destroy)(void*);
+        };
+
+        constexpr size_t coroutine_promise_offset(size_t align)
+        {
+            return (sizeof(coroutine_frame) + align - 1) & ~(align - 1);
+        }
+
+        inline bool coroutine_done(void* frame)
+        {
+#if LIBCPP_COROUTINES_SUPPORTED
+            return __builtin_coro_done(frame);
+#else
+            return static_cast<coroutine_frame*>(frame)->resume == nullptr;
+#endif
+        }
+
+        inline void coroutine_resume(void* frame)
+        {
+#if LIBCPP_COROUTINES_SUPPORTED
+            __builtin_coro_resume(frame);
+#else
+            static_cast<coroutine_frame*>(frame)->resume(frame);
+#endif
+        }
+
+        inline void coroutine_destroy(void* frame)
+        {
+#if LIBCPP_COROUTINES_SUPPORTED
+            __builtin_coro_destroy(frame);
+#else
+            static_cast<coroutine_frame*>(frame)->destroy(frame);
+#endif
+        }
+
+        template<class Promise>
+        void* coroutine_frame_of(Promise& p)
+        {
+#if LIBCPP_COROUTINES_SUPPORTED
+            return __builtin_coro_promise(
+                static_cast<void*>(&p), __alignof(Promise), true
+            );
+#else
+            return reinterpret_cast<unsigned char*>(&p) -
+                coroutine_promise_offset(__alignof(Promise));
+#endif
+        }
+
+        template<class Promise>
+        Promise& coroutine_promise_of(void* frame)
+        {
+#if LIBCPP_COROUTINES_SUPPORTED
+            return *static_cast<Promise*>(
+                __builtin_coro_promise(frame, __alignof(Promise), false)
+            );
+#else
+            return *reinterpret_cast<Promise*>(
+                static_cast<unsigned char*>(frame) +
+                coroutine_promise_offset(__alignof(Promise))
+            );
+#endif
+        }
+    }
+
+    /**
+     * 17.12.3, coroutine traits:
+     */
+
+    namespace aux
+    {
+        template<class R, class = void>
+        struct coroutine_traits_base
+        { /* DUMMY BODY */ };
+
+        template<class R>
+        struct coroutine_traits_base<R, void_t<typename R::promise_type>>
+        {
+            using promise_type = typename R::promise_type;
+        };
+    }
+
+    template<class R, class... Args>
+    struct coroutine_traits: aux::coroutine_traits_base<R>
+    { /* DUMMY BODY */ };
+
+    /**
+     * 17.12.4, coroutine handle:
+     */
+
+    template<class Promise = void>
+    struct coroutine_handle;
+
+    template<>
+    struct coroutine_handle<void>
+    {
+        constexpr coroutine_handle() noexcept
+            : frame_{nullptr}
+        { /* DUMMY BODY */ }
+
+        constexpr coroutine_handle(nullptr_t) noexcept
+            : frame_{nullptr}
+        { /* DUMMY BODY */ }
+
+        coroutine_handle& operator=(nullptr_t) noexcept
+        {
+            frame_ = nullptr;
+
+            return *this;
+        }
+
+        constexpr void* address() const noexcept
+        {
+            return frame_;
+        }
+
+        static constexpr coroutine_handle from_address(void* addr) noexcept
+        {
+            coroutine_handle res{};
+            res.frame_ = addr;
+
+            return res;
+        }
+
+        constexpr explicit operator bool() const noexcept
+        {
+            return frame_ != nullptr;
+        }
+
+        bool done() const
+        {
+            return aux::coroutine_done(frame_);
+        }
+
+        void operator()() const
+        {
+            resume();
+        }
+
+        void resume() const
+        {
+            aux::coroutine_resume(frame_);
+        }
+
+        void destroy() const
+        {
+            aux::coroutine_destroy(frame_);
+        }
+
+        protected:
+            void* frame_;
+    };
+
+    template<class Promise>
+    struct coroutine_handle: coroutine_handle<>
+    {
+        using coroutine_handle<>::coroutine_handle;
+
+        static coroutine_handle from_promise(Promise& p)
+        {
+            coroutine_handle res{};
+            res.frame_ = aux::coroutine_frame_of(p);
+
+            return res;
+        }
+
+        coroutine_handle& operator=(nullptr_t) noexcept
+        {
+            frame_ = nullptr;
+
+            return *this;
+        }
+
+        static constexpr coroutine_handle from_address(void* addr) noexcept
+        {
+            coroutine_handle res{};
+            res.frame_ = addr;
+
+            return res;
+        }
+
+        Promise& promise() const
+        {
+            return aux::coroutine_promise_of<Promise>(frame_);
+        }
+    };
+
+    /**
+     * 17.12.4.7, comparison operators:
+     */
+
+    constexpr bool operator==(coroutine_handle<> lhs, coroutine_handle<> rhs) noexcept
+    {
+        return lhs.address() == rhs.address();
+    }
+
+    constexpr bool operator!=(coroutine_handle<> lhs, coroutine_handle<> rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    constexpr bool operator<(coroutine_handle<> lhs, coroutine_handle<> rhs) noexcept
+    {
+        return lhs.address() < rhs.address();
+    }
+
+    constexpr bool operator>(coroutine_handle<> lhs, coroutine_handle<> rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+
+    constexpr bool operator<=(coroutine_handle<> lhs, coroutine_handle<> rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+
+    constexpr bool operator>=(coroutine_handle<> lhs, coroutine_handle<> rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+
+    /**
+     * 17.12.4.8, hash support:
+     */
+
+    template<class Promise>
+    struct hash<coroutine_handle<Promise>>
+    {
+        size_t operator()(const coroutine_handle<Promise>& h) const noexcept
+        {
+            return aux::hash(h.address());
+        }
+
+        using argument_type = coroutine_handle<Promise>;
+        using result_type   = size_t;
+    };
+
+    /**
+     * 17.12.5, no-op coroutines:
+     */
+
+    struct noop_coroutine_promise
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct coroutine_handle<noop_coroutine_promise>: coroutine_handle<>
+    {
+        constexpr explicit operator bool() const noexcept
+        {
+            return true;
+        }
+
+        constexpr bool done() const noexcept
+        {
+            return false;
+        }
+
+        constexpr void operator()() const noexcept
+        { /* DUMMY BODY */ }
+
+        constexpr void resume() const noexcept
+        { /* DUMMY BODY */ }
+
+        constexpr void destroy() const noexcept
+        { /* DUMMY BODY */ }
+
+        noop_coroutine_promise& promise() const noexcept
+        {
+            return static_cast<frame*>(frame_)->promise;
+        }
+
+        private:
+            friend coroutine_handle noop_coroutine() noexcept;
+
+            /**
+             * Note: The frame mimics the layout the compiler uses
+             *       for coroutine frames (resume and destroy pointers
+             *       followed by the promise), which lets the handle
+             *       be used through coroutine_handle<>.
+             */
+            struct frame
+            {
+                static void resume_destroy_(void*) noexcept
+                { /* DUMMY BODY */ }
+
+                void (*resume)(void*) = resume_destroy_;
+                void (*destroy)(void*) = resume_destroy_;
+                noop_coroutine_promise promise{};
+            };
+
+            static frame frame_instance_;
+
+            coroutine_handle() noexcept
+            {
+                frame_ = &frame_instance_;
+            }
+    };
+
+    inline coroutine_handle<noop_coroutine_promise>::frame
+    coroutine_handle<noop_coroutine_promise>::frame_instance_{};
+
+    using noop_coroutine_handle = coroutine_handle<noop_coroutine_promise>;
+
+    inline noop_coroutine_handle noop_coroutine() noexcept
+    {
+        return noop_coroutine_handle{};
+    }
+
+    /**
+     * 17.12.6, trivial awaitables:
+     */
+
+    struct suspend_never
+    {
+        constexpr bool await_ready() const noexcept
+        {
+            return true;
+        }
+
+        constexpr void await_suspend(coroutine_handle<>) const noexcept
+        { /* DUMMY BODY */ }
+
+        constexpr void await_resume() const noexcept
+        { /* DUMMY BODY */ }
+    };
+
+    struct suspend_always
+    {
+        constexpr bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        constexpr void await_suspend(coroutine_handle<>) const noexcept
+        { /* DUMMY BODY */ }
+
+        constexpr void await_resume() const noexcept
+        { /* DUMMY BODY */ }
+    };
+}
+
+#endif
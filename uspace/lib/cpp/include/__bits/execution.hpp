@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_EXECUTION
+#define LIBCPP_BITS_EXECUTION
+
+#include <__bits/type_traits/type_traits.hpp>
+#include <cstdlib>
+
+namespace std
+{
+    /**
+     * 23.19.3, execution policy type trait:
+     */
+
+    template<class T>
+    struct is_execution_policy: false_type
+    { /* DUMMY BODY */ };
+
+    template<class T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+    namespace execution
+    {
+        /**
+         * 23.19.4, sequenced execution policy:
+         */
+
+        class sequenced_policy
+        { /* DUMMY BODY */ };
+
+        /**
+         * 23.19.5, parallel execution policy:
+         */
+
+        class parallel_policy
+        { /* DUMMY BODY */ };
+
+        /**
+         * 23.19.6, parallel and unsequenced execution policy:
+         */
+
+        class parallel_unsequenced_policy
+        { /* DUMMY BODY */ };
+
+        /**
+         * 23.19.7, execution policy objects:
+         */
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+    }
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy>: true_type
+    { /* DUMMY BODY */ };
+
+    namespace experimental
+    {
+        /**
+         * Overrides the number of workers used by the parallel
+         * algorithms, zero restores the default (number of CPUs).
+         */
+        void set_parallel_concurrency(size_t workers);
+    }
+
+    namespace aux
+    {
+        /**
+         * Number of workers the parallel algorithms split their
+         * work into. Determined once from the number of active CPUs,
+         * the first call also lets the fibril runtime spread
+         * fibrils over multiple runner threads.
+         */
+        size_t parallel_concurrency();
+
+        /**
+         * Calls fn(arg, i) for every i in [0, tasks), each call in its
+         * own fibril (the first one on the calling fibril), and returns
+         * once all of them finished.
+         */
+        void parallel_run(size_t tasks, void (*fn)(void*, size_t), void* arg);
+
+        /**
+         * Minimal number of elements per chunk, smaller ranges
+         * are not worth the cost of spawning a fibril.
+         */
+        inline constexpr size_t parallel_grain = 2048;
+
+        inline size_t parallel_chunks(size_t count)
+        {
+            auto workers = parallel_concurrency();
+            if (workers <= 1 || count < 2 * parallel_grain)
+                return 1;
+
+            auto chunks = count / parallel_grain;
+
+            return chunks < workers ? chunks : workers;
+        }
+
+        /**
+         * Splits [0, count) into chunks contiguous subranges and calls
+         * f(begin, end, idx) for each of them in parallel.
+         */
+        template<class F>
+        void parallel_for(size_t count, size_t chunks, F& f)
+        {
+            if (chunks <= 1)
+            {
+                f(size_t{}, count, size_t{});
+
+                return;
+            }
+
+            struct context
+            {
+                F* f;
+                size_t count;
+                size_t chunks;
+            } ctx{&f, count, chunks};
+
+            parallel_run(chunks, [](void* arg, size_t idx) {
+                auto ctx = static_cast<context*>(arg);
+
+                (*ctx->f)(
+                    ctx->count * idx / ctx->chunks,
+                    ctx->count * (idx + 1) / ctx->chunks,
+                    idx
+                );
+            }, &ctx);
+        }
+    }
+}
+
+#endif
@@ -31,9 +31,11 @@
 
 #include <__bits/locale/locale.hpp>
 #include <__bits/locale/ctype.hpp>
+#include <__bits/locale/numpunct.hpp>
 #include <cstdlib>
 #include <iosfwd>
 #include <system_error>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -154,6 +156,32 @@ namespace std
             locale imbue(const locale& loc);
             locale getloc() const;
 
+            /**
+             * Note: Nonstandard, the facets of the imbued locale
+             *       are looked up once in imbue and kept here so
+             *       that formatted I/O does not need to copy the
+             *       locale and call use_facet for every value.
+             */
+            template<class Char>
+            const ctype<Char>& __ctype() const
+            {
+                if constexpr (is_same_v<Char, char>)
+                    return *ctype_char_;
+                else if constexpr (is_same_v<Char, wchar_t>)
+                    return *ctype_wchar_;
+                else
+                    return use_facet<ctype<Char>>(locale_);
+            }
+
+            template<class Char>
+            const numpunct<Char>& __numpunct() const
+            {
+                if constexpr (is_same_v<Char, char>)
+                    return *numpunct_char_;
+                else
+                    return use_facet<numpunct<Char>>(locale_);
+            }
+
             /**
              * 27.5.3.5, storage:
              */
@@ -212,6 +240,12 @@ namespace std
 
             locale locale_;
 
+            const ctype<char>* ctype_char_;
+            const ctype<wchar_t>* ctype_wchar_;
+            const numpunct<char>* numpunct_char_;
+
+            void cache_facets_();
+
             vector<pair<event_callback, int>> callbacks_;
 
         private:
@@ -392,6 +426,7 @@ namespace std
                 precision_  = rhs.precision_;
                 fill_      = rhs.fill_;
                 locale_     = rhs.locale_;
+                cache_facets_();
 
                 delete[] iarray_;
                 iarray_size_ = rhs.iarray_size_;
@@ -439,12 +474,12 @@ namespace std
 
             char narrow(char_type c, char def) const
             {
-                return use_facet<ctype<char_type>>(locale_).narrow(c, def);
+                return __ctype<char_type>().narrow(c, def);
             }
 
             char_type widen(char c) const
             {
-                return use_facet<ctype<char_type>>(locale_).widen(c);
+                return __ctype<char_type>().widen(c);
             }
 
         protected:
@@ -463,8 +498,9 @@ namespace std
                 width(0);
                 precision(6);
 
-                fill_ = widen(' ');
                 locale_ = locale();
+                cache_facets_();
+                fill_ = widen(' ');
 
                 iarray_ = nullptr;
                 parray_ = nullptr;
@@ -480,6 +516,7 @@ namespace std
                 precision_  = rhs.precision_;
                 fill_       = rhs.fill_;
                 locale_     = move(rhs.locale_);
+                cache_facets_();
                 rdstate_    = rhs.rdstate_;
                 callbacks_  = move(rhs.callbacks_);
 
@@ -506,6 +543,7 @@ namespace std
                 precision_  = rhs.precision_;
                 fill_       = rhs.fill_;
                 locale_     = move(rhs.locale_);
+                cache_facets_();
                 rdstate_    = rhs.rdstate_;
                 callbacks_.swap(rhs.callbacks_);
 
@@ -532,6 +570,9 @@ namespace std
                 swap(precision_, rhs.precision_);
                 swap(fill_, rhs.fill_);
                 swap(locale_, rhs.locale_);
+                std::swap(ctype_char_, rhs.ctype_char_);
+                std::swap(ctype_wchar_, rhs.ctype_wchar_);
+                std::swap(numpunct_char_, rhs.numpunct_char_);
                 swap(rdstate_, rhs.rdstate_);
                 swap(callbacks_, rhs.callbacks_);
                 swap(iarray_);
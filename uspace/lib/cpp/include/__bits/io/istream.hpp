@@ -86,10 +86,28 @@ namespace std
 
                             if (!noskipws && ((is.flags() & ios_base::skipws) != 0))
                             {
-                                const auto& ct = use_facet<ctype<Char>>(is.getloc());
+                                const auto& ct = is.template __ctype<Char>();
+                                auto buf = is.rdbuf();
                                 while (true)
                                 {
-                                    auto i = is.rdbuf()->sgetc();
+                                    /**
+                                     * Fast path: scan the get area directly
+                                     * and only fall back to sgetc to refill it.
+                                     */
+                                    auto first = buf->gptr();
+                                    auto last = buf->egptr();
+                                    if (first != last)
+                                    {
+                                        auto ptr = first;
+                                        while (ptr != last && ct.is(ctype_base::space, *ptr))
+                                            ++ptr;
+
+                                        buf->gbump(static_cast<int>(ptr - first));
+                                        if (ptr != last)
+                                            break;
+                                    }
+
+                                    auto i = buf->sgetc();
                                     if (Traits::eq_int_type(i, Traits::eof()))
                                     {
                                         is.setstate(ios_base::failbit | ios_base::eofbit);
@@ -100,7 +118,7 @@ namespace std
                                     if (!ct.is(ctype_base::space, c))
                                         break;
                                     else
-                                        is.rdbuf()->sbumpc();
+                                        buf->sbumpc();
                                 }
                             }
                         }
@@ -162,8 +180,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -180,8 +197,7 @@ namespace std
                     auto err = ios_base::goodbit;
 
                     long tmp{};
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, tmp);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, tmp);
 
                     if (tmp < numeric_limits<short>::min())
                     {
@@ -211,8 +227,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -229,8 +244,7 @@ namespace std
                     auto err = ios_base::goodbit;
 
                     long tmp{};
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, tmp);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, tmp);
 
                     if (tmp < numeric_limits<int>::min())
                     {
@@ -260,8 +274,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -277,8 +290,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -294,8 +306,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -311,8 +322,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -328,8 +338,7 @@ namespace std
                     using num_get = num_get<Char, istreambuf_iterator<Char, Traits>>;
                     auto err = ios_base::goodbit;
 
-                    auto loc = this->getloc();
-                    use_facet<num_get>(loc).get(*this, 0, *this, err, x);
+                    use_facet<num_get>(this->locale_).get(*this, 0, *this, err, x);
                     this->setstate(err);
                 }
 
@@ -831,7 +840,7 @@ namespace std
 
         if (sen)
         {
-            const auto& ct = use_facet<ctype<Char>>(is.getloc());
+            const auto& ct = is.template __ctype<Char>();
 
             size_t n{};
             if (is.width() > 0)
@@ -888,7 +897,7 @@ namespace std
 
         if (sen)
         {
-            const auto& ct = use_facet<ctype<Char>>(is.getloc());
+            const auto& ct = is.template __ctype<Char>();
             while (true)
             {
                 auto i = is.rdbuf()->sgetc();
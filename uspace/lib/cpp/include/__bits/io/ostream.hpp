@@ -141,7 +141,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -159,7 +159,7 @@ namespace std
                     auto basefield = (this->flags() & ios_base::basefield);
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(),
+                    >(this->locale_).put(*this, *this, this->fill(),
                                           (basefield == ios_base::oct || basefield == ios_base::hex)
                                           ? static_cast<long>(static_cast<unsigned short>(x))
                                           : static_cast<long>(x)).failed();
@@ -179,7 +179,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(),
+                    >(this->locale_).put(*this, *this, this->fill(),
                                           static_cast<unsigned long>(x)).failed();
 
                     if (failed)
@@ -198,7 +198,7 @@ namespace std
                     auto basefield = (this->flags() & ios_base::basefield);
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(),
+                    >(this->locale_).put(*this, *this, this->fill(),
                                           (basefield == ios_base::oct || basefield == ios_base::hex)
                                           ? static_cast<long>(static_cast<unsigned int>(x))
                                           : static_cast<long>(x)).failed();
@@ -218,7 +218,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(),
+                    >(this->locale_).put(*this, *this, this->fill(),
                                           static_cast<unsigned long>(x)).failed();
 
                     if (failed)
@@ -236,7 +236,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -253,7 +253,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -270,7 +270,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -287,7 +287,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -304,7 +304,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), static_cast<double>(x)).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), static_cast<double>(x)).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -321,7 +321,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -338,7 +338,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), x).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), x).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -355,7 +355,7 @@ namespace std
                 {
                     bool failed = use_facet<
                         num_put<char_type, ostreambuf_iterator<char_type, traits_type>>
-                    >(this->getloc()).put(*this, *this, this->fill(), p).failed();
+                    >(this->locale_).put(*this, *this, this->fill(), p).failed();
 
                     if (failed)
                         this->setstate(ios_base::badbit);
@@ -422,6 +422,12 @@ namespace std
             {
                 return input_next_ && input_next_ < input_end_;
             }
+
+            /**
+             * The istream sentry skips whitespace
+             * directly in the get area.
+             */
+            friend class basic_istream<Char, Traits>;
     };
 
     using streambuf  = basic_streambuf<char>;
@@ -260,29 +260,45 @@ namespace std
             using char_type = char;
 
             explicit ctype(const mask* tab = nullptr, bool del = false, size_t = 0)
+                : table_{tab ? tab : classic_table()}, del_{tab && del}
             { /* DUMMY BODY */ }
 
+            /**
+             * Note: As in the standard, classification in this
+             *       specialization is not virtual and is a single
+             *       lookup into the mask table.
+             */
+
             bool is(mask m, char_type c) const
             {
-                return do_is(m, c);
+                return (table_[static_cast<unsigned char>(c)] & m) != 0;
             }
 
             const char_type* is(const char_type* low, const char_type* high,
                                 mask* vec) const
             {
-                return do_is(low, high, vec);
+                while (low != high)
+                    *vec++ = table_[static_cast<unsigned char>(*low++)];
+
+                return high;
             }
 
             const char_type* scan_is(mask m, const char_type* low,
                                      const char_type* high) const
             {
-                return do_scan_is(m, low, high);
+                while (low != high && !is(m, *low))
+                    ++low;
+
+                return low;
             }
 
             const char_type* scan_not(mask m, const char_type* low,
                                       const char_type* high) const
             {
-                return do_scan_not(m, low, high);
+                while (low != high && is(m, *low))
+                    ++low;
+
+                return low;
             }
 
             char_type toupper(char_type c) const
@@ -327,58 +343,26 @@ namespace std
             }
 
             static locale::id id;
-            static const size_t table_size{0};
+            static const size_t table_size{256};
 
             const mask* table() const noexcept
             {
-                return classic_table();
-            }
-
-            static const mask* classic_table() noexcept
-            {
-                return classic_table_;
-            }
-
-            ~ctype() = default;
-
-        protected:
-            virtual bool do_is(mask m, char_type c) const
-            {
-                // TODO: implement, this is a dummy
-                if ((m & space) != 0 && std::isspace(c))
-                    return true;
-                else if ((m & alpha) != 0 && std::isalpha(c))
-                    return true;
-                else if ((m & upper) != 0 && std::isupper(c))
-                    return true;
-                else if ((m & lower) != 0 && std::islower(c))
-                    return true;
-                else if ((m & digit) != 0 && std::isdigit(c))
-                    return true;
-                return false;
+                return table_;
             }
 
-            virtual const char_type* do_is(const char_type* low, const char_type* high,
-                                           mask* m) const
-            {
-                // TODO: implement
-                return high;
-            }
-
-            virtual const char_type* do_scan_is(mask m, const char_type* low,
-                                                const char_type* high) const
-            {
-                // TODO: implement
-                return high;
-            }
+            /**
+             * The table for the "C" locale, defined
+             * in locale.cpp.
+             */
+            static const mask* classic_table() noexcept;
 
-            virtual const char_type* do_scan_not(mask m, const char_type* low,
-                                                 const char_type* high) const
+            ~ctype()
             {
-                // TODO: implement
-                return high;
+                if (del_)
+                    delete[] table_;
             }
 
+        protected:
             virtual char_type do_toupper(char_type c) const
             {
                 return std::toupper(c);
@@ -386,7 +370,7 @@ namespace std
 
             virtual const char_type* do_toupper(char_type* low, const char_type* high) const
             {
-                while (low != high)
+                for (; low != high; ++low)
                     *low = std::toupper(*low);
 
                 return high;
@@ -399,7 +383,7 @@ namespace std
 
             virtual const char_type* do_tolower(char_type* low, const char_type* high) const
             {
-                while (low != high)
+                for (; low != high; ++low)
                     *low = std::tolower(*low);
 
                 return high;
@@ -434,7 +418,8 @@ namespace std
             }
 
         private:
-            static constexpr mask* classic_table_{nullptr};
+            const mask* table_;
+            bool del_;
     };
 
     template<>
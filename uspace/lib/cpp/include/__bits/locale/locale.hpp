@@ -145,20 +145,24 @@ namespace std
             }
 
             template<class Facet>
-            /* friend const Facet& use_facet(const locale&); */
-            friend Facet use_facet(const locale&);
+            friend const Facet& use_facet(const locale&);
 
             template<class Facet>
-            /* const Facet& get_() const */
-            Facet get_() const
+            const Facet& get_() const
             {
-                return Facet{0U};
+                /**
+                 * Facets are stateless and our single locale
+                 * has all of them, so one shared instance per
+                 * facet type is enough.
+                 */
+                static const Facet facet{0U};
+
+                return facet;
             }
     };
 
     template<class Facet>
-    /* const Facet& use_facet(const locale& loc) */
-    Facet use_facet(const locale& loc)
+    const Facet& use_facet(const locale& loc)
     {
         return loc.get_<Facet>();
     }
@@ -159,8 +159,7 @@ namespace std
                      * and the result is deduced.
                      */
 
-                    auto loc = base.getloc();
-                    const auto& nt = use_facet<numpunct<char_type>>(loc);
+                    const auto& nt = base.__numpunct<char_type>();
 
                     auto true_target = nt.truename();
                     auto false_target = nt.falsename();
@@ -341,8 +340,7 @@ namespace std
                 if (in == end)
                     return 0;
 
-                auto loc = base.getloc();
-                const auto& ct = use_facet<ctype<char_type>>(loc);
+                const auto& ct = base.__ctype<char_type>();
                 auto hex = ((base.flags() & ios_base::hex) != 0);
 
                 size_t i{};
@@ -96,14 +96,12 @@ namespace std
         protected:
             iter_type do_put(iter_type it, ios_base& base, char_type fill, bool v) const
             {
-                auto loc = base.getloc();
-
                 if ((base.flags() & ios_base::boolalpha) == 0)
                     return do_put(it, base, fill, (long)v);
                 else
                 {
-                    auto s = v ? use_facet<numpunct<char_type>>(loc).truename()
-                               : use_facet<numpunct<char_type>>(loc).falsename();
+                    const auto& punct = base.__numpunct<char_type>();
+                    auto s = v ? punct.truename() : punct.falsename();
                     for (auto c: s)
                         *it++ = c;
                 }
@@ -291,9 +289,8 @@ namespace std
 
             iter_type put_buffer_(iter_type it, ios_base& base, char_type fill, size_t start, size_t size) const
             {
-                const auto& loc = base.getloc();
-                const auto& ct = use_facet<ctype<char_type>>(loc);
-                const auto& punct = use_facet<numpunct<char_type>>(loc);
+                const auto& ct = base.__ctype<char_type>();
+                const auto& punct = base.__numpunct<char_type>();
 
                 for (size_t i = start; i < size; ++i)
                 {
@@ -30,7 +30,7 @@
 #define LIBCPP_BITS_LOCALE_NUMPUNCT
 
 #include <__bits/locale/locale.hpp>
-#include <string>
+#include <__bits/string/string.hpp>
 
 namespace std
 {
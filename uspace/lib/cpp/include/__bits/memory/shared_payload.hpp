@@ -129,18 +129,10 @@ namespace std::aux
 
             shared_payload_base<T>* lock() noexcept override
             {
-                refcount_t rfs = this->refs();
-                while (rfs != 0L)
-                {
-                    if (__atomic_compare_exchange_n(&this->refcount_, &rfs, rfs + 1,
-                                                    true, __ATOMIC_RELAXED,
-                                                    __ATOMIC_RELAXED))
-                    {
-                        return this;
-                    }
-                }
-
-                return nullptr;
+                if (this->increment_if_nonzero())
+                    return this;
+                else
+                    return nullptr;
             }
 
         private:
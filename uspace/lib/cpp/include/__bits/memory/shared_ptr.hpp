@@ -622,9 +622,79 @@ namespace std
 
     /**
      * 20.8.2.6, shared_ptr atomic access
+     * Note: We do not have memory_order, so the _explicit
+     *       variants are not provided.
      */
 
-    // TODO: implement
+    template<class T>
+    bool atomic_is_lock_free(const shared_ptr<T>*)
+    {
+        return false;
+    }
+
+    template<class T>
+    shared_ptr<T> atomic_load(const shared_ptr<T>* ptr)
+    {
+        aux::atomic_access_lock(ptr);
+        shared_ptr<T> res{*ptr};
+        aux::atomic_access_unlock(ptr);
+
+        return res;
+    }
+
+    template<class T>
+    void atomic_store(shared_ptr<T>* ptr, shared_ptr<T> desired)
+    {
+        aux::atomic_access_lock(ptr);
+        ptr->swap(desired);
+        aux::atomic_access_unlock(ptr);
+
+        /**
+         * The old value is released when desired goes
+         * out of scope, outside of the critical section,
+         * because its deleter might block.
+         */
+    }
+
+    template<class T>
+    shared_ptr<T> atomic_exchange(shared_ptr<T>* ptr, shared_ptr<T> desired)
+    {
+        aux::atomic_access_lock(ptr);
+        ptr->swap(desired);
+        aux::atomic_access_unlock(ptr);
+
+        return desired;
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong(shared_ptr<T>* ptr, shared_ptr<T>* expected,
+                                        shared_ptr<T> desired)
+    {
+        shared_ptr<T> old{};
+
+        aux::atomic_access_lock(ptr);
+        bool equivalent = ptr->get() == expected->get() &&
+                          !ptr->owner_before(*expected) &&
+                          !expected->owner_before(*ptr);
+
+        if (equivalent)
+            ptr->swap(desired);
+        else
+        {
+            old.swap(*expected);
+            *expected = *ptr;
+        }
+        aux::atomic_access_unlock(ptr);
+
+        return equivalent;
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak(shared_ptr<T>* ptr, shared_ptr<T>* expected,
+                                      shared_ptr<T> desired)
+    {
+        return atomic_compare_exchange_strong(ptr, expected, move(desired));
+    }
 
     /**
      * 20.8.2.7, smart pointer hash support:
@@ -643,4 +713,78 @@ namespace std
     };
 }
 
+namespace std::experimental
+{
+    /**
+     * Concurrency TS atomic_shared_ptr, stands in for
+     * atomic<shared_ptr<T>> until we have <atomic>.
+     */
+
+    template<class T>
+    class atomic_shared_ptr
+    {
+        public:
+            using value_type = shared_ptr<T>;
+
+            constexpr atomic_shared_ptr() noexcept = default;
+
+            atomic_shared_ptr(shared_ptr<T> desired) noexcept
+                : value_{move(desired)}
+            { /* DUMMY BODY */ }
+
+            atomic_shared_ptr(const atomic_shared_ptr&) = delete;
+
+            atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
+
+            void operator=(shared_ptr<T> desired) noexcept
+            {
+                store(move(desired));
+            }
+
+            bool is_lock_free() const noexcept
+            {
+                return false;
+            }
+
+            void store(shared_ptr<T> desired) noexcept
+            {
+                atomic_store(&value_, move(desired));
+            }
+
+            shared_ptr<T> load() const noexcept
+            {
+                return atomic_load(&value_);
+            }
+
+            operator shared_ptr<T>() const noexcept
+            {
+                return load();
+            }
+
+            shared_ptr<T> exchange(shared_ptr<T> desired) noexcept
+            {
+                return atomic_exchange(&value_, move(desired));
+            }
+
+            bool compare_exchange_weak(shared_ptr<T>& expected,
+                                       shared_ptr<T> desired) noexcept
+            {
+                return atomic_compare_exchange_weak(
+                    &value_, &expected, move(desired)
+                );
+            }
+
+            bool compare_exchange_strong(shared_ptr<T>& expected,
+                                         shared_ptr<T> desired) noexcept
+            {
+                return atomic_compare_exchange_strong(
+                    &value_, &expected, move(desired)
+                );
+            }
+
+        private:
+            shared_ptr<T> value_;
+    };
+}
+
 #endif
@@ -53,6 +53,30 @@ using new_handler = void (*)();
 new_handler set_new_handler(new_handler);
 new_handler get_new_handler() noexcept;
 
+namespace aux
+{
+
+/**
+ * Allocation statistics gathered by the global
+ * operator new and operator delete, used by the
+ * benchmarks in std::test.
+ */
+struct allocation_counters
+{
+	size_t allocations;
+	size_t deallocations;
+	size_t bytes;
+};
+
+/**
+ * Makes the global operator new and operator delete
+ * update the given counters, nullptr turns counting off.
+ * Returns the previously installed counters.
+ */
+allocation_counters* set_allocation_counters(allocation_counters*) noexcept;
+
+}
+
 }
 
 void* operator new(std::size_t);
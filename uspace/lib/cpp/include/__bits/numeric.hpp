@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_NUMERIC
 #define LIBCPP_BITS_NUMERIC
 
+#include <iterator>
 #include <utility>
 
 namespace std
@@ -123,6 +124,111 @@ namespace std
         return result;
     }
 
+    /**
+     * 29.8.3, reduce:
+     */
+
+    template<class InputIterator, class T, class BinaryOperation>
+    T reduce(InputIterator first, InputIterator last, T init,
+             BinaryOperation op)
+    {
+        auto acc{init};
+        while (first != last)
+            acc = op(acc, *first++);
+
+        return acc;
+    }
+
+    template<class InputIterator, class T>
+    T reduce(InputIterator first, InputIterator last, T init)
+    {
+        auto acc{init};
+        while (first != last)
+            acc = acc + *first++;
+
+        return acc;
+    }
+
+    template<class InputIterator>
+    typename iterator_traits<InputIterator>::value_type
+    reduce(InputIterator first, InputIterator last)
+    {
+        using value_type = typename iterator_traits<InputIterator>::value_type;
+
+        return reduce(first, last, value_type{});
+    }
+
+    /**
+     * 29.8.5, transform reduce:
+     */
+
+    template<class InputIterator1, class InputIterator2, class T,
+             class BinaryOperation1, class BinaryOperation2>
+    T transform_reduce(InputIterator1 first1, InputIterator1 last1,
+                       InputIterator2 first2, T init,
+                       BinaryOperation1 op1, BinaryOperation2 op2)
+    {
+        auto acc{init};
+        while (first1 != last1)
+            acc = op1(acc, op2(*first1++, *first2++));
+
+        return acc;
+    }
+
+    template<class InputIterator1, class InputIterator2, class T>
+    T transform_reduce(InputIterator1 first1, InputIterator1 last1,
+                       InputIterator2 first2, T init)
+    {
+        auto acc{init};
+        while (first1 != last1)
+            acc = acc + (*first1++) * (*first2++);
+
+        return acc;
+    }
+
+    template<class InputIterator, class T,
+             class BinaryOperation, class UnaryOperation>
+    T transform_reduce(InputIterator first, InputIterator last, T init,
+                       BinaryOperation op, UnaryOperation conv)
+    {
+        auto acc{init};
+        while (first != last)
+            acc = op(acc, conv(*first++));
+
+        return acc;
+    }
+
+    /**
+     * 29.8.8, inclusive scan:
+     */
+
+    template<class InputIterator, class OutputIterator,
+             class BinaryOperation, class T>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                  OutputIterator result, BinaryOperation op,
+                                  T init)
+    {
+        auto acc{init};
+        while (first != last)
+            *result++ = acc = op(acc, *first++);
+
+        return result;
+    }
+
+    template<class InputIterator, class OutputIterator, class BinaryOperation>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                  OutputIterator result, BinaryOperation op)
+    {
+        return partial_sum(first, last, result, op);
+    }
+
+    template<class InputIterator, class OutputIterator>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last,
+                                  OutputIterator result)
+    {
+        return partial_sum(first, last, result);
+    }
+
     /**
      * 26.7.5, adjacent difference:
      */
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_PARALLEL_ALGORITHM
+#define LIBCPP_BITS_PARALLEL_ALGORITHM
+
+#include <__bits/algorithm.hpp>
+#include <__bits/execution.hpp>
+#include <__bits/numeric.hpp>
+#include <__bits/adt/vector.hpp>
+#include <iterator>
+
+/**
+ * Overloads of the algorithms taking an execution policy. The parallel
+ * policies split the range into one chunk per worker and process the
+ * chunks in parallel, par and par_unseq are treated the same. Ranges
+ * that are not random access, or too small to be worth splitting, are
+ * processed sequentially.
+ */
+
+namespace std
+{
+    namespace aux
+    {
+        template<class Iterator>
+        inline constexpr bool is_random_access_v = is_same_v<
+            typename iterator_traits<Iterator>::iterator_category,
+            random_access_iterator_tag
+        >;
+
+        template<class ExecutionPolicy, class... Iterators>
+        inline constexpr bool is_parallel_v =
+            !is_same_v<decay_t<ExecutionPolicy>, execution::sequenced_policy> &&
+            (is_random_access_v<Iterators> && ...);
+
+        template<class ExecutionPolicy, class R>
+        using enable_if_policy_t = enable_if_t<
+            is_execution_policy_v<decay_t<ExecutionPolicy>>, R
+        >;
+    }
+
+    /**
+     * 25.2.4, for_each:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator, class Function>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    for_each(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+             Function f)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator>)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto body = [&](size_t b, size_t e, size_t) {
+                for_each(first + b, first + e, f);
+            };
+
+            aux::parallel_for(count, aux::parallel_chunks(count), body);
+        }
+        else
+            for_each(first, last, f);
+    }
+
+    /**
+     * 25.3.1, copy:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator2>
+    copy(ExecutionPolicy&&, ForwardIterator1 first, ForwardIterator1 last,
+         ForwardIterator2 result)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator1, ForwardIterator2>)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto body = [&](size_t b, size_t e, size_t) {
+                copy(first + b, first + e, result + b);
+            };
+
+            aux::parallel_for(count, aux::parallel_chunks(count), body);
+
+            return result + count;
+        }
+        else
+            return copy(first, last, result);
+    }
+
+    /**
+     * 25.3.4, transform:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator1,
+             class ForwardIterator2, class UnaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator2>
+    transform(ExecutionPolicy&&, ForwardIterator1 first, ForwardIterator1 last,
+              ForwardIterator2 result, UnaryOperation op)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator1, ForwardIterator2>)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto body = [&](size_t b, size_t e, size_t) {
+                transform(first + b, first + e, result + b, op);
+            };
+
+            aux::parallel_for(count, aux::parallel_chunks(count), body);
+
+            return result + count;
+        }
+        else
+            return transform(first, last, result, op);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+             class ForwardIterator3, class BinaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator3>
+    transform(ExecutionPolicy&&, ForwardIterator1 first1, ForwardIterator1 last1,
+              ForwardIterator2 first2, ForwardIterator3 result, BinaryOperation op)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator1,
+                                         ForwardIterator2, ForwardIterator3>)
+        {
+            auto count = static_cast<size_t>(last1 - first1);
+            auto body = [&](size_t b, size_t e, size_t) {
+                transform(first1 + b, first1 + e, first2 + b, result + b, op);
+            };
+
+            aux::parallel_for(count, aux::parallel_chunks(count), body);
+
+            return result + count;
+        }
+        else
+            return transform(first1, last1, first2, result, op);
+    }
+
+    /**
+     * 25.3.6, fill:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator, class T>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    fill(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+         const T& value)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator>)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto body = [&](size_t b, size_t e, size_t) {
+                fill(first + b, first + e, value);
+            };
+
+            aux::parallel_for(count, aux::parallel_chunks(count), body);
+        }
+        else
+            fill(first, last, value);
+    }
+
+    /**
+     * 25.4.1.1, sort:
+     */
+
+    template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    sort(ExecutionPolicy&&, RandomAccessIterator first,
+         RandomAccessIterator last, Compare comp)
+    {
+        auto count = static_cast<size_t>(last - first);
+        auto chunks = aux::parallel_chunks(count);
+
+        if (!aux::is_parallel_v<ExecutionPolicy, RandomAccessIterator> || chunks <= 1)
+        {
+            sort(first, last, comp);
+
+            return;
+        }
+
+        /**
+         * Sort the chunks independently and then merge
+         * neighbouring runs pairwise, bouncing between
+         * the range and a buffer, until one run remains.
+         */
+        auto sort_chunk = [&](size_t b, size_t e, size_t) {
+            sort(first + b, first + e, comp);
+        };
+        aux::parallel_for(count, chunks, sort_chunk);
+
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+        vector<value_type> buffer(make_move_iterator(first), make_move_iterator(last));
+
+        vector<size_t> bounds{};
+        for (size_t i = 0; i <= chunks; ++i)
+            bounds.push_back(count * i / chunks);
+
+        bool in_buffer{true};
+        while (bounds.size() > 2)
+        {
+            auto runs = bounds.size() - 1;
+            auto merge_run = [&](size_t b, size_t e, size_t) {
+                for (auto pair = b; pair < e; ++pair)
+                {
+                    auto lo = bounds[2 * pair];
+                    auto mid = bounds[2 * pair + 1];
+                    auto hi = (2 * pair + 2 < bounds.size()) ? bounds[2 * pair + 2] : mid;
+
+                    if (in_buffer)
+                    {
+                        merge(
+                            make_move_iterator(buffer.begin() + lo),
+                            make_move_iterator(buffer.begin() + mid),
+                            make_move_iterator(buffer.begin() + mid),
+                            make_move_iterator(buffer.begin() + hi),
+                            first + lo, comp
+                        );
+                    }
+                    else
+                    {
+                        merge(
+                            make_move_iterator(first + lo),
+                            make_move_iterator(first + mid),
+                            make_move_iterator(first + mid),
+                            make_move_iterator(first + hi),
+                            buffer.begin() + lo, comp
+                        );
+                    }
+                }
+            };
+
+            auto pairs = (runs + 1) / 2;
+            aux::parallel_for(pairs, pairs, merge_run);
+
+            vector<size_t> merged{};
+            for (size_t i = 0; i < bounds.size(); i += 2)
+                merged.push_back(bounds[i]);
+            if (merged.back() != count)
+                merged.push_back(count);
+
+            bounds = move(merged);
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+        {
+            auto move_back = [&](size_t b, size_t e, size_t) {
+                move(buffer.begin() + b, buffer.begin() + e, first + b);
+            };
+
+            aux::parallel_for(count, chunks, move_back);
+        }
+    }
+
+    template<class ExecutionPolicy, class RandomAccessIterator>
+    aux::enable_if_policy_t<ExecutionPolicy, void>
+    sort(ExecutionPolicy&& policy, RandomAccessIterator first,
+         RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        sort(forward<ExecutionPolicy>(policy), first, last, less<value_type>{});
+    }
+
+    /**
+     * 29.8.3, reduce:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator, class T,
+             class BinaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    reduce(ExecutionPolicy&&, ForwardIterator first, ForwardIterator last,
+           T init, BinaryOperation op)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator>)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto chunks = aux::parallel_chunks(count);
+            if (chunks <= 1)
+                return reduce(first, last, init, op);
+
+            vector<T> partial(chunks, init);
+            auto body = [&](size_t b, size_t e, size_t idx) {
+                partial[idx] = reduce(first + b + 1, first + e, T(first[b]), op);
+            };
+            aux::parallel_for(count, chunks, body);
+
+            return reduce(partial.begin(), partial.end(), init, op);
+        }
+        else
+            return reduce(first, last, init, op);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator, class T>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    reduce(ExecutionPolicy&& policy, ForwardIterator first,
+           ForwardIterator last, T init)
+    {
+        return reduce(
+            forward<ExecutionPolicy>(policy), first, last, init,
+            [](const T& lhs, const T& rhs) { return lhs + rhs; }
+        );
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator>
+    aux::enable_if_policy_t<
+        ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type
+    >
+    reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last)
+    {
+        using value_type = typename iterator_traits<ForwardIterator>::value_type;
+
+        return reduce(forward<ExecutionPolicy>(policy), first, last, value_type{});
+    }
+
+    /**
+     * 29.8.5, transform reduce:
+     */
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+             class T, class BinaryOperation1, class BinaryOperation2>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    transform_reduce(ExecutionPolicy&&, ForwardIterator1 first1,
+                     ForwardIterator1 last1, ForwardIterator2 first2, T init,
+                     BinaryOperation1 op1, BinaryOperation2 op2)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator1, ForwardIterator2>)
+        {
+            auto count = static_cast<size_t>(last1 - first1);
+            auto chunks = aux::parallel_chunks(count);
+            if (chunks <= 1)
+                return transform_reduce(first1, last1, first2, init, op1, op2);
+
+            vector<T> partial(chunks, init);
+            auto body = [&](size_t b, size_t e, size_t idx) {
+                partial[idx] = transform_reduce(
+                    first1 + b + 1, first1 + e, first2 + b + 1,
+                    T(op2(first1[b], first2[b])), op1, op2
+                );
+            };
+            aux::parallel_for(count, chunks, body);
+
+            return reduce(partial.begin(), partial.end(), init, op1);
+        }
+        else
+            return transform_reduce(first1, last1, first2, init, op1, op2);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1,
+             class ForwardIterator2, class T>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1,
+                     ForwardIterator1 last1, ForwardIterator2 first2, T init)
+    {
+        return transform_reduce(
+            forward<ExecutionPolicy>(policy), first1, last1, first2, init,
+            [](const T& lhs, const T& rhs) { return lhs + rhs; },
+            [](const auto& lhs, const auto& rhs) { return lhs * rhs; }
+        );
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator, class T,
+             class BinaryOperation, class UnaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, T>
+    transform_reduce(ExecutionPolicy&&, ForwardIterator first,
+                     ForwardIterator last, T init, BinaryOperation op,
+                     UnaryOperation conv)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator>)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto chunks = aux::parallel_chunks(count);
+            if (chunks <= 1)
+                return transform_reduce(first, last, init, op, conv);
+
+            vector<T> partial(chunks, init);
+            auto body = [&](size_t b, size_t e, size_t idx) {
+                partial[idx] = transform_reduce(
+                    first + b + 1, first + e, T(conv(first[b])), op, conv
+                );
+            };
+            aux::parallel_for(count, chunks, body);
+
+            return reduce(partial.begin(), partial.end(), init, op);
+        }
+        else
+            return transform_reduce(first, last, init, op, conv);
+    }
+
+    /**
+     * 29.8.8, inclusive scan:
+     */
+
+    namespace aux
+    {
+        /**
+         * Three pass scan: scan the chunks independently,
+         * combine the chunk totals sequentially and then add
+         * the total of all preceding chunks to every element.
+         */
+        template<class ForwardIterator1, class ForwardIterator2,
+                 class BinaryOperation, class T>
+        ForwardIterator2 parallel_inclusive_scan(
+            ForwardIterator1 first, ForwardIterator1 last,
+            ForwardIterator2 result, BinaryOperation op, const T* init)
+        {
+            auto count = static_cast<size_t>(last - first);
+            auto chunks = parallel_chunks(count);
+
+            if (chunks <= 1)
+            {
+                if (init)
+                    return inclusive_scan(first, last, result, op, *init);
+                else
+                    return inclusive_scan(first, last, result, op);
+            }
+
+            auto scan_chunk = [&](size_t b, size_t e, size_t idx) {
+                if (idx == 0 && init)
+                    inclusive_scan(first + b, first + e, result + b, op, *init);
+                else
+                    inclusive_scan(first + b, first + e, result + b, op);
+            };
+            parallel_for(count, chunks, scan_chunk);
+
+            using value_type = typename iterator_traits<ForwardIterator2>::value_type;
+            vector<value_type> offsets{};
+            offsets.reserve(chunks);
+
+            value_type carry = result[count / chunks - 1];
+            offsets.push_back(carry);
+            for (size_t i = 1; i < chunks - 1; ++i)
+            {
+                carry = op(carry, result[count * (i + 1) / chunks - 1]);
+                offsets.push_back(carry);
+            }
+
+            auto add_offset = [&](size_t b, size_t e, size_t idx) {
+                if (idx == 0)
+                    return;
+
+                const auto& offset = offsets[idx - 1];
+                for (auto it = result + b; it != result + e; ++it)
+                    *it = op(offset, *it);
+            };
+            parallel_for(count, chunks, add_offset);
+
+            return result + count;
+        }
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+             class BinaryOperation, class T>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator2>
+    inclusive_scan(ExecutionPolicy&&, ForwardIterator1 first,
+                   ForwardIterator1 last, ForwardIterator2 result,
+                   BinaryOperation op, T init)
+    {
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator1, ForwardIterator2>)
+            return aux::parallel_inclusive_scan(first, last, result, op, &init);
+        else
+            return inclusive_scan(first, last, result, op, init);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+             class BinaryOperation>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator2>
+    inclusive_scan(ExecutionPolicy&&, ForwardIterator1 first,
+                   ForwardIterator1 last, ForwardIterator2 result,
+                   BinaryOperation op)
+    {
+        using value_type = typename iterator_traits<ForwardIterator2>::value_type;
+
+        if constexpr (aux::is_parallel_v<ExecutionPolicy, ForwardIterator1, ForwardIterator2>)
+        {
+            return aux::parallel_inclusive_scan(
+                first, last, result, op, static_cast<const value_type*>(nullptr)
+            );
+        }
+        else
+            return inclusive_scan(first, last, result, op);
+    }
+
+    template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+    aux::enable_if_policy_t<ExecutionPolicy, ForwardIterator2>
+    inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first,
+                   ForwardIterator1 last, ForwardIterator2 result)
+    {
+        using value_type = typename iterator_traits<ForwardIterator2>::value_type;
+
+        return inclusive_scan(
+            forward<ExecutionPolicy>(policy), first, last, result,
+            [](const value_type& lhs, const value_type& rhs) { return lhs + rhs; }
+        );
+    }
+}
+
+#endif
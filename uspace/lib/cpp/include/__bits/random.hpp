@@ -34,8 +34,12 @@
 #include <cstdlib>
 #include <ctime>
 #include <initializer_list>
+#include <istream>
 #include <limits>
+#include <ostream>
+#include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
@@ -999,51 +1003,417 @@ namespace std
     using default_random_engine = minstd_rand0;
 
     /**
-     * 26.5.6, class random_device:
+     * Extensions: Small and fast non-cryptographic engines,
+     * xoshiro256** by Blackman and Vigna and PCG64 (XSL RR
+     * 128/64) by O'Neill. Both have 64bit output, a state
+     * of 256 and 128 bits respectively, are cheap to seed
+     * and pass the usual statistical test batteries,
+     * which makes them a better default than mt19937.
      */
 
-    class random_device
+    namespace aux
     {
-        using result_type = unsigned int;
+        inline constexpr uint64_t rotl64(uint64_t x, int k)
+        {
+            return (x << k) | (x >> ((64 - k) & 63));
+        }
 
-        static constexpr result_type min()
+        inline constexpr uint64_t rotr64(uint64_t x, int k)
         {
-            return numeric_limits<result_type>::min();
+            return (x >> k) | (x << ((64 - k) & 63));
         }
 
-        static constexpr result_type max()
+        /**
+         * Used to expand a single 64bit seed into the
+         * state of the engines below.
+         */
+        inline uint64_t splitmix64(uint64_t& x)
         {
-            return numeric_limits<result_type>::max();
+            uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+            return z ^ (z >> 31);
         }
 
-        explicit random_device(const string& token = "")
+        template<class Seq>
+        void seed_seq_to_u64(Seq& q, uint64_t* res, size_t n)
         {
-            /**
-             * Note: token can be used to choose between
-             *       random generators, but HelenOS only
-             *       has one :/
-             *       Also note that it is implementation
-             *       defined how this class generates
-             *       random numbers and I decided to use
-             *       time seeding with C stdlib random,
-             *       - feel free to change it if you know
-             *       something better.
-             */
-            ::srand(::time(nullptr));
+            uint_least32_t arr[8]{};
+            q.generate(arr, arr + 2 * n);
+
+            for (size_t i = 0; i < n; ++i)
+                res[i] = (static_cast<uint64_t>(arr[2 * i + 1]) << 32) | arr[2 * i];
         }
 
-        result_type operator()()
+        /**
+         * Minimal unsigned 128bit arithmetic for the
+         * PCG engine, uses the compiler's type where
+         * available (64bit targets).
+         */
+        struct uint128
+        {
+            uint64_t hi;
+            uint64_t lo;
+
+            bool operator==(const uint128& rhs) const
+            {
+                return hi == rhs.hi && lo == rhs.lo;
+            }
+        };
+
+        inline uint128 add128(uint128 x, uint128 y)
         {
-            return ::rand();
+            uint128 res{x.hi + y.hi, x.lo + y.lo};
+            if (res.lo < x.lo)
+                ++res.hi;
+
+            return res;
         }
 
-        double entropy() const noexcept
+        inline uint128 mul128(uint128 x, uint128 y)
         {
-            return 0.0;
+#ifdef __SIZEOF_INT128__
+            auto xx = (static_cast<unsigned __int128>(x.hi) << 64) | x.lo;
+            auto yy = (static_cast<unsigned __int128>(y.hi) << 64) | y.lo;
+            auto res = xx * yy;
+
+            return uint128{static_cast<uint64_t>(res >> 64), static_cast<uint64_t>(res)};
+#else
+            uint64_t x0 = x.lo & 0xffffffffULL, x1 = x.lo >> 32;
+            uint64_t y0 = y.lo & 0xffffffffULL, y1 = y.lo >> 32;
+
+            uint64_t p00 = x0 * y0;
+            uint64_t p01 = x0 * y1;
+            uint64_t p10 = x1 * y0;
+            uint64_t p11 = x1 * y1;
+
+            uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffULL) + (p10 & 0xffffffffULL);
+            uint64_t lo = (mid << 32) | (p00 & 0xffffffffULL);
+            uint64_t hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+
+            return uint128{hi + x.hi * y.lo + x.lo * y.hi, lo};
+#endif
         }
+    }
+
+    namespace experimental
+    {
+        class xoshiro256starstar
+        {
+            public:
+                using result_type = uint64_t;
+
+                static constexpr result_type min()
+                {
+                    return numeric_limits<result_type>::min();
+                }
+
+                static constexpr result_type max()
+                {
+                    return numeric_limits<result_type>::max();
+                }
+
+                static constexpr result_type default_seed = 0x853c49e6748fea9bULL;
+
+                explicit xoshiro256starstar(result_type s = default_seed)
+                    : state_{}
+                {
+                    seed(s);
+                }
+
+                template<
+                    class Seq,
+                    class = enable_if_t<aux::is_seed_sequence_v<Seq, result_type>>
+                >
+                explicit xoshiro256starstar(Seq& q)
+                    : state_{}
+                {
+                    seed(q);
+                }
+
+                void seed(result_type s = default_seed)
+                {
+                    for (auto& x: state_)
+                        x = aux::splitmix64(s);
+                }
+
+                template<
+                    class Seq,
+                    class = enable_if_t<aux::is_seed_sequence_v<Seq, result_type>>
+                >
+                void seed(Seq& q)
+                {
+                    aux::seed_seq_to_u64(q, state_, 4);
+
+                    // The all zero state is a fixed point.
+                    if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0)
+                        seed();
+                }
+
+                result_type operator()()
+                {
+                    auto res = aux::rotl64(state_[1] * 5, 7) * 9;
+                    auto t = state_[1] << 17;
+
+                    state_[2] ^= state_[0];
+                    state_[3] ^= state_[1];
+                    state_[1] ^= state_[2];
+                    state_[0] ^= state_[3];
+                    state_[2] ^= t;
+                    state_[3] = aux::rotl64(state_[3], 45);
+
+                    return res;
+                }
+
+                /**
+                 * Fills [first, last) with raw output, keeping
+                 * the state in registers for the whole loop.
+                 */
+                template<class ForwardIterator>
+                void generate(ForwardIterator first, ForwardIterator last)
+                {
+                    auto copy = *this;
+                    while (first != last)
+                        *first++ = copy();
+                    *this = copy;
+                }
+
+                void discard(unsigned long long z)
+                {
+                    for (unsigned long long i = 0ULL; i < z; ++i)
+                        (*this)();
+                }
+
+                /**
+                 * Equivalent to 2^128 calls to operator(), used
+                 * to get non-overlapping sequences for parallel
+                 * computations.
+                 */
+                void jump()
+                {
+                    static constexpr uint64_t poly[] = {
+                        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+                    };
+
+                    uint64_t res[4]{};
+                    for (auto p: poly)
+                    {
+                        for (int b = 0; b < 64; ++b)
+                        {
+                            if (p & (1ULL << b))
+                            {
+                                for (size_t i = 0; i < 4; ++i)
+                                    res[i] ^= state_[i];
+                            }
+                            (*this)();
+                        }
+                    }
+
+                    for (size_t i = 0; i < 4; ++i)
+                        state_[i] = res[i];
+                }
+
+                bool operator==(const xoshiro256starstar& rhs) const
+                {
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        if (state_[i] != rhs.state_[i])
+                            return false;
+                    }
+
+                    return true;
+                }
+
+                bool operator!=(const xoshiro256starstar& rhs) const
+                {
+                    return !(*this == rhs);
+                }
+
+            private:
+                uint64_t state_[4];
+        };
+
+        class pcg64
+        {
+            public:
+                using result_type = uint64_t;
+
+                static constexpr result_type min()
+                {
+                    return numeric_limits<result_type>::min();
+                }
+
+                static constexpr result_type max()
+                {
+                    return numeric_limits<result_type>::max();
+                }
+
+                static constexpr result_type default_seed = 0xcafef00dd15ea5e5ULL;
+
+                explicit pcg64(result_type s = default_seed)
+                    : state_{}, inc_{default_increment_}
+                {
+                    seed(s);
+                }
+
+                template<
+                    class Seq,
+                    class = enable_if_t<aux::is_seed_sequence_v<Seq, result_type>>
+                >
+                explicit pcg64(Seq& q)
+                    : state_{}, inc_{default_increment_}
+                {
+                    seed(q);
+                }
+
+                void seed(result_type s = default_seed)
+                {
+                    seed_(aux::uint128{0, s});
+                }
 
-        random_device(const random_device&) = delete;
-        random_device& operator=(const random_device&) = delete;
+                template<
+                    class Seq,
+                    class = enable_if_t<aux::is_seed_sequence_v<Seq, result_type>>
+                >
+                void seed(Seq& q)
+                {
+                    uint64_t tmp[2]{};
+                    aux::seed_seq_to_u64(q, tmp, 2);
+
+                    seed_(aux::uint128{tmp[0], tmp[1]});
+                }
+
+                result_type operator()()
+                {
+                    step_();
+
+                    auto rot = static_cast<int>(state_.hi >> 58);
+
+                    return aux::rotr64(state_.hi ^ state_.lo, rot);
+                }
+
+                template<class ForwardIterator>
+                void generate(ForwardIterator first, ForwardIterator last)
+                {
+                    auto copy = *this;
+                    while (first != last)
+                        *first++ = copy();
+                    *this = copy;
+                }
+
+                void discard(unsigned long long z)
+                {
+                    for (unsigned long long i = 0ULL; i < z; ++i)
+                        step_();
+                }
+
+                bool operator==(const pcg64& rhs) const
+                {
+                    return state_ == rhs.state_ && inc_ == rhs.inc_;
+                }
+
+                bool operator!=(const pcg64& rhs) const
+                {
+                    return !(*this == rhs);
+                }
+
+            private:
+                aux::uint128 state_;
+                aux::uint128 inc_;
+
+                static constexpr aux::uint128 multiplier_{
+                    0x2360ed051fc65da4ULL, 0x4385df649fccf645ULL
+                };
+
+                static constexpr aux::uint128 default_increment_{
+                    0x5851f42d4c957f2dULL, 0x14057b7ef767814fULL
+                };
+
+                void step_()
+                {
+                    state_ = aux::add128(aux::mul128(state_, multiplier_), inc_);
+                }
+
+                void seed_(aux::uint128 s)
+                {
+                    state_ = aux::uint128{0, 0};
+                    step_();
+                    state_ = aux::add128(state_, s);
+                    step_();
+                }
+        };
+    }
+
+    /**
+     * 26.5.6, class random_device:
+     */
+
+    class random_device
+    {
+        public:
+            using result_type = unsigned int;
+
+            static constexpr result_type min()
+            {
+                return numeric_limits<result_type>::min();
+            }
+
+            static constexpr result_type max()
+            {
+                return numeric_limits<result_type>::max();
+            }
+
+            /**
+             * Note: The token can be "hw" to require the
+             *       hardware generator (RDSEED/RDRAND on x86),
+             *       "sw" to use the software fallback or
+             *       empty to use the best available source.
+             *       If the hardware generator is required but
+             *       not present, the fallback is used and
+             *       entropy() returns 0.
+             */
+            explicit random_device(const string& token = "");
+
+            result_type operator()();
+
+            /**
+             * Extension: Fills [first, last) with random
+             * numbers, avoiding per call overhead.
+             */
+            template<class ForwardIterator>
+            void generate(ForwardIterator first, ForwardIterator last)
+            {
+                result_type buf[64];
+                while (first != last)
+                {
+                    fill_(buf, 64);
+                    for (size_t i = 0; i < 64 && first != last; ++i)
+                        *first++ = buf[i];
+                }
+            }
+
+            double entropy() const noexcept;
+
+            random_device(const random_device&) = delete;
+            random_device& operator=(const random_device&) = delete;
+
+        private:
+            bool hardware_;
+            bool seeded_;
+
+            void fill_(result_type*, size_t);
+
+            /**
+             * The software fallback is xoshiro256** seeded
+             * from the cycle counter, uptime, task id and
+             * address space layout, it is unpredictable enough
+             * to give different processes different sequences,
+             * but does not have any guaranteed entropy. It is
+             * only seeded when first used.
+             */
+            experimental::xoshiro256starstar fallback_;
     };
 
     /**
@@ -1201,6 +1571,20 @@ namespace std
                 return g() % range + p.first;
             }
 
+            /**
+             * Extension: Fills [first, last) with values
+             * from the distribution.
+             */
+            template<class ForwardIterator, class URNG>
+            void generate(ForwardIterator first, ForwardIterator last, URNG& g)
+            {
+                auto range = b_ - a_ + 1;
+                auto a = a_;
+
+                while (first != last)
+                    *first++ = g() % range + a;
+            }
+
             result_type a() const
             {
                 return a_;
@@ -1298,7 +1682,7 @@ namespace std
             template<class URNG>
             result_type operator()(URNG& g)
             {
-                auto range = b_ - a_ + 1;
+                auto range = b_ - a_;
 
                 return generate_canonical<
                     result_type, numeric_limits<result_type>::digits
@@ -1308,13 +1692,27 @@ namespace std
             template<class URNG>
             result_type operator()(URNG& g, const param_type& p)
             {
-                auto range = p.second - p.first + 1;
+                auto range = p.second - p.first;
 
                 return generate_canonical<
                     result_type, numeric_limits<result_type>::digits
                 >(g) * range + p.first;
             }
 
+            template<class ForwardIterator, class URNG>
+            void generate(ForwardIterator first, ForwardIterator last, URNG& g)
+            {
+                auto range = b_ - a_;
+                auto a = a_;
+
+                while (first != last)
+                {
+                    *first++ = generate_canonical<
+                        result_type, numeric_limits<result_type>::digits
+                    >(g) * range + a;
+                }
+            }
+
             result_type a() const
             {
                 return a_;
@@ -1424,6 +1822,16 @@ namespace std
                 return dist(p) < prob_;
             }
 
+            template<class ForwardIterator, class URNG>
+            void generate(ForwardIterator first, ForwardIterator last, URNG& g)
+            {
+                uniform_real_distribution<float> dist{};
+                auto prob = prob_;
+
+                while (first != last)
+                    *first++ = dist(g) < prob;
+            }
+
             double p() const
             {
                 return prob_;
@@ -37,6 +37,22 @@ namespace std::aux
      */
     using refcount_t = long;
 
+    /**
+     * Following libstdc++'s __gthread_active_p, refcounts
+     * are only updated atomically once the task may run
+     * fibrils in more than one thread. Fibrils sharing
+     * a single thread cannot interrupt a refcount update.
+     */
+    bool threads_active() noexcept;
+
+    /**
+     * Striped spinlocks used to implement the atomic access
+     * functions of types that are not lock free (shared_ptr).
+     * Critical sections must not block or yield.
+     */
+    void atomic_access_lock(const void*) noexcept;
+    void atomic_access_unlock(const void*) noexcept;
+
     class refcount_obj
     {
         public:
@@ -46,6 +62,7 @@ namespace std::aux
             void increment_weak() noexcept;
             bool decrement() noexcept;
             bool decrement_weak() noexcept;
+            bool increment_if_nonzero() noexcept;
             refcount_t refs() const noexcept;
             refcount_t weak_refs() const noexcept;
             bool expired() const noexcept;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_TEST_BENCHMARK
+#define LIBCPP_BITS_TEST_BENCHMARK
+
+#include <__bits/new.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    /**
+     * Base class for benchmark suites. Every benchmark is
+     * first run once to warm up caches and the allocator,
+     * then the number of iterations per sample is doubled
+     * until one sample takes at least min_sample_time and
+     * finally a fixed number of samples is measured.
+     */
+    class benchmark_suite
+    {
+        public:
+            virtual void run() = 0;
+            virtual const char* name() = 0;
+
+            virtual ~benchmark_suite() = default;
+
+            void set_csv(FILE*);
+
+            void set_samples(size_t);
+
+            unsigned int get_count() const noexcept;
+
+            /**
+             * Prevents the compiler from optimizing
+             * away computations whose results are
+             * otherwise unused.
+             */
+            template<class T>
+            static void keep(T&& value)
+            {
+                asm volatile ("" : : "g" (&value) : "memory");
+            }
+
+        protected:
+            using clock = chrono::high_resolution_clock;
+
+            static constexpr chrono::nanoseconds min_sample_time{10'000'000};
+            static constexpr size_t max_iterations{1 << 20};
+
+            struct result
+            {
+                size_t iterations;
+                int64_t min_nanos;
+                int64_t median_nanos;
+                int64_t p99_nanos;
+
+                /**
+                 * Totals over all measured operations,
+                 * not including the warm-up and calibration.
+                 */
+                size_t operations;
+                size_t allocations;
+                size_t bytes;
+            };
+
+            /**
+             * Measures fn, which performs one operation
+             * on a workload of the given size.
+             */
+            template<class Function>
+            result bench(const char* bname, size_t size, Function&& fn)
+            {
+                // Warm-up.
+                auto warmup = measure(fn, 1);
+                csv_entry(bname, -1, size, warmup);
+
+                size_t iterations{1};
+                while (iterations < max_iterations)
+                {
+                    if (measure(fn, iterations) >= min_sample_time.count())
+                        break;
+                    iterations *= 2;
+                }
+
+                vector<int64_t> times{};
+                times.reserve(samples_);
+
+                aux::allocation_counters counters{};
+                auto old = aux::set_allocation_counters(&counters);
+                for (size_t i = 0; i < samples_; ++i)
+                {
+                    auto elapsed = measure(fn, iterations);
+                    times.push_back(elapsed);
+                    csv_entry(bname, static_cast<int>(i), size * iterations, elapsed);
+                }
+                aux::set_allocation_counters(old);
+
+                auto res = summarize(times, iterations, counters);
+                report(bname, size, res);
+
+                ++count_;
+
+                return res;
+            }
+
+        private:
+            template<class Function>
+            static int64_t measure(Function& fn, size_t iterations)
+            {
+                auto start = clock::now();
+                for (size_t i = 0; i < iterations; ++i)
+                    fn();
+                auto end = clock::now();
+
+                return chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+            }
+
+            result summarize(vector<int64_t>&, size_t, const aux::allocation_counters&);
+            void report(const char*, size_t, const result&);
+            void csv_entry(const char*, int, size_t, int64_t);
+
+            FILE* csv_{};
+            size_t samples_{21};
+            unsigned int count_{};
+    };
+}
+
+#endif
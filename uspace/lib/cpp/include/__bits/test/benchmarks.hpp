@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_TEST_BENCHMARKS
+#define LIBCPP_BITS_TEST_BENCHMARKS
+
+#include <__bits/test/benchmark.hpp>
+#include <cstdio>
+#include <vector>
+
+namespace std::test
+{
+    class benchmark_set
+    {
+        public:
+            benchmark_set() = default;
+
+            template<class T>
+            void add()
+            {
+                benchmarks_.push_back(new T{});
+            }
+
+            void run(FILE* csv, size_t samples)
+            {
+                unsigned int count{};
+
+                for (auto bench: benchmarks_)
+                {
+                    bench->set_csv(csv);
+                    bench->set_samples(samples);
+
+                    std::printf("\n[BENCHMARK START][%s]\n", bench->name());
+                    bench->run();
+                    std::printf("[BENCHMARK END][%s]\n", bench->name());
+
+                    count += bench->get_count();
+                }
+
+                std::printf("\n[BENCHMARKS DONE][%u TOTAL]\n", count);
+            }
+
+            ~benchmark_set()
+            {
+                for (auto ptr: benchmarks_)
+                    delete ptr;
+            }
+        private:
+            std::vector<benchmark_suite*> benchmarks_{};
+    };
+
+    class vector_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class string_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class deque_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class map_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+
+        private:
+            void bench_map();
+            void bench_unordered_map();
+            void bench_churn();
+
+            template<class Map>
+            void bench_churn_(const char*, const char*, const char*);
+    };
+
+    class btree_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+
+        private:
+            template<class Map>
+            void bench_lookups(const char*, size_t);
+    };
+
+    class future_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class random_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+
+        private:
+            template<class Engine>
+            void bench_engine(const char*, const char*, const char*);
+    };
+
+    class memory_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class stream_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class rtti_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class thread_local_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+
+    class sort_benchmark: public benchmark_suite
+    {
+        public:
+            void run() override;
+            const char* name() override;
+    };
+}
+
+#endif
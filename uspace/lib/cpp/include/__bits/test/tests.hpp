@@ -123,6 +123,7 @@ namespace std::test
             void test_find();
             void test_substr();
             void test_compare();
+            void test_extraction();
     };
 
     class bitset_test: public test_suite
@@ -148,6 +149,7 @@ namespace std::test
             void test_resizing();
             void test_push_pop();
             void test_operations();
+            void test_blocks();
     };
 
     class tuple_test: public test_suite
@@ -177,6 +179,21 @@ namespace std::test
             void test_multi();
             void test_reverse_iterators();
             void test_multi_bounds_and_ranges();
+            void test_node_handles();
+    };
+
+    class btree_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_insert_find();
+            void test_erase();
+            void test_multi();
+            void test_bulk_load();
+            void test_set();
     };
 
     class set_test: public test_suite
@@ -192,6 +209,7 @@ namespace std::test
             void test_multi();
             void test_reverse_iterators();
             void test_multi_bounds_and_ranges();
+            void test_node_handles();
     };
 
     class unordered_map_test: public test_suite
@@ -205,6 +223,7 @@ namespace std::test
             void test_histogram();
             void test_emplace_insert();
             void test_multi();
+            void test_node_handles();
     };
 
     class unordered_set_test: public test_suite
@@ -217,6 +236,7 @@ namespace std::test
             void test_constructors_and_assignment();
             void test_emplace_insert();
             void test_multi();
+            void test_node_handles();
     };
 
     class numeric_test: public test_suite
@@ -252,6 +272,7 @@ namespace std::test
             void test_unique_ptr();
             void test_shared_ptr();
             void test_weak_ptr();
+            void test_atomic_access();
             void test_allocators();
             void test_pointers();
     };
@@ -293,6 +314,38 @@ namespace std::test
         private:
             void test_non_modifying();
             void test_mutating();
+            void test_parallel();
+    };
+
+    class rtti_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_type_info();
+            void test_dynamic_cast();
+    };
+
+    class abi_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_atexit();
+            void test_atexit_stress();
+    };
+
+    class random_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_engines();
+            void test_random_device();
+            void test_distributions();
     };
 
     class future_test: public test_suite
@@ -307,6 +360,20 @@ namespace std::test
             void test_async();
             void test_packaged_task();
             void test_shared_future();
+            void test_continuations();
+    };
+
+    class coroutine_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_traits();
+            void test_handles();
+            void test_noop();
+            void test_awaitables();
+            void test_tasks();
     };
 }
 
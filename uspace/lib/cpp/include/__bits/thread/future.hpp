@@ -29,10 +29,12 @@
 #ifndef LIBCPP_BITS_THREAD_FUTURE
 #define LIBCPP_BITS_THREAD_FUTURE
 
+#include <__bits/functional/invoke.hpp>
 #include <__bits/thread/future_common.hpp>
 #include <__bits/thread/shared_state.hpp>
 #include <__bits/utility/forward_move.hpp>
 #include <cassert>
+#include <type_traits>
 
 namespace std
 {
@@ -218,10 +220,67 @@ namespace std
                         return *this->state_->get();
                     }
                     else
-                        return this->state_->get();
+                        return move(this->state_->get());
                 }
             }
 
+            /**
+             * Extension (see the Concurrency TS): Returns a future
+             * for the result of f(future), where f is called with
+             * this future once it is ready instead of blocking
+             * a fibril until then. The call happens on the fibril
+             * that makes the state ready, or immediately if it
+             * already is. This future is no longer valid afterwards.
+             */
+            template<class F>
+            future<result_of_t<decay_t<F>(future)>> then(F&& f)
+            {
+                using result_t = result_of_t<decay_t<F>(future)>;
+                using inner_t = aux::future_inner_t<result_t>;
+
+                assert(this->state_);
+
+                auto state = this->state_;
+                auto next = new aux::shared_state<inner_t>{};
+
+                // One reference for the continuation, one for the result.
+                next->increment();
+
+                state->add_continuation(aux::make_continuation(
+                    [self = move(*this), func = decay_t<F>{forward<F>(f)}, next]() mutable {
+                        /**
+                         * The continuation runs on the fibril that made
+                         * this state ready, its exception belongs to the
+                         * returned future.
+                         */
+                        try
+                        {
+                            if constexpr (is_same_v<result_t, void>)
+                            {
+                                invoke(func, move(self));
+                                next->set_value();
+                            }
+                            else if constexpr (is_reference_v<result_t>)
+                                next->set_value(&invoke(func, move(self)), true);
+                            else
+                                next->set_value(invoke(func, move(self)), true);
+                        }
+                        catch(...)
+                        {
+                            next->set_exception(current_exception());
+                        }
+
+                        if (next->decrement())
+                        {
+                            next->destroy();
+                            delete next;
+                        }
+                    }
+                ));
+
+                return future<result_t>{next};
+            }
+
             /**
              * Useful for testing as we can check some information
              * otherwise unavailable to us without waiting, e.g.
@@ -57,7 +57,7 @@ namespace std
             {
                 auto time = aux::threading::time::convert(rel_time);
 
-                return aux::threading::shared_mutex::try_lock_for(time);
+                return aux::threading::shared_mutex::try_lock_for(mtx_, time);
             }
 
             template<class Clock, class Duration>
@@ -66,7 +66,7 @@ namespace std
                 auto dur = (abs_time - Clock::now());
                 auto time = aux::threading::time::convert(dur);
 
-                return aux::threading::shared_mutex::try_lock_for(time);
+                return aux::threading::shared_mutex::try_lock_for(mtx_, time);
             }
 
             void lock_shared();
@@ -78,7 +78,7 @@ namespace std
             {
                 auto time = aux::threading::time::convert(rel_time);
 
-                return aux::threading::shared_mutex::try_lock_shared_for(time);
+                return aux::threading::shared_mutex::try_lock_shared_for(mtx_, time);
             }
 
             template<class Clock, class Duration>
@@ -87,7 +87,7 @@ namespace std
                 auto dur = (abs_time - Clock::now());
                 auto time = aux::threading::time::convert(dur);
 
-                return aux::threading::shared_mutex::try_lock_shared_for(time);
+                return aux::threading::shared_mutex::try_lock_shared_for(mtx_, time);
             }
 
             using native_handle_type = aux::shared_mutex_t*;
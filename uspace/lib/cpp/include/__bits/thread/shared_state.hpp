@@ -45,12 +45,51 @@
 
 namespace std::aux
 {
+    /**
+     * Work registered to run once a shared state becomes
+     * ready, used to implement future::then, when_all and
+     * when_any without blocking a fibril per future.
+     */
+    class continuation_base
+    {
+        public:
+            virtual void run() = 0;
+
+            virtual ~continuation_base() = default;
+
+            continuation_base* next{};
+    };
+
+    template<class F>
+    class continuation: public continuation_base
+    {
+        public:
+            continuation(F&& f)
+                : func_{move(f)}
+            { /* DUMMY BODY */ }
+
+            void run() override
+            {
+                func_();
+            }
+
+        private:
+            F func_;
+    };
+
+    template<class F>
+    continuation_base* make_continuation(F&& f)
+    {
+        return new continuation<decay_t<F>>{forward<F>(f)};
+    }
+
     class shared_state_base: public aux::refcount_obj
     {
         public:
             shared_state_base()
                 : mutex_{}, condvar_{}, value_set_{false},
-                  exception_{}, has_exception_{false}
+                  exception_{}, has_exception_{false},
+                  continuations_{nullptr}
             {
                 threading::mutex::init(mutex_);
                 threading::condvar::init(condvar_);
@@ -67,18 +106,24 @@ namespace std::aux
 
             void mark_set(bool set = true) noexcept
             {
-                value_set_ = set;
+                if (set)
+                    mark_ready_();
+                else
+                    __atomic_store_n(&value_set_, false, __ATOMIC_RELEASE);
             }
 
             bool is_set() const noexcept
             {
-                return value_set_;
+                return __atomic_load_n(&value_set_, __ATOMIC_ACQUIRE);
             }
 
             void set_exception(exception_ptr ptr, bool set = true)
             {
                 exception_ = ptr;
-                has_exception_ = set;
+                has_exception_ = true;
+
+                if (set)
+                    mark_ready_();
             }
 
             bool has_exception() const noexcept
@@ -92,13 +137,56 @@ namespace std::aux
                     rethrow_exception(exception_);
             }
 
+            /**
+             * Deferred states only become ready when
+             * someone waits for them.
+             */
+            virtual bool is_deferred() const noexcept
+            {
+                return false;
+            }
+
+            /**
+             * Runs the continuation once the state is ready,
+             * immediately (on the calling fibril) if it already
+             * is, otherwise on the fibril making it ready.
+             * Takes ownership of the continuation.
+             */
+            void add_continuation(continuation_base* cont)
+            {
+                if (is_deferred())
+                    wait();
+
+                if (!is_set())
+                {
+                    aux::threading::mutex::lock(mutex_);
+                    if (!is_set())
+                    {
+                        cont->next = continuations_;
+                        continuations_ = cont;
+                        cont = nullptr;
+                    }
+                    aux::threading::mutex::unlock(mutex_);
+                }
+
+                if (cont)
+                {
+                    cont->run();
+                    delete cont;
+                }
+            }
+
             virtual void wait() const
             {
+                // Fast path, no need to lock once the state is ready.
+                if (is_set())
+                    return;
+
                 aux::threading::mutex::lock(
                     const_cast<aux::mutex_t&>(mutex_)
                 );
 
-                while (!value_set_)
+                while (!is_set())
                 {
                     aux::threading::condvar::wait(
                         const_cast<aux::condvar_t&>(condvar_),
@@ -115,7 +203,7 @@ namespace std::aux
             future_status
             wait_for(const chrono::duration<Rep, Period>& rel_time) const
             {
-                if (value_set_)
+                if (is_set())
                     return future_status::ready;
 
                 aux::threading::mutex::lock(
@@ -137,7 +225,7 @@ namespace std::aux
             future_status
             wait_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
-                if (value_set_)
+                if (is_set())
                     return future_status::ready;
 
                 aux::threading::mutex::lock(
@@ -155,7 +243,16 @@ namespace std::aux
                 return res;
             }
 
-            ~shared_state_base() override = default;
+            ~shared_state_base() override
+            {
+                // Never became ready.
+                while (continuations_)
+                {
+                    auto cont = continuations_;
+                    continuations_ = cont->next;
+                    delete cont;
+                }
+            }
 
         protected:
             aux::mutex_t mutex_;
@@ -166,6 +263,46 @@ namespace std::aux
             exception_ptr exception_;
             bool has_exception_;
 
+            continuation_base* continuations_;
+
+            /**
+             * This is the 'mark ready' move described in 30.6.4 (6),
+             * the stored value has to be written before the call.
+             * The flag is published with release semantics so that
+             * the lock free readers in is_set() see the value.
+             */
+            void mark_ready_()
+            {
+                aux::threading::mutex::lock(mutex_);
+                __atomic_store_n(&value_set_, true, __ATOMIC_RELEASE);
+                auto conts = continuations_;
+                continuations_ = nullptr;
+                aux::threading::mutex::unlock(mutex_);
+
+                aux::threading::condvar::broadcast(condvar_);
+
+                /**
+                 * Continuations were pushed to the front,
+                 * reverse them to run in registration order.
+                 */
+                continuation_base* ordered{nullptr};
+                while (conts)
+                {
+                    auto next = conts->next;
+                    conts->next = ordered;
+                    ordered = conts;
+                    conts = next;
+                }
+
+                while (ordered)
+                {
+                    auto next = ordered->next;
+                    ordered->run();
+                    delete ordered;
+                    ordered = next;
+                }
+            }
+
             /**
              * Note: wait_for and wait_until are templates and as such
              *       cannot be virtual and overriden by the deferred_ and
@@ -198,29 +335,18 @@ namespace std::aux
 
             void set_value(const R& val, bool set)
             {
-                /**
-                 * Note: This is the 'mark ready' move described
-                 *       in 30.6.4 (6).
-                 */
-
-                aux::threading::mutex::lock(mutex_);
                 value_ = val;
-                value_set_ = set;
-                aux::threading::mutex::unlock(mutex_);
 
                 if (set)
-                    aux::threading::condvar::broadcast(condvar_);
+                    this->mark_ready_();
             }
 
             void set_value(R&& val, bool set = true)
             {
-                aux::threading::mutex::lock(mutex_);
                 value_ = std::move(val);
-                value_set_ = set;
-                aux::threading::mutex::unlock(mutex_);
 
                 if (set)
-                    aux::threading::condvar::broadcast(condvar_);
+                    this->mark_ready_();
             }
 
             R& get()
@@ -242,8 +368,7 @@ namespace std::aux
 
             void set_value()
             {
-                value_set_ = true;
-                aux::threading::condvar::broadcast(condvar_);
+                this->mark_ready_();
             }
 
             void get()
@@ -298,7 +423,13 @@ namespace std::aux
 
             void destroy() override
             {
-                if (!this->is_set())
+                /**
+                 * The last reference can be dropped by a continuation
+                 * running on our own thread, which cannot join itself.
+                 */
+                if (thread_.get_id() == this_thread::get_id())
+                    thread_.detach();
+                else if (!this->is_set())
                     thread_.join();
             }
 
@@ -321,7 +452,7 @@ namespace std::aux
                  *       behaviour should be compliant.
                  */
                 aux::threading::time::sleep(time);
-                if (this->value_set_)
+                if (this->is_set())
                     return future_status::ready;
                 else
                     return future_status::timeout;
@@ -343,10 +474,17 @@ namespace std::aux
 
             void destroy() override
             {
-                aux::threading::mutex::lock(this->mutex_);
+                /**
+                 * Note: Synchronization done in invoke_ -> set_value,
+                 *       which locks the mutex itself.
+                 */
                 if (!this->is_set())
                     invoke_(make_index_sequence<sizeof...(Args)>{});
-                aux::threading::mutex::unlock(this->mutex_);
+            }
+
+            bool is_deferred() const noexcept override
+            {
+                return !this->is_set();
             }
 
             void wait() const override
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_THREAD_TASK
+#define LIBCPP_BITS_THREAD_TASK
+
+#include <__bits/coroutine.hpp>
+#include <__bits/exception.hpp>
+#include <__bits/utility/forward_move.hpp>
+#include <cerrno>
+#include <new>
+
+#include <async.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+
+/**
+ * Extension: Stackless tasks driven by the fibril manager.
+ *
+ * A suspended coroutine only keeps its frame alive, so a server can keep
+ * a large number of requests in flight without paying for a fibril stack
+ * per request. Coroutines are resumed by a fibril_executor, which is a
+ * single fibril draining a queue of ready coroutine handles.
+ *
+ * Only available when the compiler supports coroutines.
+ */
+
+#if LIBCPP_COROUTINES_SUPPORTED
+
+namespace std::experimental
+{
+    template<class T = void>
+    class task;
+
+    class fibril_executor;
+}
+
+namespace std::aux
+{
+    struct task_promise_base
+    {
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template<class Promise>
+            coroutine_handle<> await_suspend(coroutine_handle<Promise> h) noexcept
+            {
+                auto cont = h.promise().continuation_;
+
+                if (cont)
+                    return cont;
+                else
+                    return noop_coroutine();
+            }
+
+            void await_resume() const noexcept
+            { /* DUMMY BODY */ }
+        };
+
+        suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        final_awaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            terminate();
+        }
+
+        coroutine_handle<> continuation_{};
+    };
+
+    template<class T>
+    struct task_promise: task_promise_base
+    {
+        task_promise() = default;
+
+        ~task_promise()
+        {
+            if (has_value_)
+                value().~T();
+        }
+
+        experimental::task<T> get_return_object() noexcept;
+
+        template<class U>
+        void return_value(U&& val)
+        {
+            ::new(static_cast<void*>(storage_)) T(forward<U>(val));
+            has_value_ = true;
+        }
+
+        T& value() noexcept
+        {
+            return *reinterpret_cast<T*>(storage_);
+        }
+
+        alignas(T) unsigned char storage_[sizeof(T)];
+        bool has_value_{false};
+    };
+
+    template<>
+    struct task_promise<void>: task_promise_base
+    {
+        experimental::task<void> get_return_object() noexcept;
+
+        void return_void() const noexcept
+        { /* DUMMY BODY */ }
+
+        void value() const noexcept
+        { /* DUMMY BODY */ }
+    };
+
+    /**
+     * Self-destroying coroutine used to run a task that
+     * nobody awaits.
+     */
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() const noexcept
+            {
+                return {};
+            }
+
+            suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            { /* DUMMY BODY */ }
+
+            void unhandled_exception() const noexcept
+            {
+                terminate();
+            }
+        };
+    };
+
+    inline ::helenos::aid_t async_send_n(::helenos::async_exch_t* exch, ::helenos::sysarg_t imethod,
+                              ::helenos::ipc_call_t* answer)
+    {
+        return ::helenos::async_send_0(exch, imethod, answer);
+    }
+
+    inline ::helenos::aid_t async_send_n(::helenos::async_exch_t* exch, ::helenos::sysarg_t imethod,
+                              ::helenos::ipc_call_t* answer, ::helenos::sysarg_t a1)
+    {
+        return ::helenos::async_send_1(exch, imethod, a1, answer);
+    }
+
+    inline ::helenos::aid_t async_send_n(::helenos::async_exch_t* exch, ::helenos::sysarg_t imethod,
+                              ::helenos::ipc_call_t* answer, ::helenos::sysarg_t a1,
+                              ::helenos::sysarg_t a2)
+    {
+        return ::helenos::async_send_2(exch, imethod, a1, a2, answer);
+    }
+
+    inline ::helenos::aid_t async_send_n(::helenos::async_exch_t* exch, ::helenos::sysarg_t imethod,
+                              ::helenos::ipc_call_t* answer, ::helenos::sysarg_t a1,
+                              ::helenos::sysarg_t a2, ::helenos::sysarg_t a3)
+    {
+        return ::helenos::async_send_3(exch, imethod, a1, a2, a3, answer);
+    }
+
+    inline ::helenos::aid_t async_send_n(::helenos::async_exch_t* exch, ::helenos::sysarg_t imethod,
+                              ::helenos::ipc_call_t* answer, ::helenos::sysarg_t a1,
+                              ::helenos::sysarg_t a2, ::helenos::sysarg_t a3, ::helenos::sysarg_t a4)
+    {
+        return ::helenos::async_send_4(exch, imethod, a1, a2, a3, a4, answer);
+    }
+
+    inline ::helenos::aid_t async_send_n(::helenos::async_exch_t* exch, ::helenos::sysarg_t imethod,
+                              ::helenos::ipc_call_t* answer, ::helenos::sysarg_t a1,
+                              ::helenos::sysarg_t a2, ::helenos::sysarg_t a3, ::helenos::sysarg_t a4,
+                              ::helenos::sysarg_t a5)
+    {
+        return ::helenos::async_send_5(exch, imethod, a1, a2, a3, a4, a5, answer);
+    }
+}
+
+namespace std::experimental
+{
+    /**
+     * Lazily started coroutine producing a value of type T.
+     * The coroutine starts running when the task is awaited.
+     */
+    template<class T>
+    class task
+    {
+        public:
+            using promise_type = aux::task_promise<T>;
+
+            task() noexcept
+                : handle_{}
+            { /* DUMMY BODY */ }
+
+            explicit task(coroutine_handle<promise_type> h) noexcept
+                : handle_{h}
+            { /* DUMMY BODY */ }
+
+            task(const task&) = delete;
+            task& operator=(const task&) = delete;
+
+            task(task&& other) noexcept
+                : handle_{other.handle_}
+            {
+                other.handle_ = nullptr;
+            }
+
+            task& operator=(task&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    if (handle_)
+                        handle_.destroy();
+                    handle_ = other.handle_;
+                    other.handle_ = nullptr;
+                }
+
+                return *this;
+            }
+
+            ~task()
+            {
+                if (handle_)
+                    handle_.destroy();
+            }
+
+            bool done() const noexcept
+            {
+                return !handle_ || handle_.done();
+            }
+
+            auto operator co_await() && noexcept
+            {
+                struct awaiter
+                {
+                    bool await_ready() const noexcept
+                    {
+                        return !handle || handle.done();
+                    }
+
+                    coroutine_handle<> await_suspend(coroutine_handle<> cont) noexcept
+                    {
+                        handle.promise().continuation_ = cont;
+
+                        return handle;
+                    }
+
+                    decltype(auto) await_resume()
+                    {
+                        if constexpr (is_void_v<T>)
+                            return;
+                        else
+                            return move(handle.promise().value());
+                    }
+
+                    coroutine_handle<promise_type> handle;
+                };
+
+                return awaiter{handle_};
+            }
+
+        private:
+            coroutine_handle<promise_type> handle_;
+    };
+
+    /**
+     * Resumes coroutines from a dedicated fibril. Coroutines get onto
+     * the executor by awaiting schedule(), by being spawned, or by
+     * awaiting an IPC reply through async_call().
+     */
+    class fibril_executor
+    {
+        public:
+            fibril_executor()
+                : queue_{::helenos::mpsc_create(sizeof(void*))},
+                  fibril_{}, finished_{}
+            {
+                ::helenos::fibril_semaphore_initialize(&finished_, 0);
+            }
+
+            fibril_executor(const fibril_executor&) = delete;
+            fibril_executor& operator=(const fibril_executor&) = delete;
+
+            ~fibril_executor()
+            {
+                stop();
+
+                if (queue_)
+                    ::helenos::mpsc_destroy(queue_);
+            }
+
+            /**
+             * Starts the fibril that resumes queued coroutines.
+             */
+            bool start()
+            {
+                if (!queue_ || fibril_)
+                    return false;
+
+                fibril_ = ::helenos::fibril_create(&fibril_executor::fibril_main, this);
+                if (!fibril_)
+                    return false;
+
+                ::helenos::fibril_add_ready(fibril_);
+
+                return true;
+            }
+
+            /**
+             * Stops accepting new work, drains the queue and waits
+             * for the executor fibril to finish.
+             */
+            void stop()
+            {
+                if (!fibril_)
+                    return;
+
+                ::helenos::mpsc_close(queue_);
+                ::helenos::fibril_semaphore_down(&finished_);
+                fibril_ = nullptr;
+            }
+
+            /**
+             * Queues a suspended coroutine for resumption. Safe to call
+             * from the async framework's reply callback.
+             */
+            void post(coroutine_handle<> h)
+            {
+                void* addr = h.address();
+
+                if (::helenos::mpsc_send(queue_, &addr) != EOK)
+                    terminate();
+            }
+
+            auto schedule() noexcept
+            {
+                struct awaiter
+                {
+                    bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+
+                    void await_suspend(coroutine_handle<> h)
+                    {
+                        executor->post(h);
+                    }
+
+                    void await_resume() const noexcept
+                    { /* DUMMY BODY */ }
+
+                    fibril_executor* executor;
+                };
+
+                return awaiter{this};
+            }
+
+            /**
+             * Runs the task to completion on this executor
+             * without anybody awaiting it.
+             */
+            void spawn(task<void> t)
+            {
+                run_detached_(*this, move(t));
+            }
+
+            /**
+             * Resumes queued coroutines on the calling fibril
+             * until the executor is stopped.
+             */
+            void run()
+            {
+                void* addr{};
+
+                while (::helenos::mpsc_receive(queue_, &addr, nullptr) == EOK)
+                    coroutine_handle<>::from_address(addr).resume();
+            }
+
+        private:
+            ::helenos::mpsc_t* queue_;
+            ::helenos::fid_t fibril_;
+            ::helenos::fibril_semaphore_t finished_;
+
+            static ::helenos::errno_t fibril_main(void* arg)
+            {
+                auto self = static_cast<fibril_executor*>(arg);
+
+                self->run();
+                ::helenos::fibril_semaphore_up(&self->finished_);
+
+                return EOK;
+            }
+
+            static aux::detached_task run_detached_(fibril_executor& ex, task<void> t)
+            {
+                co_await ex.schedule();
+                co_await move(t);
+            }
+    };
+
+    /**
+     * Awaitable for the reply to an asynchronous IPC message,
+     * replaces async_wait_for() in coroutines. The awaiting coroutine
+     * is resumed on the given executor once the answer arrives and
+     * co_await yields the return value of the answer.
+     */
+    class ipc_reply
+    {
+        public:
+            ipc_reply(fibril_executor& ex, ::helenos::aid_t aid) noexcept
+                : executor_{&ex}, aid_{aid}, handle_{}, retval_{EOK}
+            { /* DUMMY BODY */ }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(coroutine_handle<> h)
+            {
+                handle_ = h;
+                ::helenos::async_wait_callback(aid_, &ipc_reply::completed_, this);
+            }
+
+            ::helenos::errno_t await_resume() const noexcept
+            {
+                return retval_;
+            }
+
+        private:
+            fibril_executor* executor_;
+            ::helenos::aid_t aid_;
+            coroutine_handle<> handle_;
+            ::helenos::errno_t retval_;
+
+            static void completed_(void* arg, ::helenos::errno_t retval)
+            {
+                auto self = static_cast<ipc_reply*>(arg);
+
+                self->retval_ = retval;
+                self->executor_->post(self->handle_);
+            }
+    };
+
+    /**
+     * Awaitable counterpart of async_send_0 .. async_send_5.
+     */
+    template<class... Args>
+    ipc_reply async_call(fibril_executor& ex, ::helenos::async_exch_t* exch,
+                         ::helenos::sysarg_t imethod, ::helenos::ipc_call_t* answer,
+                         Args... args)
+    {
+        static_assert(sizeof...(Args) <= 5, "too many IPC arguments");
+
+        return ipc_reply{
+            ex, aux::async_send_n(exch, imethod, answer,
+                                  static_cast<::helenos::sysarg_t>(args)...)
+        };
+    }
+}
+
+namespace std::aux
+{
+    template<class T>
+    experimental::task<T> task_promise<T>::get_return_object() noexcept
+    {
+        return experimental::task<T>{
+            coroutine_handle<task_promise<T>>::from_promise(*this)
+        };
+    }
+
+    inline experimental::task<void> task_promise<void>::get_return_object() noexcept
+    {
+        return experimental::task<void>{
+            coroutine_handle<task_promise<void>>::from_promise(*this)
+        };
+    }
+}
+
+#endif
+
+#endif
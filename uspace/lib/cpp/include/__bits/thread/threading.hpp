@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_THREAD_THREADING
 #define LIBCPP_BITS_THREAD_THREADING
 
+#include <cerrno>
 #include <chrono>
 
 #include <fibril.h>
@@ -108,8 +109,12 @@ namespace std::aux
 
             static bool try_lock_for(mutex_type& mtx, time_unit timeout)
             {
-                // TODO: we need fibril_mutex_trylock_for() :/
-                return try_lock(mtx);
+                if (timeout <= 0)
+                    return try_lock(mtx);
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_mutex_lock_until(&mtx, &expires) == EOK;
             }
         };
 
@@ -153,6 +158,15 @@ namespace std::aux
             {
                 ::helenos::fibril_usleep(time);
             }
+
+            static ::timespec deadline(time_unit timeout)
+            {
+                ::timespec ts{};
+                ::helenos::getuptime(&ts);
+                ::helenos::ts_add_diff(&ts, USEC2NSEC(timeout));
+
+                return ts;
+            }
         };
 
         struct shared_mutex
@@ -184,27 +198,32 @@ namespace std::aux
 
             static bool try_lock(shared_mutex_type& mtx)
             {
-                // TODO: rwlocks don't have try locking capabilities
-                lock(mtx);
-
-                return true;
+                return ::helenos::fibril_rwlock_write_trylock(&mtx);
             }
 
             static bool try_lock_shared(shared_mutex_type& mtx)
             {
-                lock(mtx);
-
-                return true;
+                return ::helenos::fibril_rwlock_read_trylock(&mtx);
             }
 
             static bool try_lock_for(shared_mutex_type& mtx, time_unit timeout)
             {
-                return try_lock(mtx);
+                if (timeout <= 0)
+                    return try_lock(mtx);
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_rwlock_write_lock_until(&mtx, &expires) == EOK;
             }
 
             static bool try_lock_shared_for(shared_mutex_type& mtx, time_unit timeout)
             {
-                return try_lock(mtx);
+                if (timeout <= 0)
+                    return try_lock_shared(mtx);
+
+                auto expires = time::deadline(timeout);
+
+                return ::helenos::fibril_rwlock_read_lock_until(&mtx, &expires) == EOK;
             }
         };
     };
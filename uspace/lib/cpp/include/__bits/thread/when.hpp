@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_THREAD_WHEN
+#define LIBCPP_BITS_THREAD_WHEN
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/thread/future.hpp>
+#include <__bits/thread/shared_future.hpp>
+#include <__bits/thread/shared_state.hpp>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+/**
+ * Extensions (see the Concurrency TS): Futures that become
+ * ready when all or any of the given futures are ready.
+ * Both are implemented with continuations registered in the
+ * shared states, so no fibril is blocked while waiting.
+ */
+
+namespace std::experimental
+{
+    template<class Sequence>
+    struct when_any_result
+    {
+        size_t index;
+        Sequence futures;
+    };
+
+    namespace aux
+    {
+        template<class T>
+        struct is_future: false_type
+        { /* DUMMY BODY */ };
+
+        template<class R>
+        struct is_future<future<R>>: true_type
+        { /* DUMMY BODY */ };
+
+        template<class R>
+        struct is_future<shared_future<R>>: true_type
+        { /* DUMMY BODY */ };
+
+        template<class T>
+        inline constexpr bool is_future_v = is_future<T>::value;
+
+        template<class State>
+        void release_state(State* state)
+        {
+            if (state->decrement())
+            {
+                state->destroy();
+                delete state;
+            }
+        }
+
+        template<class Sequence, class F>
+        void for_each_future(Sequence& futures, F&& f)
+        {
+            for (size_t i = 0; i < futures.size(); ++i)
+                f(futures[i], i);
+        }
+
+        template<class... Futures, class F, size_t... Is>
+        void for_each_future_(tuple<Futures...>& futures, F&& f, index_sequence<Is...>)
+        {
+            (f(get<Is>(futures), Is), ...);
+        }
+
+        template<class... Futures, class F>
+        void for_each_future(tuple<Futures...>& futures, F&& f)
+        {
+            for_each_future_(futures, forward<F>(f), make_index_sequence<sizeof...(Futures)>{});
+        }
+
+        /**
+         * Note: The element-wise constructor of our tuple
+         *       cannot take move-only types, so we assign.
+         */
+        template<class Sequence, size_t... Is, class... Futures>
+        Sequence make_sequence_(index_sequence<Is...>, Futures&&... futures)
+        {
+            Sequence res{};
+            ((get<Is>(res) = forward<Futures>(futures)), ...);
+
+            return res;
+        }
+
+        template<class Sequence, class... Futures>
+        Sequence make_sequence(Futures&&... futures)
+        {
+            return make_sequence_<Sequence>(
+                make_index_sequence<sizeof...(Futures)>{},
+                forward<Futures>(futures)...
+            );
+        }
+
+        template<class Sequence>
+        struct when_all_context
+        {
+            Sequence futures;
+            std::aux::shared_state<Sequence>* state;
+
+            /**
+             * Number of futures that are not yet ready, plus one
+             * until all continuations are registered, so that
+             * the result is not set during the registration.
+             */
+            size_t remaining;
+
+            void ready()
+            {
+                if (__atomic_sub_fetch(&remaining, 1, __ATOMIC_ACQ_REL) > 0)
+                    return;
+
+                state->set_value(move(futures), true);
+                release_state(state);
+
+                delete this;
+            }
+        };
+
+        template<class Sequence>
+        future<Sequence> when_all(Sequence&& futures, size_t count)
+        {
+            auto state = new std::aux::shared_state<Sequence>{};
+
+            // One reference for the context, one for the result.
+            state->increment();
+
+            auto ctx = new when_all_context<Sequence>{move(futures), state, count + 1};
+            for_each_future(ctx->futures, [ctx](auto& fut, size_t) {
+                fut.__state()->add_continuation(
+                    std::aux::make_continuation([ctx]() { ctx->ready(); })
+                );
+            });
+            ctx->ready();
+
+            return future<Sequence>{state};
+        }
+
+        template<class Sequence>
+        struct when_any_context
+        {
+            Sequence futures;
+            std::aux::shared_state<when_any_result<Sequence>>* state;
+
+            /**
+             * Number of continuations that have not run yet,
+             * plus one until all of them are registered.
+             */
+            size_t refs;
+            bool done;
+
+            void ready(size_t idx)
+            {
+                if (!__atomic_exchange_n(&done, true, __ATOMIC_ACQ_REL))
+                {
+                    state->set_value(when_any_result<Sequence>{idx, move(futures)}, true);
+                    release_state(state);
+                }
+
+                release();
+            }
+
+            void release()
+            {
+                if (__atomic_sub_fetch(&refs, 1, __ATOMIC_ACQ_REL) == 0)
+                    delete this;
+            }
+        };
+
+        template<class Sequence>
+        future<when_any_result<Sequence>> when_any(Sequence&& futures, size_t count)
+        {
+            using result_t = when_any_result<Sequence>;
+
+            auto state = new std::aux::shared_state<result_t>{};
+            if (count == 0)
+            {
+                state->set_value(result_t{static_cast<size_t>(-1), move(futures)}, true);
+
+                return future<result_t>{state};
+            }
+
+            state->increment();
+
+            auto ctx = new when_any_context<Sequence>{move(futures), state, count + 1, false};
+
+            /**
+             * The futures are moved to the result as soon as one
+             * of them is ready, possibly while we are still
+             * registering, so collect the states first. They are
+             * kept alive by the futures in the result.
+             */
+            vector<std::aux::shared_state_base*> states{};
+            states.reserve(count);
+            for_each_future(ctx->futures, [&states](auto& fut, size_t) {
+                states.push_back(fut.__state());
+            });
+
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                states[i]->add_continuation(
+                    std::aux::make_continuation([ctx, i]() { ctx->ready(i); })
+                );
+            }
+            ctx->release();
+
+            return future<result_t>{state};
+        }
+    }
+
+    template<
+        class InputIterator,
+        class = enable_if_t<!aux::is_future_v<InputIterator>>
+    >
+    future<vector<typename iterator_traits<InputIterator>::value_type>>
+    when_all(InputIterator first, InputIterator last)
+    {
+        using sequence_t = vector<typename iterator_traits<InputIterator>::value_type>;
+
+        sequence_t futures{};
+        for (; first != last; ++first)
+            futures.push_back(move(*first));
+
+        auto count = futures.size();
+
+        return aux::when_all(move(futures), count);
+    }
+
+    template<class... Futures>
+    future<tuple<decay_t<Futures>...>> when_all(Futures&&... futures)
+    {
+        using sequence_t = tuple<decay_t<Futures>...>;
+
+        return aux::when_all(
+            aux::make_sequence<sequence_t>(forward<Futures>(futures)...),
+            sizeof...(Futures)
+        );
+    }
+
+    template<
+        class InputIterator,
+        class = enable_if_t<!aux::is_future_v<InputIterator>>
+    >
+    future<when_any_result<vector<typename iterator_traits<InputIterator>::value_type>>>
+    when_any(InputIterator first, InputIterator last)
+    {
+        using sequence_t = vector<typename iterator_traits<InputIterator>::value_type>;
+
+        sequence_t futures{};
+        for (; first != last; ++first)
+            futures.push_back(move(*first));
+
+        auto count = futures.size();
+
+        return aux::when_any(move(futures), count);
+    }
+
+    template<class... Futures>
+    future<when_any_result<tuple<decay_t<Futures>...>>>
+    when_any(Futures&&... futures)
+    {
+        using sequence_t = tuple<decay_t<Futures>...>;
+
+        return aux::when_any(
+            aux::make_sequence<sequence_t>(forward<Futures>(futures)...),
+            sizeof...(Futures)
+        );
+    }
+}
+
+#endif
@@ -67,9 +67,17 @@ namespace std
     template<class T>
     struct hash;
 
-    // TODO: implement
     template<>
-    struct hash<type_index>;
+    struct hash<type_index>
+    {
+        size_t operator()(const type_index& idx) const noexcept
+        {
+            return idx.hash_code();
+        }
+
+        using argument_type = type_index;
+        using result_type   = size_t;
+    };
 }
 
 #endif
@@ -30,8 +30,11 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstdint>
+#include <cerrno>
 #include <exception>
+#include <fibril.h>
 #include <mutex>
+#include <typeinfo>
 
 void* __dso_handle = nullptr;
 
@@ -39,16 +42,65 @@ namespace __cxxabiv1
 {
     namespace aux
     {
+        /**
+         * Destructors registered by __cxa_atexit are kept per dso
+         * in a list of fixed size chunks, so registering never moves
+         * entries that are already stored and __cxa_finalize(dso)
+         * only visits the destructors of that particular dso.
+         * The sequence number preserves the global reverse order
+         * of registration for __cxa_finalize(nullptr).
+         */
         struct destructor_t
         {
             void (*func)(void*);
             void* ptr;
+            std::size_t seq;
+        };
+
+        constexpr std::size_t destructor_chunk_size{64};
+
+        struct destructor_chunk_t
+        {
+            destructor_chunk_t* prev;
+            std::size_t count;
+            destructor_t entries[destructor_chunk_size];
+        };
+
+        /**
+         * Note: Every record holds at least one destructor,
+         *       records are removed once they become empty.
+         */
+        struct dso_destructors_t
+        {
             void* dso;
+            destructor_chunk_t* last;
+            dso_destructors_t* next;
+        };
+
+        /**
+         * Note: The registry is used during static initialization,
+         *       before a global std::mutex is guaranteed to be
+         *       initialized, so it is guarded by a plain flag.
+         */
+        bool destructor_lock{false};
+
+        struct destructor_guard
+        {
+            destructor_guard()
+            {
+                while (__atomic_test_and_set(&destructor_lock, __ATOMIC_ACQUIRE))
+                    ::helenos::fibril_yield();
+            }
+
+            ~destructor_guard()
+            {
+                __atomic_clear(&destructor_lock, __ATOMIC_RELEASE);
+            }
         };
 
-        destructor_t* destructors{nullptr};
-        std::size_t destructor_count{0};
-        std::size_t destructor_size{32};
+        dso_destructors_t* dso_destructors{nullptr};
+        std::size_t destructor_seq{0};
+        bool destructors_hooked{false};
 
         /**
          * C atexit does not pass any arguments,
@@ -59,6 +111,56 @@ namespace __cxxabiv1
         {
             __cxa_finalize(nullptr);
         }
+
+        /**
+         * Returns the link that points to the record of the
+         * given dso or the null link at the end of the list.
+         * Found records are moved to the front as a single
+         * library usually registers all its objects in a row.
+         */
+        dso_destructors_t** find_dso_destructors(void* dso)
+        {
+            auto link = &dso_destructors;
+            while (*link && (*link)->dso != dso)
+                link = &(*link)->next;
+
+            auto rec = *link;
+            if (rec && link != &dso_destructors)
+            {
+                *link = rec->next;
+                rec->next = dso_destructors;
+                dso_destructors = rec;
+
+                return &dso_destructors;
+            }
+
+            return link;
+        }
+
+        /**
+         * Removes the most recently registered destructor
+         * of the record pointed to by the given link.
+         */
+        destructor_t pop_destructor(dso_destructors_t** link)
+        {
+            auto rec = *link;
+            auto chunk = rec->last;
+            auto destr = chunk->entries[--chunk->count];
+
+            if (chunk->count == 0)
+            {
+                rec->last = chunk->prev;
+                std::free(chunk);
+            }
+
+            if (!rec->last)
+            {
+                *link = rec->next;
+                std::free(rec);
+            }
+
+            return destr;
+        }
     }
 
     /**
@@ -79,53 +181,108 @@ namespace __cxxabiv1
 
     extern "C" int __cxa_atexit(void (*f)(void*), void* p, void* d)
     {
-        if (!aux::destructors)
+        aux::destructor_guard guard{};
+
+        if (!aux::destructors_hooked)
         {
-            aux::destructors = new aux::destructor_t[aux::destructor_size];
-            std::atexit(aux::atexit_destructors);
+            if (std::atexit(aux::atexit_destructors) != 0)
+                return -1;
+            aux::destructors_hooked = true;
         }
-        else if (aux::destructor_count >= aux::destructor_size)
+
+        auto link = aux::find_dso_destructors(d);
+        auto rec = *link;
+        if (!rec)
         {
-            auto tmp = std::realloc(aux::destructors, aux::destructor_size * 2);
+            rec = static_cast<aux::dso_destructors_t*>(
+                std::malloc(sizeof(aux::dso_destructors_t))
+            );
+            if (!rec)
+                return -1;
+
+            rec->dso = d;
+            rec->last = nullptr;
+            rec->next = aux::dso_destructors;
+            aux::dso_destructors = rec;
+        }
+
+        auto chunk = rec->last;
+        if (!chunk || chunk->count == aux::destructor_chunk_size)
+        {
+            chunk = static_cast<aux::destructor_chunk_t*>(
+                std::malloc(sizeof(aux::destructor_chunk_t))
+            );
+            if (!chunk)
+            {
+                if (!rec->last)
+                {
+                    aux::dso_destructors = rec->next;
+                    std::free(rec);
+                }
 
-            if (!tmp)
                 return -1;
+            }
 
-            aux::destructors = static_cast<aux::destructor_t*>(tmp);
-            aux::destructor_size *= 2;
+            chunk->prev = rec->last;
+            chunk->count = 0;
+            rec->last = chunk;
         }
 
-        auto& destr = aux::destructors[aux::destructor_count++];
+        auto& destr = chunk->entries[chunk->count++];
         destr.func = f;
         destr.ptr = p;
-        destr.dso = d;
+        destr.seq = aux::destructor_seq++;
 
         return 0;
     }
 
-    extern "C" void __cxa_finalize(void *f)
+    /**
+     * Runs the destructors registered for the given dso (or all
+     * of them if d is null) in reverse order of registration.
+     * The lock is not held while a destructor runs, so it can
+     * register new destructors (which are then run as well) and
+     * other dsos can be finalized concurrently, e.g. on dlclose.
+     */
+    extern "C" void __cxa_finalize(void* d)
     {
-        if (!f)
+        while (true)
         {
-            for (std::size_t i = aux::destructor_count; i > 0; --i)
-            {
-                if (aux::destructors[i - 1].func)
-                    (*aux::destructors[i - 1].func)(aux::destructors[i - 1].ptr);
-            }
-        }
-        else
-        {
-            for (std::size_t i = aux::destructor_count; i > 0; --i)
+            aux::destructor_t destr;
+
             {
-                if (aux::destructors[i - 1].func == f)
+                aux::destructor_guard guard{};
+
+                aux::dso_destructors_t** link{nullptr};
+                if (d)
+                {
+                    link = aux::find_dso_destructors(d);
+                    if (!*link)
+                        link = nullptr;
+                }
+                else
                 {
-                    (*aux::destructors[i - 1].func)(aux::destructors[i - 1].ptr);
-                    aux::destructors[i - 1].func = nullptr;
-                    aux::destructors[i - 1].ptr = nullptr;
-                    aux::destructors[i - 1].dso = nullptr;
-                    // TODO: shift and decrement count
+                    std::size_t latest{0};
+                    for (auto it = &aux::dso_destructors; *it; it = &(*it)->next)
+                    {
+                        auto chunk = (*it)->last;
+                        auto seq = chunk->entries[chunk->count - 1].seq;
+
+                        if (!link || seq > latest)
+                        {
+                            link = it;
+                            latest = seq;
+                        }
+                    }
                 }
+
+                if (!link)
+                    return;
+
+                destr = aux::pop_destructor(link);
             }
+
+            if (destr.func)
+                (*destr.func)(destr.ptr);
         }
     }
 
@@ -194,24 +351,336 @@ namespace __cxxabiv1
 
         // Actual vtable.
     };
+
+    namespace aux
+    {
+        enum class class_kind
+        {
+            plain,
+            si,
+            vmi
+        };
+
+        /**
+         * Note: We cannot use dynamic_cast on the type infos
+         *       themselves, that would recurse back to us.
+         */
+        class_kind get_class_kind(const __class_type_info* type)
+        {
+            const auto& info = typeid(*type);
+
+            if (info == typeid(__si_class_type_info))
+                return class_kind::si;
+            else if (info == typeid(__vmi_class_type_info))
+                return class_kind::vmi;
+            else
+                return class_kind::plain;
+        }
+
+        /**
+         * Calls visit(type, obj, is_public) for every subobject
+         * of the object obj of the given type (including the
+         * object itself), is_public tells if the path to the
+         * subobject consists of public bases only. Stops when
+         * visit returns true and returns true in that case.
+         */
+        template<class Visitor>
+        bool walk(const __class_type_info* type, const char* obj,
+                  bool is_public, Visitor& visit)
+        {
+            if (visit(type, obj, is_public))
+                return true;
+
+            switch (get_class_kind(type))
+            {
+                case class_kind::si:
+                {
+                    auto si = static_cast<const __si_class_type_info*>(type);
+
+                    return walk(si->__base_type, obj, is_public, visit);
+                }
+                case class_kind::vmi:
+                {
+                    auto vmi = static_cast<const __vmi_class_type_info*>(type);
+
+                    for (std::uint32_t i = 0; i < vmi->__base_count; ++i)
+                    {
+                        const auto& base = vmi->__base_info[i];
+                        auto flags = base.__offset_flags;
+                        std::ptrdiff_t offset = flags >> __base_class_type_info::__offset_shift;
+
+                        if (flags & __base_class_type_info::__virtual_mask)
+                        {
+                            /**
+                             * The offset is the position of the actual
+                             * offset of the virtual base in the vtable.
+                             */
+                            auto vptr = *reinterpret_cast<const char* const*>(obj);
+                            offset = *reinterpret_cast<const std::ptrdiff_t*>(vptr + offset);
+                        }
+
+                        bool base_public = is_public &&
+                            (flags & __base_class_type_info::__public_mask);
+
+                        if (walk(base.__base_type, obj + offset, base_public, visit))
+                            return true;
+                    }
+
+                    return false;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * Checks if sub is a public base class subobject
+         * of type src of the object obj of the given type.
+         */
+        bool has_public_base(const __class_type_info* type, const char* obj,
+                             const __class_type_info* src, const char* sub)
+        {
+            auto visit = [src, sub](auto base, auto base_obj, bool is_public) {
+                return is_public && base_obj == sub && *base == *src;
+            };
+
+            return walk(type, obj, true, visit);
+        }
+
+        constexpr std::ptrdiff_t cast_failed{PTRDIFF_MIN};
+
+        /**
+         * Computes the offset of the result of a dynamic_cast
+         * of sub (at offset sub_offset in the most derived
+         * object whole of type whole_type) to dst from whole.
+         * See [expr.dynamic.cast]/8.
+         */
+        std::ptrdiff_t dynamic_cast_offset(
+            const __class_type_info* whole_type, const char* whole,
+            const __class_type_info* src, const char* sub,
+            const __class_type_info* dst, std::ptrdiff_t src2dst)
+        {
+            /**
+             * In single inheritance hierarchies all subobjects
+             * are public, unique and share the address of the
+             * most derived object.
+             */
+            auto type = whole_type;
+            while (true)
+            {
+                if (*type == *dst)
+                    return 0;
+
+                auto kind = get_class_kind(type);
+                if (kind == class_kind::si)
+                    type = static_cast<const __si_class_type_info*>(type)->__base_type;
+                else if (kind == class_kind::plain)
+                    return cast_failed;
+                else
+                    break;
+            }
+
+            /**
+             * Downcast, the result is the unique dst object
+             * sub is a public base of. A src2dst of -2 means
+             * that src is not a public base of dst.
+             */
+            if (src2dst != -2)
+            {
+                const char* found{};
+                bool ambiguous{false};
+
+                auto downcast = [&](auto base, auto base_obj, bool) {
+                    if (*base == *dst && has_public_base(base, base_obj, src, sub))
+                    {
+                        if (found && found != base_obj)
+                            ambiguous = true;
+                        found = base_obj;
+                    }
+
+                    return ambiguous;
+                };
+                walk(whole_type, whole, true, downcast);
+
+                if (found && !ambiguous)
+                    return found - whole;
+            }
+
+            /**
+             * Crosscast, the result is the unambiguous public
+             * dst base of the most derived object if sub is
+             * its public base.
+             */
+            if (!has_public_base(whole_type, whole, src, sub))
+                return cast_failed;
+
+            const char* found{};
+            bool found_public{false};
+            bool ambiguous{false};
+
+            auto crosscast = [&](auto base, auto base_obj, bool is_public) {
+                if (*base == *dst)
+                {
+                    if (found && found != base_obj)
+                        ambiguous = true;
+                    found = base_obj;
+                    found_public |= is_public;
+                }
+
+                return ambiguous;
+            };
+            walk(whole_type, whole, true, crosscast);
+
+            if (found && found_public && !ambiguous)
+                return found - whole;
+            else
+                return cast_failed;
+        }
+
+        /**
+         * Direct mapped cache of dynamic_cast results. Each
+         * entry is protected by a sequence number, which is
+         * odd while the entry is being written, so that
+         * readers never use a partially written entry.
+         */
+        struct cast_cache_entry
+        {
+            unsigned int seq;
+            const __class_type_info* whole_type;
+            const __class_type_info* src;
+            const __class_type_info* dst;
+            std::ptrdiff_t sub_offset;
+            std::ptrdiff_t result;
+        };
+
+        constexpr std::size_t cast_cache_size{128};
+        cast_cache_entry cast_cache[cast_cache_size]{};
+
+        std::size_t cast_cache_index(const __class_type_info* whole_type,
+                                     const __class_type_info* src,
+                                     const __class_type_info* dst,
+                                     std::ptrdiff_t sub_offset)
+        {
+            auto hash = reinterpret_cast<std::uintptr_t>(whole_type);
+            hash = hash * 31 + reinterpret_cast<std::uintptr_t>(src);
+            hash = hash * 31 + reinterpret_cast<std::uintptr_t>(dst);
+            hash = hash * 31 + static_cast<std::uintptr_t>(sub_offset);
+
+            return (hash ^ (hash >> 7) ^ (hash >> 15)) % cast_cache_size;
+        }
+
+        bool cast_cache_lookup(cast_cache_entry& entry,
+                               const __class_type_info* whole_type,
+                               const __class_type_info* src,
+                               const __class_type_info* dst,
+                               std::ptrdiff_t sub_offset, std::ptrdiff_t& result)
+        {
+            auto seq = __atomic_load_n(&entry.seq, __ATOMIC_ACQUIRE);
+            if (seq == 0 || (seq & 1))
+                return false;
+
+            auto e_whole_type = __atomic_load_n(&entry.whole_type, __ATOMIC_RELAXED);
+            auto e_src = __atomic_load_n(&entry.src, __ATOMIC_RELAXED);
+            auto e_dst = __atomic_load_n(&entry.dst, __ATOMIC_RELAXED);
+            auto e_sub_offset = __atomic_load_n(&entry.sub_offset, __ATOMIC_RELAXED);
+            auto e_result = __atomic_load_n(&entry.result, __ATOMIC_RELAXED);
+
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&entry.seq, __ATOMIC_RELAXED) != seq)
+                return false;
+
+            if (e_whole_type != whole_type || e_src != src ||
+                e_dst != dst || e_sub_offset != sub_offset)
+                return false;
+
+            result = e_result;
+
+            return true;
+        }
+
+        void cast_cache_store(cast_cache_entry& entry,
+                              const __class_type_info* whole_type,
+                              const __class_type_info* src,
+                              const __class_type_info* dst,
+                              std::ptrdiff_t sub_offset, std::ptrdiff_t result)
+        {
+            auto seq = __atomic_load_n(&entry.seq, __ATOMIC_RELAXED);
+            if (seq & 1)
+                return;
+
+            // Someone else is updating the entry, no need to wait.
+            if (!__atomic_compare_exchange_n(&entry.seq, &seq, seq + 1, false,
+                                             __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                return;
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+
+            __atomic_store_n(&entry.whole_type, whole_type, __ATOMIC_RELAXED);
+            __atomic_store_n(&entry.src, src, __ATOMIC_RELAXED);
+            __atomic_store_n(&entry.dst, dst, __ATOMIC_RELAXED);
+            __atomic_store_n(&entry.sub_offset, sub_offset, __ATOMIC_RELAXED);
+            __atomic_store_n(&entry.result, result, __ATOMIC_RELAXED);
+
+            __atomic_store_n(&entry.seq, seq + 2, __ATOMIC_RELEASE);
+        }
+    }
+
+    /**
+     * Itanium C++ ABI 2.9.7: src2dst is a hint, non-negative values
+     * mean that src is a unique public non-virtual base of dst at
+     * that offset, -1 means no hint, -2 that src is not a public
+     * base of dst and -3 that src is a multiple public base of dst.
+     */
     extern "C" void* __dynamic_cast(const void* sub, const __class_type_info* src,
-                                    const __class_type_info* dst, std::ptrdiff_t offset)
+                                    const __class_type_info* dst, std::ptrdiff_t src2dst)
     {
-        // TODO: implement
-        // NOTE: as far as I understand it, we get vtable prefix from sub, get the type_info
-        //       ptr from that and then climb the inheritance hierarchy upwards till we either
-        //       fint dst or fail and return nullptr
-        return nullptr;
+        auto prefix = *static_cast<const vtable* const*>(sub) - 1;
+        auto whole = static_cast<const char*>(sub) + prefix->offset_to_top;
+        auto whole_type = static_cast<const __class_type_info*>(prefix->tinfo);
+
+        // Common downcast to the most derived type.
+        if (src2dst >= 0 && whole_type == dst &&
+            static_cast<const char*>(sub) - src2dst == whole)
+            return const_cast<char*>(whole);
+
+        auto sub_offset = -prefix->offset_to_top;
+        auto& entry = aux::cast_cache[
+            aux::cast_cache_index(whole_type, src, dst, sub_offset)
+        ];
+
+        std::ptrdiff_t result{};
+        if (!aux::cast_cache_lookup(entry, whole_type, src, dst, sub_offset, result))
+        {
+            result = aux::dynamic_cast_offset(
+                whole_type, whole, src, static_cast<const char*>(sub),
+                dst, src2dst
+            );
+
+            aux::cast_cache_store(entry, whole_type, src, dst, sub_offset, result);
+        }
+
+        if (result == aux::cast_failed)
+            return nullptr;
+        else
+            return const_cast<char*>(whole + result);
     }
 
     // Needed on arm.
     extern "C" void __cxa_end_cleanup()
     { /* DUMMY BODY */ }
 
-    extern "C" int __cxa_thread_atexit(void(*)(void*), void*, void*)
+    /**
+     * Registers the destructor of a thread_local object. Every
+     * fibril has its own TLS block, so the object is destroyed
+     * when the fibril (or the thread or program it runs) exits.
+     *
+     * Note: Shared objects are never unloaded, so we do not need
+     *       to keep track of the dso the object belongs to.
+     */
+    extern "C" int __cxa_thread_atexit(void (*dtor)(void*), void* obj, void*)
     {
-        // TODO: needed for thread_local variables
-        __unimplemented();
+        if (::helenos::fibril_add_exit_hook(dtor, obj) != EOK)
+            return -1;
+
         return 0;
     }
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/abi.hpp>
+#include <__bits/test/tests.hpp>
+#include <cstdlib>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        /**
+         * Addresses of these only serve as distinct dso
+         * handles, no library is loaded for them.
+         */
+        char fake_dsos[4]{};
+
+        struct record
+        {
+            std::vector<std::size_t>* log;
+            std::size_t idx;
+        };
+
+        void log_destructor(void* arg)
+        {
+            auto rec = static_cast<record*>(arg);
+
+            rec->log->push_back(rec->idx);
+        }
+
+        record reentrant_inner{};
+
+        void reentrant_destructor(void* arg)
+        {
+            log_destructor(arg);
+
+            __cxxabiv1::__cxa_atexit(
+                log_destructor, &reentrant_inner, &fake_dsos[0]
+            );
+        }
+
+        bool is_reverse(const std::vector<std::size_t>& log)
+        {
+            for (std::size_t i = 1; i < log.size(); ++i)
+            {
+                if (log[i - 1] <= log[i])
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    bool abi_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_atexit();
+        test_atexit_stress();
+
+        return end();
+    }
+
+    const char* abi_test::name()
+    {
+        return "abi";
+    }
+
+    void abi_test::test_atexit()
+    {
+        std::vector<std::size_t> log{};
+        std::vector<record> recs(200);
+
+        for (std::size_t i = 0; i < recs.size(); ++i)
+        {
+            recs[i] = record{&log, i};
+            __cxxabiv1::__cxa_atexit(log_destructor, &recs[i], &fake_dsos[0]);
+        }
+
+        __cxxabiv1::__cxa_finalize(&fake_dsos[1]);
+        test("finalize other dso", log.empty());
+
+        __cxxabiv1::__cxa_finalize(&fake_dsos[0]);
+        test_eq("finalize count", log.size(), recs.size());
+        test("finalize order", is_reverse(log));
+
+        log.clear();
+        __cxxabiv1::__cxa_finalize(&fake_dsos[0]);
+        test("finalize twice", log.empty());
+
+        record outer{&log, 1};
+        reentrant_inner = record{&log, 0};
+        __cxxabiv1::__cxa_atexit(reentrant_destructor, &outer, &fake_dsos[0]);
+        __cxxabiv1::__cxa_finalize(&fake_dsos[0]);
+        test_eq("finalize reentrant count", log.size(), 2U);
+        test("finalize reentrant order", is_reverse(log));
+    }
+
+    void abi_test::test_atexit_stress()
+    {
+        constexpr std::size_t count{100000};
+        constexpr std::size_t dso_count{sizeof(fake_dsos)};
+
+        std::vector<std::size_t> logs[dso_count]{};
+        std::vector<record> recs(count);
+
+        bool registered{true};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto dso = i % dso_count;
+
+            recs[i] = record{&logs[dso], i};
+            if (__cxxabiv1::__cxa_atexit(log_destructor, &recs[i], &fake_dsos[dso]) != 0)
+                registered = false;
+        }
+        test("stress register", registered);
+
+        std::size_t order[dso_count]{2, 0, 3, 1};
+        for (std::size_t j = 0; j < dso_count; ++j)
+        {
+            auto dso = order[j];
+            __cxxabiv1::__cxa_finalize(&fake_dsos[dso]);
+
+            bool ok = logs[dso].size() == count / dso_count && is_reverse(logs[dso]);
+            for (auto idx: logs[dso])
+                ok = ok && (idx % dso_count == dso);
+            test("stress finalize dso", ok);
+
+            std::size_t finalized{};
+            for (std::size_t k = 0; k < dso_count; ++k)
+                finalized += logs[k].size();
+            test_eq("stress untouched dsos", finalized, (j + 1) * (count / dso_count));
+        }
+    }
+}
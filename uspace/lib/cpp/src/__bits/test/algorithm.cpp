@@ -29,8 +29,11 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <array>
+#include <execution>
+#include <numeric>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace std::test
 {
@@ -41,6 +44,7 @@ namespace std::test
 
         test_non_modifying();
         test_mutating();
+        test_parallel();
 
         return end();
     }
@@ -293,4 +297,73 @@ namespace std::test
         );
         test_eq("transform pt2", res6, data10.end());
     }
+
+    void algorithm_test::test_parallel()
+    {
+        /**
+         * Large enough to be split into multiple
+         * chunks on multi-core machines.
+         */
+        constexpr std::size_t size = 100000;
+
+        std::vector<long> data1(size);
+        std::fill(std::execution::par, data1.begin(), data1.end(), 2L);
+        test_eq("parallel fill", std::count(data1.begin(), data1.end(), 2L), (long)size);
+
+        std::vector<long> data2(size);
+        std::iota(data1.begin(), data1.end(), 1L);
+        std::copy(std::execution::par, data1.begin(), data1.end(), data2.begin());
+        test_eq(
+            "parallel copy", data1.begin(), data1.end(),
+            data2.begin(), data2.end()
+        );
+
+        std::for_each(
+            std::execution::par, data2.begin(), data2.end(),
+            [](auto& x) { x *= 2; }
+        );
+        test_eq("parallel for_each", data2[size - 1], (long)(2 * size));
+
+        std::transform(
+            std::execution::par_unseq, data1.begin(), data1.end(),
+            data2.begin(), [](auto x) { return x + 1; }
+        );
+        test_eq("parallel transform pt1", data2[0], 2L);
+        test_eq("parallel transform pt2", data2[size - 1], (long)(size + 1));
+
+        auto sum = std::reduce(std::execution::par, data1.begin(), data1.end());
+        test_eq("parallel reduce pt1", sum, (long)(size * (size + 1) / 2));
+
+        auto sum2 = std::reduce(std::execution::par, data1.begin(), data1.end(), 10L);
+        test_eq("parallel reduce pt2", sum2, sum + 10);
+
+        auto sum3 = std::transform_reduce(
+            std::execution::par, data1.begin(), data1.end(), 0L,
+            [](auto x, auto y) { return x + y; },
+            [](auto x) { return 2 * x; }
+        );
+        test_eq("parallel transform_reduce", sum3, 2 * sum);
+
+        std::vector<long> data3(size);
+        std::inclusive_scan(
+            std::execution::par, data1.begin(), data1.end(), data3.begin()
+        );
+        test_eq("parallel inclusive_scan pt1", data3[0], 1L);
+        test_eq("parallel inclusive_scan pt2", data3[size - 1], sum);
+        test_eq("parallel inclusive_scan pt3", data3[size / 2 - 1], (long)(size / 2 * (size / 2 + 1) / 2));
+
+        std::vector<long> data4(data1.rbegin(), data1.rend());
+        std::sort(std::execution::par, data4.begin(), data4.end());
+        test_eq(
+            "parallel sort pt1", data1.begin(), data1.end(),
+            data4.begin(), data4.end()
+        );
+
+        std::sort(
+            std::execution::par, data4.begin(), data4.end(),
+            [](auto x, auto y) { return x > y; }
+        );
+        test_eq("parallel sort pt2", data4[0], (long)size);
+        test_eq("parallel sort pt3", std::is_sorted(data4.rbegin(), data4.rend()), true);
+    }
 }
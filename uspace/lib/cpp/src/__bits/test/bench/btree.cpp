@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t lookups = 10000;
+
+        /**
+         * Note: 10^7 keys do not fit into the memory
+         *       of a typical HelenOS machine twice,
+         *       raise this if yours is bigger.
+         */
+        constexpr size_t max_keys = 1'000'000;
+
+        /**
+         * Pseudo random sequence of keys in [0, 2 * size),
+         * the same for all runs.
+         */
+        std::vector<int> make_keys(size_t count, size_t size)
+        {
+            std::vector<int> keys{};
+            keys.reserve(count);
+
+            unsigned int state{2463534242u};
+            for (size_t i = 0; i < count; ++i)
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                keys.push_back(static_cast<int>(state % (2 * size)));
+            }
+
+            return keys;
+        }
+    }
+
+    /**
+     * Containers of the given size with every even
+     * key, so that half of the lookups miss.
+     */
+    template<class Map>
+    void btree_benchmark::bench_lookups(const char* bname, size_t size)
+    {
+        std::vector<std::pair<int, int>> sorted{};
+        sorted.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            sorted.emplace_back(static_cast<int>(2 * i), static_cast<int>(i));
+
+        Map m{};
+        for (const auto& x: sorted)
+            m.emplace(x.first, x.second);
+
+        auto keys = make_keys(lookups, size);
+        bench(bname, lookups, [&m, &keys] {
+            size_t found{};
+            for (auto key: keys)
+                found += m.find(key) != m.end();
+            benchmark_suite::keep(found);
+        });
+    }
+
+    void btree_benchmark::run()
+    {
+        static const char* map_names[] = {
+            "map find 10^4", "map find 10^5", "map find 10^6", "map find 10^7"
+        };
+        static const char* btree_names[] = {
+            "btree_map find 10^4", "btree_map find 10^5",
+            "btree_map find 10^6", "btree_map find 10^7"
+        };
+
+        size_t idx{};
+        for (size_t size = 10'000; size <= max_keys; size *= 10, ++idx)
+        {
+            bench_lookups<std::map<int, int>>(map_names[idx], size);
+            bench_lookups<std::experimental::btree_map<int, int>>(btree_names[idx], size);
+        }
+
+        constexpr size_t build_size = 100'000;
+        auto keys = make_keys(build_size, build_size);
+
+        bench("map insert 10^5", build_size, [&keys] {
+            std::map<int, int> m{};
+            for (auto key: keys)
+                m.emplace(key, key);
+            benchmark_suite::keep(m);
+        });
+
+        bench("btree_map insert 10^5", build_size, [&keys] {
+            std::experimental::btree_map<int, int> m{};
+            for (auto key: keys)
+                m.emplace(key, key);
+            benchmark_suite::keep(m);
+        });
+
+        std::vector<std::pair<int, int>> sorted{};
+        sorted.reserve(build_size);
+        for (size_t i = 0; i < build_size; ++i)
+            sorted.emplace_back(static_cast<int>(i), static_cast<int>(i));
+
+        bench("btree_map bulk load 10^5", build_size, [&sorted] {
+            std::experimental::btree_map<int, int> m{
+                std::experimental::sorted_range, sorted.begin(), sorted.end()
+            };
+            benchmark_suite::keep(m);
+        });
+
+        bench("map fill+erase 10^5", build_size, [&keys, &sorted] {
+            std::map<int, int> m{sorted.begin(), sorted.end()};
+            for (auto key: keys)
+                m.erase(key);
+            benchmark_suite::keep(m);
+        });
+
+        bench("btree_map fill+erase 10^5", build_size, [&keys, &sorted] {
+            std::experimental::btree_map<int, int> m{
+                std::experimental::sorted_range, sorted.begin(), sorted.end()
+            };
+            for (auto key: keys)
+                m.erase(key);
+            benchmark_suite::keep(m);
+        });
+    }
+
+    const char* btree_benchmark::name()
+    {
+        return "btree";
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t size = 10000;
+        constexpr size_t window = 100;
+    }
+
+    void deque_benchmark::run()
+    {
+        bench("push_back", size, [] {
+            std::deque<int> deq{};
+            for (size_t i = 0; i < size; ++i)
+                deq.push_back(static_cast<int>(i));
+            keep(deq.size());
+        });
+
+        bench("push_front", size, [] {
+            std::deque<int> deq{};
+            for (size_t i = 0; i < size; ++i)
+                deq.push_front(static_cast<int>(i));
+            keep(deq.size());
+        });
+
+        /**
+         * Queue like use with a short queue, this keeps
+         * crossing block boundaries in the same direction.
+         */
+        std::deque<int> fifo{};
+        bench("fifo", size, [&fifo] {
+            for (size_t i = 0; i < size; ++i)
+            {
+                fifo.push_back(static_cast<int>(i));
+                if (fifo.size() > window)
+                    fifo.pop_front();
+            }
+            keep(fifo.front());
+        });
+
+        std::queue<int> queue{};
+        bench("queue adaptor fifo", size, [&queue] {
+            for (size_t i = 0; i < size; ++i)
+            {
+                queue.push(static_cast<int>(i));
+                if (queue.size() > window)
+                    queue.pop();
+            }
+            keep(queue.front());
+        });
+
+        std::deque<int> deq{};
+        std::vector<int> vec{};
+        for (size_t i = 0; i < size; ++i)
+        {
+            deq.push_back(static_cast<int>(i));
+            vec.push_back(static_cast<int>(i));
+        }
+
+        bench("random access", size, [&deq] {
+            int sum{};
+            for (size_t i = 0, j = 0; i < size; ++i, j = (j + 7919) % size)
+                sum += deq[j];
+            keep(sum);
+        });
+
+        bench("vector random access", size, [&vec] {
+            int sum{};
+            for (size_t i = 0, j = 0; i < size; ++i, j = (j + 7919) % size)
+                sum += vec[j];
+            keep(sum);
+        });
+
+        bench("iterate", size, [&deq] {
+            int sum{};
+            for (auto x: deq)
+                sum += x;
+            keep(sum);
+        });
+
+        bench("vector iterate", size, [&vec] {
+            int sum{};
+            for (auto x: vec)
+                sum += x;
+            keep(sum);
+        });
+    }
+
+    const char* deque_benchmark::name()
+    {
+        return "deque";
+    }
+}
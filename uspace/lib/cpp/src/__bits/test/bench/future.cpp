@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t fan_out = 10000;
+
+        /**
+         * Creates fan_out promise/future pairs and fulfills the
+         * promises from another thread, while the calling thread
+         * collects the results with the given fan-in function.
+         */
+        template<class FanIn>
+        void fan_out_fan_in(FanIn fan_in)
+        {
+            std::vector<std::promise<int>> promises{};
+            std::vector<std::future<int>> futures{};
+            promises.reserve(fan_out);
+            futures.reserve(fan_out);
+
+            for (size_t i = 0; i < fan_out; ++i)
+            {
+                promises.push_back(std::promise<int>{});
+                futures.push_back(promises.back().get_future());
+            }
+
+            std::thread producer{[&promises] {
+                for (size_t i = 0; i < promises.size(); ++i)
+                    promises[i].set_value(static_cast<int>(i));
+            }};
+
+            benchmark_suite::keep(fan_in(futures));
+            producer.join();
+        }
+    }
+
+    void future_benchmark::run()
+    {
+        bench("get each", fan_out, [] {
+            fan_out_fan_in([](auto& futures) {
+                int sum{};
+                for (auto& fut: futures)
+                    sum += fut.get();
+
+                return sum;
+            });
+        });
+
+        bench("when_all then", fan_out, [] {
+            fan_out_fan_in([](auto& futures) {
+                auto all = std::experimental::when_all(futures.begin(), futures.end());
+
+                return all.then([](auto ready) {
+                    int sum{};
+                    for (auto& fut: ready.get())
+                        sum += fut.get();
+
+                    return sum;
+                }).get();
+            });
+        });
+
+        /**
+         * Note: The chain is attached to a ready future, so that
+         *       every continuation runs inline instead of all of
+         *       them nesting on the stack of the final set_value.
+         */
+        bench("then chain", fan_out, [] {
+            std::promise<int> first{};
+            auto fut = first.get_future();
+            first.set_value(0);
+
+            for (size_t i = 0; i < fan_out; ++i)
+                fut = fut.then([](std::future<int> prev) { return prev.get() + 1; });
+
+            benchmark_suite::keep(fut.get());
+        });
+
+        bench("ready get", fan_out, [] {
+            int sum{};
+            for (size_t i = 0; i < fan_out; ++i)
+            {
+                std::promise<int> p{};
+                auto fut = p.get_future();
+                p.set_value(static_cast<int>(i));
+                sum += fut.get();
+            }
+            benchmark_suite::keep(sum);
+        });
+    }
+
+    const char* future_benchmark::name()
+    {
+        return "future";
+    }
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t size = 1000;
+
+        /**
+         * Distinct keys in a pseudo random order,
+         * same for all runs.
+         */
+        std::vector<int> make_keys()
+        {
+            std::vector<int> keys{};
+            keys.reserve(size);
+
+            unsigned int state{2463534242u};
+            for (size_t i = 0; i < size; ++i)
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                keys.push_back(static_cast<int>((state & ~0xFFFu) | i));
+            }
+
+            return keys;
+        }
+
+        /**
+         * LRU like churn: the container holds a sliding
+         * window of half of the keys, every operation drops
+         * the oldest key and adds a new one.
+         */
+        template<class Map>
+        void fill_window(Map& m, const std::vector<int>& keys)
+        {
+            for (size_t i = 0; i < size / 2; ++i)
+                m.emplace(keys[i], keys[i]);
+        }
+
+        template<class Map>
+        void churn(Map& m, const std::vector<int>& keys, size_t& pos)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto key = keys[(pos + size / 2) % size];
+
+                m.erase(keys[pos]);
+                m.emplace(key, key);
+                pos = (pos + 1) % size;
+            }
+        }
+
+        template<class Map>
+        void churn_extract(Map& m, const std::vector<int>& keys, size_t& pos)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto nh = m.extract(keys[pos]);
+                nh.key() = keys[(pos + size / 2) % size];
+                nh.mapped() = nh.key();
+
+                m.insert(std::move(nh));
+                pos = (pos + 1) % size;
+            }
+        }
+    }
+
+    void map_benchmark::run()
+    {
+        bench_map();
+        bench_unordered_map();
+        bench_churn();
+    }
+
+    const char* map_benchmark::name()
+    {
+        return "maps";
+    }
+
+    void map_benchmark::bench_map()
+    {
+        auto keys = make_keys();
+
+        bench("map insert", size, [&keys] {
+            std::map<int, int> m{};
+            for (auto key: keys)
+                m.emplace(key, key);
+            keep(m.size());
+        });
+
+        std::map<int, int> m{};
+        for (auto key: keys)
+            m.emplace(key, key);
+
+        bench("map find", size, [&keys, &m] {
+            int sum{};
+            for (auto key: keys)
+                sum += m.find(key)->second;
+            keep(sum);
+        });
+
+        bench("map iterate", size, [&m] {
+            int sum{};
+            for (const auto& entry: m)
+                sum += entry.second;
+            keep(sum);
+        });
+
+        bench("map erase", size, [&keys, &m] {
+            auto copy{m};
+            for (auto key: keys)
+                copy.erase(key);
+            keep(copy.size());
+        });
+    }
+
+    void map_benchmark::bench_unordered_map()
+    {
+        auto keys = make_keys();
+
+        bench("unordered_map insert", size, [&keys] {
+            std::unordered_map<int, int> m{};
+            for (auto key: keys)
+                m.emplace(key, key);
+            keep(m.size());
+        });
+
+        std::unordered_map<int, int> m{};
+        for (auto key: keys)
+            m.emplace(key, key);
+
+        bench("unordered_map find", size, [&keys, &m] {
+            int sum{};
+            for (auto key: keys)
+                sum += m.find(key)->second;
+            keep(sum);
+        });
+
+        bench("unordered_map iterate", size, [&m] {
+            int sum{};
+            for (const auto& entry: m)
+                sum += entry.second;
+            keep(sum);
+        });
+
+        bench("unordered_map erase", size, [&keys, &m] {
+            auto copy{m};
+            for (auto key: keys)
+                copy.erase(key);
+            keep(copy.size());
+        });
+    }
+
+    template<class Map>
+    void map_benchmark::bench_churn_(const char* name, const char* cached_name,
+                                     const char* extract_name)
+    {
+        auto keys = make_keys();
+
+        Map m1{};
+        size_t pos1{};
+        fill_window(m1, keys);
+        bench(name, size, [&keys, &m1, &pos1] {
+            churn(m1, keys, pos1);
+            keep(m1.size());
+        });
+
+        Map m2{};
+        size_t pos2{};
+        m2.__node_cache_limit(16U);
+        fill_window(m2, keys);
+        bench(cached_name, size, [&keys, &m2, &pos2] {
+            churn(m2, keys, pos2);
+            keep(m2.size());
+        });
+
+        Map m3{};
+        size_t pos3{};
+        fill_window(m3, keys);
+        bench(extract_name, size, [&keys, &m3, &pos3] {
+            churn_extract(m3, keys, pos3);
+            keep(m3.size());
+        });
+    }
+
+    void map_benchmark::bench_churn()
+    {
+        bench_churn_<std::map<int, int>>(
+            "map churn", "map churn (node cache)",
+            "map churn (extract)"
+        );
+        bench_churn_<std::unordered_map<int, int>>(
+            "unordered_map churn", "unordered_map churn (node cache)",
+            "unordered_map churn (extract)"
+        );
+    }
+}
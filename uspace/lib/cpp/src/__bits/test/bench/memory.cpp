@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <memory>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t count = 1000;
+    }
+
+    void memory_benchmark::run()
+    {
+        auto ptr = std::make_shared<int>(1);
+
+        /**
+         * Reference point for the refcount fast path,
+         * this is what every copy cost before.
+         */
+        bench("atomic increment", count, [] {
+            long refcount{};
+            for (size_t i = 0; i < count; ++i)
+                __atomic_add_fetch(&refcount, 1, __ATOMIC_ACQ_REL);
+            keep(refcount);
+        });
+
+        bench("shared_ptr copy", count, [&ptr] {
+            std::vector<std::shared_ptr<int>> copies{};
+            copies.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+                copies.push_back(ptr);
+            keep(copies.size());
+        });
+
+        bench("shared_ptr copy and destroy", count, [&ptr] {
+            long sum{};
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto copy = ptr;
+                sum += *copy;
+            }
+            keep(sum);
+        });
+
+        bench("make_shared and destroy", count, [] {
+            long sum{};
+            for (size_t i = 0; i < count; ++i)
+                sum += *std::make_shared<int>(static_cast<int>(i));
+            keep(sum);
+        });
+
+        std::weak_ptr<int> wptr{ptr};
+        bench("weak_ptr lock", count, [&wptr] {
+            long sum{};
+            for (size_t i = 0; i < count; ++i)
+                sum += *wptr.lock();
+            keep(sum);
+        });
+
+        std::experimental::atomic_shared_ptr<int> aptr{ptr};
+        bench("atomic_shared_ptr load", count, [&aptr] {
+            long sum{};
+            for (size_t i = 0; i < count; ++i)
+                sum += *aptr.load();
+            keep(sum);
+        });
+    }
+
+    const char* memory_benchmark::name()
+    {
+        return "memory";
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t count = 1 << 16;
+    }
+
+    /**
+     * Compares single calls, bulk generation and a bulk
+     * uniform_int_distribution fill for the given engine.
+     */
+    template<class Engine>
+    void random_benchmark::bench_engine(const char* call_name,
+                                        const char* bulk_name,
+                                        const char* dist_name)
+    {
+        Engine g{42};
+        std::vector<typename Engine::result_type> raw(count);
+        std::vector<int> dice(count);
+
+        bench(call_name, count, [&g, &raw] {
+            for (auto& x: raw)
+                x = g();
+            benchmark_suite::keep(raw);
+        });
+
+        bench(bulk_name, count, [&g, &raw] {
+            if constexpr (is_same_v<Engine, std::mt19937_64>)
+            {
+                for (auto& x: raw)
+                    x = g();
+            }
+            else
+                g.generate(raw.begin(), raw.end());
+            benchmark_suite::keep(raw);
+        });
+
+        bench(dist_name, count, [&g, &dice] {
+            std::uniform_int_distribution<int> dist{1, 6};
+            dist.generate(dice.begin(), dice.end(), g);
+            benchmark_suite::keep(dice);
+        });
+    }
+
+    void random_benchmark::run()
+    {
+        bench_engine<std::mt19937_64>(
+            "mt19937_64 call", "mt19937_64 bulk", "mt19937_64 dice"
+        );
+        bench_engine<std::experimental::xoshiro256starstar>(
+            "xoshiro256** call", "xoshiro256** bulk", "xoshiro256** dice"
+        );
+        bench_engine<std::experimental::pcg64>(
+            "pcg64 call", "pcg64 bulk", "pcg64 dice"
+        );
+
+        bench("mt19937_64 seed", 1, [] {
+            std::mt19937_64 g{42};
+            benchmark_suite::keep(g);
+        });
+
+        bench("xoshiro256** seed", 1, [] {
+            std::experimental::xoshiro256starstar g{42};
+            benchmark_suite::keep(g);
+        });
+
+        bench("pcg64 seed", 1, [] {
+            std::experimental::pcg64 g{42};
+            benchmark_suite::keep(g);
+        });
+
+        std::vector<unsigned int> buf(count);
+        bench("random_device", count, [&buf] {
+            std::random_device rd{};
+            rd.generate(buf.begin(), buf.end());
+            benchmark_suite::keep(buf);
+        });
+    }
+
+    const char* random_benchmark::name()
+    {
+        return "random";
+    }
+}
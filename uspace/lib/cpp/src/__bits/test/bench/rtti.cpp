@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace std::test
+{
+    namespace
+    {
+        /**
+         * Single inheritance chain of the given depth,
+         * level<0> is the root.
+         */
+        template<int N>
+        struct level: level<N - 1>
+        {
+            int value{N};
+        };
+
+        template<>
+        struct level<0>
+        {
+            virtual ~level() = default;
+            int value{};
+        };
+
+        template<int N>
+        struct mixin
+        {
+            virtual ~mixin() = default;
+            int value{N};
+        };
+
+        /**
+         * The same depth with a second base at
+         * every level, the chain therefore uses
+         * __vmi_class_type_info.
+         */
+        template<int N>
+        struct mlevel: mlevel<N - 1>, mixin<N>
+        { /* DUMMY BODY */ };
+
+        template<>
+        struct mlevel<0>
+        {
+            virtual ~mlevel() = default;
+            int value{};
+        };
+
+        constexpr int depth = 16;
+
+        /**
+         * Prevents the compiler from knowing
+         * the dynamic type of the object.
+         */
+        template<class T>
+        T* launder(T* ptr)
+        {
+            asm volatile ("" : "+r" (ptr));
+
+            return ptr;
+        }
+    }
+
+    void rtti_benchmark::run()
+    {
+        level<depth> si{};
+        auto si_root = launder(static_cast<level<0>*>(&si));
+
+        bench("si downcast leaf", 1, [si_root] {
+            keep(dynamic_cast<level<depth>*>(si_root));
+        });
+
+        bench("si downcast middle", 1, [si_root] {
+            keep(dynamic_cast<level<depth / 2>*>(si_root));
+        });
+
+        level<depth / 2> si_half{};
+        auto si_half_root = launder(static_cast<level<0>*>(&si_half));
+
+        bench("si downcast fail", 1, [si_half_root] {
+            keep(dynamic_cast<level<depth>*>(si_half_root));
+        });
+
+        mlevel<depth> vmi{};
+        auto vmi_root = launder(static_cast<mlevel<0>*>(&vmi));
+
+        bench("vmi downcast leaf", 1, [vmi_root] {
+            keep(dynamic_cast<mlevel<depth>*>(vmi_root));
+        });
+
+        bench("vmi crosscast", 1, [vmi_root] {
+            keep(dynamic_cast<mixin<depth>*>(vmi_root));
+        });
+
+        std::unordered_map<std::type_index, int> types{};
+        types[typeid(level<1>)] = 1;
+        types[typeid(level<depth>)] = depth;
+        types[typeid(mlevel<depth>)] = depth;
+
+        bench("type_index lookup", 1, [&types, si_root] {
+            keep(types.find(typeid(*si_root))->second);
+        });
+    }
+
+    const char* rtti_benchmark::name()
+    {
+        return "rtti";
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace std::test
+{
+    void sort_benchmark::run()
+    {
+        constexpr size_t size = 10000;
+
+        std::vector<int> random(size);
+        unsigned int state{2463534242u};
+        for (auto& x: random)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            x = static_cast<int>(state);
+        }
+
+        std::vector<int> sorted{random};
+        std::sort(sorted.begin(), sorted.end());
+
+        std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+
+        /**
+         * Note: Every iteration sorts a fresh copy
+         *       of the input, so the copy is part
+         *       of the measured time.
+         */
+        auto sort_copy = [](const std::vector<int>& input) {
+            return [&input] {
+                std::vector<int> data{input};
+                std::sort(data.begin(), data.end());
+                keep(data.data());
+            };
+        };
+
+        bench("random", size, sort_copy(random));
+        bench("sorted", size, sort_copy(sorted));
+        bench("reversed", size, sort_copy(reversed));
+
+        bench("random greater", size, [&random] {
+            std::vector<int> data{random};
+            std::sort(data.begin(), data.end(), std::greater<int>{});
+            keep(data.data());
+        });
+
+        std::vector<std::string> strings{};
+        strings.reserve(size / 10);
+        for (size_t i = 0; i < size / 10; ++i)
+            strings.push_back(std::to_string(random[i]));
+
+        bench("strings", strings.size(), [&strings] {
+            std::vector<std::string> data{strings};
+            std::sort(data.begin(), data.end());
+            keep(data.data());
+        });
+    }
+
+    const char* sort_benchmark::name()
+    {
+        return "sort";
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t count = 1000000;
+
+        /**
+         * Whitespace separated integers with varying
+         * amounts of whitespace between them.
+         */
+        std::string make_input(size_t n)
+        {
+            std::ostringstream os{};
+            for (size_t i = 0; i < n; ++i)
+            {
+                os << static_cast<long>(i * 7919 % 100000) - 50000;
+                os << ((i % 8 == 7) ? "\n" : (i % 3 == 0) ? "  " : " ");
+            }
+
+            return os.str();
+        }
+    }
+
+    void stream_benchmark::run()
+    {
+        auto input = make_input(count);
+
+        bench("parse ints", count, [&input] {
+            std::istringstream is{input};
+            long sum{};
+            int x{};
+            while (is >> x)
+                sum += x;
+            keep(sum);
+        });
+
+        bench("parse words", count, [&input] {
+            std::istringstream is{input};
+            size_t len{};
+            std::string word{};
+            while (is >> word)
+                len += word.size();
+            keep(len);
+        });
+
+        bench("ctype classify", input.size(), [&input] {
+            const auto& ct = std::use_facet<std::ctype<char>>(std::locale{});
+            size_t spaces{};
+            for (auto c: input)
+            {
+                if (ct.is(std::ctype_base::space, c))
+                    ++spaces;
+            }
+            keep(spaces);
+        });
+    }
+
+    const char* stream_benchmark::name()
+    {
+        return "stream";
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <string>
+
+namespace std::test
+{
+    void string_benchmark::run()
+    {
+        bench("construct short", 1, [] {
+            std::string str{"short"};
+            keep(str.data());
+        });
+
+        bench("construct long", 1, [] {
+            std::string str{"a string that is long enough to need the heap"};
+            keep(str.data());
+        });
+
+        constexpr size_t size = 1000;
+
+        bench("append char", size, [] {
+            std::string str{};
+            for (size_t i = 0; i < size; ++i)
+                str.push_back('a' + (i % 26));
+            keep(str.data());
+        });
+
+        bench("append string", size, [] {
+            std::string str{};
+            for (size_t i = 0; i < size / 10; ++i)
+                str.append("0123456789");
+            keep(str.data());
+        });
+
+        std::string haystack(size * 10, 'a');
+        haystack.append("needle");
+
+        bench("find", haystack.size(), [&haystack] {
+            keep(haystack.find("needle"));
+        });
+
+        std::string other{haystack};
+        bench("compare", haystack.size(), [&haystack, &other] {
+            keep(haystack.compare(other));
+        });
+
+        bench("substr", 100, [&haystack] {
+            auto sub = haystack.substr(haystack.size() / 2, 100);
+            keep(sub.data());
+        });
+
+        bench("to_string", 1, [] {
+            auto str = std::to_string(1234567);
+            keep(str.data());
+        });
+    }
+
+    const char* string_benchmark::name()
+    {
+        return "string";
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <fibril.h>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        constexpr size_t workers = 4;
+        constexpr size_t lookups = 10000;
+        constexpr int keys = 64;
+
+        /**
+         * Memoizes an artificial expensive function, either
+         * in a cache shared by all threads and guarded by a
+         * mutex or in a thread_local cache.
+         */
+        int compute(int key)
+        {
+            int res{key};
+            for (int i = 0; i < 16; ++i)
+                res = res * 31 + i;
+
+            return res;
+        }
+
+        std::mutex shared_cache_mtx{};
+        std::unordered_map<int, int> shared_cache{};
+
+        int lookup_shared(int key)
+        {
+            std::lock_guard<std::mutex> guard{shared_cache_mtx};
+
+            auto it = shared_cache.find(key);
+            if (it != shared_cache.end())
+                return it->second;
+
+            return shared_cache.emplace(key, compute(key)).first->second;
+        }
+
+        int lookup_local(int key)
+        {
+            thread_local std::unordered_map<int, int> local_cache{};
+
+            auto it = local_cache.find(key);
+            if (it != local_cache.end())
+                return it->second;
+
+            return local_cache.emplace(key, compute(key)).first->second;
+        }
+
+        template<class Lookup>
+        void run_workers(Lookup lookup)
+        {
+            std::vector<std::thread> threads{};
+            threads.reserve(workers);
+
+            for (size_t i = 0; i < workers; ++i)
+            {
+                threads.emplace_back([lookup, i] {
+                    int sum{};
+                    for (size_t j = 0; j < lookups; ++j)
+                        sum += lookup(static_cast<int>((i + j) % keys));
+                    benchmark_suite::keep(sum);
+                });
+            }
+
+            for (auto& thr: threads)
+                thr.join();
+        }
+    }
+
+    void thread_local_benchmark::run()
+    {
+        // Contention needs the workers to run in parallel.
+        ::helenos::fibril_enable_multithreaded();
+
+        bench("mutex global", workers * lookups, [] {
+            run_workers(lookup_shared);
+        });
+
+        bench("thread_local", workers * lookups, [] {
+            run_workers(lookup_local);
+        });
+    }
+
+    const char* thread_local_benchmark::name()
+    {
+        return "thread_local";
+    }
+}
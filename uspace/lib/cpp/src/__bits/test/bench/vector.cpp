@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmarks.hpp>
+#include <numeric>
+#include <vector>
+
+namespace std::test
+{
+    void vector_benchmark::run()
+    {
+        constexpr size_t size = 10000;
+
+        bench("push_back", size, [] {
+            std::vector<int> vec{};
+            for (size_t i = 0; i < size; ++i)
+                vec.push_back(static_cast<int>(i));
+            keep(vec.data());
+        });
+
+        bench("push_back reserved", size, [] {
+            std::vector<int> vec{};
+            vec.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+                vec.push_back(static_cast<int>(i));
+            keep(vec.data());
+        });
+
+        std::vector<int> data(size);
+        std::iota(data.begin(), data.end(), 0);
+
+        bench("iterate", size, [&data] {
+            int sum{};
+            for (auto x: data)
+                sum += x;
+            keep(sum);
+        });
+
+        bench("copy", size, [&data] {
+            std::vector<int> copy{data};
+            keep(copy.data());
+        });
+
+        bench("insert front", 100, [] {
+            std::vector<int> vec{};
+            for (int i = 0; i < 100; ++i)
+                vec.insert(vec.begin(), i);
+            keep(vec.data());
+        });
+
+        bench("erase front", 100, [&data] {
+            std::vector<int> vec(data.begin(), data.begin() + 100);
+            while (!vec.empty())
+                vec.erase(vec.begin());
+            keep(vec.data());
+        });
+    }
+
+    const char* vector_benchmark::name()
+    {
+        return "vector";
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/benchmark.hpp>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace std::test
+{
+    void benchmark_suite::set_csv(FILE* csv)
+    {
+        csv_ = csv;
+    }
+
+    void benchmark_suite::set_samples(size_t samples)
+    {
+        if (samples > 0)
+            samples_ = samples;
+    }
+
+    unsigned int benchmark_suite::get_count() const noexcept
+    {
+        return count_;
+    }
+
+    benchmark_suite::result benchmark_suite::summarize(
+        vector<int64_t>& times, size_t iterations,
+        const aux::allocation_counters& counters
+    )
+    {
+        std::sort(times.begin(), times.end());
+
+        auto per_op = [iterations](int64_t t) {
+            return t / static_cast<int64_t>(iterations);
+        };
+
+        /**
+         * Nearest rank percentile, with fewer than
+         * 100 samples p99 is the slowest sample.
+         */
+        auto p99_idx = (times.size() * 99 + 99) / 100 - 1;
+
+        return result{
+            iterations,
+            per_op(times.front()),
+            per_op(times[times.size() / 2]),
+            per_op(times[p99_idx]),
+            iterations * times.size(),
+            counters.allocations,
+            counters.bytes
+        };
+    }
+
+    void benchmark_suite::report(const char* bname, size_t size, const result& res)
+    {
+        // Allocations per operation with two decimal places.
+        auto allocs = res.allocations * 100 / res.operations;
+
+        std::printf(
+            "[%s][%s][%zu] iters=%zu min=%" PRId64 "ns median=%" PRId64 "ns "
+            "p99=%" PRId64 "ns allocs/op=%zu.%02zu bytes/op=%zu\n",
+            name(), bname, size, res.iterations, res.min_nanos,
+            res.median_nanos, res.p99_nanos, allocs / 100, allocs % 100,
+            res.bytes / res.operations
+        );
+    }
+
+    void benchmark_suite::csv_entry(const char* bname, int run,
+                                    size_t size, int64_t nanos)
+    {
+        if (!csv_)
+            return;
+
+        /**
+         * Same format as the reports of hbench, so
+         * the same tools can be used to process them.
+         */
+        std::fprintf(csv_, "%s/%s,%d,%zu,%" PRId64 "\n",
+                     name(), bname, run, size, nanos);
+    }
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace std::test
+{
+    namespace
+    {
+        /**
+         * Small nodes so that a few hundred values
+         * already need several levels.
+         */
+        template<class Key, class Value>
+        using small_btree_map = std::experimental::btree_map<
+            Key, Value, std::less<Key>,
+            std::allocator<std::pair<const Key, Value>>, 4
+        >;
+
+        template<class Key, class Value>
+        using small_btree_multimap = std::experimental::btree_multimap<
+            Key, Value, std::less<Key>,
+            std::allocator<std::pair<const Key, Value>>, 4
+        >;
+
+        /**
+         * Same pseudo random permutation of
+         * [0, count) for every run.
+         */
+        std::vector<int> shuffled(int count)
+        {
+            std::vector<int> res{};
+            for (int i = 0; i < count; ++i)
+                res.push_back(i);
+
+            unsigned int state{2463534242u};
+            for (int i = count - 1; i > 0; --i)
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                std::swap(res[i], res[state % (i + 1)]);
+            }
+
+            return res;
+        }
+    }
+
+    bool btree_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_insert_find();
+        test_erase();
+        test_multi();
+        test_bulk_load();
+        test_set();
+
+        return end();
+    }
+
+    const char* btree_test::name()
+    {
+        return "btree";
+    }
+
+    void btree_test::test_insert_find()
+    {
+        small_btree_map<int, int> bmap{};
+        std::map<int, int> map{};
+        for (auto x: shuffled(500))
+        {
+            bmap.emplace(x, 2 * x);
+            map.emplace(x, 2 * x);
+        }
+
+        test_eq("size", bmap.size(), 500U);
+        test_eq("ordered", bmap.begin(), bmap.end(), map.begin(), map.end());
+        test_eq("reverse", bmap.rbegin(), bmap.rend(), map.rbegin(), map.rend());
+        test("tree grew", bmap.__height() > 3);
+
+        auto res1 = bmap.emplace(42, 0);
+        test("duplicate emplace", !res1.second);
+        test_eq("duplicate emplace keeps value", res1.first->second, 84);
+
+        test_eq("find", bmap.find(123)->second, 246);
+        test("find missing", bmap.find(500) == bmap.end());
+        test_eq("lower_bound", bmap.lower_bound(-1)->first, 0);
+        test_eq("upper_bound", bmap.upper_bound(10)->first, 11);
+        test("upper_bound end", bmap.upper_bound(499) == bmap.end());
+
+        bmap[1000] = 1;
+        test_eq("operator[] insert", bmap.size(), 501U);
+        bmap[1000] = 2;
+        test_eq("operator[] assign", bmap.at(1000), 2);
+
+        auto res2 = bmap.insert_or_assign(0, 7);
+        test("insert_or_assign existing", !res2.second);
+        test_eq("insert_or_assign value", bmap[0], 7);
+
+        auto copy = bmap;
+        test("copy equal", copy == bmap);
+        copy[1001] = 1;
+        test("copy independent", copy != bmap);
+    }
+
+    void btree_test::test_erase()
+    {
+        small_btree_map<int, int> bmap{};
+        std::map<int, int> map{};
+        for (auto x: shuffled(300))
+        {
+            bmap.emplace(x, x);
+            map.emplace(x, x);
+        }
+
+        for (int i = 0; i < 300; i += 3)
+        {
+            bmap.erase(i);
+            map.erase(i);
+        }
+        test_eq("erase by key", bmap.begin(), bmap.end(), map.begin(), map.end());
+
+        auto it1 = bmap.erase(bmap.find(100));
+        test_eq("erase returns next", it1->first, 101);
+        map.erase(100);
+
+        auto it2 = bmap.erase(bmap.lower_bound(50), bmap.lower_bound(200));
+        test_eq("erase range returns last", it2->first, 200);
+        for (int i = 50; i < 200; ++i)
+            map.erase(i);
+        test_eq("erase range", bmap.begin(), bmap.end(), map.begin(), map.end());
+
+        auto it3 = bmap.begin();
+        while (it3 != bmap.end())
+            it3 = bmap.erase(it3);
+        test("erase all", bmap.empty());
+        test_eq("erase all height", bmap.__height(), 0U);
+    }
+
+    void btree_test::test_multi()
+    {
+        small_btree_multimap<int, int> bmap{};
+        std::multimap<int, int> map{};
+        for (auto x: shuffled(200))
+        {
+            bmap.emplace(x % 20, x);
+            map.emplace(x % 20, x);
+        }
+
+        test_eq("multi size", bmap.size(), 200U);
+        test_eq("multi count", bmap.count(7), 10U);
+
+        auto range = bmap.equal_range(7);
+        bool all_equal{true};
+        for (auto it = range.first; it != range.second; ++it)
+            all_equal = all_equal && it->first == 7;
+        test("multi equal_range", all_equal);
+        test_eq("multi equal_range length", std::distance(range.first, range.second), 10);
+
+        test_eq("multi erase", bmap.erase(7), 10U);
+        map.erase(7);
+        test("multi erased", bmap.find(7) == bmap.end());
+
+        bool same_keys{bmap.size() == map.size()};
+        auto it1 = bmap.begin();
+        for (auto it2 = map.begin(); same_keys && it2 != map.end(); ++it1, ++it2)
+            same_keys = it1->first == it2->first;
+        test("multi ordered", same_keys);
+    }
+
+    void btree_test::test_bulk_load()
+    {
+        std::vector<std::pair<int, int>> sorted{};
+        for (int i = 0; i < 1000; ++i)
+            sorted.emplace_back(i, i);
+
+        small_btree_map<int, int> bmap{
+            std::experimental::sorted_range, sorted.begin(), sorted.end()
+        };
+        test_eq("bulk load size", bmap.size(), 1000U);
+
+        bool same{true};
+        auto it = bmap.begin();
+        for (const auto& x: sorted)
+        {
+            same = same && it->first == x.first;
+            ++it;
+        }
+        test("bulk load", same && it == bmap.end());
+        test_eq("bulk load find", bmap.find(777)->second, 777);
+
+        bmap.emplace(1000, 1000);
+        bmap.erase(0);
+        test_eq("modify after bulk load", bmap.begin()->first, 1);
+        test_eq("modify after bulk load size", bmap.size(), 1000U);
+
+        std::vector<int> dups{1, 1, 2, 3, 3, 3, 4};
+        std::experimental::btree_set<int> bset{};
+        bset.assign_sorted(dups.begin(), dups.end());
+        test_eq("bulk load skips duplicates", bset.size(), 4U);
+
+        std::experimental::btree_multiset<int> bmset{
+            std::experimental::sorted_range, dups.begin(), dups.end()
+        };
+        test_eq("multi bulk load", bmset.begin(), bmset.end(), dups.begin(), dups.end());
+    }
+
+    void btree_test::test_set()
+    {
+        auto check = {1, 2, 3, 5, 8, 13};
+        std::experimental::btree_set<int> bset{8, 3, 13, 1, 5, 2, 3, 8};
+
+        test_eq("set construction", bset.begin(), bset.end(), check.begin(), check.end());
+        test("set insert duplicate", !bset.insert(5).second);
+        test_eq("set lower_bound", *bset.lower_bound(4), 5);
+        test_eq("set count", bset.count(13), 1U);
+
+        std::experimental::btree_set<int> other{1, 2, 3, 5, 8, 14};
+        test("set less", bset < other);
+    }
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <__bits/test/tests.hpp>
+#include <coroutine>
+#include <functional>
+#include <type_traits>
+
+#include <fibril_synch.h>
+
+namespace
+{
+    template<class R, class = void>
+    struct has_promise_type: std::false_type
+    { /* DUMMY BODY */ };
+
+    template<class R>
+    struct has_promise_type<R, std::void_t<typename std::coroutine_traits<R>::promise_type>>
+        : std::true_type
+    { /* DUMMY BODY */ };
+
+    struct with_promise
+    {
+        struct promise_type
+        { /* DUMMY BODY */ };
+    };
+
+    /**
+     * Hand made frame with the layout compilers use,
+     * lets us test the handles on any compiler.
+     */
+    struct fake_promise
+    {
+        int resumed;
+        bool destroyed;
+    };
+
+    struct fake_frame
+    {
+        void (*resume)(void*);
+        void (*destroy)(void*);
+        fake_promise promise;
+    };
+
+    void fake_resume(void* addr)
+    {
+        auto frame = static_cast<fake_frame*>(addr);
+
+        ++frame->promise.resumed;
+        frame->resume = nullptr;
+    }
+
+    void fake_destroy(void* addr)
+    {
+        static_cast<fake_frame*>(addr)->promise.destroyed = true;
+    }
+
+#if LIBCPP_COROUTINES_SUPPORTED
+    int task_runs{};
+
+    std::experimental::task<int> answer()
+    {
+        ++task_runs;
+
+        co_return 41;
+    }
+
+    std::experimental::task<void> add_one(std::experimental::fibril_executor& ex,
+                                          int& res, ::helenos::fibril_semaphore_t& done)
+    {
+        co_await ex.schedule();
+
+        res = co_await answer() + 1;
+        ::helenos::fibril_semaphore_up(&done);
+    }
+#endif
+}
+
+namespace std::test
+{
+    bool coroutine_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_traits();
+        test_handles();
+        test_noop();
+        test_awaitables();
+        test_tasks();
+
+        return end();
+    }
+
+    const char* coroutine_test::name()
+    {
+        return "coroutine";
+    }
+
+    void coroutine_test::test_traits()
+    {
+        test("traits promise_type", is_same_v<
+            coroutine_traits<with_promise, int>::promise_type,
+            with_promise::promise_type
+        >);
+        test("traits without promise_type", !has_promise_type<int>::value);
+    }
+
+    void coroutine_test::test_handles()
+    {
+        coroutine_handle<> h1{};
+        test("null handle", !h1);
+        test_eq("null handle address", h1.address(), nullptr);
+
+        fake_frame frame{fake_resume, fake_destroy, {0, false}};
+        auto h2 = coroutine_handle<>::from_address(&frame);
+        test("from_address", static_cast<bool>(h2));
+        test_eq("address", h2.address(), static_cast<void*>(&frame));
+        test("comparison", h1 != h2 && h1 < h2 && h2 >= h1);
+        test_eq("hash", hash<coroutine_handle<>>{}(h2),
+                hash<coroutine_handle<>>{}(coroutine_handle<>::from_address(&frame)));
+
+        auto h3 = coroutine_handle<fake_promise>::from_promise(frame.promise);
+        test("from_promise", h3 == h2);
+        test_eq("promise", &h3.promise(), &frame.promise);
+
+        test("not done", !h2.done());
+        h2.resume();
+        test_eq("resume", frame.promise.resumed, 1);
+        test("done", h3.done());
+        h3.destroy();
+        test("destroy", frame.promise.destroyed);
+
+        h3 = nullptr;
+        test("assign nullptr", !h3);
+    }
+
+    void coroutine_test::test_noop()
+    {
+        auto h1 = noop_coroutine();
+        auto h2 = noop_coroutine();
+        test("noop handle", static_cast<bool>(h1));
+        test("noop never done", !h1.done());
+        test("noop handles equal", h1 == h2);
+
+        coroutine_handle<> h3 = h1;
+        h3.resume();
+        h1();
+        test("noop resume", !h3.done());
+        test_eq("noop promise", &h1.promise(), &h2.promise());
+    }
+
+    void coroutine_test::test_awaitables()
+    {
+        static_assert(suspend_never{}.await_ready());
+        static_assert(!suspend_always{}.await_ready());
+
+        test("suspend_never ready", suspend_never{}.await_ready());
+        test("suspend_always not ready", !suspend_always{}.await_ready());
+    }
+
+    void coroutine_test::test_tasks()
+    {
+#if LIBCPP_COROUTINES_SUPPORTED
+        task_runs = 0;
+        {
+            auto t = answer();
+            test("task is lazy", !t.done() && task_runs == 0);
+        }
+        test_eq("unstarted task destroyed", task_runs, 0);
+
+        experimental::fibril_executor ex{};
+        test("executor start", ex.start());
+
+        int res{};
+        ::helenos::fibril_semaphore_t done;
+        ::helenos::fibril_semaphore_initialize(&done, 0);
+
+        ex.spawn(add_one(ex, res, done));
+        ::helenos::fibril_semaphore_down(&done);
+        ex.stop();
+
+        test_eq("awaited task result", res, 42);
+        test_eq("awaited task ran once", task_runs, 1);
+#endif
+    }
+}
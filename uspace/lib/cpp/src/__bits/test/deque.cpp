@@ -42,6 +42,7 @@ namespace std::test
         test_resizing();
         test_push_pop();
         test_operations();
+        test_blocks();
 
         return end();
     }
@@ -239,14 +240,14 @@ namespace std::test
         std::deque<int> d3{d1};
         std::deque<int> d4{d1};
 
-        d1.insert(d1.begin() + 5, to_insert.begin(), to_insert.end());
+        d1.insert(d1.begin() + 4, to_insert.begin(), to_insert.end());
         test_eq(
             "insert iterator range",
             check1.begin(), check1.end(),
             d1.begin(), d1.end()
         );
 
-        d2.insert(d2.begin() + 5, to_insert);
+        d2.insert(d2.begin() + 4, to_insert);
         test_eq(
             "insert initializer list",
             check1.begin(), check1.end(),
@@ -257,7 +258,7 @@ namespace std::test
             1, 2, 3, 4, 99, 99, 99, 99, 99, 99, 99, 99,
             5, 6, 7, 8, 9, 10, 11, 12
         };
-        d3.insert(d3.begin() + 5, 8U, 99);
+        d3.insert(d3.begin() + 4, 8U, 99);
         test_eq(
             "insert value n times",
             check2.begin(), check2.end(),
@@ -280,6 +281,24 @@ namespace std::test
             d3.begin(), d3.end()
         );
 
+        auto check5 = {1, 2, 3, 4, 5, 6, 7, 8, 42, 9, 10, 12};
+        d3.emplace(d3.begin() + 8, 42);
+        test_eq(
+            "emplace near back",
+            check5.begin(), check5.end(),
+            d3.begin(), d3.end()
+        );
+
+        auto check6 = {1, 42, 2, 3, 4, 5, 6, 7, 8, 42, 9, 10, 12};
+        d3.insert(d3.begin() + 1, 42);
+        test_eq(
+            "insert near front",
+            check6.begin(), check6.end(),
+            d3.begin(), d3.end()
+        );
+
+        d3.erase(d3.begin() + 1);
+        d3.erase(d3.begin() + 8);
         d2.swap(d3);
         test_eq(
             "swap1",
@@ -292,4 +311,52 @@ namespace std::test
             d2.begin(), d2.end()
         );
     }
+
+    void deque_test::test_blocks()
+    {
+        /**
+         * Enough elements to span several blocks
+         * and wrap around the block map.
+         */
+        std::deque<int> d1{};
+        for (int i = 0; i < 5000; ++i)
+        {
+            d1.push_back(i);
+            if (i >= 1000)
+                d1.pop_front();
+        }
+        test_eq("queue use size", d1.size(), 1000U);
+        test_eq("queue use front", d1.front(), 4000);
+        test_eq("queue use back", d1.back(), 4999);
+
+        bool ok{true};
+        for (size_t i = 0; i < d1.size(); ++i)
+            ok = ok && d1[i] == static_cast<int>(4000 + i);
+        test("queue use random access", ok);
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            d1.push_front(i);
+            d1.pop_back();
+        }
+        test_eq("reverse queue use front", d1.front(), 4999);
+        test_eq("reverse queue use back", d1.back(), 4000);
+
+        std::deque<int> d2{};
+        for (int i = 0; i < 1000; ++i)
+            d2.push_front(i);
+        d2.insert(d2.begin() + 500, d1.begin(), d1.end());
+        test_eq("large insert size", d2.size(), 2000U);
+        test_eq("large insert first", d2[500], 4999);
+        test_eq("large insert last", d2[1499], 4000);
+        test_eq("large insert after", d2[1500], 499);
+
+        d2.erase(d2.begin() + 100, d2.begin() + 1900);
+        test_eq("large erase size", d2.size(), 200U);
+        test_eq("large erase front side", d2[99], 900);
+        test_eq("large erase back side", d2[100], 99);
+
+        d2.shrink_to_fit();
+        test_eq("shrink_to_fit keeps elements", d2[150], 49);
+    }
 }
@@ -33,6 +33,7 @@
 #include <future>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -66,6 +67,7 @@ namespace std::test
         test_async();
         test_packaged_task();
         test_shared_future();
+        test_continuations();
 
         return end();
     }
@@ -348,4 +350,77 @@ namespace std::test
         test_eq("first result correct", res1, 42);
         test_eq("second result correct", res2, 42);
     }
+
+    void future_test::test_continuations()
+    {
+        auto [p1, f1, s1] = prepare<int>();
+        auto f2 = f1.then([](std::future<int> f){ return f.get() * 2; });
+        test("future invalid after then", !f1.valid());
+        test("continuation not run before ready", !f2.__state()->is_set());
+
+        p1.set_value(21);
+        test("continuation run on set_value", f2.__state()->is_set());
+        test_eq("continuation result", f2.get(), 42);
+
+        auto [p2, f3, s2] = prepare<int>();
+        p2.set_value(1);
+        auto f4 = f3.then([](std::future<int> f){ return f.get() + 1; })
+                    .then([](std::future<int> f){ return f.get() + 1; });
+        test_eq("continuation chain on ready state", f4.get(), 3);
+
+        auto [p3, f5, s3] = prepare<void>();
+        int called{};
+        auto f6 = f5.then([&called](std::future<void>){ ++called; });
+        p3.set_value();
+        f6.get();
+        test_eq("void continuation", called, 1);
+
+        std::vector<std::promise<int>> ps{};
+        std::vector<std::future<int>> fs{};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            ps.push_back(std::promise<int>{});
+            fs.push_back(ps.back().get_future());
+        }
+
+        auto all1 = std::experimental::when_all(fs.begin(), fs.end());
+        for (size_t i = 0; i < ps.size(); ++i)
+        {
+            test("when_all not ready early", !all1.__state()->is_set());
+            ps[i].set_value(static_cast<int>(i));
+        }
+        test("when_all ready", all1.__state()->is_set());
+
+        auto res1 = all1.get();
+        int sum{};
+        for (auto& f: res1)
+            sum += f.get();
+        test_eq("when_all results", sum, 6);
+
+        auto [p4, f7, s4] = prepare<int>();
+        auto [p5, f8, s5] = prepare<int>();
+        auto all2 = std::experimental::when_all(std::move(f7), std::move(f8));
+        p5.set_value(2);
+        p4.set_value(1);
+        auto res2 = all2.get();
+        test_eq("when_all tuple first", std::get<0>(res2).get(), 1);
+        test_eq("when_all tuple second", std::get<1>(res2).get(), 2);
+
+        auto [p6, f9, s6] = prepare<int>();
+        auto [p7, f10, s7] = prepare<int>();
+        auto any1 = std::experimental::when_any(std::move(f9), std::move(f10));
+        test("when_any not ready early", !any1.__state()->is_set());
+        p7.set_value(7);
+        test("when_any ready after one", any1.__state()->is_set());
+
+        auto res3 = any1.get();
+        test_eq("when_any index", res3.index, 1U);
+        test_eq("when_any result", std::get<1>(res3.futures).get(), 7);
+        p6.set_value(6);
+        test_eq("when_any other future", std::get<0>(res3.futures).get(), 6);
+
+        std::vector<std::future<int>> empty{};
+        auto any2 = std::experimental::when_any(empty.begin(), empty.end());
+        test_eq("when_any on empty range", any2.get().index, static_cast<size_t>(-1));
+    }
 }
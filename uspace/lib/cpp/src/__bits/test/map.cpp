@@ -47,6 +47,7 @@ namespace std::test
         test_multi();
         test_reverse_iterators();
         test_multi_bounds_and_ranges();
+        test_node_handles();
 
         return end();
     }
@@ -431,4 +432,97 @@ namespace std::test
             res3.first, res3.second
         );
     }
+
+    void map_test::test_node_handles()
+    {
+        auto check1 = {
+            std::pair<const int, int>{1, 1},
+            std::pair<const int, int>{3, 3},
+            std::pair<const int, int>{4, 4}
+        };
+        auto check2 = {
+            std::pair<const int, int>{2, 20},
+            std::pair<const int, int>{5, 5}
+        };
+
+        std::map<int, int> m1{
+            {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}
+        };
+        std::map<int, int> m2{};
+
+        auto nh1 = m1.extract(2);
+        test("extract by key", !nh1.empty());
+        test_eq("extract by key - size", m1.size(), 4U);
+        test_eq("extract by key - key", nh1.key(), 2);
+
+        nh1.mapped() = 20;
+        auto res1 = m2.insert(std::move(nh1));
+        test("insert node", res1.inserted);
+        test("insert node - handle moved from", res1.node.empty());
+        test_eq("insert node - position", res1.position->second, 20);
+
+        auto nh2 = m1.extract(m1.find(5));
+        test_eq("extract by iterator", nh2.key(), 5);
+        m2.insert(m2.end(), std::move(nh2));
+        test_eq(
+            "extract from source",
+            check1.begin(), check1.end(),
+            m1.begin(), m1.end()
+        );
+        test_eq(
+            "insert into target",
+            check2.begin(), check2.end(),
+            m2.begin(), m2.end()
+        );
+
+        auto nh3 = m1.extract(42);
+        test("extract missing key", nh3.empty());
+
+        auto nh4 = m1.extract(1);
+        nh4.key() = 2;
+        auto res2 = m2.insert(std::move(nh4));
+        test("insert duplicate", !res2.inserted);
+        test("insert duplicate - handle returned", !res2.node.empty());
+        test_eq("insert duplicate - position", res2.position->second, 20);
+        m1.insert(std::move(res2.node)); // Reinserted as {2, 1}.
+
+        /**
+         * Note: m1 = {2: 1, 3: 3, 4: 4}, m2 = {2: 20, 5: 5},
+         *       the merge moves 3 and 4 and leaves 2 in m1.
+         */
+        m2.merge(m1);
+        test_eq("merge - source size", m1.size(), 1U);
+        test_eq("merge - conflict left in source", m1.begin()->second, 1);
+        test_eq("merge - target size", m2.size(), 4U);
+
+        std::multimap<int, int> mm{{1, 1}, {1, 2}, {3, 3}, {2, 4}};
+        auto nh5 = mm.extract(1);
+        test_eq("multi extract first equivalent", nh5.mapped(), 1);
+        mm.insert(std::move(nh5));
+        test_eq("multi insert node", mm.count(1), 2U);
+
+        auto it = mm.find(1);
+        ++it; // Second of the equivalent keys.
+        auto nh6 = mm.extract(it);
+        test_eq("multi extract from list", nh6.mapped(), 1);
+        test_eq("multi extract from list - count", mm.count(1), 1U);
+
+        std::map<int, int> m3{{1, 10}, {3, 30}};
+        m3.merge(mm);
+        test_eq("merge multi into single", m3.size(), 3U);
+        test_eq("merge multi into single - source", mm.size(), 2U);
+        test_eq("merge multi into single - conflict", mm.begin()->first, 1);
+
+        std::map<int, int> m4{};
+        m4.__node_cache_limit(2U);
+        for (int i = 0; i < 10; ++i)
+            m4.emplace(i, i);
+        for (int i = 0; i < 10; ++i)
+            m4.erase(i);
+        test_eq("node cache size", m4.__node_cache_size(), 2U);
+        m4.emplace(1, 1);
+        test_eq("node cache reuse", m4.__node_cache_size(), 1U);
+        m4.__node_cache_limit(0U);
+        test_eq("node cache disable", m4.__node_cache_size(), 0U);
+    }
 }
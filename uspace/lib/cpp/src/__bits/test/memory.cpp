@@ -92,6 +92,7 @@ namespace std::test
         test_unique_ptr();
         test_shared_ptr();
         test_weak_ptr();
+        test_atomic_access();
         test_allocators();
         test_pointers();
 
@@ -201,6 +202,52 @@ namespace std::test
         }
     }
 
+    void memory_test::test_atomic_access()
+    {
+        mock::clear();
+        {
+            auto ptr1 = std::make_shared<mock>();
+            auto ptr2 = std::make_shared<mock>();
+
+            auto loaded = std::atomic_load(&ptr1);
+            test_eq("atomic_load shares ownership", ptr1.use_count(), 2L);
+
+            std::atomic_store(&loaded, ptr2);
+            test_eq("atomic_store releases old value", ptr1.use_count(), 1L);
+            test_eq("atomic_store stores new value", loaded.get(), ptr2.get());
+
+            auto old = std::atomic_exchange(&loaded, ptr1);
+            test_eq("atomic_exchange returns old value", old.get(), ptr2.get());
+            test_eq("atomic_exchange stores new value", loaded.get(), ptr1.get());
+
+            auto expected = ptr2;
+            auto res = std::atomic_compare_exchange_strong(&loaded, &expected, ptr2);
+            test_eq("atomic_compare_exchange fail", res, false);
+            test_eq("atomic_compare_exchange fail updates expected", expected.get(), ptr1.get());
+
+            res = std::atomic_compare_exchange_strong(&loaded, &expected, ptr2);
+            test_eq("atomic_compare_exchange success", res, true);
+            test_eq("atomic_compare_exchange success stores", loaded.get(), ptr2.get());
+
+            std::shared_ptr<mock> alias{ptr2, ptr1.get()};
+            expected = std::shared_ptr<mock>{ptr1, ptr2.get()};
+            res = std::atomic_compare_exchange_strong(&loaded, &expected, alias);
+            test_eq("atomic_compare_exchange checks ownership", res, false);
+
+            std::experimental::atomic_shared_ptr<mock> aptr{ptr1};
+            test_eq("atomic_shared_ptr load", aptr.load().get(), ptr1.get());
+
+            aptr = ptr2;
+            test_eq("atomic_shared_ptr store", aptr.load().get(), ptr2.get());
+
+            expected = ptr2;
+            res = aptr.compare_exchange_weak(expected, nullptr);
+            test_eq("atomic_shared_ptr compare_exchange", res, true);
+            test_eq("atomic_shared_ptr compare_exchange stores", aptr.load().get(), (mock*)nullptr);
+        }
+        test_eq("atomic access does not leak", mock::destructor_calls, 2U);
+    }
+
     void memory_test::test_allocators()
     {
         using dummy_traits1 = std::allocator_traits<aux::dummy_allocator1>;
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace std::test
+{
+    bool random_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_engines();
+        test_random_device();
+        test_distributions();
+
+        return end();
+    }
+
+    const char* random_test::name()
+    {
+        return "random";
+    }
+
+    void random_test::test_engines()
+    {
+        /**
+         * Reference values computed with the reference
+         * implementations, xoshiro256** seeded by splitmix64.
+         */
+        std::experimental::xoshiro256starstar x1{42};
+        test_eq("xoshiro256** first", x1(), 0x15780b2e0c2ec716ULL);
+        test_eq("xoshiro256** second", x1(), 0x6104d9866d113a7eULL);
+        test_eq("xoshiro256** third", x1(), 0xae17533239e499a1ULL);
+
+        std::experimental::pcg64 p1{42};
+        test_eq("pcg64 first", p1(), 0x287472e87ff5705aULL);
+        test_eq("pcg64 second", p1(), 0xbbd190b04ed0b545ULL);
+        test_eq("pcg64 third", p1(), 0xb6cee3580db14880ULL);
+
+        std::experimental::xoshiro256starstar x2{42};
+        x2.discard(3);
+        test("xoshiro256** discard", x1 == x2);
+
+        std::experimental::pcg64 p2{42};
+        p2.discard(3);
+        test("pcg64 discard", p1 == p2);
+
+        std::vector<uint64_t> bulk(3);
+        std::experimental::pcg64 p3{42};
+        p3.generate(bulk.begin(), bulk.end());
+        test_eq("pcg64 generate", bulk[2], 0xb6cee3580db14880ULL);
+        test("pcg64 generate advances", p1 == p3);
+
+        std::experimental::xoshiro256starstar x3{42};
+        x3.jump();
+        test("xoshiro256** jump", x3 != x2);
+
+        std::seed_seq seq{1, 2, 3};
+        std::experimental::xoshiro256starstar x4{seq};
+        std::seed_seq seq2{1, 2, 3};
+        std::experimental::xoshiro256starstar x5{seq2};
+        test("seed_seq seeding deterministic", x4 == x5);
+    }
+
+    void random_test::test_random_device()
+    {
+        std::random_device rd1{};
+        std::random_device rd2{"sw"};
+        test_eq("sw random_device has no entropy", rd2.entropy(), 0.0);
+
+        std::random_device rd3{"sw"};
+        bool differ{false};
+        for (int i = 0; i < 4; ++i)
+            differ = differ || rd2() != rd3();
+        test("sw random_devices differ", differ);
+
+        std::vector<unsigned int> vals(100);
+        rd1.generate(vals.begin(), vals.end());
+        bool all_same{true};
+        for (auto v: vals)
+            all_same = all_same && v == vals[0];
+        test("random_device generate", !all_same);
+    }
+
+    void random_test::test_distributions()
+    {
+        std::experimental::xoshiro256starstar g{};
+        std::uniform_int_distribution<int> d1{1, 6};
+
+        std::vector<int> vals(1000);
+        d1.generate(vals.begin(), vals.end(), g);
+
+        bool in_range{true};
+        for (auto v: vals)
+            in_range = in_range && 1 <= v && v <= 6;
+        test("uniform_int generate in range", in_range);
+
+        std::uniform_real_distribution<double> d2{0.0, 1.0};
+        std::vector<double> reals(1000);
+        d2.generate(reals.begin(), reals.end(), g);
+
+        in_range = true;
+        for (auto v: reals)
+            in_range = in_range && 0.0 <= v && v < 1.0;
+        test("uniform_real generate in range", in_range);
+    }
+}
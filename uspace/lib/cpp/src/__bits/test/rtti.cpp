@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace std::test
+{
+    namespace
+    {
+        struct base
+        {
+            virtual ~base() = default;
+            int b{1};
+        };
+
+        struct derived: base
+        {
+            int d{2};
+        };
+
+        struct more_derived: derived
+        {
+            int md{3};
+        };
+
+        struct other
+        {
+            virtual ~other() = default;
+            int o{4};
+        };
+
+        struct multi: derived, other
+        {
+            int m{5};
+        };
+
+        struct left: virtual base
+        {
+            int l{6};
+        };
+
+        struct right: virtual base
+        {
+            int r{7};
+        };
+
+        struct diamond: left, right
+        {
+            int dm{8};
+        };
+
+        struct left_nv: base
+        { /* DUMMY BODY */ };
+
+        struct right_nv: base
+        { /* DUMMY BODY */ };
+
+        struct repeated: left_nv, right_nv
+        { /* DUMMY BODY */ };
+
+        struct hidden: private base
+        {
+            base* as_base()
+            {
+                return this;
+            }
+        };
+    }
+
+    bool rtti_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_type_info();
+        test_dynamic_cast();
+
+        return end();
+    }
+
+    const char* rtti_test::name()
+    {
+        return "rtti";
+    }
+
+    void rtti_test::test_type_info()
+    {
+        test("type_info equality pt1", typeid(derived) == typeid(derived));
+        test("type_info equality pt2", typeid(derived) != typeid(base));
+        test_eq("hash_code", typeid(int).hash_code(), typeid(int).hash_code());
+        test("before", typeid(int).before(typeid(long)) != typeid(long).before(typeid(int)));
+
+        std::unordered_map<std::type_index, int> map{};
+        map[typeid(base)] = 1;
+        map[typeid(derived)] = 2;
+        map[typeid(multi)] = 3;
+        test_eq("type_index key pt1", map.size(), 3U);
+        test_eq("type_index key pt2", map[typeid(derived)], 2);
+    }
+
+    void rtti_test::test_dynamic_cast()
+    {
+        more_derived md{};
+        base* b1 = &md;
+        test_eq("downcast", dynamic_cast<derived*>(b1), static_cast<derived*>(&md));
+        test_eq("downcast most derived", dynamic_cast<more_derived*>(b1), &md);
+
+        base b{};
+        base* b0 = &b;
+        test_eq("downcast fail", dynamic_cast<derived*>(b0), static_cast<derived*>(nullptr));
+
+        multi m{};
+        base* b2 = &m;
+        test_eq("multiple downcast", dynamic_cast<multi*>(b2), &m);
+        test_eq("crosscast", dynamic_cast<other*>(b2), static_cast<other*>(&m));
+
+        other* o = &m;
+        test_eq("crosscast back", dynamic_cast<derived*>(o), static_cast<derived*>(&m));
+        test_eq("cast to void", dynamic_cast<void*>(o), static_cast<void*>(&m));
+
+        diamond d{};
+        base* b3 = static_cast<left*>(&d);
+        test_eq("virtual base downcast", dynamic_cast<diamond*>(b3), &d);
+        test_eq("virtual base crosscast", dynamic_cast<right*>(b3), static_cast<right*>(&d));
+
+        repeated r{};
+        base* b4 = static_cast<left_nv*>(&r);
+        test_eq("repeated base downcast", dynamic_cast<repeated*>(b4), &r);
+        test_eq("repeated base sibling", dynamic_cast<right_nv*>(b4), static_cast<right_nv*>(&r));
+
+        hidden h{};
+        test_eq("private base", dynamic_cast<hidden*>(h.as_base()), static_cast<hidden*>(nullptr));
+
+        // Repeated casts are served from the cache.
+        for (int i = 0; i < 3; ++i)
+        {
+            test_eq("cached downcast", dynamic_cast<multi*>(b2), &m);
+            test_eq("cached fail", dynamic_cast<derived*>(b0), static_cast<derived*>(nullptr));
+        }
+    }
+}
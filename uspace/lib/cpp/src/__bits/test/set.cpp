@@ -45,6 +45,7 @@ namespace std::test
         test_multi();
         test_reverse_iterators();
         test_multi_bounds_and_ranges();
+        test_node_handles();
 
         return end();
     }
@@ -298,4 +299,55 @@ namespace std::test
             res3.first, res3.second
         );
     }
+
+    void set_test::test_node_handles()
+    {
+        auto check1 = {1, 3, 5};
+        auto check2 = {2, 4, 6};
+
+        std::set<int> s1{1, 2, 3, 4, 5};
+        std::set<int> s2{6};
+
+        auto nh1 = s1.extract(2);
+        test_eq("extract by key", nh1.value(), 2);
+        auto res1 = s2.insert(std::move(nh1));
+        test("insert node", res1.inserted);
+        test_eq("insert node - position", *res1.position, 2);
+
+        auto nh2 = s1.extract(s1.find(4));
+        s2.insert(s2.begin(), std::move(nh2));
+        test_eq(
+            "extract from source",
+            check1.begin(), check1.end(),
+            s1.begin(), s1.end()
+        );
+        test_eq(
+            "insert into target",
+            check2.begin(), check2.end(),
+            s2.begin(), s2.end()
+        );
+
+        auto nh3 = s1.extract(3);
+        nh3.value() = 2;
+        auto res2 = s2.insert(std::move(nh3));
+        test("insert duplicate", !res2.inserted);
+        test_eq("insert duplicate - handle returned", res2.node.value(), 2);
+
+        std::set<int> s3{1, 2, 7};
+        s3.merge(s2);
+        test_eq("merge - target size", s3.size(), 5U);
+        test_eq("merge - source size", s2.size(), 1U);
+        test_eq("merge - conflict left in source", *s2.begin(), 2);
+
+        std::multiset<int> ms{1, 1, 2};
+        ms.merge(s3);
+        test_eq("multi merge - count", ms.count(1), 3U);
+        test_eq("multi merge - size", ms.size(), 8U);
+        test("multi merge - source empty", s3.empty());
+
+        auto nh4 = ms.extract(1);
+        test_eq("multi extract", ms.count(1), 2U);
+        ms.insert(std::move(nh4));
+        test_eq("multi insert node", ms.count(1), 3U);
+    }
 }
@@ -30,6 +30,8 @@
 #include <__bits/test/tests.hpp>
 #include <string>
 #include <cstdio>
+#include <locale>
+#include <sstream>
 
 namespace std::test
 {
@@ -47,6 +49,7 @@ namespace std::test
         test_find();
         test_substr();
         test_compare();
+        test_extraction();
 
         return end();
     }
@@ -703,4 +706,36 @@ namespace std::test
             res, 0
         );
     }
+
+    void string_test::test_extraction()
+    {
+        const auto& ct = std::use_facet<std::ctype<char>>(std::locale{});
+        test("ctype space", ct.is(std::ctype_base::space, '\t'));
+        test("ctype not space", !ct.is(std::ctype_base::space, 'a'));
+        test("ctype xdigit", ct.is(std::ctype_base::xdigit, 'F'));
+        test("ctype punct", ct.is(std::ctype_base::punct, '!'));
+        test("ctype alnum", !ct.is(std::ctype_base::alnum, '_'));
+        test("ctype high chars", !ct.is(std::ctype_base::print, '\xE9'));
+
+        const char str[] = "  ab12\n";
+        auto res = ct.scan_not(std::ctype_base::space, str, str + sizeof(str) - 1);
+        test_eq("ctype scan_not", res, str + 2);
+        res = ct.scan_is(std::ctype_base::digit, str, str + sizeof(str) - 1);
+        test_eq("ctype scan_is", res, str + 4);
+
+        std::istringstream is{" 12\t-34\n\n 56 word  "};
+        int x{}, y{}, z{};
+        is >> x >> y >> z;
+        test_eq("extraction first", x, 12);
+        test_eq("extraction second", y, -34);
+        test_eq("extraction third", z, 56);
+
+        std::string word{};
+        is >> word;
+        test_eq("extraction string", word, std::string{"word"});
+
+        is >> x;
+        test("extraction trailing whitespace sets eof", is.eof());
+        test("extraction trailing whitespace fails", is.fail());
+    }
 }
@@ -44,6 +44,7 @@ namespace std::test
         test_histogram();
         test_emplace_insert();
         test_multi();
+        test_node_handles();
 
         return end();
     }
@@ -263,4 +264,68 @@ namespace std::test
         test_eq("multi erase by iterator pt1", res7->first, 7);
         test_eq("multi erase by iterator pt2", mmap.count(7), 1U);
     }
+
+    void unordered_map_test::test_node_handles()
+    {
+        auto check1 = {1, 3, 4};
+        auto check2 = {2, 5, 6};
+
+        std::unordered_map<int, int> m1{
+            {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}
+        };
+        std::unordered_map<int, int> m2{{6, 6}};
+
+        auto nh1 = m1.extract(2);
+        test_eq("extract by key", nh1.key(), 2);
+        nh1.mapped() = 20;
+        auto res1 = m2.insert(std::move(nh1));
+        test("insert node", res1.inserted);
+        test("insert node - handle moved from", res1.node.empty());
+        test_eq("insert node - position", res1.position->second, 20);
+
+        auto nh2 = m1.extract(m1.find(5));
+        m2.insert(m2.end(), std::move(nh2));
+        test_contains(
+            "extract from source",
+            check1.begin(), check1.end(), m1
+        );
+        test_contains(
+            "insert into target",
+            check2.begin(), check2.end(), m2
+        );
+        test("extract missing key", m1.extract(42).empty());
+
+        auto nh3 = m1.extract(1);
+        nh3.key() = 2;
+        auto res2 = m2.insert(std::move(nh3));
+        test("insert duplicate", !res2.inserted);
+        test_eq("insert duplicate - position", res2.position->second, 20);
+        m1.insert(std::move(res2.node)); // Reinserted as {2, 1}.
+
+        m2.merge(m1);
+        test_eq("merge - source size", m1.size(), 1U);
+        test_eq("merge - conflict left in source", m1.begin()->second, 1);
+        test_eq("merge - target size", m2.size(), 5U);
+
+        std::unordered_multimap<int, int> mm{{2, 2}, {7, 7}};
+        mm.merge(m2);
+        test_eq("multi merge - count", mm.count(2), 2U);
+        test_eq("multi merge - size", mm.size(), 7U);
+        test("multi merge - source empty", m2.empty());
+
+        auto nh4 = mm.extract(2);
+        test_eq("multi extract", mm.count(2), 1U);
+        mm.insert(std::move(nh4));
+        test_eq("multi insert node", mm.count(2), 2U);
+
+        std::unordered_map<int, int> m3{};
+        m3.__node_cache_limit(4U);
+        for (int i = 0; i < 10; ++i)
+            m3.emplace(i, i);
+        for (int i = 0; i < 10; ++i)
+            m3.erase(i);
+        test_eq("node cache size", m3.__node_cache_size(), 4U);
+        m3.emplace(1, 1);
+        test_eq("node cache reuse", m3.__node_cache_size(), 3U);
+    }
 }
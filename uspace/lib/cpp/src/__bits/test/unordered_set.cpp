@@ -42,6 +42,7 @@ namespace std::test
         test_constructors_and_assignment();
         test_emplace_insert();
         test_multi();
+        test_node_handles();
 
         return end();
     }
@@ -211,4 +212,46 @@ namespace std::test
         test_eq("multi erase by iterator pt1", *res7, 7);
         test_eq("multi erase by iterator pt2", mset.count(7), 1U);
     }
+
+    void unordered_set_test::test_node_handles()
+    {
+        auto check1 = {1, 3, 5};
+        auto check2 = {2, 4, 6};
+
+        std::unordered_set<int> s1{1, 2, 3, 4, 5};
+        std::unordered_set<int> s2{6};
+
+        auto nh1 = s1.extract(2);
+        test_eq("extract by key", nh1.value(), 2);
+        auto res1 = s2.insert(std::move(nh1));
+        test("insert node", res1.inserted);
+        test_eq("insert node - position", *res1.position, 2);
+
+        s2.insert(s2.end(), s1.extract(s1.find(4)));
+        test_contains(
+            "extract from source",
+            check1.begin(), check1.end(), s1
+        );
+        test_contains(
+            "insert into target",
+            check2.begin(), check2.end(), s2
+        );
+
+        auto nh2 = s1.extract(3);
+        nh2.value() = 2;
+        auto res2 = s2.insert(std::move(nh2));
+        test("insert duplicate", !res2.inserted);
+        test_eq("insert duplicate - handle returned", res2.node.value(), 2);
+
+        std::unordered_set<int> s3{1, 2, 7};
+        s3.merge(s2);
+        test_eq("merge - target size", s3.size(), 5U);
+        test_eq("merge - source size", s2.size(), 1U);
+
+        std::unordered_multiset<int> ms{1, 1, 2};
+        ms.merge(s3);
+        test_eq("multi merge - count", ms.count(1), 3U);
+        test_eq("multi merge - size", ms.size(), 8U);
+        test("multi merge - source empty", s3.empty());
+    }
 }
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <fibril.h>
+
+namespace std::chrono
+{
+    namespace
+    {
+        int64_t uptime_nanos()
+        {
+            ::std::timespec ts{};
+            ::helenos::getuptime(&ts);
+
+            return ts.tv_sec * 1'000'000'000ll + ts.tv_nsec;
+        }
+
+#if defined(__x86_64__) || defined(__i386__)
+        inline uint64_t read_cycles()
+        {
+            uint32_t lo, hi;
+            asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+
+            return (static_cast<uint64_t>(hi) << 32) | lo;
+        }
+
+        /**
+         * The TSC can only be used as a clock if it runs
+         * at a constant rate in all power states, which is
+         * reported by CPUID as the invariant TSC.
+         */
+        bool has_usable_cycles()
+        {
+            uint32_t eax{0x80000000}, ebx{}, ecx{}, edx{};
+            asm volatile ("cpuid" : "+a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx));
+            if (eax < 0x80000007)
+                return false;
+
+            eax = 0x80000007;
+            asm volatile ("cpuid" : "+a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx));
+
+            return (edx & (1 << 8)) != 0;
+        }
+#else
+        inline uint64_t read_cycles()
+        {
+            return 0;
+        }
+
+        bool has_usable_cycles()
+        {
+            return false;
+        }
+#endif
+
+        enum class calibration: int
+        {
+            none,
+            running,
+            cycles,
+            uptime
+        };
+
+        int state{static_cast<int>(calibration::none)};
+
+        /**
+         * Conversion of cycles since base_cycles to
+         * nanoseconds since base_nanos, the number of
+         * nanoseconds per cycle is stored in 32.32
+         * fixed point format.
+         */
+        uint64_t base_cycles{};
+        int64_t base_nanos{};
+        uint64_t nanos_per_cycle{};
+
+        /**
+         * The uptime only advances once per clock tick, so the
+         * calibration measures between two tick edges over at
+         * least this many microseconds (10 ticks at HZ=100),
+         * which keeps the error of the rate well below 1%.
+         */
+        constexpr int64_t calibration_usecs{100'000};
+
+        /**
+         * Spin until the uptime advances, and return the
+         * new uptime together with the cycle count right
+         * after the change was observed.
+         */
+        int64_t uptime_edge(uint64_t& cycles)
+        {
+            auto start = uptime_nanos();
+            int64_t now{};
+
+            do
+            {
+                now = uptime_nanos();
+            } while (now == start);
+
+            cycles = read_cycles();
+
+            return now;
+        }
+
+        void calibrate()
+        {
+            /**
+             * An uptime of zero means it is not available
+             * and would never advance.
+             */
+            if (!has_usable_cycles() || uptime_nanos() == 0)
+            {
+                __atomic_store_n(&state, static_cast<int>(calibration::uptime), __ATOMIC_RELEASE);
+
+                return;
+            }
+
+            uint64_t start_cycles{};
+            auto start_nanos = uptime_edge(start_cycles);
+
+            ::helenos::fibril_usleep(calibration_usecs);
+
+            uint64_t end_cycles{};
+            auto end_nanos = uptime_edge(end_cycles);
+
+            auto cycles = end_cycles - start_cycles;
+            auto nanos = static_cast<uint64_t>(end_nanos - start_nanos);
+            if (cycles == 0 || nanos == 0)
+            {
+                __atomic_store_n(&state, static_cast<int>(calibration::uptime), __ATOMIC_RELEASE);
+
+                return;
+            }
+
+            base_cycles = end_cycles;
+            base_nanos = end_nanos;
+            nanos_per_cycle = (nanos << 32) / cycles;
+
+            __atomic_store_n(&state, static_cast<int>(calibration::cycles), __ATOMIC_RELEASE);
+        }
+
+        calibration get_calibration()
+        {
+            auto current = __atomic_load_n(&state, __ATOMIC_ACQUIRE);
+
+            while (current < static_cast<int>(calibration::cycles))
+            {
+                int expected{static_cast<int>(calibration::none)};
+                if (__atomic_compare_exchange_n(
+                    &state, &expected, static_cast<int>(calibration::running),
+                    false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                {
+                    calibrate();
+                }
+                else
+                    ::helenos::fibril_yield();
+
+                current = __atomic_load_n(&state, __ATOMIC_ACQUIRE);
+            }
+
+            return static_cast<calibration>(current);
+        }
+    }
+
+    high_resolution_clock::time_point high_resolution_clock::now()
+    {
+        if (get_calibration() == calibration::uptime)
+            return time_point{duration{uptime_nanos()}};
+
+        auto delta = read_cycles() - base_cycles;
+        if (static_cast<int64_t>(delta) < 0)
+        {
+            // Counters of different CPUs can be slightly off.
+            delta = 0;
+        }
+
+        /**
+         * Split the multiplication so that it does not
+         * overflow for long uptimes.
+         */
+        auto nanos = (delta >> 32) * nanos_per_cycle +
+            (((delta & 0xFFFFFFFFu) * nanos_per_cycle) >> 32);
+
+        return time_point{duration{base_nanos + static_cast<rep>(nanos)}};
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <exception>
+#include <execution>
+#include <thread>
+
+namespace std
+{
+    namespace experimental
+    {
+        static size_t concurrency_override{};
+
+        void set_parallel_concurrency(size_t workers)
+        {
+            __atomic_store_n(&concurrency_override, workers, __ATOMIC_RELAXED);
+        }
+    }
+
+    namespace aux
+    {
+        size_t parallel_concurrency()
+        {
+            static size_t workers{};
+
+            auto res = __atomic_load_n(&experimental::concurrency_override, __ATOMIC_RELAXED);
+            if (res > 0)
+                return res;
+
+            res = __atomic_load_n(&workers, __ATOMIC_RELAXED);
+            if (res == 0)
+            {
+                res = thread::hardware_concurrency();
+                if (res == 0)
+                    res = 1;
+                __atomic_store_n(&workers, res, __ATOMIC_RELAXED);
+            }
+
+            return res;
+        }
+
+        namespace
+        {
+            struct parallel_task
+            {
+                void (*fn)(void*, size_t);
+                void* arg;
+                size_t idx;
+                ::helenos::fibril_semaphore_t* done;
+            };
+
+            /**
+             * An exception escaping a chunk terminates the program
+             * ([algorithms.parallel.exceptions]), it must neither unwind
+             * through the fibril entry point nor leave the other chunks
+             * running with the caller's state gone.
+             */
+            void run_chunk(void (*fn)(void*, size_t), void* arg, size_t idx)
+            {
+                try
+                {
+                    fn(arg, idx);
+                }
+                catch(...)
+                {
+                    terminate();
+                }
+            }
+
+            ::helenos::errno_t parallel_task_main(void* arg)
+            {
+                auto task = static_cast<parallel_task*>(arg);
+
+                run_chunk(task->fn, task->arg, task->idx);
+                ::helenos::fibril_semaphore_up(task->done);
+
+                return EOK;
+            }
+        }
+
+        void parallel_run(size_t tasks, void (*fn)(void*, size_t), void* arg)
+        {
+            if (tasks == 0)
+                return;
+
+            /**
+             * Without additional runners all fibrils would
+             * run on the calling thread, so the first call
+             * enables the default runner pool. It grows with
+             * the amount of work up to about one runner per
+             * CPU, parks idle runners, and never shrinks a
+             * pool the program has set up itself.
+             */
+            static bool runners_started{};
+            if (!__atomic_exchange_n(&runners_started, true, __ATOMIC_ACQ_REL))
+                ::helenos::fibril_enable_multithreaded();
+
+            ::helenos::fibril_semaphore_t done;
+            ::helenos::fibril_semaphore_initialize(&done, 0);
+
+            auto ctx = new parallel_task[tasks];
+            size_t spawned{};
+            for (size_t i = 1; i < tasks; ++i)
+            {
+                ctx[i] = parallel_task{fn, arg, i, &done};
+
+                auto fid = ::helenos::fibril_create(parallel_task_main, &ctx[i]);
+                if (fid == 0)
+                {
+                    // Not enough memory, do the work ourselves.
+                    run_chunk(fn, arg, i);
+                    continue;
+                }
+
+                ::helenos::fibril_add_ready(fid);
+                ++spawned;
+            }
+
+            run_chunk(fn, arg, 0);
+
+            for (size_t i = 0; i < spawned; ++i)
+                ::helenos::fibril_semaphore_down(&done);
+
+            delete[] ctx;
+        }
+    }
+}
@@ -38,8 +38,10 @@ namespace std
     ios_base::ios_base()
         : iarray_{}, parray_{}, iarray_size_{}, parray_size_{},
           flags_{}, precision_{}, width_{}, locale_{/* TODO: use locale()? */},
-          callbacks_{}
-    { /* DUMMY BODY */ }
+          ctype_char_{}, ctype_wchar_{}, numpunct_char_{}, callbacks_{}
+    {
+        cache_facets_();
+    }
 
     ios_base::~ios_base()
     {
@@ -112,6 +114,7 @@ namespace std
     {
         auto old = locale_;
         locale_ = loc;
+        cache_facets_();
 
         for (auto& callback: callbacks_)
             callback.first(imbue_event, *this, callback.second);
@@ -124,6 +127,13 @@ namespace std
         return locale_;
     }
 
+    void ios_base::cache_facets_()
+    {
+        ctype_char_ = &use_facet<ctype<char>>(locale_);
+        ctype_wchar_ = &use_facet<ctype<wchar_t>>(locale_);
+        numpunct_char_ = &use_facet<numpunct<char>>(locale_);
+    }
+
     long& ios_base::iword(int index)
     {
         if (!iarray_)
@@ -30,6 +30,58 @@
 
 namespace std
 {
+    namespace
+    {
+        constexpr ctype_base::mask classic_mask(int c)
+        {
+            ctype_base::mask res{};
+
+            if (c < 0x20 || c == 0x7F)
+                res |= ctype_base::cntrl;
+            else if (c < 0x7F)
+                res |= ctype_base::print;
+
+            if ((c >= '\t' && c <= '\r') || c == ' ')
+                res |= ctype_base::space;
+            if (c == '\t' || c == ' ')
+                res |= ctype_base::blank;
+
+            if (c >= 'A' && c <= 'Z')
+                res |= ctype_base::upper | ctype_base::alpha;
+            else if (c >= 'a' && c <= 'z')
+                res |= ctype_base::lower | ctype_base::alpha;
+            else if (c >= '0' && c <= '9')
+                res |= ctype_base::digit;
+            else if (c > ' ' && c < 0x7F)
+                res |= ctype_base::punct;
+
+            if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') ||
+                (c >= 'a' && c <= 'f'))
+                res |= ctype_base::xdigit;
+
+            return res;
+        }
+
+        struct classic_masks
+        {
+            ctype_base::mask table[ctype<char>::table_size];
+
+            constexpr classic_masks()
+                : table{}
+            {
+                for (size_t c = 0; c < ctype<char>::table_size; ++c)
+                    table[c] = classic_mask(static_cast<int>(c));
+            }
+        };
+
+        constexpr classic_masks classic{};
+    }
+
+    const ctype_base::mask* ctype<char>::classic_table() noexcept
+    {
+        return classic.table;
+    }
+
     locale::facet::facet(size_t refs)
     {
         // TODO: implement
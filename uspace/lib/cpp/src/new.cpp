@@ -51,6 +51,33 @@ namespace std
     {
         return handler;
     }
+
+    namespace aux
+    {
+        static allocation_counters* counters = nullptr;
+
+        allocation_counters* set_allocation_counters(allocation_counters* c) noexcept
+        {
+            return __atomic_exchange_n(&counters, c, __ATOMIC_ACQ_REL);
+        }
+
+        static void count_allocation(std::size_t size)
+        {
+            auto c = __atomic_load_n(&counters, __ATOMIC_ACQUIRE);
+            if (c)
+            {
+                __atomic_add_fetch(&c->allocations, 1, __ATOMIC_RELAXED);
+                __atomic_add_fetch(&c->bytes, size, __ATOMIC_RELAXED);
+            }
+        }
+
+        static void count_deallocation()
+        {
+            auto c = __atomic_load_n(&counters, __ATOMIC_ACQUIRE);
+            if (c)
+                __atomic_add_fetch(&c->deallocations, 1, __ATOMIC_RELAXED);
+        }
+    }
 }
 
 void* operator new(std::size_t size)
@@ -58,6 +85,7 @@ void* operator new(std::size_t size)
     if (size == 0)
         size = 1;
 
+    std::aux::count_allocation(size);
     void *ptr = std::malloc(size);
 
     while (!ptr)
@@ -107,7 +135,10 @@ void* operator new[](std::size_t size, const std::nothrow_t& nt) noexcept
 void operator delete(void* ptr) noexcept
 {
     if (ptr)
+    {
+        std::aux::count_deallocation();
         std::free(ptr);
+    }
 }
 
 void operator delete(void* ptr, std::size_t ignored) noexcept
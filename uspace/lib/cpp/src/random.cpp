@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 HelenOS developers
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <ctime>
+#include <random>
+#include <task.h>
+
+namespace std
+{
+    namespace
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        enum class hw_source: int
+        {
+            unknown,
+            none,
+            rdrand,
+            rdseed
+        };
+
+        int source{static_cast<int>(hw_source::unknown)};
+
+        /**
+         * RDRAND is reported in CPUID leaf 1 (ECX bit 30),
+         * RDSEED in leaf 7 (EBX bit 18). RDSEED returns
+         * conditioned output of the entropy source directly
+         * and is preferred, RDRAND is a DRBG reseeded from it.
+         */
+        hw_source detect_source()
+        {
+            uint32_t eax{0}, ebx{}, ecx{}, edx{};
+            asm volatile ("cpuid" : "+a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx));
+            auto max_leaf = eax;
+
+            if (max_leaf >= 7)
+            {
+                eax = 7;
+                ecx = 0;
+                asm volatile ("cpuid" : "+a" (eax), "=b" (ebx), "+c" (ecx), "=d" (edx));
+                if (ebx & (1 << 18))
+                    return hw_source::rdseed;
+            }
+
+            eax = 1;
+            asm volatile ("cpuid" : "+a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx));
+            if (ecx & (1 << 30))
+                return hw_source::rdrand;
+
+            return hw_source::none;
+        }
+
+        hw_source get_source()
+        {
+            auto res = __atomic_load_n(&source, __ATOMIC_RELAXED);
+            if (res == static_cast<int>(hw_source::unknown))
+            {
+                res = static_cast<int>(detect_source());
+                __atomic_store_n(&source, res, __ATOMIC_RELAXED);
+            }
+
+            return static_cast<hw_source>(res);
+        }
+
+        /**
+         * Both instructions can transiently fail (CF=0) when
+         * the entropy source is drained, the recommended
+         * approach is to retry a limited number of times.
+         */
+        constexpr int hw_retries{64};
+
+        bool hw_random(hw_source src, unsigned int& res)
+        {
+            for (int i = 0; i < hw_retries; ++i)
+            {
+                unsigned char ok;
+                if (src == hw_source::rdseed)
+                    asm volatile ("rdseed %0; setc %1" : "=r" (res), "=qm" (ok) :: "cc");
+                else
+                    asm volatile ("rdrand %0; setc %1" : "=r" (res), "=qm" (ok) :: "cc");
+
+                if (ok)
+                    return true;
+
+                asm volatile ("pause");
+            }
+
+            // RDSEED can be drained for long, RDRAND cannot.
+            if (src == hw_source::rdseed)
+                return hw_random(hw_source::rdrand, res);
+
+            return false;
+        }
+
+        bool has_hw_random()
+        {
+            return get_source() != hw_source::none;
+        }
+
+        bool hw_random(unsigned int& res)
+        {
+            return hw_random(get_source(), res);
+        }
+
+        uint64_t read_cycles()
+        {
+            uint32_t lo, hi;
+            asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+
+            return (static_cast<uint64_t>(hi) << 32) | lo;
+        }
+#else
+        bool has_hw_random()
+        {
+            return false;
+        }
+
+        bool hw_random(unsigned int&)
+        {
+            return false;
+        }
+
+        uint64_t read_cycles()
+        {
+            return 0;
+        }
+#endif
+
+        /**
+         * Distinguishes random_devices created within the
+         * same process at the same time.
+         */
+        uint64_t instance_counter{};
+
+        /**
+         * Note: The raw cycle counter and uptime are used instead
+         *       of high_resolution_clock, whose first use calibrates
+         *       the cycle counter for over 100 milliseconds.
+         */
+        uint64_t fallback_seed(const void* obj)
+        {
+            ::std::timespec ts{};
+            ::helenos::getuptime(&ts);
+
+            uint64_t s = static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL +
+                static_cast<uint64_t>(ts.tv_nsec);
+            s ^= aux::rotl64(read_cycles(), 23);
+            s ^= aux::rotl64(static_cast<uint64_t>(::helenos::task_get_id()), 32);
+            s ^= aux::rotl64(reinterpret_cast<uintptr_t>(obj), 17);
+            s ^= aux::rotl64(reinterpret_cast<uintptr_t>(&instance_counter), 43);
+            s += __atomic_add_fetch(&instance_counter, 1, __ATOMIC_RELAXED) * 0x9e3779b97f4a7c15ULL;
+
+            return aux::splitmix64(s);
+        }
+    }
+
+    random_device::random_device(const string& token)
+        : hardware_{false}, seeded_{false}, fallback_{}
+    {
+        if (token != "sw")
+            hardware_ = has_hw_random();
+    }
+
+    random_device::result_type random_device::operator()()
+    {
+        result_type res{};
+        if (hardware_ && hw_random(res))
+            return res;
+
+        // The fallback is seeded once it is first needed.
+        if (!seeded_)
+        {
+            fallback_.seed(fallback_seed(this));
+            seeded_ = true;
+        }
+
+        return static_cast<result_type>(fallback_() >> 32);
+    }
+
+    void random_device::fill_(result_type* buf, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            buf[i] = (*this)();
+    }
+
+    double random_device::entropy() const noexcept
+    {
+        if (hardware_)
+            return numeric_limits<result_type>::digits;
+        else
+            return 0.0;
+    }
+}
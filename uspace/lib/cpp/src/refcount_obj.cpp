@@ -27,22 +27,76 @@
  */
 
 #include <__bits/refcount_obj.hpp>
+#include <cstdint>
+#include <fibril.h>
 
 namespace std::aux
 {
-    void refcount_obj::increment()
+    bool threads_active() noexcept
     {
-        __atomic_add_fetch(&refcount_, 1, __ATOMIC_ACQ_REL);
+        return ::helenos::fibril_is_multithreaded();
     }
 
-    void refcount_obj::increment_weak()
+    namespace
     {
-        __atomic_add_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL);
+        constexpr size_t atomic_access_lock_count = 16;
+
+        bool atomic_access_locks[atomic_access_lock_count]{};
+
+        bool& atomic_access_lock_for(const void* ptr)
+        {
+            auto addr = reinterpret_cast<uintptr_t>(ptr);
+
+            return atomic_access_locks[(addr >> 4) % atomic_access_lock_count];
+        }
+    }
+
+    void atomic_access_lock(const void* ptr) noexcept
+    {
+        if (!threads_active())
+            return;
+
+        auto& lock = atomic_access_lock_for(ptr);
+        while (__atomic_test_and_set(&lock, __ATOMIC_ACQUIRE))
+        {
+            while (__atomic_load_n(&lock, __ATOMIC_RELAXED))
+            { /* DUMMY BODY */ }
+        }
+    }
+
+    void atomic_access_unlock(const void* ptr) noexcept
+    {
+        if (!threads_active())
+            return;
+
+        __atomic_clear(&atomic_access_lock_for(ptr), __ATOMIC_RELEASE);
+    }
+
+    void refcount_obj::increment() noexcept
+    {
+        if (threads_active())
+            __atomic_add_fetch(&refcount_, 1, __ATOMIC_RELAXED);
+        else
+            ++refcount_;
     }
 
-    bool refcount_obj::decrement()
+    void refcount_obj::increment_weak() noexcept
     {
-        if (__atomic_sub_fetch(&refcount_, 1, __ATOMIC_ACQ_REL) == 0)
+        if (threads_active())
+            __atomic_add_fetch(&weak_refcount_, 1, __ATOMIC_RELAXED);
+        else
+            ++weak_refcount_;
+    }
+
+    bool refcount_obj::decrement() noexcept
+    {
+        refcount_t rfs{};
+        if (threads_active())
+            rfs = __atomic_sub_fetch(&refcount_, 1, __ATOMIC_ACQ_REL);
+        else
+            rfs = --refcount_;
+
+        if (rfs == 0)
         {
             /**
              * First call to destroy() will delete the held object,
@@ -57,22 +111,53 @@ namespace std::aux
             return false;
     }
 
-    bool refcount_obj::decrement_weak()
+    bool refcount_obj::decrement_weak() noexcept
     {
-        return __atomic_sub_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL) == 0 && refs() == 0;
+        refcount_t rfs{};
+        if (threads_active())
+            rfs = __atomic_sub_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL);
+        else
+            rfs = --weak_refcount_;
+
+        return rfs == 0 && refs() == 0;
+    }
+
+    bool refcount_obj::increment_if_nonzero() noexcept
+    {
+        if (!threads_active())
+        {
+            if (refcount_ == 0)
+                return false;
+
+            ++refcount_;
+            return true;
+        }
+
+        refcount_t rfs = refs();
+        while (rfs != 0L)
+        {
+            if (__atomic_compare_exchange_n(&refcount_, &rfs, rfs + 1,
+                                            true, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                return true;
+            }
+        }
+
+        return false;
     }
 
-    refcount_t refcount_obj::refs() const
+    refcount_t refcount_obj::refs() const noexcept
     {
         return __atomic_load_n(&refcount_, __ATOMIC_RELAXED);
     }
 
-    refcount_t refcount_obj::weak_refs() const
+    refcount_t refcount_obj::weak_refs() const noexcept
     {
         return __atomic_load_n(&weak_refcount_, __ATOMIC_RELAXED);
     }
 
-    bool refcount_obj::expired() const
+    bool refcount_obj::expired() const noexcept
     {
         return refs() == 0;
     }
@@ -29,6 +29,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <exception>
+#include <stats.h>
 #include <thread>
 #include <utility>
 
@@ -119,9 +120,20 @@ namespace std
 
     unsigned thread::hardware_concurrency() noexcept
     {
-        // TODO:
-        __unimplemented();
-        return 0;
+        size_t count{};
+        auto cpus = ::helenos::stats_get_cpus(&count);
+        if (!cpus)
+            return 0;
+
+        unsigned active{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (cpus[i].active)
+                ++active;
+        }
+        std::free(cpus);
+
+        return active;
     }
 
     void swap(thread& x, thread& y) noexcept
@@ -35,9 +35,34 @@ namespace std
     type_info::~type_info()
     { /* DUMMY BODY */ }
 
+    namespace
+    {
+        /**
+         * Itanium C++ ABI: Type names starting with '*' are
+         * local to their translation unit and two type_info
+         * instances with such names are equal only if they
+         * are the same object.
+         */
+        bool is_local_name(const char* name)
+        {
+            return name[0] == '*';
+        }
+    }
+
     bool type_info::operator==(const type_info& other) const noexcept
     {
-        return (this == &other) || ::strcmp(name(), other.name()) == 0;
+        if (this == &other || name() == other.name())
+            return true;
+
+        /**
+         * Different type_info instances of the same type
+         * only exist when they come from different shared
+         * objects, so comparing the names is the slow path.
+         */
+        if (is_local_name(name()) || is_local_name(other.name()))
+            return false;
+
+        return ::strcmp(name(), other.name()) == 0;
     }
 
     bool type_info::operator!=(const type_info& other) const noexcept
@@ -58,20 +83,32 @@ namespace std
          * we have to provide that two comparisons of two same
          * type_info instances return the same result.
          */
-        return name() < other.name();
+        auto cmp = ::strcmp(name(), other.name());
+        if (cmp == 0 && is_local_name(name()))
+            return name() < other.name();
+        else
+            return cmp < 0;
     }
 
     size_t type_info::hash_code() const noexcept
     {
         /**
-         * We only need for the hash codes of two type_info
-         * instances describing the same type to match, nothing
-         * else.
+         * Equal type_info instances must have equal hash
+         * codes even when they are not the same object, so
+         * we hash the name (FNV-1a) unless it is local.
          */
-        size_t res{};
-        const char* str = name();
-        while(*str)
-            res += static_cast<size_t>(*str++);
+        if (is_local_name(name()))
+            return reinterpret_cast<size_t>(name());
+
+        constexpr bool is64 = sizeof(size_t) == 8;
+        size_t res = is64 ? static_cast<size_t>(14695981039346656037ull) : 2166136261u;
+        const size_t prime = is64 ? static_cast<size_t>(1099511628211ull) : 16777619u;
+
+        for (auto str = name(); *str; ++str)
+        {
+            res ^= static_cast<unsigned char>(*str);
+            res *= prime;
+        }
 
         return res;
     }
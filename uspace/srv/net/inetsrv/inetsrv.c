@@ -38,6 +38,7 @@
 #include <async.h>
 #include <errno.h>
 #include <str_error.h>
+#include <fibril.h>
 #include <fibril_synch.h>
 #include <io/log.h>
 #include <ipc/inet.h>
@@ -551,6 +552,9 @@ int main(int argc, char *argv[])
 	if (rc != EOK)
 		return 1;
 
+	/* Serve clients on a pool of runner threads. */
+	fibril_enable_multithreaded();
+
 	printf(NAME ": Accepting connections.\n");
 	task_retval(0);
 	async_manager();
@@ -36,6 +36,7 @@
 
 #include <async.h>
 #include <errno.h>
+#include <fibril.h>
 #include <io/log.h>
 #include <stdio.h>
 #include <task.h>
@@ -89,6 +90,9 @@ int main(int argc, char **argv)
 	if (rc != EOK)
 		return 1;
 
+	/* Serve clients on a pool of runner threads. */
+	fibril_enable_multithreaded();
+
 	printf(NAME ": Accepting connections.\n");
 	task_retval(0);
 	async_manager();
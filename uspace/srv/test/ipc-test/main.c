@@ -40,6 +40,7 @@
 #include <as.h>
 #include <async.h>
 #include <errno.h>
+#include <fibril.h>
 #include <str_error.h>
 #include <io/log.h>
 #include <ipc/ipc_test.h>
@@ -47,6 +48,7 @@
 #include <loc.h>
 #include <mem.h>
 #include <stdio.h>
+#include <str.h>
 #include <task.h>
 
 #define NAME  "ipc-test"
@@ -67,6 +69,9 @@ static const char *ro_data = "Hello, world!";
  */
 static char rw_data[] = "Hello, world!";
 
+/** Buffer for data transfer tests. */
+static char xfer_data[DATA_XFER_LIMIT];
+
 static void ipc_test_get_ro_area_size_srv(ipc_call_t *icall)
 {
 	errno_t rc;
@@ -181,6 +186,66 @@ static void ipc_test_share_in_rw_srv(ipc_call_t *icall)
 	async_answer_0(icall, EOK);
 }
 
+static void ipc_test_write_srv(ipc_call_t *icall)
+{
+	ipc_call_t call;
+	errno_t rc;
+	size_t size;
+
+	log_msg(LOG_DEFAULT, LVL_DEBUG, "ipc_test_write_srv");
+	if (!async_data_write_receive(&call, &size)) {
+		async_answer_0(icall, EINVAL);
+		log_msg(LOG_DEFAULT, LVL_ERROR, "data_write_receive failed");
+		return;
+	}
+
+	if (size > sizeof(xfer_data)) {
+		async_answer_0(&call, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	rc = async_data_write_finalize(&call, xfer_data, size);
+	if (rc != EOK) {
+		log_msg(LOG_DEFAULT, LVL_ERROR,
+		    "async_data_write_finalize failed");
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	async_answer_0(icall, EOK);
+}
+
+static void ipc_test_read_srv(ipc_call_t *icall)
+{
+	ipc_call_t call;
+	errno_t rc;
+	size_t size;
+
+	log_msg(LOG_DEFAULT, LVL_DEBUG, "ipc_test_read_srv");
+	if (!async_data_read_receive(&call, &size)) {
+		async_answer_0(icall, EINVAL);
+		log_msg(LOG_DEFAULT, LVL_ERROR, "data_read_receive failed");
+		return;
+	}
+
+	if (size > sizeof(xfer_data)) {
+		async_answer_0(&call, EINVAL);
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	rc = async_data_read_finalize(&call, xfer_data, size);
+	if (rc != EOK) {
+		log_msg(LOG_DEFAULT, LVL_ERROR,
+		    "async_data_read_finalize failed");
+		async_answer_0(icall, EINVAL);
+		return;
+	}
+
+	async_answer_0(icall, EOK);
+}
+
 static void ipc_test_connection(ipc_call_t *icall, void *arg)
 {
 	/* Accept connection */
@@ -211,6 +276,12 @@ static void ipc_test_connection(ipc_call_t *icall, void *arg)
 		case IPC_TEST_SHARE_IN_RW:
 			ipc_test_share_in_rw_srv(&call);
 			break;
+		case IPC_TEST_WRITE:
+			ipc_test_write_srv(&call);
+			break;
+		case IPC_TEST_READ:
+			ipc_test_read_srv(&call);
+			break;
 		default:
 			async_answer_0(&call, ENOTSUP);
 			break;
@@ -225,6 +296,10 @@ int main(int argc, char *argv[])
 	printf("%s: IPC test service\n", NAME);
 	async_set_fallback_port_handler(ipc_test_connection, NULL);
 
+	/* Allow comparing a single runner with the runner pool. */
+	if (argc > 1 && str_cmp(argv[1], "--pool") == 0)
+		fibril_enable_multithreaded();
+
 	rc = log_init(NAME);
 	if (rc != EOK) {
 		printf(NAME ": Failed to initialize log.\n");
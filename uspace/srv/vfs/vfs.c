@@ -43,6 +43,7 @@
 #include <ns.h>
 #include <async.h>
 #include <errno.h>
+#include <fibril.h>
 #include <str_error.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -143,6 +144,11 @@ int main(int argc, char **argv)
 		return rc;
 	}
 
+	/*
+	 * Serve clients on a pool of runner threads.
+	 */
+	fibril_enable_multithreaded();
+
 	/*
 	 * Start accepting connections.
 	 */